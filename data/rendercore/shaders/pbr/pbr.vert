@@ -12,11 +12,34 @@ uniform bool hasColors    = false;
 uniform bool hasTexCoords = false;
 uniform bool hasNormals   = false;
 uniform bool hasTangents  = false;
+uniform bool hasInstances = false;
 
+uniform mat4 positionDequantization = mat4(1.0);
 uniform mat4 modelMatrix;
 uniform mat4 viewProjectionMatrix;
 uniform mat3 normalMatrix;
 
+// Morph targets (position and normal displacement of each vertex, see MorphTargets)
+#define MAX_MORPH_TARGETS 8
+
+uniform samplerBuffer morphDisplacements;
+uniform int           morphTargetCount = 0;
+uniform int           morphVertexCount = 0;
+uniform int           morphTargets[MAX_MORPH_TARGETS];
+uniform float         morphWeights[MAX_MORPH_TARGETS];
+
+#ifdef SKINNING
+// Joint matrices (the uniform block holds at most 16 KB)
+#define MAX_JOINTS 256
+
+uniform bool hasJoints = false;
+
+layout (std140) uniform JointMatrices
+{
+    mat4 jointMatrices[MAX_JOINTS];
+};
+#endif
+
 
 // Inputs
 layout (location = 0) in vec4 position;
@@ -25,6 +48,13 @@ layout (location = 2) in vec4 tangent;
 layout (location = 3) in vec2 texcoord0;
 layout (location = 4) in vec2 texcoord1;
 layout (location = 7) in vec4 color;
+#ifdef SKINNING
+layout (location = 11) in vec4 joints;
+layout (location = 12) in vec4 weights;
+#endif
+layout (location = 13) in vec3 instanceTranslation;
+layout (location = 14) in vec4 instanceRotation;
+layout (location = 15) in vec3 instanceScale;
 
 
 // Outputs
@@ -37,25 +67,66 @@ out vec3 v_normal;
 
 void main()
 {
+    // Get position in model space (quantized positions are stored relative to the bounding box)
+    vec4 modelPosition = positionDequantization * position;
+    vec3 modelNormal   = normal;
+
+    // Add displacements of the active morph targets
+    for (int i=0; i<morphTargetCount; i++) {
+        int texel = (morphTargets[i] * morphVertexCount + gl_VertexID) * 2;
+        modelPosition.xyz += morphWeights[i] * texelFetch(morphDisplacements, texel).xyz;
+        modelNormal       += morphWeights[i] * texelFetch(morphDisplacements, texel + 1).xyz;
+    }
+
+    // Blend joint matrices
+    mat4 skinMatrix = mat4(1.0);
+#ifdef SKINNING
+    if (hasJoints) {
+        skinMatrix = weights.x * jointMatrices[int(joints.x)]
+                   + weights.y * jointMatrices[int(joints.y)]
+                   + weights.z * jointMatrices[int(joints.z)]
+                   + weights.w * jointMatrices[int(joints.w)];
+    }
+#endif
+
+    // Get transformation of the instance (translation * rotation * scale)
+    mat4 instanceMatrix = mat4(1.0);
+    if (hasInstances) {
+        vec4 q = instanceRotation;
+        mat3 rotation = mat3(
+            1.0 - 2.0 * (q.y * q.y + q.z * q.z), 2.0 * (q.x * q.y + q.w * q.z),       2.0 * (q.x * q.z - q.w * q.y),
+            2.0 * (q.x * q.y - q.w * q.z),       1.0 - 2.0 * (q.x * q.x + q.z * q.z), 2.0 * (q.y * q.z + q.w * q.x),
+            2.0 * (q.x * q.z + q.w * q.y),       2.0 * (q.y * q.z - q.w * q.x),       1.0 - 2.0 * (q.x * q.x + q.y * q.y)
+        );
+
+        instanceMatrix = mat4(
+            vec4(rotation[0] * instanceScale.x, 0.0),
+            vec4(rotation[1] * instanceScale.y, 0.0),
+            vec4(rotation[2] * instanceScale.z, 0.0),
+            vec4(instanceTranslation, 1.0)
+        );
+    }
+
     // Get position in world space
-    vec4 pos = modelMatrix * position;
+    mat4 model = modelMatrix * instanceMatrix * skinMatrix;
+    vec4 pos   = model * modelPosition;
     v_position = vec3(pos.xyz) / pos.w;
 
     // Get normal vector
     if (hasNormals) {
         if (hasTangents) {
             // Calculate TBN matrix
-            vec3 normalW = normalize(vec3(normalMatrix * normal));
-            vec3 tangentW = normalize(vec3(modelMatrix * vec4(tangent.xyz, 0.0)));
+            vec3 normalW = normalize(vec3(normalMatrix * (mat3(instanceMatrix) * mat3(skinMatrix) * modelNormal)));
+            vec3 tangentW = normalize(vec3(model * vec4(tangent.xyz, 0.0)));
             vec3 bitangentW = cross(normalW, tangentW) * tangent.w;
             v_tbn = mat3(tangentW, bitangentW, normalW);
         } else {
             // Only transform normal vector
-            v_normal = normalize(vec3(modelMatrix * vec4(normal.xyz, 0.0)));
+            v_normal = normalize(vec3(model * vec4(modelNormal, 0.0)));
         }
     } else {
         // Assuming a model that is centered around the origin, calculate normal in world space (and then camera space)
-        vec4 center = modelMatrix * vec4(0.0, 0.0, 0.0, 1.0);
+        vec4 center = modelMatrix * instanceMatrix * vec4(0.0, 0.0, 0.0, 1.0);
         v_normal = normalize(vec3(normalMatrix * normalize(v_position - center.xyz)));
     }
 
@@ -76,5 +147,5 @@ void main()
     }
 
     // Transform position into screen space
-    gl_Position = viewProjectionMatrix * modelMatrix * position;
+    gl_Position = viewProjectionMatrix * pos;
 }
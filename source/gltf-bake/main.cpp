@@ -0,0 +1,62 @@
+
+#include <cstdlib>
+#include <string>
+
+#include <cppassist/logging/logging.h>
+#include <cppassist/cmdline/ArgumentParser.h>
+
+#include <rendercore-opengl/BakedAsset.h>
+
+#include <rendercore-gltf/Asset.h>
+#include <rendercore-gltf/GltfConverter.h>
+#include <rendercore-gltf/GltfLoader.h>
+
+
+using namespace rendercore;
+using namespace rendercore::opengl;
+using namespace rendercore::gltf;
+
+
+int main(int argc, char * argv[])
+{
+    // Read command line options
+    cppassist::ArgumentParser argumentParser;
+    argumentParser.parse(argc, argv);
+
+    const auto & params = argumentParser.params();
+    if (params.size() != 2)
+    {
+        cppassist::info() << "Usage: gltf-bake [-optimize] [-quantize] [--lods <levels>] [--meshlets <triangles>] <input.gltf> <output.rcasset>";
+        return 1;
+    }
+
+    const std::string lodString     = argumentParser.value("--lods");
+    const std::string meshletString = argumentParser.value("--meshlets");
+
+    // Load GLTF asset
+    GltfLoader loader;
+    auto asset = loader.load(params[0]);
+    if (!asset)
+    {
+        cppassist::warning() << "Could not load '" << params[0] << "'";
+        return 1;
+    }
+
+    // Convert asset with the requested processing (mipmaps are generated when baking)
+    GltfConverter converter;
+    converter.setGeometryOptimization(argumentParser.isSet("-optimize"));
+    converter.setVertexQuantization(argumentParser.isSet("-quantize"));
+    if (!lodString.empty())     converter.setLodLevels(static_cast<unsigned int>(std::atoi(lodString.c_str())));
+    if (!meshletString.empty()) converter.setMeshletThreshold(static_cast<unsigned int>(std::atoi(meshletString.c_str())));
+    converter.convert(*asset.get());
+
+    // Save baked asset
+    if (!BakedAsset::save(params[1], converter.buffers(), converter.textures(), converter.samplers(),
+                          converter.materials(), converter.meshes(), converter.scenes()))
+    {
+        return 1;
+    }
+
+    // Done
+    return 0;
+}
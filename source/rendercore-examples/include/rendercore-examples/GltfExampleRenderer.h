@@ -13,8 +13,13 @@
 #include <rendercore-opengl/Mesh.h>
 #include <rendercore-opengl/Material.h>
 #include <rendercore-opengl/Texture.h>
+#include <rendercore-opengl/Sampler.h>
+#include <rendercore-opengl/TextureStreamer.h>
 #include <rendercore-opengl/SceneRenderer.h>
 
+#include <rendercore-gltf/AssetRegistry.h>
+#include <rendercore-gltf/GltfStreamer.h>
+
 #include <rendercore-examples/rendercore-examples_api.h>
 
 
@@ -37,8 +42,14 @@ public:
     *
     *  @param[in] container
     *    GPU container (can be null)
+    *  @param[in] registry
+    *    Registry through which the asset is loaded and shared with other renderers (can be null)
+    *
+    *  @remarks
+    *    Without a registry, the asset is streamed and owned by the renderer.
+    *    With a registry, it is loaded synchronously and may be shared.
     */
-    GltfExampleRenderer(GpuContainer * container = nullptr);
+    GltfExampleRenderer(GpuContainer * container = nullptr, rendercore::gltf::AssetRegistry * registry = nullptr);
 
     // Copying a renderer is not allowed
     GltfExampleRenderer(const GltfExampleRenderer &) = delete;
@@ -56,18 +67,44 @@ protected:
     virtual void onUpdate() override;
     virtual void onRender() override;
 
+    /**
+    *  @brief
+    *    Take over buffers, textures, samplers, materials, meshes, and scenes
+    *
+    *  @param[in] source
+    *    Source of the objects (GltfConverter, GltfStreamer, or BakedAsset)
+    */
+    template <typename Source>
+    void takeObjects(Source & source);
+
+    /**
+    *  @brief
+    *    Get scenes to display
+    *
+    *  @return
+    *    Scenes owned by the renderer and scenes of the shared asset
+    */
+    std::vector<rendercore::Scene *> scenes() const;
+
 protected:
     // Simulation data
-    unsigned int m_counter;   ///< Update counter
-    float        m_angle;     ///< Rotation angle
-    Transform    m_transform; ///< Transformation of the model
+    unsigned int m_counter;       ///< Update counter
+    float        m_angle;         ///< Rotation angle
+    float        m_animationTime; ///< Time of the scene animations (in seconds)
+    Transform    m_transform;     ///< Transformation of the model
 
     // GPU data
-    std::unique_ptr<rendercore::Camera>                          m_camera;    ///< Camera in the scene
-    std::vector< std::unique_ptr<rendercore::opengl::Texture> >  m_textures;  ///< List of textures
-    std::vector< std::unique_ptr<rendercore::opengl::Material> > m_materials; ///< List of materials
-    std::vector< std::unique_ptr<rendercore::opengl::Mesh> >     m_meshes;    ///< List of meshes
-    std::vector< std::unique_ptr<rendercore::Scene> >            m_scenes;    ///< List of scenes
+    std::unique_ptr<rendercore::Camera>                             m_camera;    ///< Camera in the scene
+    std::unique_ptr<rendercore::opengl::TextureStreamer>            m_streamer;  ///< Asynchronous uploader for texture data
+    std::vector< std::unique_ptr<rendercore::opengl::Buffer> >      m_buffers;   ///< List of buffers (shared by the meshes)
+    std::vector< std::unique_ptr<rendercore::opengl::Texture> >     m_textures;  ///< List of textures
+    std::vector< std::unique_ptr<rendercore::opengl::Sampler> >     m_samplers;  ///< List of samplers
+    std::vector< std::unique_ptr<rendercore::opengl::Material> >    m_materials; ///< List of materials
+    std::vector< std::unique_ptr<rendercore::opengl::Mesh> >        m_meshes;    ///< List of meshes
+    std::vector< std::unique_ptr<rendercore::Scene> >               m_scenes;    ///< List of scenes
+    std::unique_ptr<rendercore::gltf::GltfStreamer>                 m_loader;    ///< Progressive loader for the GLTF asset (can be null)
+    rendercore::gltf::AssetRegistry                               * m_registry;  ///< Registry of shared assets (can be null)
+    std::shared_ptr<rendercore::gltf::AssetRegistry::LoadedAsset>   m_asset;     ///< Asset loaded through the registry (can be null)
 
     // Sub-renderers
     std::unique_ptr<rendercore::opengl::SceneRenderer> m_sceneRenderer; ///< Scene renderer
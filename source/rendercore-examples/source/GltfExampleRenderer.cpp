@@ -1,15 +1,17 @@
 
 #include <rendercore-examples/GltfExampleRenderer.h>
 
+#include <cmath>
+
 #include <cppassist/memory/make_unique.h>
 
 #include <glbinding/gl/gl.h>
 
 #include <rendercore/rendercore.h>
 
-#include <rendercore-gltf/GltfConverter.h>
-#include <rendercore-gltf/GltfLoader.h>
-#include <rendercore-gltf/Asset.h>
+#include <rendercore-opengl/BakedAsset.h>
+
+#include <rendercore-gltf/GltfStreamer.h>
 
 
 using namespace rendercore::opengl;
@@ -22,10 +24,12 @@ namespace examples
 {
 
 
-GltfExampleRenderer::GltfExampleRenderer(GpuContainer * container)
+GltfExampleRenderer::GltfExampleRenderer(GpuContainer * container, AssetRegistry * registry)
 : Renderer(container)
+, m_registry(registry)
 , m_counter(0)
 , m_angle(0.0f)
+, m_animationTime(0.0f)
 {
     // Initialize object transformation
     m_transform.setTranslation({ 0.0f, 0.0f, 0.0f });
@@ -35,47 +39,77 @@ GltfExampleRenderer::GltfExampleRenderer(GpuContainer * container)
     // Create camera
     m_camera = cppassist::make_unique<Camera>();
 
-    // Load GLTF asset
-    GltfLoader loader;
-    // auto asset = loader.load(rendercore::dataPath() + "/rendercore/gltf/BoxAnimated/BoxAnimated.gltf");
-    // auto asset = loader.load(rendercore::dataPath() + "/rendercore/gltf/TextureCoordinateTest/TextureCoordinateTest.gltf");
-    auto asset = loader.load(rendercore::dataPath() + "/rendercore/gltf/BoomBox/BoomBox.gltf");
-    // auto asset = loader.load(rendercore::dataPath() + "/rendercore/gltf/PbrTest/PbrTest.gltf");
-    // auto asset = loader.load(rendercore::dataPath() + "/rendercore/gltf/Taxi/Taxi.gltf");
+    // Create texture streamer
+    m_streamer = cppassist::make_unique<TextureStreamer>(this);
+
+    // Choose GLTF asset
+    // const std::string filename = rendercore::dataPath() + "/rendercore/gltf/BoxAnimated/BoxAnimated.gltf";
+    // const std::string filename = rendercore::dataPath() + "/rendercore/gltf/TextureCoordinateTest/TextureCoordinateTest.gltf";
+    const std::string filename = rendercore::dataPath() + "/rendercore/gltf/BoomBox/BoomBox.gltf";
+    // const std::string filename = rendercore::dataPath() + "/rendercore/gltf/PbrTest/PbrTest.gltf";
+    // const std::string filename = rendercore::dataPath() + "/rendercore/gltf/Taxi/Taxi.gltf";
+
+    // Load baked asset (see gltf-bake) if available, otherwise stream the GLTF asset
+    BakedAsset baked;
+    if (m_registry) {
+        // Load shared asset
+        m_asset = m_registry->load(filename + ".rcasset");
+        if (!m_asset) {
+            m_asset = m_registry->load(filename);
+        }
+    } else if (baked.load(filename + ".rcasset")) {
+        takeObjects(baked);
+    } else {
+        m_loader = cppassist::make_unique<GltfStreamer>();
+        m_loader->load(filename);
+    }
+
+    // Create mesh renderer
+    m_sceneRenderer = cppassist::make_unique<SceneRenderer>(this);
+}
 
-    // Transfer data from GLTF
-    GltfConverter converter;
-    converter.convert(*asset.get());
+GltfExampleRenderer::~GltfExampleRenderer()
+{
+}
 
-    auto & textures = converter.textures();
+template <typename Source>
+void GltfExampleRenderer::takeObjects(Source & source)
+{
+    auto & buffers = source.buffers();
+    for (auto & buffer : buffers) {
+        buffer->setContainer(this);
+        m_buffers.push_back(std::move(buffer));
+    }
+
+    auto & textures = source.textures();
     for (auto & texture : textures) {
         texture->setContainer(this);
+        texture->setStreamer(m_streamer.get());
         m_textures.push_back(std::move(texture));
     }
 
-    auto & materials = converter.materials();
+    auto & samplers = source.samplers();
+    for (auto & sampler : samplers) {
+        sampler->setContainer(this);
+        m_samplers.push_back(std::move(sampler));
+    }
+
+    auto & materials = source.materials();
     for (auto & material : materials) {
         material->setContainer(this);
         m_materials.push_back(std::move(material));
     }
 
-    auto & meshes = converter.meshes();
+    auto & meshes = source.meshes();
     for (auto & mesh : meshes) {
         mesh->setContainer(this);
         m_meshes.push_back(std::move(mesh));
     }
 
-    auto & scenes = converter.scenes();
+    auto & scenes = source.scenes();
     for (auto & scene : scenes) {
         m_scenes.push_back(std::move(scene));
     }
-
-    // Create mesh renderer
-    m_sceneRenderer = cppassist::make_unique<SceneRenderer>(this);
-}
-
-GltfExampleRenderer::~GltfExampleRenderer()
-{
 }
 
 void GltfExampleRenderer::onUpdate()
@@ -87,12 +121,24 @@ void GltfExampleRenderer::onUpdate()
     m_angle += m_timeDelta * 1.0f;
     m_transform.setRotation(glm::angleAxis(m_angle, glm::vec3(0.0f, 1.0f, 0.0f)));
 
+    // Play scene animations in a loop
+    m_animationTime += m_timeDelta;
+    for (auto * scene : scenes()) {
+        for (auto * animation : scene->animations()) {
+            float duration = animation->duration();
+            animation->apply(duration > 0.0f ? std::fmod(m_animationTime, duration) : 0.0f);
+        }
+    }
+
     // Animation has been updated, redraw the scene (will also issue another update)
     scheduleRedraw();
 }
 
 void GltfExampleRenderer::onRender()
 {
+    // Upload texture data
+    m_streamer->update();
+
     // Update viewport
     gl::glViewport(m_viewport.x, m_viewport.y, m_viewport.z, m_viewport.w);
 
@@ -103,10 +149,42 @@ void GltfExampleRenderer::onRender()
     m_camera->lookAt(glm::vec3(0.0f, 0.0, 9.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
     m_camera->perspective(glm::radians(40.0f), glm::ivec2(m_viewport.z, m_viewport.w), 0.1f, 64.0f);
 
+    // Take over streamed objects, prioritized by their size on screen
+    if (m_loader) {
+        m_loader->update(m_transform.transform(), *m_camera);
+        takeObjects(*m_loader);
+
+        if (!m_loader->busy()) {
+            m_loader.reset();
+        }
+    }
+
     // Render scenes
+    for (auto * scene : scenes()) {
+        m_sceneRenderer->render(*scene, m_transform.transform(), m_camera.get());
+    }
+
+    // Destroy shared assets that are no longer used
+    if (m_registry) {
+        m_registry->collect();
+    }
+}
+
+std::vector<rendercore::Scene *> GltfExampleRenderer::scenes() const
+{
+    std::vector<rendercore::Scene *> scenes;
+
     for (auto & scene : m_scenes) {
-        m_sceneRenderer->render(*scene.get(), m_transform.transform(), m_camera.get());
+        scenes.push_back(scene.get());
+    }
+
+    if (m_asset) {
+        for (auto & scene : m_asset->scenes) {
+            scenes.push_back(scene.get());
+        }
     }
+
+    return scenes;
 }
 
 
@@ -20,6 +20,26 @@ namespace gltf
 */
 class RENDERCORE_GLTF_API Accessor
 {
+public:
+    /**
+    *  @brief
+    *    Sparse storage
+    *
+    *  @remarks
+    *    A sparse accessor replaces the elements at the given indices of the
+    *    data in its buffer view (or of zeros, if it has no buffer view) with
+    *    the given values. Indices are sorted in ascending order.
+    */
+    struct Sparse
+    {
+        unsigned int count;                ///< Number of replaced elements
+        unsigned int indicesBufferView;    ///< Buffer view index of the indices
+        unsigned int indicesOffset;        ///< Offset of the indices (in bytes)
+        unsigned int indicesComponentType; ///< Component type of the indices (OpenGL enum)
+        unsigned int valuesBufferView;     ///< Buffer view index of the values
+        unsigned int valuesOffset;         ///< Offset of the values (in bytes)
+    };
+
 public:
     /**
     *  @brief
@@ -38,18 +58,18 @@ public:
     *    Get buffer view
     *
     *  @return
-    *    Buffer view index
+    *    Buffer view index (-1 for none, in which case all elements are zero)
     */
-    unsigned int bufferView() const;
+    int bufferView() const;
 
     /**
     *  @brief
     *    Set buffer view
     *
     *  @param[in] bufferView
-    *    Buffer view index
+    *    Buffer view index (-1 for none)
     */
-    void setBufferView(unsigned int bufferView);
+    void setBufferView(int bufferView);
 
     /**
     *  @brief
@@ -87,6 +107,24 @@ public:
     */
     void setComponentType(unsigned int componentType);
 
+    /**
+    *  @brief
+    *    Check if integer components are normalized
+    *
+    *  @return
+    *    'true' if integer values are mapped to [0, 1] or [-1, 1], else 'false'
+    */
+    bool normalized() const;
+
+    /**
+    *  @brief
+    *    Set if integer components are normalized
+    *
+    *  @param[in] normalized
+    *    'true' if integer values are mapped to [0, 1] or [-1, 1], else 'false'
+    */
+    void setNormalized(bool normalized);
+
     /**
     *  @brief
     *    Get offset into buffer view
@@ -159,14 +197,44 @@ public:
     */
     void setMaxValue(const std::vector<float> & maxValue);
 
+    /**
+    *  @brief
+    *    Check if accessor uses sparse storage
+    *
+    *  @return
+    *    'true' if sparse, else 'false'
+    */
+    bool isSparse() const;
+
+    /**
+    *  @brief
+    *    Get sparse storage
+    *
+    *  @return
+    *    Sparse storage (only valid if isSparse() is 'true')
+    */
+    const Sparse & sparse() const;
+
+    /**
+    *  @brief
+    *    Set sparse storage
+    *
+    *  @param[in] sparse
+    *    Sparse storage
+    */
+    void setSparse(const Sparse & sparse);
+
 protected:
-    unsigned int       m_bufferView;    ///< Buffer view index
+    int                m_bufferView;    ///< Buffer view index (-1 for none)
     std::string        m_dataType;      ///< Data type (e.g., "SCALAR", "VEC3", ...)
     unsigned int       m_componentType; ///< Component type (OpenGL enum)
+    bool               m_normalized;    ///< Are integer components normalized?
     unsigned int       m_offset;        ///< Offset (in bytes)
     unsigned int       m_count;         ///< Number of elements
     std::vector<float> m_minValue;      ///< Minimum value
     std::vector<float> m_maxValue;      ///< Maximum value
+    bool               m_isSparse;      ///< Does the accessor use sparse storage?
+    Sparse             m_sparse;        ///< Sparse storage
 };
 
 
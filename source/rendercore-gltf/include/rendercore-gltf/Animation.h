@@ -0,0 +1,121 @@
+
+#pragma once
+
+
+#include <string>
+#include <vector>
+
+#include <rendercore-gltf/rendercore-gltf_api.h>
+
+
+namespace rendercore
+{
+namespace gltf
+{
+
+
+/**
+*  @brief
+*    Animation
+*/
+class RENDERCORE_GLTF_API Animation
+{
+public:
+    /**
+    *  @brief
+    *    Animation channel
+    */
+    struct Channel
+    {
+        unsigned int sampler; ///< Index of the sampler in this animation
+        int          node;    ///< Index of the animated node (-1 for none)
+        std::string  path;    ///< Animated property ('translation', 'rotation', 'scale' or 'weights')
+    };
+
+    /**
+    *  @brief
+    *    Animation sampler
+    */
+    struct Sampler
+    {
+        unsigned int input;         ///< Index of the accessor with keyframe times
+        unsigned int output;        ///< Index of the accessor with keyframe values
+        std::string  interpolation; ///< Interpolation ('STEP', 'LINEAR' or 'CUBICSPLINE')
+    };
+
+public:
+    /**
+    *  @brief
+    *    Constructor
+    */
+    Animation();
+
+    /**
+    *  @brief
+    *    Destructor
+    */
+    ~Animation();
+
+    /**
+    *  @brief
+    *    Get name
+    *
+    *  @return
+    *    Animation name
+    */
+    const std::string & name() const;
+
+    /**
+    *  @brief
+    *    Set name
+    *
+    *  @param[in] name
+    *    Animation name
+    */
+    void setName(const std::string & name);
+
+    /**
+    *  @brief
+    *    Get channels
+    *
+    *  @return
+    *    List of channels
+    */
+    const std::vector<Channel> & channels() const;
+
+    /**
+    *  @brief
+    *    Add channel
+    *
+    *  @param[in] channel
+    *    Channel
+    */
+    void addChannel(const Channel & channel);
+
+    /**
+    *  @brief
+    *    Get samplers
+    *
+    *  @return
+    *    List of samplers
+    */
+    const std::vector<Sampler> & samplers() const;
+
+    /**
+    *  @brief
+    *    Add sampler
+    *
+    *  @param[in] sampler
+    *    Sampler
+    */
+    void addSampler(const Sampler & sampler);
+
+protected:
+    std::string          m_name;     ///< Animation name
+    std::vector<Channel> m_channels; ///< List of channels
+    std::vector<Sampler> m_samplers; ///< List of samplers
+};
+
+
+} // namespace gltf
+} // namespace rendercore
@@ -11,6 +11,8 @@
 #include <rendercore-gltf/Buffer.h>
 #include <rendercore-gltf/BufferView.h>
 #include <rendercore-gltf/Accessor.h>
+#include <rendercore-gltf/Animation.h>
+#include <rendercore-gltf/Skin.h>
 #include <rendercore-gltf/Mesh.h>
 #include <rendercore-gltf/Material.h>
 #include <rendercore-gltf/TextureInfo.h>
@@ -116,6 +118,39 @@ public:
     */
     void setDefaultScene(int scene);
 
+    /**
+    *  @brief
+    *    Get binary chunk
+    *
+    *  @return
+    *    Data of the embedded binary chunk (can be null)
+    *
+    *  @remarks
+    *    For binary GLTF files (.glb), this references the BIN chunk in the
+    *    mapped file, which is used by the first buffer if it has no URI.
+    */
+    const std::shared_ptr<char> & binaryChunk() const;
+
+    /**
+    *  @brief
+    *    Get size of binary chunk
+    *
+    *  @return
+    *    Size of the embedded binary chunk (in bytes)
+    */
+    unsigned int binaryChunkSize() const;
+
+    /**
+    *  @brief
+    *    Set binary chunk
+    *
+    *  @param[in] data
+    *    Data of the embedded binary chunk (can be null)
+    *  @param[in] size
+    *    Size of the embedded binary chunk (in bytes)
+    */
+    void setBinaryChunk(const std::shared_ptr<char> & data, unsigned int size);
+
     /**
     *  @brief
     *    Get scenes
@@ -146,6 +181,15 @@ public:
     */
     void addScene(std::unique_ptr<Scene> && scene);
 
+    /**
+    *  @brief
+    *    Get number of nodes
+    *
+    *  @return
+    *    Number of nodes
+    */
+    size_t nodeCount() const;
+
     /**
     *  @brief
     *    Get nodes
@@ -296,6 +340,66 @@ public:
     */
     void addMesh(std::unique_ptr<Mesh> && mesh);
 
+    /**
+    *  @brief
+    *    Get animations
+    *
+    *  @return
+    *    List of animations
+    */
+    std::vector<Animation *> animations() const;
+
+    /**
+    *  @brief
+    *    Get animation
+    *
+    *  @param[in] index
+    *    Animation index
+    *
+    *  @return
+    *    Animation (can be null)
+    */
+    Animation * animation(size_t index) const;
+
+    /**
+    *  @brief
+    *    Add animation
+    *
+    *  @param[in] animation
+    *    Animation (must NOT be nullptr)
+    */
+    void addAnimation(std::unique_ptr<Animation> && animation);
+
+    /**
+    *  @brief
+    *    Get skins
+    *
+    *  @return
+    *    List of skins
+    */
+    std::vector<Skin *> skins() const;
+
+    /**
+    *  @brief
+    *    Get skin
+    *
+    *  @param[in] index
+    *    Skin index
+    *
+    *  @return
+    *    Skin (can be null)
+    */
+    Skin * skin(size_t index) const;
+
+    /**
+    *  @brief
+    *    Add skin
+    *
+    *  @param[in] skin
+    *    Skin (must NOT be nullptr)
+    */
+    void addSkin(std::unique_ptr<Skin> && skin);
+
     /**
     *  @brief
     *    Get materials
@@ -453,6 +557,10 @@ protected:
     float       m_minVersion; ///< Minimum GLTF version for this asset
     int         m_scene;      ///< Index of default scene (-1 for none)
 
+    // Embedded binary data
+    std::shared_ptr<char> m_binaryChunk;     ///< BIN chunk of a binary GLTF file (can be null)
+    unsigned int          m_binaryChunkSize; ///< Size of the BIN chunk (in bytes)
+
     // Data
     std::vector< std::unique_ptr<Scene> >       m_scenes;
     std::vector< std::unique_ptr<Node> >        m_nodes;
@@ -460,6 +568,8 @@ protected:
     std::vector< std::unique_ptr<BufferView> >  m_bufferViews;
     std::vector< std::unique_ptr<Accessor> >    m_accessors;
     std::vector< std::unique_ptr<Mesh> >        m_meshes;
+    std::vector< std::unique_ptr<Animation> >   m_animations;
+    std::vector< std::unique_ptr<Skin> >        m_skins;
     std::vector< std::unique_ptr<Material> >    m_materials;
     std::vector< std::unique_ptr<TextureInfo> > m_textureInfos;
     std::vector< std::unique_ptr<Texture> >     m_textures;
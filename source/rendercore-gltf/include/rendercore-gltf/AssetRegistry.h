@@ -0,0 +1,311 @@
+
+#pragma once
+
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <rendercore/GpuContainer.h>
+#include <rendercore/scene/Scene.h>
+
+#include <rendercore-opengl/Buffer.h>
+#include <rendercore-opengl/Mesh.h>
+#include <rendercore-opengl/Material.h>
+#include <rendercore-opengl/Texture.h>
+#include <rendercore-opengl/Sampler.h>
+
+#include <rendercore-gltf/rendercore-gltf_api.h>
+
+
+namespace rendercore
+{
+namespace gltf
+{
+
+
+class Asset;
+
+
+/**
+*  @brief
+*    Registry that shares converted assets between their users
+*
+*  @remarks
+*    Assets are identified by their canonical path and the content hash
+*    of their file and of the external buffer and image files of GLTF
+*    assets, so an asset is loaded and converted only once, and is loaded
+*    again if any of these files has changed. Textures of image files are
+*    registered as well, so assets that refer to the same image file share
+*    its texture.
+*
+*    Users hold shared handles to the loaded assets. When the last handle
+*    of an asset is released, its objects are not destroyed immediately,
+*    but by collect() after a number of further calls, so the GPU data is
+*    released on the rendering thread and assets that are used again soon
+*    do not have to be reloaded.
+*
+*    The registry is the GPU container of all registered objects. One
+*    registry should be used per group of rendering contexts that share
+*    their objects. Handles should be released before the registry is
+*    destroyed. Assets that are still in use at that time are detached
+*    from the registry and destroyed when their last handle is released.
+*/
+class RENDERCORE_GLTF_API AssetRegistry : public rendercore::GpuContainer
+{
+public:
+    /**
+    *  @brief
+    *    Objects of a registered asset
+    *
+    *  @remarks
+    *    Scenes are shared as well, including the state of their animations.
+    */
+    struct LoadedAsset
+    {
+        std::string                                                  path;         ///< Canonical path of the file
+        unsigned long long                                           hash;         ///< Content hash of the file
+        std::vector< std::unique_ptr<rendercore::opengl::Buffer> >   buffers;      ///< List of buffers (shared by the meshes)
+        std::vector< std::unique_ptr<rendercore::opengl::Texture> >  textures;     ///< List of textures (only embedded images, or the image of a texture asset)
+        std::vector< std::unique_ptr<rendercore::opengl::Sampler> >  samplers;     ///< List of samplers
+        std::vector< std::unique_ptr<rendercore::opengl::Material> > materials;    ///< List of materials
+        std::vector< std::unique_ptr<rendercore::opengl::Mesh> >     meshes;       ///< List of meshes
+        std::vector< std::unique_ptr<rendercore::Scene> >            scenes;       ///< List of scenes
+        std::vector< std::shared_ptr<LoadedAsset> >                  dependencies; ///< Registered assets used by this asset (e.g., textures of image files)
+    };
+
+public:
+    /**
+    *  @brief
+    *    Constructor
+    *
+    *  @param[in] container
+    *    GPU container (can be null)
+    */
+    AssetRegistry(GpuContainer * container = nullptr);
+
+    /**
+    *  @brief
+    *    Destructor
+    *
+    *  @notes
+    *    - Requires an active rendering context
+    */
+    virtual ~AssetRegistry();
+
+    /**
+    *  @brief
+    *    Get release delay
+    *
+    *  @return
+    *    Number of calls to collect() after which unused assets are destroyed
+    */
+    unsigned int releaseDelay() const;
+
+    /**
+    *  @brief
+    *    Set release delay
+    *
+    *  @param[in] delay
+    *    Number of calls to collect() after which unused assets are destroyed
+    */
+    void setReleaseDelay(unsigned int delay);
+
+    /**
+    *  @brief
+    *    Get number of registered assets
+    *
+    *  @return
+    *    Number of assets and textures, including unused ones that have not been destroyed yet
+    */
+    size_t size() const;
+
+    /**
+    *  @brief
+    *    Load asset
+    *
+    *  @param[in] filename
+    *    Filename of a GLTF asset, or of a baked asset ('.rcasset')
+    *
+    *  @return
+    *    Handle to the asset (null if it could not be loaded)
+    *
+    *  @remarks
+    *    If the asset has already been loaded from the same file with
+    *    the same content, the registered asset is returned. The JSON of
+    *    GLTF assets is parsed in any case, to find the files it refers to.
+    */
+    std::shared_ptr<LoadedAsset> load(const std::string & filename);
+
+    /**
+    *  @brief
+    *    Load texture from an image file
+    *
+    *  @param[in] filename
+    *    Filename of the image
+    *
+    *  @return
+    *    Handle to an asset that contains the texture (null if the file does not exist)
+    *
+    *  @remarks
+    *    If the texture has already been loaded from the same file with
+    *    the same content, the registered texture is returned.
+    */
+    std::shared_ptr<LoadedAsset> loadTexture(const std::string & filename);
+
+    /**
+    *  @brief
+    *    Destroy assets that have not been used for the release delay
+    *
+    *  @remarks
+    *    This has to be called regularly (e.g., once per frame).
+    *
+    *  @notes
+    *    - Requires an active rendering context
+    */
+    void collect();
+
+protected:
+    /**
+    *  @brief
+    *    Registered asset
+    */
+    struct Entry
+    {
+        std::unique_ptr<LoadedAsset> asset;    ///< Objects of the asset
+        std::weak_ptr<LoadedAsset>   handle;   ///< Handle that is given to the users (expired if unused)
+        bool                         released; ///< Has the last handle been released?
+        unsigned int                 age;      ///< Number of calls to collect() since the release
+    };
+
+    /**
+    *  @brief
+    *    Registered assets
+    *
+    *  @remarks
+    *    The state is shared with the handles, so that handles can be
+    *    released safely after the registry has been destroyed.
+    */
+    struct State
+    {
+        std::map< std::pair<std::string, unsigned long long>, Entry > entries; ///< Registered assets by canonical path and content hash
+        std::mutex                                                    mutex;   ///< Mutex for the registered assets (handles can be released on any thread)
+        bool                                                          closed;  ///< Has the registry been destroyed?
+    };
+
+protected:
+    /**
+    *  @brief
+    *    Get handle to a registered asset
+    *
+    *  @param[in] path
+    *    Canonical path of the file
+    *  @param[in] hash
+    *    Content hash of the file
+    *
+    *  @return
+    *    Handle to the asset (null if it is not registered)
+    */
+    std::shared_ptr<LoadedAsset> acquire(const std::string & path, unsigned long long hash);
+
+    /**
+    *  @brief
+    *    Register asset
+    *
+    *  @param[in] asset
+    *    Loaded asset (must NOT be null)
+    *
+    *  @return
+    *    Handle to the asset
+    */
+    std::shared_ptr<LoadedAsset> add(std::unique_ptr<LoadedAsset> && asset);
+
+    /**
+    *  @brief
+    *    Create handle to a registered asset
+    *
+    *  @param[in] asset
+    *    Registered asset (must NOT be null)
+    *
+    *  @return
+    *    Handle that marks the asset as unused when it is released
+    */
+    std::shared_ptr<LoadedAsset> createHandle(LoadedAsset * asset);
+
+    /**
+    *  @brief
+    *    Mark asset as unused
+    *
+    *  @param[in] state
+    *    Registered assets
+    *  @param[in] asset
+    *    Registered asset (must NOT be null)
+    *
+    *  @remarks
+    *    This is called when the last handle of an asset is released.
+    *    If the registry has already been destroyed, the asset is
+    *    destroyed immediately.
+    */
+    static void release(State & state, LoadedAsset * asset);
+
+    /**
+    *  @brief
+    *    Detach objects of an asset from the registry
+    *
+    *  @param[in] asset
+    *    Registered asset
+    */
+    static void detach(LoadedAsset & asset);
+
+    /**
+    *  @brief
+    *    Get canonical path of a file
+    *
+    *  @param[in] filename
+    *    Filename
+    *
+    *  @return
+    *    Path with unified separators and without '.' and '..' components
+    */
+    static std::string canonicalPath(const std::string & filename);
+
+    /**
+    *  @brief
+    *    Get content hash of a file
+    *
+    *  @param[in] path
+    *    Path of the file
+    *  @param[out] hash
+    *    Content hash of the file
+    *
+    *  @return
+    *    'true' if the file could be read, else 'false'
+    */
+    static bool fileHash(const std::string & path, unsigned long long & hash);
+
+    /**
+    *  @brief
+    *    Add content hashes of the external files of a GLTF asset to a hash
+    *
+    *  @param[in] gltfAsset
+    *    GLTF asset
+    *  @param[in,out] hash
+    *    Content hash of the asset file, combined with those of its external buffers and images
+    *
+    *  @remarks
+    *    Embedded data (data URIs and binary chunks) is already covered by
+    *    the hash of the asset file. Files that cannot be read are skipped.
+    */
+    static void dependencyHash(const Asset & gltfAsset, unsigned long long & hash);
+
+protected:
+    unsigned int           m_releaseDelay; ///< Number of calls to collect() after which unused assets are destroyed
+    std::shared_ptr<State> m_state;        ///< Registered assets (shared with the handles)
+};
+
+
+} // namespace gltf
+} // namespace rendercore
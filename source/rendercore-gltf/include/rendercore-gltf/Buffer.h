@@ -68,9 +68,28 @@ public:
     */
     void setUri(const std::string & uri);
 
+    /**
+    *  @brief
+    *    Check if buffer is a fallback buffer
+    *
+    *  @return
+    *    'true' if the buffer only receives decompressed data and need not be loaded, else 'false'
+    */
+    bool isFallback() const;
+
+    /**
+    *  @brief
+    *    Set if buffer is a fallback buffer
+    *
+    *  @param[in] fallback
+    *    'true' if the buffer only receives decompressed data and need not be loaded, else 'false'
+    */
+    void setFallback(bool fallback);
+
 protected:
-    unsigned int m_size; ///< Buffer size (in bytes)
-    std::string  m_uri;  ///< URI
+    unsigned int m_size;     ///< Buffer size (in bytes)
+    std::string  m_uri;      ///< URI
+    bool         m_fallback; ///< Is the buffer a fallback buffer (EXT_meshopt_compression)?
 };
 
 
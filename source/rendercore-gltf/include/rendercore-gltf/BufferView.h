@@ -2,6 +2,8 @@
 #pragma once
 
 
+#include <string>
+
 #include <rendercore-gltf/rendercore-gltf_api.h>
 
 
@@ -17,6 +19,27 @@ namespace gltf
 */
 class RENDERCORE_GLTF_API BufferView
 {
+public:
+    /**
+    *  @brief
+    *    Compressed storage (EXT_meshopt_compression)
+    *
+    *  @remarks
+    *    The data of a compressed buffer view is stored in another buffer
+    *    and has to be decoded into the range of the buffer view. The buffer
+    *    of the buffer view itself is usually a fallback buffer without data.
+    */
+    struct Compression
+    {
+        unsigned int buffer; ///< Buffer index of the compressed data
+        unsigned int offset; ///< Offset of the compressed data (in bytes)
+        unsigned int size;   ///< Size of the compressed data (in bytes)
+        unsigned int stride; ///< Size of an element (in bytes)
+        unsigned int count;  ///< Number of elements
+        std::string  mode;   ///< Compression mode ('ATTRIBUTES', 'TRIANGLES', or 'INDICES')
+        std::string  filter; ///< Filter applied after decoding ('NONE', 'OCTAHEDRAL', 'QUATERNION', or 'EXPONENTIAL')
+    };
+
 public:
     /**
     *  @brief
@@ -120,12 +143,41 @@ public:
     */
     void setTarget(unsigned int target);
 
+    /**
+    *  @brief
+    *    Check if buffer view is compressed
+    *
+    *  @return
+    *    'true' if compressed, else 'false'
+    */
+    bool isCompressed() const;
+
+    /**
+    *  @brief
+    *    Get compressed storage
+    *
+    *  @return
+    *    Compressed storage (only valid if isCompressed() is 'true')
+    */
+    const Compression & compression() const;
+
+    /**
+    *  @brief
+    *    Set compressed storage
+    *
+    *  @param[in] compression
+    *    Compressed storage
+    */
+    void setCompression(const Compression & compression);
+
 protected:
-    unsigned int m_buffer; ///< Buffer index
-    unsigned int m_size;   ///< Size (in bytes)
-    unsigned int m_offset; ///< Offset (in bytes)
-    unsigned int m_stride; ///< Stride (in bytes)
-    unsigned int m_target; ///< Bind target (OpenGL enum, e.g., GL_ARRAY_BUFFER, or GL_ELEMENT_ARRAY_BUFFER)
+    unsigned int m_buffer;       ///< Buffer index
+    unsigned int m_size;         ///< Size (in bytes)
+    unsigned int m_offset;       ///< Offset (in bytes)
+    unsigned int m_stride;       ///< Stride (in bytes)
+    unsigned int m_target;       ///< Bind target (OpenGL enum, e.g., GL_ARRAY_BUFFER, or GL_ELEMENT_ARRAY_BUFFER)
+    bool         m_isCompressed; ///< Is the buffer view compressed?
+    Compression  m_compression;  ///< Compressed storage
 };
 
 
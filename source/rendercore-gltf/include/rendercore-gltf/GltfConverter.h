@@ -2,34 +2,68 @@
 #pragma once
 
 
+#include <functional>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
+#include <unordered_map>
+#include <unordered_set>
 
+#include <glm/glm.hpp>
+
+#include <rendercore/FileCache.h>
+#include <rendercore/GeometryOptimizer.h>
+#include <rendercore/Image.h>
+#include <rendercore/MeshletBuilder.h>
 #include <rendercore/scene/Scene.h>
 
+#include <rendercore-opengl/Buffer.h>
+#include <rendercore-opengl/Geometry.h>
 #include <rendercore-opengl/Mesh.h>
 #include <rendercore-opengl/Material.h>
 #include <rendercore-opengl/Texture.h>
+#include <rendercore-opengl/Sampler.h>
 
 #include <rendercore-gltf/rendercore-gltf_api.h>
 
 
 namespace rendercore
 {
+
+
+class WorkerPool;
+
+
+namespace opengl
+{
+    class InstancedMeshComponent;
+    class MeshComponent;
+}
+
+
 namespace gltf
 {
 
 
+class Accessor;
 class Asset;
+class BufferView;
 class Material;
 class Mesh;
+class Node;
+class Primitive;
 class Scene;
 
 
 /**
 *  @brief
 *    Converter from GTLF data into rendercore objects
+*
+*  @remarks
+*    Buffers are loaded and decompressed, images decoded, and meshes
+*    generated in parallel on a worker pool. Materials and scenes are generated, and decoded
+*    images are handed over to their textures, on the calling thread.
 */
 class RENDERCORE_GLTF_API GltfConverter
 {
@@ -46,6 +80,136 @@ public:
     */
     ~GltfConverter();
 
+    /**
+    *  @brief
+    *    Check if geometry is optimized during conversion
+    *
+    *  @return
+    *    'true' if geometry is optimized, else 'false'
+    */
+    bool geometryOptimization() const;
+
+    /**
+    *  @brief
+    *    Set if geometry is optimized during conversion
+    *
+    *  @param[in] enabled
+    *    'true' to optimize geometry, else 'false'
+    *
+    *  @remarks
+    *    If enabled, triangles are reordered for vertex cache locality
+    *    and reduced overdraw, and vertices for fetch locality. Index and
+    *    vertex data are rewritten in place before the buffers are created.
+    *    Disabled by default.
+    */
+    void setGeometryOptimization(bool enabled);
+
+    /**
+    *  @brief
+    *    Get number of generated levels of detail
+    *
+    *  @return
+    *    Number of simplified levels generated for each triangle list (0 if disabled)
+    */
+    unsigned int lodLevels() const;
+
+    /**
+    *  @brief
+    *    Set number of generated levels of detail
+    *
+    *  @param[in] levels
+    *    Number of simplified levels generated for each triangle list (0 to disable)
+    *
+    *  @remarks
+    *    Each level has about half the triangles of the previous one.
+    *    Fewer levels are generated if a mesh cannot be simplified any
+    *    further. All levels share the vertex buffers of the mesh and
+    *    are stored one after the other in its index buffer.
+    *    Disabled by default.
+    */
+    void setLodLevels(unsigned int levels);
+
+    /**
+    *  @brief
+    *    Get minimum size of triangle lists that are split into meshlets
+    *
+    *  @return
+    *    Minimum number of triangles (0 if disabled)
+    */
+    unsigned int meshletThreshold() const;
+
+    /**
+    *  @brief
+    *    Set minimum size of triangle lists that are split into meshlets
+    *
+    *  @param[in] triangles
+    *    Minimum number of triangles (0 to disable)
+    *
+    *  @remarks
+    *    The triangles of large meshes are reordered into clusters of at
+    *    most 64 vertices and 124 triangles, which the scene renderer can
+    *    cull individually. Only the full geometry (first level of detail)
+    *    is split. Disabled by default.
+    */
+    void setMeshletThreshold(unsigned int triangles);
+
+    /**
+    *  @brief
+    *    Check if vertex attributes are quantized during conversion
+    *
+    *  @return
+    *    'true' if vertex attributes are quantized, else 'false'
+    */
+    bool vertexQuantization() const;
+
+    /**
+    *  @brief
+    *    Set if vertex attributes are quantized during conversion
+    *
+    *  @param[in] enabled
+    *    'true' to quantize vertex attributes, else 'false'
+    *
+    *  @remarks
+    *    If enabled, float positions are stored as 16 bit integers relative
+    *    to their bounding box, normals and tangents as 10:10:10:2 integers,
+    *    and texture coordinates as 16 bit integers or half floats, if
+    *    their range allows it. Other attributes are kept as they are.
+    *    Disabled by default.
+    */
+    void setVertexQuantization(bool enabled);
+
+    /**
+    *  @brief
+    *    Get cache directory for optimized geometry
+    *
+    *  @return
+    *    Cache directory ('' if the cache is disabled)
+    */
+    const std::string & cacheDirectory() const;
+
+    /**
+    *  @brief
+    *    Set cache directory for optimized geometry
+    *
+    *  @param[in] directory
+    *    Cache directory ('' to disable the cache)
+    */
+    void setCacheDirectory(const std::string & directory);
+
+    /**
+    *  @brief
+    *    Set function that provides existing textures for image files
+    *
+    *  @param[in] lookup
+    *    Function that is called with the path of an image file and returns
+    *    an existing texture for it, or null to load the image (can be empty)
+    *
+    *  @remarks
+    *    Textures that are provided by the function are used by the materials,
+    *    but are not owned by the converter and not listed in textures().
+    */
+    void setTextureLookup(std::function<rendercore::opengl::Texture * (const std::string & path)> lookup);
+
     /**
     *  @brief
     *    Convert GLTF asset
@@ -55,6 +219,15 @@ public:
     */
     void convert(const Asset & asset);
 
+    /**
+    *  @brief
+    *    Get buffers
+    *
+    *  @return
+    *    List of buffers (shared by all meshes, must outlive them)
+    */
+    std::vector< std::unique_ptr<rendercore::opengl::Buffer> > & buffers();
+
     /**
     *  @brief
     *    Get textures
@@ -64,6 +237,24 @@ public:
     */
     std::vector< std::unique_ptr<rendercore::opengl::Texture> > & textures();
 
+    /**
+    *  @brief
+    *    Get paths of the image files of the loaded textures
+    *
+    *  @return
+    *    Path of the image file of each texture in textures() ('' for embedded images)
+    */
+    const std::vector<std::string> & texturePaths() const;
+
+    /**
+    *  @brief
+    *    Get samplers
+    *
+    *  @return
+    *    List of samplers
+    */
+    std::vector< std::unique_ptr<rendercore::opengl::Sampler> > & samplers();
+
     /**
     *  @brief
     *    Get materials
@@ -91,6 +282,30 @@ public:
     */
     std::vector< std::unique_ptr<rendercore::Scene> > & scenes();
 
+protected:
+    /**
+    *  @brief
+    *    Levels of detail of a triangle list
+    */
+    struct LodData
+    {
+        std::vector<unsigned int>                      indices;        ///< Indices of all levels
+        std::vector<rendercore::opengl::Geometry::Lod> lods;           ///< Index range and error of each level
+        glm::vec4                                      boundingSphere; ///< Bounding sphere of the vertices
+    };
+
+    /**
+    *  @brief
+    *    Index buffer of a primitive, or of a part of a split primitive
+    */
+    struct IndexRange
+    {
+        rendercore::opengl::Buffer * buffer;     ///< Index buffer
+        unsigned int                 type;       ///< Data type of the indices (e.g., GL_UNSIGNED_SHORT)
+        unsigned int                 count;      ///< Number of indices
+        unsigned int                 baseVertex; ///< Value that is added to each index before fetching the vertex
+    };
+
 protected:
     /**
     *  @brief
@@ -111,8 +326,15 @@ protected:
     *    GLTF asset
     *  @param[in] mesh
     *    GLTF mesh
+    *
+    *  @return
+    *    Mesh
+    *
+    *  @remarks
+    *    This function is called on worker threads. It must only read
+    *    the loaded buffers and materials.
     */
-    void generateMesh(const Asset & asset, const Mesh & mesh);
+    std::unique_ptr<rendercore::opengl::Mesh> generateMesh(const Asset & asset, const Mesh & mesh) const;
 
     /**
     *  @brief
@@ -122,39 +344,660 @@ protected:
     *    GLTF asset
     *  @param[in] scene
     *    GLTF scene
+    *
+    *  @remarks
+    *    The node hierarchy is traversed iteratively, so deep hierarchies
+    *    do not exhaust the stack. Scene nodes and mesh components are
+    *    created by the arena of the scene.
     */
     void generateScene(const Asset & asset, const Scene & scene);
 
     /**
     *  @brief
-    *    Load texture from external file
+    *    Generate instanced mesh component from GLTF data (EXT_mesh_gpu_instancing)
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[in] node
+    *    GLTF node with instance attributes
+    *
+    *  @return
+    *    Mesh component that draws all instances (without instances if the attributes are invalid)
+    *
+    *  @remarks
+    *    The instance attributes are interleaved into a single buffer,
+    *    no scene node is created per instance. The bounding box of the
+    *    component encloses the bounding box of the mesh at each instance.
+    */
+    std::unique_ptr<rendercore::opengl::InstancedMeshComponent> generateInstances(const Asset & asset, const Node & node);
+
+    /**
+    *  @brief
+    *    Generate animations of a scene from GLTF data
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[in] scene
+    *    Scene to which the animations are added
+    *  @param[in] sceneNodes
+    *    Scene nodes by GLTF node index (null for nodes outside of the scene)
+    *
+    *  @remarks
+    *    Only channels that animate nodes of the scene are converted.
+    *    Morph target weights are split into channels of up to three weights.
+    */
+    void generateAnimations(const Asset & asset, rendercore::Scene & scene, const std::vector<rendercore::SceneNode *> & sceneNodes) const;
+
+    /**
+    *  @brief
+    *    Generate skins of a scene from GLTF data
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[in] scene
+    *    Scene to which the skins are added
+    *  @param[in] sceneNodes
+    *    Scene nodes by GLTF node index (null for nodes outside of the scene)
+    *  @param[in] skinnedMeshes
+    *    Mesh components and the index of the skin they use
+    *
+    *  @remarks
+    *    Each skin is created once and shared by all meshes that use it.
+    *    Skins with joints outside of the scene are ignored.
+    */
+    void generateSkins(const Asset & asset, rendercore::Scene & scene, const std::vector<rendercore::SceneNode *> & sceneNodes, const std::vector< std::pair<rendercore::opengl::MeshComponent *, int> > & skinnedMeshes) const;
+
+    /**
+    *  @brief
+    *    Calculate bounding box of a scene
+    *
+    *  @param[in] scene
+    *    Scene
+    *
+    *  @remarks
+    *    The bounding boxes of the meshes (or of all instances of instanced
+    *    meshes) are transformed into scene coordinates. Meshes without
+    *    bounding box are ignored.
+    */
+    void generateBounds(rendercore::Scene & scene) const;
+
+    /**
+    *  @brief
+    *    Optimize geometry of all triangle lists
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[in] pool
+    *    Worker pool
+    *
+    *  @remarks
+    *    Each index accessor is optimized once. Vertices are only
+    *    reordered if none of the vertex accessors is used together
+    *    with other index accessors.
+    */
+    void optimizeGeometry(const Asset & asset, rendercore::WorkerPool & pool);
+
+    /**
+    *  @brief
+    *    Optimize index and vertex data of a triangle list
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[in] primitive
+    *    GLTF primitive (must be an indexed triangle list)
+    *  @param[in] remapVertices
+    *    Reorder vertex data?
+    *  @param[out] before
+    *    Vertex cache statistics before the optimization
+    *  @param[out] after
+    *    Vertex cache statistics after the optimization
+    *
+    *  @return
+    *    Number of triangles (0 if the data could not be optimized)
+    *
+    *  @remarks
+    *    This function is called on worker threads. It must only read
+    *    the loaded buffers and modify the data of the given primitive.
+    */
+    unsigned int optimizePrimitive(const Asset & asset, const Primitive & primitive, bool remapVertices, rendercore::GeometryOptimizer::Statistics & before, rendercore::GeometryOptimizer::Statistics & after) const;
+
+    /**
+    *  @brief
+    *    Find indexed triangle lists
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *
+    *  @return
+    *    First primitive that uses each index accessor
+    *
+    *  @remarks
+    *    Index accessors that are also used for other primitive modes,
+    *    or with different positions, are not included.
+    */
+    std::map<int, const Primitive *> triangleLists(const Asset & asset) const;
+
+    /**
+    *  @brief
+    *    Generate levels of detail for all triangle lists
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[in] pool
+    *    Worker pool
+    *
+    *  @remarks
+    *    Levels of detail are generated once per index accessor. Index
+    *    accessors that are used with different positions are skipped.
+    */
+    void generateLods(const Asset & asset, rendercore::WorkerPool & pool);
+
+    /**
+    *  @brief
+    *    Generate levels of detail for a triangle list
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[in] primitive
+    *    Primitive (must be an indexed triangle list)
+    *  @param[out] lodData
+    *    Indices of all levels and their index ranges
+    *
+    *  @return
+    *    'true' if at least one simplified level has been generated, else 'false'
+    *
+    *  @remarks
+    *    This function is called on worker threads. It must only read
+    *    the loaded buffers.
+    */
+    bool generatePrimitiveLods(const Asset & asset, const Primitive & primitive, LodData & lodData) const;
+
+    /**
+    *  @brief
+    *    Split large triangle lists into meshlets
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[in] pool
+    *    Worker pool
+    */
+    void buildMeshlets(const Asset & asset, rendercore::WorkerPool & pool);
+
+    /**
+    *  @brief
+    *    Split triangle list into meshlets
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[in] primitive
+    *    Primitive (must be an indexed triangle list)
+    *  @param[out] meshlets
+    *    Meshlets (empty on error)
+    *
+    *  @remarks
+    *    The triangles are reordered in the loaded buffer, or in the first
+    *    level of detail if levels of detail have been generated. This
+    *    function is called on worker threads. It must only modify the
+    *    indices of the given primitive.
+    */
+    void buildPrimitiveMeshlets(const Asset & asset, const Primitive & primitive, std::vector<rendercore::MeshletBuilder::Meshlet> & meshlets);
+
+    /**
+    *  @brief
+    *    Create buffers for all buffer views and index accessors used by meshes
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *
+    *  @remarks
+    *    Vertex buffers are created once per buffer view and shared by all
+    *    meshes that reference it. Index buffers are created once per
+    *    accessor and only contain the indices of that accessor, narrowed
+    *    to the smallest index type that fits. If vertex quantization is
+    *    enabled, quantized attributes get a buffer of their own instead.
+    */
+    void createBuffers(const Asset & asset);
+
+    /**
+    *  @brief
+    *    Merge strips, fans and loops into batches separated by primitive restart
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *
+    *  @remarks
+    *    Indexed primitives of a mesh that share their mode, material and
+    *    vertex attributes, and have no morph targets, are merged into a
+    *    single index buffer, with the maximum index value between them.
+    *    The batch is drawn by the geometry of the first primitive, the
+    *    other primitives are skipped.
+    */
+    void mergeStrips(const Asset & asset);
+
+    /**
+    *  @brief
+    *    Create index buffers with the narrowest possible index type
+    *
+    *  @param[in] indices
+    *    Indices (0xffffffff separates primitives)
+    *  @param[in] type
+    *    Original data type of the indices (e.g., GL_UNSIGNED_INT)
+    *  @param[in] splittable
+    *    Can the indices be split into parts? (only for triangle lists)
+    *  @param[out] ranges
+    *    Created index buffers
+    *  @param[out] originalSize
+    *    Size of the original indices is added to this (in bytes)
+    *  @param[out] narrowedSize
+    *    Size of the narrowed indices is added to this (in bytes)
+    *
+    *  @return
+    *    'true' if the indices have been narrowed, 'false' if they must be used as they are
+    *
+    *  @remarks
+    *    The maximum value of each type is reserved for primitive restart.
+    *    Triangle lists that reference more vertices than 16 bit indices
+    *    can address are split into consecutive parts, each with a base
+    *    vertex at its lowest index, unless this would result in many
+    *    small parts.
+    */
+    bool createIndexBuffers(const std::vector<unsigned int> & indices, unsigned int type, bool splittable, std::vector<IndexRange> & ranges, unsigned int & originalSize, unsigned int & narrowedSize);
+
+    /**
+    *  @brief
+    *    Create quantized buffer for a vertex attribute
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[in] name
+    *    Attribute name (e.g., 'POSITION')
+    *  @param[in] accessorIndex
+    *    Accessor index
+    *  @param[out] originalSize
+    *    Size of the original attribute data (in bytes)
+    *  @param[out] quantizedSize
+    *    Size of the quantized attribute data (in bytes)
+    *
+    *  @return
+    *    'true' if the attribute has been quantized, 'false' if it must be used as it is
+    */
+    bool quantizeAttribute(const Asset & asset, const std::string & name, unsigned int accessorIndex, unsigned int & originalSize, unsigned int & quantizedSize);
+
+    /**
+    *  @brief
+    *    Get texture for a texture info
     *
-    *  @param[in] basePath
-    *    Path to directory
     *  @param[in] asset
     *    GLTF asset
     *  @param[in] textureInfoIndex
     *    Texture info index
+    *
+    *  @return
+    *    Texture (can be null)
+    *
+    *  @remarks
+    *    Textures are shared between all references to the same image.
+    *    The image data is not loaded here, but later by loadImage().
+    *    Textures of image files may be provided by the texture lookup.
+    */
+    rendercore::opengl::Texture * loadTexture(const Asset & asset, int textureInfoIndex);
+
+    /**
+    *  @brief
+    *    Load and decode image
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[in] imageIndex
+    *    Image index
+    *
+    *  @return
+    *    Image (can be null)
+    *
+    *  @remarks
+    *    This function is called on worker threads. It must only read
+    *    the loaded buffers.
+    */
+    std::unique_ptr<rendercore::Image> loadImage(const Asset & asset, int imageIndex) const;
+
+    /**
+    *  @brief
+    *    Get sampler for a texture
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[in] textureInfoIndex
+    *    Texture info index
+    *
+    *  @return
+    *    Sampler (can be null)
+    *
+    *  @remarks
+    *    Samplers are shared between all textures that use the same
+    *    GLTF sampler. Textures without a sampler use a default sampler.
+    */
+    rendercore::opengl::Sampler * loadSampler(const Asset & asset, int textureInfoIndex);
+
+    /**
+    *  @brief
+    *    Set texture and sampler of a material
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[in] material
+    *    Material
+    *  @param[in] name
+    *    Texture name
+    *  @param[in] textureInfoIndex
+    *    Texture info index
+    */
+    void setMaterialTexture(const Asset & asset, rendercore::opengl::Material & material, const std::string & name, int textureInfoIndex);
+
+    /**
+    *  @brief
+    *    Load binary data of a buffer
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[in] bufferIndex
+    *    Buffer index
+    *  @param[in] writable
+    *    Must the data be writable? (see writableBuffers())
+    *
+    *  @remarks
+    *    External files are memory-mapped. A buffer without URI
+    *    references the BIN chunk of a binary GLTF file, base64
+    *    encoded data URIs are decoded into a new buffer. Fallback
+    *    buffers of compressed buffer views are not loaded, but
+    *    allocated. Mapped data that must be writable is copied. This
+    *    function is called on worker threads, each writing its own
+    *    entry of m_data.
+    */
+    void loadData(const Asset & asset, unsigned int bufferIndex, bool writable);
+
+    /**
+    *  @brief
+    *    Find buffers that are modified by the conversion
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *
+    *  @return
+    *    Flag for each GLTF buffer, set if its data must be writable
+    *
+    *  @remarks
+    *    Buffers receive decompressed buffer views, and the geometry of
+    *    mesh primitives is rewritten in place by geometry optimization
+    *    and meshlet building. Their data is copied when loaded, so the
+    *    asset itself (e.g., its BIN chunk or mapped files) is never
+    *    modified and can be converted again.
+    */
+    std::vector<bool> writableBuffers(const Asset & asset) const;
+
+    /**
+    *  @brief
+    *    Decompress buffer views and Draco compressed primitives
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[in] pool
+    *    Worker pool
+    *
+    *  @remarks
+    *    Compressed buffer views are decoded in place into the range
+    *    of their buffer, which is later referenced by the vertex and
+    *    index buffers without a copy. Draco compressed primitives are
+    *    decoded into m_decodedAttributes and m_decodedIndices.
     */
-    rendercore::opengl::Texture * loadTexture(const std::string & basePath, const Asset & asset, int textureInfoIndex);
+    void decompress(const Asset & asset, rendercore::WorkerPool & pool);
 
     /**
     *  @brief
-    *    Load binary data from external file
+    *    Decompress selected buffer views and Draco compressed primitives
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[in] pool
+    *    Worker pool
+    *  @param[in] bufferViews
+    *    Flag for each buffer view, compressed buffer views are only decompressed if it is set
+    *  @param[in] primitives
+    *    Decompress Draco compressed primitives?
+    *
+    *  @remarks
+    *    This allows for decompressing the data of a scene in several
+    *    steps. Each buffer view must only be decompressed once.
+    */
+    void decompress(const Asset & asset, rendercore::WorkerPool & pool, const std::vector<bool> & bufferViews, bool primitives);
+
+    /**
+    *  @brief
+    *    Decompress buffer view (EXT_meshopt_compression)
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[in] bufferView
+    *    Compressed buffer view
+    *
+    *  @return
+    *    'true' on success, 'false' if the compressed data is malformed
+    *
+    *  @remarks
+    *    This function is called on worker threads. It must only write
+    *    the range of the given buffer view.
+    */
+    bool decompressBufferView(const Asset & asset, const BufferView & bufferView);
+
+    /**
+    *  @brief
+    *    Decompress primitive (KHR_draco_mesh_compression)
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[in] primitive
+    *    Draco compressed primitive
+    *  @param[out] attributes
+    *    Decoded vertex attributes (map of accessor index -> values)
+    *  @param[out] indices
+    *    Decoded indices (empty if the primitive is not indexed)
+    *
+    *  @return
+    *    'true' on success, 'false' if the compressed data is malformed or Draco is not available
     *
-    *  @param[in] basePath
-    *    Path to directory
-    *  @param[in] filename
-    *    Filename
+    *  @remarks
+    *    Draco support is optional (OPTION_DRACO). This function is
+    *    called on worker threads. It must only read the loaded buffers.
+    */
+    bool decompressPrimitive(const Asset & asset, const Primitive & primitive, std::map<unsigned int, std::vector<float> > & attributes, std::vector<unsigned int> & indices) const;
+
+    /**
+    *  @brief
+    *    Get range of binary data
+    *
+    *  @param[in] bufferIndex
+    *    Buffer index
+    *  @param[in] offset
+    *    Offset into the buffer (in bytes)
+    *  @param[in] size
+    *    Size of the range (in bytes)
+    *
+    *  @return
+    *    Pointer to data, which keeps the buffer data alive (null if not loaded or out of range)
+    */
+    std::shared_ptr<char> bufferData(unsigned int bufferIndex, unsigned int offset, unsigned int size) const;
+
+    /**
+    *  @brief
+    *    Read accessor as floats
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[in] accessorIndex
+    *    Accessor index
+    *  @param[out] values
+    *    Values (components of each element in a row)
+    *  @param[out] components
+    *    Number of components per element
+    *
+    *  @return
+    *    'true' on success, 'false' if the accessor can not be read as floats
+    *
+    *  @remarks
+    *    Normalized integer components are converted to floats. Accessors
+    *    of Draco compressed primitives are read from the decoded data,
+    *    other accessors without buffer view are read as zeros, and sparse
+    *    elements replace the elements at their indices.
+    */
+    bool readFloats(const Asset & asset, unsigned int accessorIndex, std::vector<float> & values, unsigned int & components) const;
+
+    /**
+    *  @brief
+    *    Get bounding box of an accessor of 3D positions
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[in] accessorIndex
+    *    Index of the accessor (VEC3)
+    *  @param[out] min
+    *    Minimum position
+    *  @param[out] max
+    *    Maximum position
+    *
+    *  @return
+    *    'true' on success, 'false' if the bounds are unknown
+    *
+    *  @remarks
+    *    The min/max values of the accessor are used if available,
+    *    otherwise the positions are read and scanned.
+    */
+    bool readBounds(const Asset & asset, unsigned int accessorIndex, glm::vec3 & min, glm::vec3 & max) const;
+
+    /**
+    *  @brief
+    *    Read indices of an index accessor
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[in] accessorIndex
+    *    Index of the accessor (SCALAR, unsigned integer)
+    *  @param[out] indices
+    *    Indices
+    *
+    *  @return
+    *    'true' on success, 'false' if the accessor can not be read as indices
+    *
+    *  @remarks
+    *    Accessors of Draco compressed primitives are read from the decoded data.
+    */
+    bool readPrimitiveIndices(const Asset & asset, int accessorIndex, std::vector<unsigned int> & indices) const;
+
+    /**
+    *  @brief
+    *    Read sparse elements of an accessor as floats
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[in] accessor
+    *    Sparse accessor
+    *  @param[out] indices
+    *    Index of each sparse element
+    *  @param[out] values
+    *    Values of the sparse elements (components of each element in a row)
+    *
+    *  @return
+    *    'true' on success, 'false' if the sparse elements can not be read as floats
+    */
+    bool readSparse(const Asset & asset, const Accessor & accessor, std::vector<unsigned int> & indices, std::vector<float> & values) const;
+
+    /**
+    *  @brief
+    *    Read displacements of a morph target attribute
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[in] accessorIndex
+    *    Accessor index (VEC3)
+    *  @param[out] vertices
+    *    Indices of the displaced vertices (ascending)
+    *  @param[out] displacements
+    *    Displacement of each of these vertices
+    *
+    *  @return
+    *    'true' on success, else 'false'
+    *
+    *  @remarks
+    *    Sparse accessors without buffer view are read without expanding
+    *    them, otherwise vertices that are not displaced are dropped.
+    */
+    bool readDisplacements(const Asset & asset, unsigned int accessorIndex, std::vector<unsigned int> & vertices, std::vector<glm::vec3> & displacements) const;
+
+    /**
+    *  @brief
+    *    Decode base64 encoded data URI
+    *
+    *  @param[in] uri
+    *    URI (e.g., 'data:application/octet-stream;base64,...')
+    *  @param[out] size
+    *    Size of the decoded data (in bytes)
+    *
+    *  @return
+    *    Decoded data (null if the URI is not a valid base64 data URI)
+    */
+    static std::shared_ptr<char> decodeDataUri(const std::string & uri, unsigned int & size);
+
+protected:
+    /**
+    *  @brief
+    *    Loaded binary data of a buffer
+    */
+    struct BufferData
+    {
+        std::shared_ptr<char> data; ///< Data (can be null)
+        unsigned int          size; ///< Size (in bytes)
+    };
+
+    /**
+    *  @brief
+    *    Vertex attribute that has been converted into a compact format
     */
-    void loadData(const std::string & basePath, const std::string & filename);
+    struct QuantizedAttribute
+    {
+        rendercore::opengl::Buffer * buffer;         ///< Buffer with tightly packed data
+        unsigned int                 type;           ///< Component type (OpenGL enum)
+        unsigned int                 components;     ///< Number of components
+        bool                         normalize;      ///< Are integer components normalized?
+        unsigned int                 stride;         ///< Number of bytes between two vertices
+        glm::mat4                    dequantization; ///< Transformation back into the original range
+    };
 
 protected:
-    std::vector< std::unique_ptr< std::vector<char> > >          m_data;      ///< Loaded data buffers
-    std::vector< std::unique_ptr<rendercore::opengl::Texture> >  m_textures;  ///< List of textures
-    std::vector< std::unique_ptr<rendercore::opengl::Material> > m_materials; ///< List of materials
-    std::vector< std::unique_ptr<rendercore::opengl::Mesh> >     m_meshes;    ///< List of meshes
-    std::vector< std::unique_ptr<rendercore::Scene> >            m_scenes;    ///< List of scenes
+    bool                                                                       m_geometryOptimization; ///< Optimize geometry?
+    bool                                                                       m_vertexQuantization;   ///< Quantize vertex attributes?
+    unsigned int                                                               m_lodLevels;            ///< Number of generated levels of detail
+    unsigned int                                                               m_meshletThreshold;     ///< Minimum number of triangles for meshlets (0 if disabled)
+    rendercore::FileCache                                                      m_cache;                ///< Cache for optimized geometry
+    std::vector<BufferData>                                                    m_data;                 ///< Loaded data buffers
+    std::unordered_map<unsigned int, std::vector<float> >                      m_decodedAttributes;    ///< Decoded vertex attributes of Draco compressed primitives by GLTF accessor index
+    std::unordered_map<int, std::vector<unsigned int> >                        m_decodedIndices;       ///< Decoded indices of Draco compressed primitives by GLTF accessor index
+    std::vector< std::unique_ptr<rendercore::opengl::Buffer> >                 m_buffers;              ///< List of buffers
+    std::unordered_map<unsigned int, rendercore::opengl::Buffer *>             m_vertexBuffers;        ///< Vertex buffers by GLTF buffer view index
+    std::unordered_map<int, std::vector<IndexRange> >                          m_indexBuffers;         ///< Index buffers by GLTF accessor index (several if the primitive has been split)
+    std::unordered_map<const Primitive *, IndexRange>                          m_restartBatches;       ///< Index buffers of merged strips, fans and loops by their first GLTF primitive
+    std::unordered_set<const Primitive *>                                      m_mergedPrimitives;     ///< GLTF primitives that are drawn as part of a batch of another primitive
+    std::unordered_map<unsigned int, QuantizedAttribute>                       m_quantizedAttributes;  ///< Quantized vertex attributes by GLTF accessor index
+    std::unordered_map<int, LodData>                                           m_lods;                 ///< Levels of detail by GLTF index accessor index
+    std::unordered_map<int, std::vector<rendercore::MeshletBuilder::Meshlet> > m_meshlets;             ///< Meshlets by GLTF index accessor index
+    std::vector< std::unique_ptr<rendercore::opengl::Texture> >                m_textures;             ///< List of textures
+    std::vector<std::string>                                                   m_texturePaths;         ///< Path of the image file of each texture ('' for embedded images)
+    std::function<rendercore::opengl::Texture * (const std::string &)>         m_textureLookup;        ///< Function that provides existing textures for image files (can be empty)
+    std::unordered_map<int, rendercore::opengl::Texture *>                     m_sharedTextures;       ///< Textures provided by the texture lookup by GLTF image index
+    std::vector< std::unique_ptr<rendercore::opengl::Sampler> >                m_samplers;             ///< List of samplers
+    std::unordered_map<int, rendercore::opengl::Texture *>                     m_imageTextures;        ///< Textures by GLTF image index
+    std::unordered_map<int, rendercore::opengl::Sampler *>                     m_samplerObjects;       ///< Samplers by GLTF sampler index (-1 for the default sampler)
+    std::vector< std::unique_ptr<rendercore::opengl::Material> >               m_materials;            ///< List of materials
+    std::vector<rendercore::opengl::Material *>                                m_materialObjects;      ///< Materials by GLTF material index
+    std::vector< std::unique_ptr<rendercore::opengl::Mesh> >                   m_meshes;               ///< List of meshes
+    std::vector< std::unique_ptr<rendercore::Scene> >                          m_scenes;               ///< List of scenes
 };
 
 
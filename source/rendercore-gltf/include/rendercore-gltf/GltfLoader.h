@@ -2,6 +2,7 @@
 #pragma once
 
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <map>
@@ -12,21 +13,32 @@
 #include <rendercore-gltf/Mesh.h>
 
 
-namespace cppexpose {
-    class AbstractVar;
-    class Object;
-}
-
-
 namespace rendercore
 {
+
+
+class MappedFile;
+
+
 namespace gltf
 {
 
 
+class JsonReader;
+
+
 /**
 *  @brief
 *    GLTF 2.0 loader
+*
+*  @remarks
+*    The JSON document is parsed in a single pass with a streaming
+*    reader, which fills the asset directly without building a
+*    document tree.
+*
+*    Both text (.gltf) and binary (.glb) files are supported. Files are
+*    memory-mapped, and the BIN chunk of a binary file is referenced in
+*    place by the asset (see Asset::binaryChunk()).
 */
 class RENDERCORE_GLTF_API GltfLoader
 {
@@ -48,7 +60,7 @@ public:
     *    Load GLTF file
     *
     *  @param[in] path
-    *    Path to file
+    *    Path to file (.gltf or .glb)
     *
     *  @return
     *    Loaded asset (can be null)
@@ -56,42 +68,76 @@ public:
     std::unique_ptr<Asset> load(const std::string & path);
 
 protected:
+    /**
+    *  @brief
+    *    Locate chunks of a binary GLTF file
+    *
+    *  @param[in] file
+    *    Mapped binary GLTF file (must NOT be null)
+    *  @param[out] json
+    *    Pointer to JSON chunk
+    *  @param[out] jsonSize
+    *    Size of JSON chunk (in bytes)
+    *  @param[out] binary
+    *    BIN chunk (null if the file has none), keeps the file mapped
+    *  @param[out] binarySize
+    *    Size of BIN chunk (in bytes)
+    *
+    *  @return
+    *    'true' if the file is a valid binary GLTF file, else 'false'
+    */
+    bool readBinaryChunks(const std::shared_ptr<MappedFile> & file, const char *& json, size_t & jsonSize, std::shared_ptr<char> & binary, unsigned int & binarySize);
+
     // GLTF parsing
-    std::unique_ptr<Asset> parseFile(const cppexpose::Object & root, const std::string & basePath);
-    bool parseAsset(Asset & asset, const cppexpose::AbstractVar * value);
-    bool parseDefaultScene(Asset & asset, const cppexpose::AbstractVar * value);
-    bool parseScenes(Asset & asset, const cppexpose::AbstractVar * value);
-    bool parseScene(Asset & asset, const cppexpose::AbstractVar * value);
-    bool parseNodes(Asset & asset, const cppexpose::AbstractVar * value);
-    bool parseNode(Asset & asset, const cppexpose::AbstractVar * value);
-    bool parseMeshes(Asset & asset, const cppexpose::AbstractVar * value);
-    bool parseMesh(Asset & asset, const cppexpose::AbstractVar * value);
-    bool parsePrimitives(Mesh & mesh, const cppexpose::AbstractVar * value);
-    bool parsePrimitive(Mesh & mesh, const cppexpose::AbstractVar * value);
-    bool parseAnimations(Asset & asset, const cppexpose::AbstractVar * value);
-    bool parseAccessors(Asset & asset, const cppexpose::AbstractVar * value);
-    bool parseAccessor(Asset & asset, const cppexpose::AbstractVar * value);
-    bool parseMaterials(Asset & asset, const cppexpose::AbstractVar * value);
-    bool parseMaterial(Asset & asset, const cppexpose::AbstractVar * value);
-    bool parseBuffers(Asset & asset, const cppexpose::AbstractVar * value);
-    bool parseBuffer(Asset & asset, const cppexpose::AbstractVar * value);
-    bool parseBufferViews(Asset & asset, const cppexpose::AbstractVar * value);
-    bool parseBufferView(Asset & asset, const cppexpose::AbstractVar * value);
-    bool parseTextures(Asset & asset, const cppexpose::AbstractVar * value);
-    bool parseTexture(Asset & asset, const cppexpose::AbstractVar * value);
-    bool parseSamplers(Asset & asset, const cppexpose::AbstractVar * value);
-    bool parseSampler(Asset & asset, const cppexpose::AbstractVar * value);
-    bool parseImages(Asset & asset, const cppexpose::AbstractVar * value);
-    bool parseImage(Asset & asset, const cppexpose::AbstractVar * value);
+    std::unique_ptr<Asset> parseFile(JsonReader & reader, const std::string & basePath);
+    bool parseAsset(Asset & asset, JsonReader & reader);
+    bool parseDefaultScene(Asset & asset, JsonReader & reader);
+    bool parseScenes(Asset & asset, JsonReader & reader);
+    bool parseScene(Asset & asset, JsonReader & reader);
+    bool parseNodes(Asset & asset, JsonReader & reader);
+    bool parseNode(Asset & asset, JsonReader & reader);
+    bool parseNodeExtensions(Node & node, JsonReader & reader);
+    bool parseMeshes(Asset & asset, JsonReader & reader);
+    bool parseMesh(Asset & asset, JsonReader & reader);
+    bool parsePrimitives(Mesh & mesh, JsonReader & reader);
+    bool parsePrimitive(Mesh & mesh, JsonReader & reader);
+    bool parsePrimitiveExtensions(Primitive & primitive, JsonReader & reader);
+    bool parseAnimations(Asset & asset, JsonReader & reader);
+    bool parseAnimation(Asset & asset, JsonReader & reader);
+    bool parseAnimationChannels(Animation & animation, JsonReader & reader);
+    bool parseAnimationChannel(Animation & animation, JsonReader & reader);
+    bool parseAnimationSamplers(Animation & animation, JsonReader & reader);
+    bool parseAnimationSampler(Animation & animation, JsonReader & reader);
+    bool parseSkins(Asset & asset, JsonReader & reader);
+    bool parseSkin(Asset & asset, JsonReader & reader);
+    bool parseAccessors(Asset & asset, JsonReader & reader);
+    bool parseAccessor(Asset & asset, JsonReader & reader);
+    bool parseSparse(Accessor & accessor, JsonReader & reader);
+    bool parseMaterials(Asset & asset, JsonReader & reader);
+    bool parseMaterial(Asset & asset, JsonReader & reader);
+    int  parseTextureInfo(Asset & asset, JsonReader & reader);
+    bool parseBuffers(Asset & asset, JsonReader & reader);
+    bool parseBuffer(Asset & asset, JsonReader & reader);
+    bool parseBufferExtensions(Buffer & buffer, JsonReader & reader);
+    bool parseBufferViews(Asset & asset, JsonReader & reader);
+    bool parseBufferView(Asset & asset, JsonReader & reader);
+    bool parseBufferViewExtensions(BufferView & bufferView, JsonReader & reader);
+    bool parseTextures(Asset & asset, JsonReader & reader);
+    bool parseTexture(Asset & asset, JsonReader & reader);
+    bool parseSamplers(Asset & asset, JsonReader & reader);
+    bool parseSampler(Asset & asset, JsonReader & reader);
+    bool parseImages(Asset & asset, JsonReader & reader);
+    bool parseImage(Asset & asset, JsonReader & reader);
 
     // General parsing functions
-    std::map<std::string, unsigned int> parseIntMap(const cppexpose::AbstractVar * value);
-    std::vector<unsigned int> parseIntArray(const cppexpose::AbstractVar * value);
-    std::vector<float> parseFloatArray(const cppexpose::AbstractVar * value);
-    glm::vec2 parseVec2(const cppexpose::AbstractVar * value);
-    glm::vec3 parseVec3(const cppexpose::AbstractVar * value);
-    glm::vec4 parseVec4(const cppexpose::AbstractVar * value);
-    glm::mat4 parseMat4(const cppexpose::AbstractVar * value);
+    std::string parseString(JsonReader & reader);
+    std::map<std::string, unsigned int> parseIntMap(JsonReader & reader);
+    std::vector<unsigned int> parseIntArray(JsonReader & reader);
+    std::vector<float> parseFloatArray(JsonReader & reader);
+    glm::vec2 parseVec2(JsonReader & reader);
+    glm::vec3 parseVec3(JsonReader & reader);
+    glm::vec4 parseVec4(JsonReader & reader);
+    glm::mat4 parseMat4(JsonReader & reader);
 };
 
 
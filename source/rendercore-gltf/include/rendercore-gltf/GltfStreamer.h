@@ -0,0 +1,420 @@
+
+#pragma once
+
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <rendercore/Image.h>
+#include <rendercore/scene/Scene.h>
+
+#include <rendercore-opengl/Buffer.h>
+#include <rendercore-opengl/Mesh.h>
+#include <rendercore-opengl/Material.h>
+#include <rendercore-opengl/Texture.h>
+#include <rendercore-opengl/Sampler.h>
+
+#include <rendercore-gltf/GltfConverter.h>
+
+
+namespace rendercore
+{
+
+
+class Camera;
+
+
+namespace opengl
+{
+    class MeshComponent;
+}
+
+
+namespace gltf
+{
+
+
+/**
+*  @brief
+*    Progressive loader that streams a GLTF asset into rendercore objects
+*
+*  @remarks
+*    The asset is loaded and converted on a worker thread in three stages:
+*    First, the scene hierarchy is created, with a box showing the bounds
+*    of each mesh (taken from the min/max values of the position accessors).
+*    Then, the geometry is decompressed and the meshes are generated, and
+*    finally the images are decoded.
+*    Textures are uploaded smallest mipmap level first by the texture
+*    streamer, so they are refined while they are uploaded.
+*
+*    Meshes and images are processed in the order of the screen size of
+*    the nodes that use them, which is determined from the camera in each
+*    call to update(). The worker can be limited to a number of bytes read
+*    and decoded per second, and the geometry handed over per update can be
+*    limited to a number of bytes, so that GPU uploads are spread over
+*    several frames.
+*
+*    Objects that are ready are handed over on the rendering thread in
+*    update(), and can then be taken from the lists returned by buffers(),
+*    textures(), samplers(), materials(), meshes(), and scenes(). Texture
+*    images are only assigned to the materials once they have been decoded.
+*/
+class RENDERCORE_GLTF_API GltfStreamer : protected GltfConverter
+{
+public:
+    /**
+    *  @brief
+    *    Constructor
+    */
+    GltfStreamer();
+
+    /**
+    *  @brief
+    *    Destructor
+    *
+    *  @remarks
+    *    Stops loading and waits for the worker thread to finish.
+    */
+    ~GltfStreamer();
+
+    // Conversion options (must not be changed while loading)
+    using GltfConverter::geometryOptimization;
+    using GltfConverter::setGeometryOptimization;
+    using GltfConverter::lodLevels;
+    using GltfConverter::setLodLevels;
+    using GltfConverter::meshletThreshold;
+    using GltfConverter::setMeshletThreshold;
+    using GltfConverter::vertexQuantization;
+    using GltfConverter::setVertexQuantization;
+    using GltfConverter::cacheDirectory;
+    using GltfConverter::setCacheDirectory;
+
+    /**
+    *  @brief
+    *    Get bandwidth budget of the worker
+    *
+    *  @return
+    *    Maximum number of bytes read and decoded per second (0 for unlimited)
+    */
+    unsigned int readBudget() const;
+
+    /**
+    *  @brief
+    *    Set bandwidth budget of the worker
+    *
+    *  @param[in] budget
+    *    Maximum number of bytes read and decoded per second (0 for unlimited)
+    *
+    *  @remarks
+    *    The budget applies to the data of the meshes (which is read ahead
+    *    before they are handed over) and to decoded images. The scene
+    *    hierarchy is always loaded without delay.
+    */
+    void setReadBudget(unsigned int budget);
+
+    /**
+    *  @brief
+    *    Get upload budget
+    *
+    *  @return
+    *    Maximum number of bytes of new buffers handed over per call to update()
+    */
+    unsigned int uploadBudget() const;
+
+    /**
+    *  @brief
+    *    Set upload budget
+    *
+    *  @param[in] budget
+    *    Maximum number of bytes of new buffers handed over per call to update()
+    *
+    *  @remarks
+    *    At least one mesh is handed over per call, even if it exceeds the budget.
+    */
+    void setUploadBudget(unsigned int budget);
+
+    /**
+    *  @brief
+    *    Start loading a GLTF asset
+    *
+    *  @param[in] filename
+    *    Filename of the GLTF asset
+    *
+    *  @remarks
+    *    Returns immediately. Can only be called once per streamer.
+    */
+    void load(const std::string & filename);
+
+    /**
+    *  @brief
+    *    Check if the asset is still being loaded
+    *
+    *  @return
+    *    'true' if objects are still pending, else 'false'
+    */
+    bool busy() const;
+
+    /**
+    *  @brief
+    *    Update priorities and hand over objects that are ready
+    *
+    *  @param[in] transform
+    *    Transformation of the scenes
+    *  @param[in] camera
+    *    Camera used to render the scenes
+    *
+    *  @return
+    *    'true' if objects have been handed over, else 'false'
+    *
+    *  @remarks
+    *    This has to be called regularly on the rendering thread (e.g.,
+    *    once per frame), after the camera has been updated.
+    */
+    bool update(const glm::mat4 & transform, const rendercore::Camera & camera);
+
+    /**
+    *  @brief
+    *    Get buffers that have been handed over
+    *
+    *  @return
+    *    List of buffers (shared by the meshes)
+    */
+    std::vector< std::unique_ptr<rendercore::opengl::Buffer> > & buffers();
+
+    /**
+    *  @brief
+    *    Get textures that have been handed over
+    *
+    *  @return
+    *    List of textures
+    */
+    std::vector< std::unique_ptr<rendercore::opengl::Texture> > & textures();
+
+    /**
+    *  @brief
+    *    Get samplers that have been handed over
+    *
+    *  @return
+    *    List of samplers
+    */
+    std::vector< std::unique_ptr<rendercore::opengl::Sampler> > & samplers();
+
+    /**
+    *  @brief
+    *    Get materials that have been handed over
+    *
+    *  @return
+    *    List of materials
+    */
+    std::vector< std::unique_ptr<rendercore::opengl::Material> > & materials();
+
+    /**
+    *  @brief
+    *    Get meshes that have been handed over
+    *
+    *  @return
+    *    List of meshes
+    */
+    std::vector< std::unique_ptr<rendercore::opengl::Mesh> > & meshes();
+
+    /**
+    *  @brief
+    *    Get scenes that have been handed over
+    *
+    *  @return
+    *    List of scenes
+    */
+    std::vector< std::unique_ptr<rendercore::Scene> > & scenes();
+
+protected:
+    /**
+    *  @brief
+    *    Mesh component that waits for its mesh
+    */
+    struct PendingComponent
+    {
+        rendercore::opengl::MeshComponent * component; ///< Mesh component
+        rendercore::SceneNode             * proxy;     ///< Child node that shows the bounding box (can be null)
+        unsigned int                        mesh;      ///< Index of the GLTF mesh
+    };
+
+    /**
+    *  @brief
+    *    Texture of a material that waits for its image
+    */
+    struct TextureBinding
+    {
+        rendercore::opengl::Material * material; ///< Material
+        std::string                    name;     ///< Name of the texture in the material
+        rendercore::opengl::Texture  * texture;  ///< Texture
+    };
+
+    /**
+    *  @brief
+    *    Objects created by the worker that have not been handed over yet
+    */
+    struct Results
+    {
+        std::vector< std::unique_ptr<rendercore::opengl::Buffer> >                                   buffers;    ///< New buffers
+        std::vector< std::unique_ptr<rendercore::opengl::Texture> >                                  textures;   ///< New textures
+        std::vector< std::unique_ptr<rendercore::opengl::Sampler> >                                  samplers;   ///< New samplers
+        std::vector< std::unique_ptr<rendercore::opengl::Material> >                                 materials;  ///< New materials
+        std::vector< std::unique_ptr<rendercore::opengl::Mesh> >                                     proxies;    ///< New meshes that are used by the proxy nodes
+        std::vector< std::unique_ptr<rendercore::Scene> >                                            scenes;     ///< New scenes
+        std::vector<PendingComponent>                                                                components; ///< Mesh components that wait for their mesh
+        std::vector<glm::vec4>                                                                       bounds;     ///< Bounding sphere of each GLTF mesh (radius 0 if unknown)
+        std::vector<TextureBinding>                                                                  bindings;   ///< Textures that wait for their image
+        std::vector< std::pair<unsigned int, std::unique_ptr<rendercore::opengl::Mesh> > >           meshes;     ///< Generated meshes by GLTF mesh index
+        std::vector< std::pair<rendercore::opengl::Texture *, std::unique_ptr<rendercore::Image> > > images;     ///< Decoded images by texture
+    };
+
+protected:
+    /**
+    *  @brief
+    *    Worker thread
+    */
+    void run();
+
+    /**
+    *  @brief
+    *    Load and convert the asset in stages
+    *
+    *  @remarks
+    *    Returns early if the streamer is stopped.
+    */
+    void stream();
+
+    /**
+    *  @brief
+    *    Create scenes with a proxy for each mesh
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *  @param[out] results
+    *    Results that receive the scenes
+    */
+    void generateHierarchy(const Asset & asset, Results & results);
+
+    /**
+    *  @brief
+    *    Get images used by each mesh
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *
+    *  @return
+    *    Indices of the GLTF images used by each GLTF mesh
+    */
+    std::vector< std::vector<int> > meshImages(const Asset & asset) const;
+
+    /**
+    *  @brief
+    *    Get buffer views that only contain geometry
+    *
+    *  @param[in] asset
+    *    GLTF asset
+    *
+    *  @return
+    *    Flag for each GLTF buffer view, set if it is used by mesh primitives only
+    *
+    *  @remarks
+    *    These buffer views are not needed for the scene hierarchy, so
+    *    they are decompressed after it has been handed over. Buffer views
+    *    of positions without min/max values are excluded, as the bounds
+    *    of the meshes are read from them.
+    */
+    std::vector<bool> geometryBufferViews(const Asset & asset) const;
+
+    /**
+    *  @brief
+    *    Read ahead the data of a mesh
+    *
+    *  @param[in] mesh
+    *    Mesh
+    *
+    *  @return
+    *    Number of bytes read
+    *
+    *  @remarks
+    *    Touches every page of the buffers of the mesh that have not been
+    *    read before, so that mapped files are read on the worker thread
+    *    rather than during the upload.
+    */
+    unsigned int readAhead(const rendercore::opengl::Mesh & mesh);
+
+    /**
+    *  @brief
+    *    Account for data that has been read and wait to honor the budget
+    *
+    *  @param[in] bytes
+    *    Number of bytes read or decoded
+    *
+    *  @return
+    *    'false' if the streamer is stopped, else 'true'
+    */
+    bool throttle(unsigned int bytes);
+
+    /**
+    *  @brief
+    *    Get priority of a mesh
+    *
+    *  @param[in] mesh
+    *    Index of the GLTF mesh
+    *
+    *  @return
+    *    Priority (larger values are processed first)
+    *
+    *  @notes
+    *    - m_mutex must be locked
+    */
+    float priority(unsigned int mesh) const;
+
+protected:
+    // Options (guarded by m_mutex)
+    unsigned int m_readBudget;   ///< Maximum number of bytes read and decoded per second (0 for unlimited)
+    unsigned int m_uploadBudget; ///< Maximum number of bytes of new buffers handed over per update
+
+    // Worker data
+    std::string                                            m_filename;    ///< Filename of the GLTF asset
+    std::unordered_set<const rendercore::opengl::Buffer *> m_readBuffers; ///< Buffers that have been read ahead
+    std::chrono::steady_clock::time_point                  m_readStart;   ///< Time at which reading started
+    unsigned long long                                     m_readBytes;   ///< Number of bytes read since then
+
+    // Shared data
+    Results                 m_queue;          ///< Objects waiting to be handed over
+    std::vector<float>      m_meshPriorities; ///< Priority of each GLTF mesh
+    bool                    m_finished;       ///< Has the worker finished?
+    bool                    m_stop;           ///< Stop the worker thread?
+    std::thread             m_thread;         ///< Worker thread
+    mutable std::mutex      m_mutex;          ///< Mutex for the shared data
+    std::condition_variable m_signal;         ///< Signals stop requests
+
+    // Rendering thread data
+    std::vector<PendingComponent>                                                m_components;  ///< Mesh components that wait for their mesh
+    std::vector<glm::vec4>                                                       m_bounds;      ///< Bounding sphere of each GLTF mesh
+    std::vector<TextureBinding>                                                  m_bindings;    ///< Textures that wait for their image
+    std::unordered_map<unsigned int, std::unique_ptr<rendercore::opengl::Mesh> > m_readyMeshes; ///< Generated meshes that have not been handed over
+    std::unordered_set<const rendercore::opengl::Buffer *>                       m_uploaded;    ///< Buffers of meshes that have been handed over
+
+    // Objects that have been handed over
+    std::vector< std::unique_ptr<rendercore::opengl::Buffer> >   m_availableBuffers;   ///< List of buffers
+    std::vector< std::unique_ptr<rendercore::opengl::Texture> >  m_availableTextures;  ///< List of textures
+    std::vector< std::unique_ptr<rendercore::opengl::Sampler> >  m_availableSamplers;  ///< List of samplers
+    std::vector< std::unique_ptr<rendercore::opengl::Material> > m_availableMaterials; ///< List of materials
+    std::vector< std::unique_ptr<rendercore::opengl::Mesh> >     m_availableMeshes;    ///< List of meshes
+    std::vector< std::unique_ptr<rendercore::Scene> >            m_availableScenes;    ///< List of scenes
+};
+
+
+} // namespace gltf
+} // namespace rendercore
@@ -0,0 +1,280 @@
+
+#pragma once
+
+
+#include <cstddef>
+#include <string>
+
+#include <rendercore-gltf/rendercore-gltf_api.h>
+
+
+namespace rendercore
+{
+namespace gltf
+{
+
+
+/**
+*  @brief
+*    Streaming JSON reader
+*
+*  @remarks
+*    The reader tokenizes a JSON document in place and lets the caller
+*    pull values in document order, without building a document tree.
+*    Objects are read by calling beginObject() and then nextKey() until
+*    it returns 'false', arrays by calling beginArray() and then
+*    nextElement() until it returns 'false'. Values that are not needed
+*    can be skipped with skipValue().
+*
+*    Whitespace, strings, and skipped values are scanned 16 bytes at a
+*    time if SSE2 is available.
+*
+*    After a syntax error, all functions return 'false' and error()
+*    returns 'true'.
+*/
+class RENDERCORE_GLTF_API JsonReader
+{
+public:
+    /**
+    *  @brief
+    *    Type of the next value
+    */
+    enum class Type
+    {
+        Invalid = 0, ///< Syntax error or end of document
+        Object,      ///< Object
+        Array,       ///< Array
+        String,      ///< String
+        Number,      ///< Number
+        Boolean,     ///< 'true' or 'false'
+        Null         ///< 'null'
+    };
+
+public:
+    /**
+    *  @brief
+    *    Constructor
+    *
+    *  @param[in] data
+    *    JSON text (must NOT be null, must stay valid while the reader is used)
+    *  @param[in] size
+    *    Size of the JSON text (in bytes)
+    */
+    JsonReader(const char * data, size_t size);
+
+    /**
+    *  @brief
+    *    Destructor
+    */
+    ~JsonReader();
+
+    /**
+    *  @brief
+    *    Check if a syntax error has occured
+    *
+    *  @return
+    *    'true' on error, else 'false'
+    */
+    bool error() const;
+
+    /**
+    *  @brief
+    *    Get current position
+    *
+    *  @return
+    *    Offset in the JSON text (in bytes)
+    */
+    size_t position() const;
+
+    /**
+    *  @brief
+    *    Get type of the next value
+    *
+    *  @return
+    *    Value type
+    */
+    Type peek();
+
+    /**
+    *  @brief
+    *    Begin reading an object
+    *
+    *  @return
+    *    'true' if the next value is an object, else 'false'
+    */
+    bool beginObject();
+
+    /**
+    *  @brief
+    *    Read next key of the current object
+    *
+    *  @param[out] key
+    *    Key
+    *
+    *  @return
+    *    'true' if a key has been read, 'false' at the end of the object
+    *
+    *  @remarks
+    *    The value of the key must be read or skipped before calling
+    *    this function again.
+    */
+    bool nextKey(std::string & key);
+
+    /**
+    *  @brief
+    *    Begin reading an array
+    *
+    *  @return
+    *    'true' if the next value is an array, else 'false'
+    */
+    bool beginArray();
+
+    /**
+    *  @brief
+    *    Move to the next element of the current array
+    *
+    *  @return
+    *    'true' if there is another element, 'false' at the end of the array
+    *
+    *  @remarks
+    *    The element must be read or skipped before calling this function again.
+    */
+    bool nextElement();
+
+    /**
+    *  @brief
+    *    Read string value
+    *
+    *  @param[out] value
+    *    Value
+    *
+    *  @return
+    *    'true' if a string has been read, else 'false'
+    */
+    bool readString(std::string & value);
+
+    /**
+    *  @brief
+    *    Read number value
+    *
+    *  @param[out] value
+    *    Value
+    *
+    *  @return
+    *    'true' if a number has been read, else 'false'
+    */
+    bool readNumber(double & value);
+
+    /**
+    *  @brief
+    *    Read boolean value
+    *
+    *  @param[out] value
+    *    Value
+    *
+    *  @return
+    *    'true' if a boolean has been read, else 'false'
+    */
+    bool readBool(bool & value);
+
+    /**
+    *  @brief
+    *    Read number value as float
+    *
+    *  @return
+    *    Value (0.0 if the value is not a number)
+    */
+    float readFloat();
+
+    /**
+    *  @brief
+    *    Read number value as integer
+    *
+    *  @return
+    *    Value (0 if the value is not a number)
+    */
+    int readInt();
+
+    /**
+    *  @brief
+    *    Read number value as unsigned integer
+    *
+    *  @return
+    *    Value (0 if the value is not a number or negative)
+    */
+    unsigned int readUInt();
+
+    /**
+    *  @brief
+    *    Skip the next value (including all nested values)
+    *
+    *  @return
+    *    'true' if a value has been skipped, else 'false'
+    */
+    bool skipValue();
+
+protected:
+    /**
+    *  @brief
+    *    Skip whitespace
+    */
+    void skipWhitespace();
+
+    /**
+    *  @brief
+    *    Find end of string
+    *
+    *  @param[in] pos
+    *    Position after the opening quote
+    *
+    *  @return
+    *    Position of the first quote or backslash at or after pos (m_end if none)
+    */
+    const char * scanString(const char * pos) const;
+
+    /**
+    *  @brief
+    *    Skip a literal ('true', 'false', or 'null')
+    *
+    *  @param[in] literal
+    *    Literal (must NOT be null)
+    *  @param[in] length
+    *    Length of the literal
+    *
+    *  @return
+    *    'true' if the literal has been skipped, else 'false'
+    */
+    bool skipLiteral(const char * literal, size_t length);
+
+    /**
+    *  @brief
+    *    Consume separator before the next key or element
+    *
+    *  @param[in] close
+    *    Closing character of the current object or array ('}' or ']')
+    *
+    *  @return
+    *    'true' if another key or element follows, 'false' at the end of the object or array
+    */
+    bool consumeSeparator(char close);
+
+    /**
+    *  @brief
+    *    Flag syntax error
+    *
+    *  @return
+    *    'false'
+    */
+    bool fail();
+
+protected:
+    const char * m_begin; ///< Beginning of the JSON text
+    const char * m_end;   ///< End of the JSON text
+    const char * m_pos;   ///< Current position
+    bool         m_first; ///< Is the next key or element the first in its object or array?
+    bool         m_error; ///< Has a syntax error occured?
+};
+
+
+} // namespace gltf
+} // namespace rendercore
@@ -51,8 +51,27 @@ public:
     */
     void addPrimitive(std::unique_ptr<Primitive> && primitive);
 
+    /**
+    *  @brief
+    *    Get default morph target weights
+    *
+    *  @return
+    *    Weight of each morph target (can be empty)
+    */
+    const std::vector<float> & weights() const;
+
+    /**
+    *  @brief
+    *    Set default morph target weights
+    *
+    *  @param[in] weights
+    *    Weight of each morph target
+    */
+    void setWeights(const std::vector<float> & weights);
+
 protected:
     std::vector< std::unique_ptr<Primitive> > m_primitives;
+    std::vector<float>                        m_weights;
 };
 
 
@@ -2,6 +2,7 @@
 #pragma once
 
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -188,16 +189,73 @@ public:
     */
     void setMesh(int mesh);
 
+    /**
+    *  @brief
+    *    Get attached skin
+    *
+    *  @return
+    *    Index of skin used by the attached mesh (-1 for none)
+    */
+    int skin() const;
+
+    /**
+    *  @brief
+    *    Set attached skin
+    *
+    *  @param[in] skin
+    *    Index of skin used by the attached mesh (-1 for none)
+    */
+    void setSkin(int skin);
+
+    /**
+    *  @brief
+    *    Get morph target weights
+    *
+    *  @return
+    *    Weight of each morph target of the attached mesh (empty to use the defaults of the mesh)
+    */
+    const std::vector<float> & weights() const;
+
+    /**
+    *  @brief
+    *    Set morph target weights
+    *
+    *  @param[in] weights
+    *    Weight of each morph target of the attached mesh
+    */
+    void setWeights(const std::vector<float> & weights);
+
+    /**
+    *  @brief
+    *    Get instance attributes (EXT_mesh_gpu_instancing)
+    *
+    *  @return
+    *    Accessor index of each instance attribute ('TRANSLATION', 'ROTATION', 'SCALE'), empty if the mesh is not instanced
+    */
+    const std::map<std::string, unsigned int> & instanceAttributes() const;
+
+    /**
+    *  @brief
+    *    Set instance attributes (EXT_mesh_gpu_instancing)
+    *
+    *  @param[in] attributes
+    *    Accessor index of each instance attribute
+    */
+    void setInstanceAttributes(const std::map<std::string, unsigned int> & attributes);
+
 protected:
-    std::string               m_name;        ///< Node name
-    int                       m_camera;      ///< Index of attached camera
-    int                       m_mesh;        ///< Index of attached mesh
-    bool                      m_hasMatrix;   ///< 'true' if matrix has been set, else 'false'
-    glm::mat4                 m_matrix;      ///< Transformation matrix
-    glm::vec3                 m_translation; ///< Translation
-    glm::vec4                 m_rotation;    ///< Rotation quaternion
-    glm::vec3                 m_scale;       ///< Scale
-    std::vector<unsigned int> m_children;    ///< Indices of child nodes
+    std::string                         m_name;               ///< Node name
+    int                                 m_camera;             ///< Index of attached camera
+    int                                 m_mesh;               ///< Index of attached mesh
+    int                                 m_skin;               ///< Index of attached skin
+    bool                                m_hasMatrix;          ///< 'true' if matrix has been set, else 'false'
+    glm::mat4                           m_matrix;             ///< Transformation matrix
+    glm::vec3                           m_translation;        ///< Translation
+    glm::vec4                           m_rotation;           ///< Rotation quaternion
+    glm::vec3                           m_scale;              ///< Scale
+    std::vector<unsigned int>           m_children;           ///< Indices of child nodes
+    std::vector<float>                  m_weights;            ///< Morph target weights
+    std::map<std::string, unsigned int> m_instanceAttributes; ///< Accessor index of each instance attribute
 };
 
 
@@ -4,6 +4,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 
 #include <rendercore-gltf/rendercore-gltf_api.h>
 
@@ -105,11 +106,65 @@ public:
     */
     void setAttributes(const std::map<std::string, unsigned int> & attributes);
 
+    /**
+    *  @brief
+    *    Get morph targets
+    *
+    *  @return
+    *    List of morph targets (map of attribute name -> accessor index with the displacements)
+    */
+    const std::vector< std::map<std::string, unsigned int> > & targets() const;
+
+    /**
+    *  @brief
+    *    Add morph target
+    *
+    *  @param[in] target
+    *    Map of attribute name -> accessor index with the displacements
+    */
+    void addTarget(const std::map<std::string, unsigned int> & target);
+
+    /**
+    *  @brief
+    *    Get buffer view with Draco compressed geometry (KHR_draco_mesh_compression)
+    *
+    *  @return
+    *    Buffer view index (-1 if the primitive is not compressed)
+    */
+    int dracoBufferView() const;
+
+    /**
+    *  @brief
+    *    Get attributes of the Draco compressed geometry
+    *
+    *  @return
+    *    Map of attribute name -> Draco attribute id
+    */
+    const std::map<std::string, unsigned int> & dracoAttributes() const;
+
+    /**
+    *  @brief
+    *    Set Draco compressed geometry
+    *
+    *  @param[in] bufferView
+    *    Buffer view index (-1 if the primitive is not compressed)
+    *  @param[in] attributes
+    *    Map of attribute name -> Draco attribute id
+    *
+    *  @remarks
+    *    The accessors of the primitive describe the decoded data,
+    *    they usually have no buffer view.
+    */
+    void setDraco(int bufferView, const std::map<std::string, unsigned int> & attributes);
+
 protected:
-    unsigned int                        m_mode;       ///< Primitive mode
-    unsigned int                        m_material;   ///< Material index
-    int                                 m_indices;    ///< Accessor index (-1 for none)
-    std::map<std::string, unsigned int> m_attributes; ///< Map of attribute name -> accessor index
+    unsigned int                                       m_mode;            ///< Primitive mode
+    unsigned int                                       m_material;        ///< Material index
+    int                                                m_indices;         ///< Accessor index (-1 for none)
+    std::map<std::string, unsigned int>                m_attributes;      ///< Map of attribute name -> accessor index
+    std::vector< std::map<std::string, unsigned int> > m_targets;         ///< Morph targets (map of attribute name -> accessor index)
+    int                                                m_dracoBufferView; ///< Buffer view index of Draco compressed geometry (-1 for none)
+    std::map<std::string, unsigned int>                m_dracoAttributes; ///< Map of attribute name -> Draco attribute id
 };
 
 
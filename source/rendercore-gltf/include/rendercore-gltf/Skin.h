@@ -0,0 +1,117 @@
+
+#pragma once
+
+
+#include <string>
+#include <vector>
+
+#include <rendercore-gltf/rendercore-gltf_api.h>
+
+
+namespace rendercore
+{
+namespace gltf
+{
+
+
+/**
+*  @brief
+*    Skin
+*/
+class RENDERCORE_GLTF_API Skin
+{
+public:
+    /**
+    *  @brief
+    *    Constructor
+    */
+    Skin();
+
+    /**
+    *  @brief
+    *    Destructor
+    */
+    ~Skin();
+
+    /**
+    *  @brief
+    *    Get name
+    *
+    *  @return
+    *    Skin name
+    */
+    const std::string & name() const;
+
+    /**
+    *  @brief
+    *    Set name
+    *
+    *  @param[in] name
+    *    Skin name
+    */
+    void setName(const std::string & name);
+
+    /**
+    *  @brief
+    *    Get inverse bind matrices
+    *
+    *  @return
+    *    Index of the accessor with the inverse bind matrices (-1 for none)
+    */
+    int inverseBindMatrices() const;
+
+    /**
+    *  @brief
+    *    Set inverse bind matrices
+    *
+    *  @param[in] inverseBindMatrices
+    *    Index of the accessor with the inverse bind matrices (-1 for none)
+    */
+    void setInverseBindMatrices(int inverseBindMatrices);
+
+    /**
+    *  @brief
+    *    Get skeleton root
+    *
+    *  @return
+    *    Index of the common root node of the joints (-1 for none)
+    */
+    int skeleton() const;
+
+    /**
+    *  @brief
+    *    Set skeleton root
+    *
+    *  @param[in] skeleton
+    *    Index of the common root node of the joints (-1 for none)
+    */
+    void setSkeleton(int skeleton);
+
+    /**
+    *  @brief
+    *    Get joints
+    *
+    *  @return
+    *    Indices of the joint nodes
+    */
+    const std::vector<unsigned int> & joints() const;
+
+    /**
+    *  @brief
+    *    Set joints
+    *
+    *  @param[in] joints
+    *    Indices of the joint nodes
+    */
+    void setJoints(const std::vector<unsigned int> & joints);
+
+protected:
+    std::string               m_name;                ///< Skin name
+    int                       m_inverseBindMatrices; ///< Index of the accessor with the inverse bind matrices
+    int                       m_skeleton;            ///< Index of the skeleton root node
+    std::vector<unsigned int> m_joints;              ///< Indices of the joint nodes
+};
+
+
+} // namespace gltf
+} // namespace rendercore
@@ -9,23 +9,31 @@ namespace gltf
 
 
 Accessor::Accessor()
-: m_bufferView(0)
+: m_bufferView(-1)
 , m_componentType(0)
+, m_normalized(false)
 , m_offset(0)
 , m_count(0)
+, m_isSparse(false)
 {
+    m_sparse.count                = 0;
+    m_sparse.indicesBufferView    = 0;
+    m_sparse.indicesOffset        = 0;
+    m_sparse.indicesComponentType = 0;
+    m_sparse.valuesBufferView     = 0;
+    m_sparse.valuesOffset         = 0;
 }
 
 Accessor::~Accessor()
 {
 }
 
-unsigned int Accessor::bufferView() const
+int Accessor::bufferView() const
 {
     return m_bufferView;
 }
 
-void Accessor::setBufferView(unsigned int bufferView)
+void Accessor::setBufferView(int bufferView)
 {
     m_bufferView = bufferView;
 }
@@ -50,6 +58,16 @@ void Accessor::setComponentType(unsigned int componentType)
     m_componentType = componentType;
 }
 
+bool Accessor::normalized() const
+{
+    return m_normalized;
+}
+
+void Accessor::setNormalized(bool normalized)
+{
+    m_normalized = normalized;
+}
+
 unsigned int Accessor::offset() const
 {
     return m_offset;
@@ -91,5 +109,21 @@ void Accessor::setMaxValue(const std::vector<float> & maxValue)
 }
 
 
+bool Accessor::isSparse() const
+{
+    return m_isSparse;
+}
+
+const Accessor::Sparse & Accessor::sparse() const
+{
+    return m_sparse;
+}
+
+void Accessor::setSparse(const Sparse & sparse)
+{
+    m_isSparse = true;
+    m_sparse   = sparse;
+}
+
 } // namespace gltf
 } // namespace rendercore
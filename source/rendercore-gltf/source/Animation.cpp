@@ -0,0 +1,51 @@
+
+#include <rendercore-gltf/Animation.h>
+
+
+namespace rendercore
+{
+namespace gltf
+{
+
+
+Animation::Animation()
+{
+}
+
+Animation::~Animation()
+{
+}
+
+const std::string & Animation::name() const
+{
+    return m_name;
+}
+
+void Animation::setName(const std::string & name)
+{
+    m_name = name;
+}
+
+const std::vector<Animation::Channel> & Animation::channels() const
+{
+    return m_channels;
+}
+
+void Animation::addChannel(const Channel & channel)
+{
+    m_channels.push_back(channel);
+}
+
+const std::vector<Animation::Sampler> & Animation::samplers() const
+{
+    return m_samplers;
+}
+
+void Animation::addSampler(const Sampler & sampler)
+{
+    m_samplers.push_back(sampler);
+}
+
+
+} // namespace gltf
+} // namespace rendercore
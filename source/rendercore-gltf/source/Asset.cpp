@@ -12,6 +12,7 @@ Asset::Asset()
 : m_version(0.0f)
 , m_minVersion(0.0f)
 , m_scene(-1)
+, m_binaryChunkSize(0)
 {
 }
 
@@ -59,6 +60,22 @@ void Asset::setDefaultScene(int scene)
     m_scene = scene;
 }
 
+const std::shared_ptr<char> & Asset::binaryChunk() const
+{
+    return m_binaryChunk;
+}
+
+unsigned int Asset::binaryChunkSize() const
+{
+    return m_binaryChunkSize;
+}
+
+void Asset::setBinaryChunk(const std::shared_ptr<char> & data, unsigned int size)
+{
+    m_binaryChunk     = data;
+    m_binaryChunkSize = data ? size : 0;
+}
+
 std::vector<Scene *> Asset::scenes() const
 {
     std::vector<Scene *> lst;
@@ -84,6 +101,11 @@ void Asset::addScene(std::unique_ptr<Scene> && scene)
     m_scenes.push_back(std::move(scene));
 }
 
+size_t Asset::nodeCount() const
+{
+    return m_nodes.size();
+}
+
 std::vector<Node *> Asset::nodes() const
 {
     std::vector<Node *> lst;
@@ -209,6 +231,56 @@ void Asset::addMesh(std::unique_ptr<Mesh> && mesh)
     m_meshes.push_back(std::move(mesh));
 }
 
+std::vector<Animation *> Asset::animations() const
+{
+    std::vector<Animation *> lst;
+
+    for (auto & animation : m_animations) {
+        lst.push_back(animation.get());
+    }
+
+    return lst;
+}
+
+Animation * Asset::animation(size_t index) const
+{
+    if (index < m_animations.size()) {
+        return m_animations[index].get();
+    } else {
+        return nullptr;
+    }
+}
+
+void Asset::addAnimation(std::unique_ptr<Animation> && animation)
+{
+    m_animations.push_back(std::move(animation));
+}
+
+std::vector<Skin *> Asset::skins() const
+{
+    std::vector<Skin *> lst;
+
+    for (auto & skin : m_skins) {
+        lst.push_back(skin.get());
+    }
+
+    return lst;
+}
+
+Skin * Asset::skin(size_t index) const
+{
+    if (index < m_skins.size()) {
+        return m_skins[index].get();
+    } else {
+        return nullptr;
+    }
+}
+
+void Asset::addSkin(std::unique_ptr<Skin> && skin)
+{
+    m_skins.push_back(std::move(skin));
+}
+
 std::vector<Material *> Asset::materials() const
 {
     std::vector<Material *> lst;
@@ -0,0 +1,391 @@
+
+#include <rendercore-gltf/AssetRegistry.h>
+
+#include <cppassist/logging/logging.h>
+#include <cppassist/memory/make_unique.h>
+
+#include <cppfs/FilePath.h>
+
+#include <rendercore/FileCache.h>
+#include <rendercore/MappedFile.h>
+
+#include <rendercore-opengl/BakedAsset.h>
+
+#include <rendercore-gltf/Asset.h>
+#include <rendercore-gltf/GltfConverter.h>
+#include <rendercore-gltf/GltfLoader.h>
+
+
+using namespace rendercore::opengl;
+
+
+namespace rendercore
+{
+namespace gltf
+{
+
+
+AssetRegistry::AssetRegistry(GpuContainer * container)
+: GpuContainer(container)
+, m_releaseDelay(60)
+, m_state(std::make_shared<State>())
+{
+    m_state->closed = false;
+}
+
+AssetRegistry::~AssetRegistry()
+{
+    // Take unused assets out of the registry, assets that are still in use are left to their handles
+    std::vector< std::unique_ptr<LoadedAsset> > assets;
+    unsigned int used = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        m_state->closed = true;
+
+        for (auto it = m_state->entries.begin(); it != m_state->entries.end(); ) {
+            Entry & entry = it->second;
+
+            if (entry.handle.expired()) {
+                assets.push_back(std::move(entry.asset));
+                it = m_state->entries.erase(it);
+            } else {
+                detach(*entry.asset);
+                used++;
+                ++it;
+            }
+        }
+    }
+
+    if (used > 0) {
+        cppassist::warning("rendercore-gltf") << "AssetRegistry: " << used << " assets are still in use, they are destroyed with their last handle";
+    }
+
+    // Destroy unused assets (outside of the lock, as this releases their dependencies)
+    assets.clear();
+}
+
+unsigned int AssetRegistry::releaseDelay() const
+{
+    return m_releaseDelay;
+}
+
+void AssetRegistry::setReleaseDelay(unsigned int delay)
+{
+    m_releaseDelay = delay;
+}
+
+size_t AssetRegistry::size() const
+{
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    return m_state->entries.size();
+}
+
+std::shared_ptr<AssetRegistry::LoadedAsset> AssetRegistry::load(const std::string & filename)
+{
+    // Identify file
+    std::string path = canonicalPath(filename);
+
+    unsigned long long hash = 0;
+    if (!fileHash(path, hash)) {
+        return nullptr;
+    }
+
+    // Parse GLTF asset, as its external files contribute to the hash
+    const bool baked = cppfs::FilePath(path).extension() == ".rcasset";
+
+    std::unique_ptr<Asset> gltfAsset;
+    if (!baked) {
+        GltfLoader loader;
+        gltfAsset = loader.load(path);
+        if (!gltfAsset) {
+            cppassist::warning("rendercore-gltf") << "AssetRegistry: Could not load '" << path << "'";
+            return nullptr;
+        }
+
+        dependencyHash(*gltfAsset.get(), hash);
+    }
+
+    // Return registered asset
+    auto handle = acquire(path, hash);
+    if (handle) {
+        return handle;
+    }
+
+    // Create asset
+    auto asset = cppassist::make_unique<LoadedAsset>();
+    asset->path = path;
+    asset->hash = hash;
+
+    if (baked) {
+        // Load baked asset
+        BakedAsset baked;
+        if (!baked.load(path)) {
+            return nullptr;
+        }
+
+        asset->buffers   = std::move(baked.buffers());
+        asset->textures  = std::move(baked.textures());
+        asset->samplers  = std::move(baked.samplers());
+        asset->materials = std::move(baked.materials());
+        asset->meshes    = std::move(baked.meshes());
+        asset->scenes    = std::move(baked.scenes());
+    } else {
+        // Use registered textures for image files that have already been loaded
+        auto & dependencies = asset->dependencies;
+
+        GltfConverter converter;
+        converter.setTextureLookup([this, &dependencies] (const std::string & imagePath) -> rendercore::opengl::Texture *
+        {
+            std::string texturePath = canonicalPath(imagePath);
+
+            unsigned long long textureHash = 0;
+            if (!fileHash(texturePath, textureHash)) return nullptr;
+
+            auto texture = acquire(texturePath, textureHash);
+            if (!texture || texture->textures.empty()) return nullptr;
+
+            dependencies.push_back(texture);
+            return texture->textures.front().get();
+        });
+
+        converter.convert(*gltfAsset.get());
+
+        // Register textures of image files, so that other assets can use them
+        const auto & texturePaths = converter.texturePaths();
+        auto & textures = converter.textures();
+
+        for (size_t i = 0; i < textures.size(); i++) {
+            std::string texturePath = texturePaths[i].empty() ? "" : canonicalPath(texturePaths[i]);
+
+            unsigned long long textureHash = 0;
+            if (texturePath.empty() || !fileHash(texturePath, textureHash) || acquire(texturePath, textureHash)) {
+                // Keep embedded textures (and duplicates) in the asset
+                asset->textures.push_back(std::move(textures[i]));
+                continue;
+            }
+
+            textures[i]->setContainer(this);
+
+            auto textureAsset = cppassist::make_unique<LoadedAsset>();
+            textureAsset->path = texturePath;
+            textureAsset->hash = textureHash;
+            textureAsset->textures.push_back(std::move(textures[i]));
+
+            asset->dependencies.push_back(add(std::move(textureAsset)));
+        }
+
+        asset->buffers   = std::move(converter.buffers());
+        asset->samplers  = std::move(converter.samplers());
+        asset->materials = std::move(converter.materials());
+        asset->meshes    = std::move(converter.meshes());
+        asset->scenes    = std::move(converter.scenes());
+    }
+
+    // Take over objects
+    for (auto & buffer : asset->buffers)     buffer->setContainer(this);
+    for (auto & texture : asset->textures)   texture->setContainer(this);
+    for (auto & sampler : asset->samplers)   sampler->setContainer(this);
+    for (auto & material : asset->materials) material->setContainer(this);
+    for (auto & mesh : asset->meshes)        mesh->setContainer(this);
+
+    // Register asset
+    return add(std::move(asset));
+}
+
+std::shared_ptr<AssetRegistry::LoadedAsset> AssetRegistry::loadTexture(const std::string & filename)
+{
+    // Identify file
+    std::string path = canonicalPath(filename);
+
+    unsigned long long hash = 0;
+    if (!fileHash(path, hash)) {
+        return nullptr;
+    }
+
+    // Return registered texture
+    auto handle = acquire(path, hash);
+    if (handle) {
+        return handle;
+    }
+
+    // Create texture
+    auto texture = cppassist::make_unique<rendercore::opengl::Texture>(this);
+    texture->load(path);
+
+    // Register texture
+    auto asset = cppassist::make_unique<LoadedAsset>();
+    asset->path = path;
+    asset->hash = hash;
+    asset->textures.push_back(std::move(texture));
+
+    return add(std::move(asset));
+}
+
+void AssetRegistry::collect()
+{
+    // Take out assets that have not been used for the release delay
+    std::vector< std::unique_ptr<LoadedAsset> > assets;
+
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+
+        for (auto it = m_state->entries.begin(); it != m_state->entries.end(); ) {
+            Entry & entry = it->second;
+
+            if (entry.released && ++entry.age > m_releaseDelay) {
+                assets.push_back(std::move(entry.asset));
+                it = m_state->entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    if (assets.empty()) {
+        return;
+    }
+
+    // Destroy assets (outside of the lock, as this releases their dependencies)
+    assets.clear();
+
+    // Remove destroyed objects from the container
+    updateLists();
+}
+
+std::shared_ptr<AssetRegistry::LoadedAsset> AssetRegistry::acquire(const std::string & path, unsigned long long hash)
+{
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+
+    // Find asset
+    auto it = m_state->entries.find(std::make_pair(path, hash));
+    if (it == m_state->entries.end()) {
+        return nullptr;
+    }
+
+    // Return existing handle
+    Entry & entry = it->second;
+
+    auto handle = entry.handle.lock();
+    if (handle) {
+        return handle;
+    }
+
+    // Revive asset that has been released
+    handle = createHandle(entry.asset.get());
+
+    entry.handle   = handle;
+    entry.released = false;
+    entry.age      = 0;
+
+    return handle;
+}
+
+std::shared_ptr<AssetRegistry::LoadedAsset> AssetRegistry::add(std::unique_ptr<LoadedAsset> && asset)
+{
+    // Create handle
+    auto handle = createHandle(asset.get());
+
+    // Register asset
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+
+    Entry & entry = m_state->entries[std::make_pair(asset->path, asset->hash)];
+    entry.asset    = std::move(asset);
+    entry.handle   = handle;
+    entry.released = false;
+    entry.age      = 0;
+
+    return handle;
+}
+
+std::shared_ptr<AssetRegistry::LoadedAsset> AssetRegistry::createHandle(LoadedAsset * asset)
+{
+    // The handle keeps the registered assets alive, even if the registry is destroyed before it
+    std::shared_ptr<State> state = m_state;
+
+    return std::shared_ptr<LoadedAsset>(asset, [state] (LoadedAsset * registered)
+    {
+        release(*state, registered);
+    });
+}
+
+void AssetRegistry::release(State & state, LoadedAsset * asset)
+{
+    std::unique_ptr<LoadedAsset> destroyed;
+
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        // Find asset
+        auto it = state.entries.find(std::make_pair(asset->path, asset->hash));
+        if (it == state.entries.end()) {
+            return;
+        }
+
+        // Mark as unused, unless it has been acquired again in the meantime
+        Entry & entry = it->second;
+
+        if (entry.handle.expired()) {
+            if (state.closed) {
+                // Take out asset of a destroyed registry
+                destroyed = std::move(entry.asset);
+                state.entries.erase(it);
+            } else {
+                entry.released = true;
+                entry.age      = 0;
+            }
+        }
+    }
+
+    // Destroy asset (outside of the lock, as this releases its dependencies)
+    destroyed.reset();
+}
+
+void AssetRegistry::detach(LoadedAsset & asset)
+{
+    for (auto & buffer : asset.buffers)     buffer->setContainer(nullptr);
+    for (auto & texture : asset.textures)   texture->setContainer(nullptr);
+    for (auto & sampler : asset.samplers)   sampler->setContainer(nullptr);
+    for (auto & material : asset.materials) material->setContainer(nullptr);
+    for (auto & mesh : asset.meshes)        mesh->setContainer(nullptr);
+}
+
+std::string AssetRegistry::canonicalPath(const std::string & filename)
+{
+    return cppfs::FilePath(filename).resolved();
+}
+
+bool AssetRegistry::fileHash(const std::string & path, unsigned long long & hash)
+{
+    // Map file
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+
+    // Hash content
+    hash = FileCache::hash(file.data(), file.size());
+    return true;
+}
+
+void AssetRegistry::dependencyHash(const Asset & gltfAsset, unsigned long long & hash)
+{
+    // Collect external files
+    std::vector<std::string> uris;
+    for (auto * buffer : gltfAsset.buffers()) uris.push_back(buffer->uri());
+    for (auto * image : gltfAsset.images())   uris.push_back(image->uri());
+
+    // Combine their content hashes in order
+    for (const auto & uri : uris) {
+        if (uri.empty() || uri.compare(0, 5, "data:") == 0) continue;
+
+        unsigned long long uriHash = 0;
+        if (fileHash(canonicalPath(gltfAsset.basePath() + uri), uriHash)) {
+            hash = FileCache::hash(&uriHash, sizeof(uriHash), hash);
+        }
+    }
+}
+
+
+} // namespace gltf
+} // namespace rendercore
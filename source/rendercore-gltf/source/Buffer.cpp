@@ -11,6 +11,7 @@ namespace gltf
 Buffer::Buffer()
 : m_size(0)
 , m_uri("")
+, m_fallback(false)
 {
 }
 
@@ -38,6 +39,16 @@ void Buffer::setUri(const std::string & uri)
     m_uri = uri;
 }
 
+bool Buffer::isFallback() const
+{
+    return m_fallback;
+}
+
+void Buffer::setFallback(bool fallback)
+{
+    m_fallback = fallback;
+}
+
 
 } // namespace gltf
 } // namespace rendercore
@@ -14,7 +14,13 @@ BufferView::BufferView()
 , m_offset(0)
 , m_stride(0)
 , m_target(0)
+, m_isCompressed(false)
 {
+    m_compression.buffer = 0;
+    m_compression.offset = 0;
+    m_compression.size   = 0;
+    m_compression.stride = 0;
+    m_compression.count  = 0;
 }
 
 BufferView::~BufferView()
@@ -71,6 +77,22 @@ void BufferView::setTarget(unsigned int target)
     m_target = target;
 }
 
+bool BufferView::isCompressed() const
+{
+    return m_isCompressed;
+}
+
+const BufferView::Compression & BufferView::compression() const
+{
+    return m_compression;
+}
+
+void BufferView::setCompression(const Compression & compression)
+{
+    m_isCompressed = true;
+    m_compression  = compression;
+}
+
 
 } // namespace gltf
 } // namespace rendercore
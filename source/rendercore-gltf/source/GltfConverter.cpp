@@ -1,34 +1,292 @@
 
 #include <rendercore-gltf/GltfConverter.h>
 
-#include <istream>
-
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <map>
+#include <set>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define GLTF_CONVERTER_SSE2
+    #include <emmintrin.h>
+#endif
+
+#include <cppassist/logging/logging.h>
 #include <cppassist/memory/make_unique.h>
 
-#include <cppfs/fs.h>
-#include <cppfs/FileHandle.h>
-
 #include <glbinding/gl/enum.h>
 
+#ifdef RENDERCORE_GLTF_DRACO
+    #include <draco/compression/decode.h>
+#endif
+
+#include <rendercore/Base64.h>
 #include <rendercore/Image.h>
 #include <rendercore/ImageLoader.h>
+#include <rendercore/MappedFile.h>
+#include <rendercore/MeshSimplifier.h>
+#include <rendercore/MeshletBuilder.h>
+#include <rendercore/MeshoptDecoder.h>
+#include <rendercore/VertexQuantizer.h>
+#include <rendercore/WorkerPool.h>
 
 #include <rendercore-opengl/enums.h>
 #include <rendercore-opengl/Mesh.h>
 #include <rendercore-opengl/Material.h>
+#include <rendercore-opengl/MorphTargets.h>
 #include <rendercore-opengl/Texture.h>
+#include <rendercore-opengl/Sampler.h>
+#include <rendercore-opengl/scene/InstancedMeshComponent.h>
 #include <rendercore-opengl/scene/MeshComponent.h>
 
+#include <rendercore-gltf/Accessor.h>
 #include <rendercore-gltf/Asset.h>
 #include <rendercore-gltf/Buffer.h>
 #include <rendercore-gltf/Material.h>
 #include <rendercore-gltf/Mesh.h>
+#include <rendercore-gltf/Primitive.h>
+#include <rendercore-gltf/Sampler.h>
+#include <rendercore-gltf/Texture.h>
+#include <rendercore-gltf/TextureInfo.h>
+
+
+using namespace rendercore::opengl;
 
 
-using namespace cppfs;
+namespace
+{
 
 
-using namespace rendercore::opengl;
+// Get size of a component type (in bytes)
+unsigned int componentSize(unsigned int componentType)
+{
+    switch (componentType) {
+        case (unsigned int)gl::GL_BYTE:           return sizeof(char);
+        case (unsigned int)gl::GL_UNSIGNED_BYTE:  return sizeof(unsigned char);
+        case (unsigned int)gl::GL_SHORT:          return sizeof(short);
+        case (unsigned int)gl::GL_UNSIGNED_SHORT: return sizeof(unsigned short);
+        case (unsigned int)gl::GL_INT:            return sizeof(int);
+        case (unsigned int)gl::GL_UNSIGNED_INT:   return sizeof(unsigned int);
+        case (unsigned int)gl::GL_FLOAT:          return sizeof(float);
+        case (unsigned int)gl::GL_DOUBLE:         return sizeof(double);
+        default:                                  return 0;
+    }
+}
+
+// Get number of components of a data type
+unsigned int componentCount(const std::string & dataType)
+{
+         if (dataType == "SCALAR") return 1;
+    else if (dataType == "VEC2")   return 2;
+    else if (dataType == "VEC3")   return 3;
+    else if (dataType == "VEC4")   return 4;
+    else if (dataType == "MAT2")   return 4;
+    else if (dataType == "MAT3")   return 9;
+    else if (dataType == "MAT4")   return 16;
+    else                           return 1;
+}
+
+// Convert components of an element to floats (returns 'false' if the component type is not supported)
+bool convertComponents(const char * data, unsigned int type, unsigned int components, float * values)
+{
+    const unsigned int size = componentSize(type);
+
+    for (unsigned int c=0; c<components; c++) {
+        const char * component = data + c * size;
+        float      & value     = values[c];
+
+        switch (type) {
+            case (unsigned int)gl::GL_FLOAT:          { std::memcpy(&value, component, sizeof(float)); break; }
+            case (unsigned int)gl::GL_BYTE:           { value = std::max(static_cast<signed char>(*component) / 127.0f, -1.0f); break; }
+            case (unsigned int)gl::GL_UNSIGNED_BYTE:  { value = static_cast<unsigned char>(*component) / 255.0f; break; }
+            case (unsigned int)gl::GL_SHORT:          { short v; std::memcpy(&v, component, sizeof(v)); value = std::max(v / 32767.0f, -1.0f); break; }
+            case (unsigned int)gl::GL_UNSIGNED_SHORT: { unsigned short v; std::memcpy(&v, component, sizeof(v)); value = v / 65535.0f; break; }
+            default:                                  return false;
+        }
+    }
+
+    return true;
+}
+
+// Convert a value of a normalized integer component type to float
+float normalizeComponent(float value, unsigned int type)
+{
+    switch (type) {
+        case (unsigned int)gl::GL_BYTE:           return std::max(value / 127.0f, -1.0f);
+        case (unsigned int)gl::GL_UNSIGNED_BYTE:  return value / 255.0f;
+        case (unsigned int)gl::GL_SHORT:          return std::max(value / 32767.0f, -1.0f);
+        case (unsigned int)gl::GL_UNSIGNED_SHORT: return value / 65535.0f;
+        default:                                  return value;
+    }
+}
+
+// Get bounding box of tightly packed positions (vec3)
+void scanBounds(const float * positions, size_t count, glm::vec3 & min, glm::vec3 & max)
+{
+    min = glm::vec3( std::numeric_limits<float>::max());
+    max = glm::vec3(-std::numeric_limits<float>::max());
+
+    size_t i = 0;
+
+#ifdef GLTF_CONVERTER_SSE2
+    // Load four floats per position, the fourth belongs to the next position and is ignored
+    // (the last position is processed separately, so no data is read past the end)
+    if (count > 1) {
+        __m128 lo = _mm_set1_ps( std::numeric_limits<float>::max());
+        __m128 hi = _mm_set1_ps(-std::numeric_limits<float>::max());
+
+        for (; i + 1 < count; i++) {
+            __m128 position = _mm_loadu_ps(positions + i * 3);
+            lo = _mm_min_ps(lo, position);
+            hi = _mm_max_ps(hi, position);
+        }
+
+        float values[4];
+        _mm_storeu_ps(values, lo); min = glm::vec3(values[0], values[1], values[2]);
+        _mm_storeu_ps(values, hi); max = glm::vec3(values[0], values[1], values[2]);
+    }
+#endif
+
+    for (; i < count; i++) {
+        glm::vec3 position(positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2]);
+        min = glm::min(min, position);
+        max = glm::max(max, position);
+    }
+}
+
+// Transform bounding box (the result encloses the transformed box)
+void transformBounds(const glm::mat4 & transform, const glm::vec3 & min, const glm::vec3 & max, glm::vec3 & transformedMin, glm::vec3 & transformedMax)
+{
+    glm::vec3 center = glm::vec3(transform * glm::vec4((min + max) * 0.5f, 1.0f));
+    glm::vec3 extent = (max - min) * 0.5f;
+
+    // Project the half extents onto each axis
+    glm::vec3 radius(0.0f);
+    for (int i=0; i<3; i++) {
+        radius += glm::abs(glm::vec3(transform[i])) * extent[i];
+    }
+
+    transformedMin = center - radius;
+    transformedMax = center + radius;
+}
+
+// Read indices of the given size (returns 'false' if an index is out of range)
+bool readIndices(const char * data, unsigned int indexSize, unsigned int count, unsigned int vertexCount, std::vector<unsigned int> & indices)
+{
+    indices.resize(count);
+
+    for (unsigned int i=0; i<count; i++) {
+        const char * index = data + i * indexSize;
+
+             if (indexSize == 1) indices[i] = static_cast<unsigned char>(*index);
+        else if (indexSize == 2) { unsigned short value; std::memcpy(&value, index, 2); indices[i] = value; }
+        else                     { unsigned int   value; std::memcpy(&value, index, 4); indices[i] = value; }
+
+        if (indices[i] >= vertexCount) return false;
+    }
+
+    return true;
+}
+
+// Write indices of the given size
+void writeIndices(char * data, unsigned int indexSize, const std::vector<unsigned int> & indices)
+{
+    for (size_t i=0; i<indices.size(); i++) {
+        char * index = data + i * indexSize;
+
+             if (indexSize == 1) *index = static_cast<char>(indices[i]);
+        else if (indexSize == 2) { unsigned short value = static_cast<unsigned short>(indices[i]); std::memcpy(index, &value, 2); }
+        else                     { std::memcpy(index, &indices[i], 4); }
+    }
+}
+
+// Index that separates primitives in merged strips, fans and loops
+const unsigned int restartIndex = 0xffffffff;
+
+// Minimum average number of indices per part of a split triangle list (smaller parts are not worth the additional draw calls)
+const size_t minimumPartSize = 3 * 4096;
+
+// Get narrowest index type for the given maximum index (the maximum value of each type is reserved for primitive restart)
+unsigned int narrowIndexType(unsigned int maxIndex)
+{
+    if (maxIndex < 0xff)   return (unsigned int)gl::GL_UNSIGNED_BYTE;
+    if (maxIndex < 0xffff) return (unsigned int)gl::GL_UNSIGNED_SHORT;
+    return (unsigned int)gl::GL_UNSIGNED_INT;
+}
+
+// Convert indices to a narrower type relative to the base vertex (restart indices become the maximum value of the type)
+template <typename Type>
+std::vector<Type> convertIndices(const unsigned int * indices, size_t count, unsigned int baseVertex)
+{
+    std::vector<Type> converted(count);
+
+    for (size_t i=0; i<count; i++) {
+        converted[i] = (indices[i] == restartIndex) ? std::numeric_limits<Type>::max() : static_cast<Type>(indices[i] - baseVertex);
+    }
+
+    return converted;
+}
+
+// Split triangle list into consecutive parts that each fit into 16 bit indices relative to their lowest index
+// (returns the first index and base vertex of each part, or nothing if a single triangle does not fit)
+std::vector< std::pair<size_t, unsigned int> > splitTriangles(const std::vector<unsigned int> & indices)
+{
+    std::vector< std::pair<size_t, unsigned int> > parts;
+    unsigned int minIndex = 0;
+    unsigned int maxIndex = 0;
+
+    for (size_t i=0; i+2<indices.size(); i+=3) {
+        unsigned int triangleMin = std::min(indices[i], std::min(indices[i + 1], indices[i + 2]));
+        unsigned int triangleMax = std::max(indices[i], std::max(indices[i + 1], indices[i + 2]));
+        if (triangleMax - triangleMin >= 0xffff) return {};
+
+        // Start a new part if the triangle does not fit into the current one
+        if (parts.empty() || std::max(maxIndex, triangleMax) - std::min(minIndex, triangleMin) >= 0xffff) {
+            parts.push_back(std::make_pair(i, triangleMin));
+            minIndex = triangleMin;
+            maxIndex = triangleMax;
+        } else {
+            minIndex = std::min(minIndex, triangleMin);
+            maxIndex = std::max(maxIndex, triangleMax);
+        }
+
+        parts.back().second = minIndex;
+    }
+
+    return parts;
+}
+
+// Cached geometry: header, indices, then vertex remap table (if vertices have been reordered)
+const unsigned int  geometryCacheVersion   = 1;
+const char        * geometryCacheExtension = ".rcgeometry";
+
+struct CachedGeometryHeader
+{
+    char         magic[4];
+    unsigned int version;
+    unsigned int indexCount;
+    unsigned int vertexCount;
+    unsigned int remapped;
+};
+
+// Cached levels of detail: header, bounding sphere, index range and error of each level, then indices
+const unsigned int  lodCacheVersion   = 1;
+const char        * lodCacheExtension = ".rclod";
+
+struct CachedLodHeader
+{
+    char         magic[4];
+    unsigned int version;
+    unsigned int levels;
+    unsigned int indexCount;
+};
+
+
+} // namespace
 
 
 namespace rendercore
@@ -38,6 +296,10 @@ namespace gltf
 
 
 GltfConverter::GltfConverter()
+: m_geometryOptimization(false)
+, m_vertexQuantization(false)
+, m_lodLevels(0)
+, m_meshletThreshold(0)
 {
 }
 
@@ -45,24 +307,150 @@ GltfConverter::~GltfConverter()
 {
 }
 
+bool GltfConverter::geometryOptimization() const
+{
+    return m_geometryOptimization;
+}
+
+void GltfConverter::setGeometryOptimization(bool enabled)
+{
+    m_geometryOptimization = enabled;
+}
+
+unsigned int GltfConverter::lodLevels() const
+{
+    return m_lodLevels;
+}
+
+void GltfConverter::setLodLevels(unsigned int levels)
+{
+    m_lodLevels = levels;
+}
+
+unsigned int GltfConverter::meshletThreshold() const
+{
+    return m_meshletThreshold;
+}
+
+void GltfConverter::setMeshletThreshold(unsigned int triangles)
+{
+    m_meshletThreshold = triangles;
+}
+
+bool GltfConverter::vertexQuantization() const
+{
+    return m_vertexQuantization;
+}
+
+void GltfConverter::setVertexQuantization(bool enabled)
+{
+    m_vertexQuantization = enabled;
+}
+
+const std::string & GltfConverter::cacheDirectory() const
+{
+    return m_cache.directory();
+}
+
+void GltfConverter::setCacheDirectory(const std::string & directory)
+{
+    m_cache.setDirectory(directory);
+}
+
+void GltfConverter::setTextureLookup(std::function<rendercore::opengl::Texture * (const std::string & path)> lookup)
+{
+    m_textureLookup = lookup;
+}
+
 void GltfConverter::convert(const Asset & asset)
 {
-    // Load data buffers
+    WorkerPool pool;
+
+    // Find buffers that are modified by the conversion
     auto buffers = asset.buffers();
-    for (auto * buffer : buffers) {
-        loadData(asset.basePath(), buffer->uri());
+    std::vector<bool> writable = writableBuffers(asset);
+
+    // Load data buffers
+    m_data.clear();
+    m_data.resize(buffers.size());
+    for (size_t i=0; i<buffers.size(); i++) {
+        bool write = writable[i];
+        pool.run([this, &asset, i, write] () {
+            loadData(asset, i, write);
+        });
+    }
+
+    pool.wait();
+
+    // Decompress buffer views and primitives
+    m_decodedAttributes.clear();
+    m_decodedIndices.clear();
+    decompress(asset, pool);
+
+    // Optimize geometry in place
+    if (m_geometryOptimization) {
+        optimizeGeometry(asset, pool);
+    }
+
+    // Generate levels of detail
+    m_lods.clear();
+    if (m_lodLevels > 0) {
+        generateLods(asset, pool);
+    }
+
+    // Split large meshes into meshlets
+    m_meshlets.clear();
+    if (m_meshletThreshold > 0) {
+        buildMeshlets(asset, pool);
     }
 
-    // Generate materials
+    // Create buffers that are shared by all meshes
+    m_vertexBuffers.clear();
+    m_indexBuffers.clear();
+    m_quantizedAttributes.clear();
+    createBuffers(asset);
+
+    // Generate materials (this creates the textures, but does not load their images)
     auto materials = asset.materials();
     for (auto * material : materials) {
         generateMaterial(asset, *material);
     }
 
+    // Decode images
+    std::vector<int>                                  imageIndices;
+    std::vector<rendercore::opengl::Texture *>        imageTextures;
+    std::vector< std::unique_ptr<rendercore::Image> > images;
+
+    for (auto & it : m_imageTextures) {
+        imageIndices.push_back(it.first);
+        imageTextures.push_back(it.second);
+    }
+
+    images.resize(imageIndices.size());
+    for (size_t i=0; i<imageIndices.size(); i++) {
+        pool.run([this, &asset, &imageIndices, &images, i] () {
+            images[i] = loadImage(asset, imageIndices[i]);
+        });
+    }
+
     // Generate meshes
-    auto meshes = asset.meshes();
-    for (auto * mesh : meshes) {
-        generateMesh(asset, *mesh);
+    auto gltfMeshes = asset.meshes();
+    std::vector< std::unique_ptr<rendercore::opengl::Mesh> > meshes(gltfMeshes.size());
+    for (size_t i=0; i<gltfMeshes.size(); i++) {
+        pool.run([this, &asset, &gltfMeshes, &meshes, i] () {
+            meshes[i] = generateMesh(asset, *gltfMeshes[i]);
+        });
+    }
+
+    pool.wait();
+
+    // Hand over images and meshes
+    for (size_t i=0; i<images.size(); i++) {
+        imageTextures[i]->setImage(std::move(images[i]));
+    }
+
+    for (auto & mesh : meshes) {
+        m_meshes.push_back(std::move(mesh));
     }
 
     // Generate scenes
@@ -72,11 +460,26 @@ void GltfConverter::convert(const Asset & asset)
     }
 }
 
+std::vector< std::unique_ptr<rendercore::opengl::Buffer> > & GltfConverter::buffers()
+{
+    return m_buffers;
+}
+
 std::vector< std::unique_ptr<rendercore::opengl::Texture> > & GltfConverter::textures()
 {
     return m_textures;
 }
 
+const std::vector<std::string> & GltfConverter::texturePaths() const
+{
+    return m_texturePaths;
+}
+
+std::vector< std::unique_ptr<rendercore::opengl::Sampler> > & GltfConverter::samplers()
+{
+    return m_samplers;
+}
+
 std::vector< std::unique_ptr<rendercore::opengl::Material> > & GltfConverter::materials()
 {
     return m_materials;
@@ -107,17 +510,18 @@ void GltfConverter::generateMaterial(const Asset & asset, const Material & gltfM
     material->setValue<bool>       ("doubleSided",     gltfMaterial.doubleSided());
 
     // Set textures
-    material->setTexture("baseColor",         loadTexture(asset.basePath(), asset, gltfMaterial.baseColorTexture()));
-    material->setTexture("metallicRoughness", loadTexture(asset.basePath(), asset, gltfMaterial.metallicRoughnessTexture()));
-    material->setTexture("normal",            loadTexture(asset.basePath(), asset, gltfMaterial.normalTexture()));
-    material->setTexture("occlusion",         loadTexture(asset.basePath(), asset, gltfMaterial.occlusionTexture()));
-    material->setTexture("emissive",          loadTexture(asset.basePath(), asset, gltfMaterial.emissiveTexture()));
+    setMaterialTexture(asset, *material, "baseColor",         gltfMaterial.baseColorTexture());
+    setMaterialTexture(asset, *material, "metallicRoughness", gltfMaterial.metallicRoughnessTexture());
+    setMaterialTexture(asset, *material, "normal",            gltfMaterial.normalTexture());
+    setMaterialTexture(asset, *material, "occlusion",         gltfMaterial.occlusionTexture());
+    setMaterialTexture(asset, *material, "emissive",          gltfMaterial.emissiveTexture());
 
     // Save material
+    m_materialObjects.push_back(material.get());
     m_materials.push_back(std::move(material));
 }
 
-void GltfConverter::generateMesh(const Asset & gltfAsset, const Mesh & gltfMesh)
+std::unique_ptr<rendercore::opengl::Mesh> GltfConverter::generateMesh(const Asset & gltfAsset, const Mesh & gltfMesh) const
 {
     // Create mesh
     auto mesh = cppassist::make_unique<rendercore::opengl::Mesh>();
@@ -128,10 +532,15 @@ void GltfConverter::generateMesh(const Asset & gltfAsset, const Mesh & gltfMesh)
 
     // Process primitives
     for (auto * gltfPrimitive : gltfMesh.primitives()) {
+        // Skip primitives that are drawn as part of a batch
+        if (m_mergedPrimitives.count(gltfPrimitive) > 0) {
+            continue;
+        }
+
         // Create geometry
         auto geometry = cppassist::make_unique<rendercore::opengl::Geometry>();
         geometry->setMode((gl::GLenum)gltfPrimitive->mode());
-        geometry->setMaterial(gltfPrimitive->material() < m_materials.size() ? m_materials[gltfPrimitive->material()].get() : nullptr);
+        geometry->setMaterial(gltfPrimitive->material() < m_materialObjects.size() ? m_materialObjects[gltfPrimitive->material()] : nullptr);
 
         // Process vertex attributes
         const auto & attributes = gltfPrimitive->attributes();
@@ -155,6 +564,8 @@ void GltfConverter::generateMesh(const Asset & gltfAsset, const Mesh & gltfMesh)
             if (name == "COLOR_1")    attributeIndex = (unsigned int)AttributeIndex::Color1;
             if (name == "COLOR_2")    attributeIndex = (unsigned int)AttributeIndex::Color2;
             if (name == "COLOR_3")    attributeIndex = (unsigned int)AttributeIndex::Color3;
+            if (name == "JOINTS_0")   attributeIndex = (unsigned int)AttributeIndex::Joints0;
+            if (name == "WEIGHTS_0")  attributeIndex = (unsigned int)AttributeIndex::Weights0;
             if (attributeIndex == 2342) {
                 continue;
             }
@@ -164,63 +575,77 @@ void GltfConverter::generateMesh(const Asset & gltfAsset, const Mesh & gltfMesh)
             auto * gltfAccessor = gltfAsset.accessor(accessorIndex);
             if (!gltfAccessor) break;
 
-            // Get GLTF buffer view
-            unsigned int bufferViewIndex = gltfAccessor->bufferView();
-            auto * gltfBufferView = gltfAsset.bufferView(bufferViewIndex);
-            if (!gltfBufferView) break;
-
-            // Get GLTF buffer
-            unsigned int bufferIndex = gltfBufferView->buffer();
-            auto * gltfBuffer = gltfAsset.buffer(bufferIndex);
-            if (!gltfBuffer) break;
-
-            // Get or create buffer view
-            opengl::Buffer * buffer = nullptr;
-            if (bufferViews.count(bufferViewIndex) > 0) {
-                buffer = bufferViews.at(bufferViewIndex);
-            } else {
-                // Get data
-                std::vector<char> * data = (bufferIndex < m_data.size()) ? m_data[bufferIndex].get() : nullptr;
-                if (data) {
-                    // Create buffer
-                    buffer = mesh->createBuffer(data->data() + gltfBufferView->offset(), gltfBufferView->size());
-
-                    // Save buffer for later use
-                    bufferViews[bufferViewIndex] = buffer;
-                } else break;
-            }
+            // Get quantized attribute (if any)
+            auto quantizedIt = m_quantizedAttributes.find(accessorIndex);
+            bool isQuantized = (quantizedIt != m_quantizedAttributes.end());
 
             // Get or create vertex attribute
             opengl::VertexAttribute * vertexAttribute = nullptr;
             if (vertexAttributes.count(accessorIndex) > 0) {
                 vertexAttribute = vertexAttributes.at(accessorIndex);
+            } else if (isQuantized) {
+                // Reference quantized buffer from the mesh
+                const QuantizedAttribute & quantized = quantizedIt->second;
+                mesh->addBuffer(quantized.buffer);
+
+                // Create vertex attribute
+                vertexAttribute = mesh->addVertexAttribute(
+                    quantized.buffer,
+                    0,
+                    0,
+                    quantized.stride,
+                    (gl::GLenum)quantized.type,
+                    quantized.components,
+                    quantized.normalize
+                );
+
+                // Save vertex attribute for later use
+                vertexAttributes[accessorIndex] = vertexAttribute;
+            } else if (gltfAccessor->isSparse() || gltfAccessor->bufferView() < 0 || m_decodedAttributes.count(accessorIndex) > 0) {
+                // Expand sparse or decoded data into a buffer of the mesh
+                std::vector<float> values;
+                unsigned int       numComponents = 0;
+                if (!readFloats(gltfAsset, accessorIndex, values, numComponents)) break;
+
+                opengl::Buffer * buffer = mesh->createBuffer(values);
+
+                // Create vertex attribute
+                vertexAttribute = mesh->addVertexAttribute(
+                    buffer,
+                    0,
+                    0,
+                    numComponents * sizeof(float),
+                    gl::GL_FLOAT,
+                    numComponents,
+                    false
+                );
+
+                // Save vertex attribute for later use
+                vertexAttributes[accessorIndex] = vertexAttribute;
             } else {
+                // Get GLTF buffer view
+                unsigned int bufferViewIndex = gltfAccessor->bufferView();
+                auto * gltfBufferView = gltfAsset.bufferView(bufferViewIndex);
+                if (!gltfBufferView) break;
+
+                // Get shared buffer of the buffer view
+                auto bufferIt = m_vertexBuffers.find(bufferViewIndex);
+                if (bufferIt == m_vertexBuffers.end()) break;
+                opengl::Buffer * buffer = bufferIt->second;
+
+                // Reference buffer from the mesh (once per mesh)
+                if (bufferViews.count(bufferViewIndex) == 0) {
+                    mesh->addBuffer(buffer);
+                    bufferViews[bufferViewIndex] = buffer;
+                }
+
                 // Get data type
-                size_t numComponents = 1;
-                auto & dataType = gltfAccessor->dataType();
-                     if (dataType == "SCALAR") numComponents = 1;
-                else if (dataType == "VEC2")   numComponents = 2;
-                else if (dataType == "VEC3")   numComponents = 3;
-                else if (dataType == "VEC4")   numComponents = 4;
-                else if (dataType == "MAT2")   numComponents = 4;
-                else if (dataType == "MAT3")   numComponents = 9;
-                else if (dataType == "MAT4")   numComponents = 16;
-
-                // Get component type
-                size_t componentSize = 0;
-                     if (gltfAccessor->componentType() == (unsigned int)gl::GL_INT)            componentSize = sizeof(int);
-                else if (gltfAccessor->componentType() == (unsigned int)gl::GL_UNSIGNED_INT)   componentSize = sizeof(unsigned int);
-                else if (gltfAccessor->componentType() == (unsigned int)gl::GL_SHORT)          componentSize = sizeof(short);
-                else if (gltfAccessor->componentType() == (unsigned int)gl::GL_UNSIGNED_SHORT) componentSize = sizeof(unsigned short);
-                else if (gltfAccessor->componentType() == (unsigned int)gl::GL_BYTE)           componentSize = sizeof(char);
-                else if (gltfAccessor->componentType() == (unsigned int)gl::GL_UNSIGNED_BYTE)  componentSize = sizeof(unsigned char);
-                else if (gltfAccessor->componentType() == (unsigned int)gl::GL_FLOAT)          componentSize = sizeof(float);
-                else if (gltfAccessor->componentType() == (unsigned int)gl::GL_DOUBLE)         componentSize = sizeof(double);
+                unsigned int numComponents = componentCount(gltfAccessor->dataType());
 
                 // Calculate stride
                 size_t stride = gltfBufferView->stride();
                 if (stride == 0) {
-                    stride = componentSize * numComponents;
+                    stride = componentSize(gltfAccessor->componentType()) * numComponents;
                 }
 
                 // Create vertex attribute
@@ -231,42 +656,126 @@ void GltfConverter::generateMesh(const Asset & gltfAsset, const Mesh & gltfMesh)
                     stride,
                     (gl::GLenum)gltfAccessor->componentType(),
                     numComponents,
-                    false
+                    gltfAccessor->normalized()
                 );
 
                 // Save vertex attribute for later use
                 vertexAttributes[accessorIndex] = vertexAttribute;
             }
 
+            // Transform quantized positions back into their bounding box
+            if (isQuantized && attributeIndex == (unsigned int)AttributeIndex::Position) {
+                geometry->setPositionDequantization(quantizedIt->second.dequantization);
+            }
+
             // Bind vertex attribute
             geometry->bindAttribute(attributeIndex, vertexAttribute);
         }
 
-        // Set index buffer
-        int indexBuffer = gltfPrimitive->indices();
-        if (indexBuffer >= 0) {
-            // Get accessor
-            auto * gltfAccessor = gltfAsset.accessor(indexBuffer);
-            if (gltfAccessor) {
-                // Get buffer view
-                auto bufferViewIndex = gltfAccessor->bufferView();
-                auto * gltfBufferView = gltfAsset.bufferView(bufferViewIndex);
-                if (gltfBufferView) {
-                    // Get buffer
-                    size_t bufferIndex = gltfBufferView->buffer();
-                    auto * gltfBuffer = gltfAsset.buffer(bufferIndex);
-                    if (gltfBuffer) {
-                        // Get data
-                        std::vector<char> * data = (bufferIndex < m_data.size()) ? m_data[bufferIndex].get() : nullptr;
-                        if (data) {
-                            // Create buffer
-                            opengl::Buffer * buffer = mesh->createBuffer(data->data() + gltfBufferView->offset() + gltfAccessor->offset(), gltfBufferView->size() - gltfAccessor->offset());
-
-                            // Set index buffer
-                            geometry->setIndexBuffer(buffer, (gl::GLenum)gltfAccessor->componentType());
-                            geometry->setCount(gltfAccessor->count());
-                        }
+        // Create morph targets (displacements of positions and normals)
+        auto positionIt = attributes.find("POSITION");
+        auto * gltfPositions = positionIt != attributes.end() ? gltfAsset.accessor(positionIt->second) : nullptr;
+
+        if (!gltfPrimitive->targets().empty() && gltfPositions) {
+            auto morphTargets = cppassist::make_unique<rendercore::opengl::MorphTargets>();
+            morphTargets->setVertexCount(gltfPositions->count());
+
+            for (const auto & gltfTarget : gltfPrimitive->targets()) {
+                std::vector<unsigned int> positionVertices;
+                std::vector<unsigned int> normalVertices;
+                std::vector<glm::vec3>    positions;
+                std::vector<glm::vec3>    normals;
+
+                // Missing attributes are not displaced, the target is still added to keep the weights in order
+                auto targetIt = gltfTarget.find("POSITION");
+                if (targetIt != gltfTarget.end()) readDisplacements(gltfAsset, targetIt->second, positionVertices, positions);
+
+                targetIt = gltfTarget.find("NORMAL");
+                if (targetIt != gltfTarget.end()) readDisplacements(gltfAsset, targetIt->second, normalVertices, normals);
+
+                morphTargets->addTarget(positionVertices, positions, normalVertices, normals);
+            }
+
+            geometry->setMorphTargets(mesh->addMorphTargets(std::move(morphTargets)));
+        }
+
+        // Set bounding box
+        glm::vec3 boundsMin, boundsMax;
+        if (positionIt != attributes.end() && readBounds(gltfAsset, positionIt->second, boundsMin, boundsMax)) {
+            // Include the displacements of the morph targets (for weights between 0 and 1)
+            for (const auto & gltfTarget : gltfPrimitive->targets()) {
+                auto targetIt = gltfTarget.find("POSITION");
+
+                glm::vec3 displacementMin, displacementMax;
+                if (targetIt != gltfTarget.end() && readBounds(gltfAsset, targetIt->second, displacementMin, displacementMax)) {
+                    boundsMin += glm::min(displacementMin, glm::vec3(0.0f));
+                    boundsMax += glm::max(displacementMax, glm::vec3(0.0f));
+                }
+            }
+
+            geometry->setBoundingBox(boundsMin, boundsMax);
+        }
+
+        // Set index buffer of a batch of merged strips, fans or loops
+        int indexAccessor = gltfPrimitive->indices();
+        auto batchIt = m_restartBatches.find(gltfPrimitive);
+        if (batchIt != m_restartBatches.end()) {
+            const IndexRange & range = batchIt->second;
+            mesh->addBuffer(range.buffer);
+
+            geometry->setIndexBuffer(range.buffer, (gl::GLenum)range.type);
+            geometry->setCount(range.count);
+            geometry->setPrimitiveRestart(true);
+        } else if (indexAccessor >= 0) {
+            // Get shared index buffers of the accessor
+            auto bufferIt = m_indexBuffers.find(indexAccessor);
+            if (bufferIt != m_indexBuffers.end() && !bufferIt->second.empty()) {
+                const auto & ranges = bufferIt->second;
+
+                // Reference buffers from the mesh
+                for (const auto & range : ranges) {
+                    mesh->addBuffer(range.buffer);
+                }
+
+                // Set index buffer
+                geometry->setIndexBuffer(ranges[0].buffer, (gl::GLenum)ranges[0].type);
+                geometry->setCount(ranges[0].count);
+                geometry->setBaseVertex(static_cast<int>(ranges[0].baseVertex));
+
+                // Create a geometry for each further part of a split triangle list
+                for (size_t i=1; i<ranges.size(); i++) {
+                    auto part = cppassist::make_unique<rendercore::opengl::Geometry>();
+                    part->setMode(geometry->mode());
+                    part->setMaterial(geometry->material());
+                    part->setMorphTargets(geometry->morphTargets());
+                    part->setPositionDequantization(geometry->positionDequantization());
+                    part->setBoundingBox(geometry->boundingBoxMin(), geometry->boundingBoxMax());
+
+                    for (const auto & it : geometry->attributeBindings()) {
+                        part->bindAttribute(it.first, it.second);
                     }
+
+                    part->setIndexBuffer(ranges[i].buffer, (gl::GLenum)ranges[i].type);
+                    part->setCount(ranges[i].count);
+                    part->setBaseVertex(static_cast<int>(ranges[i].baseVertex));
+
+                    mesh->addGeometry(std::move(part));
+                }
+
+                // Set levels of detail
+                auto lodIt = m_lods.find(indexAccessor);
+                if (lodIt != m_lods.end()) {
+                    for (const auto & lod : lodIt->second.lods) {
+                        geometry->addLod(lod.offset, lod.count, lod.error);
+                    }
+
+                    geometry->setBoundingSphere(lodIt->second.boundingSphere);
+                }
+
+                // Set meshlets
+                auto meshletIt = m_meshlets.find(indexAccessor);
+                if (meshletIt != m_meshlets.end()) {
+                    geometry->setMeshlets(meshletIt->second);
                 }
             }
         }
@@ -275,32 +784,49 @@ void GltfConverter::generateMesh(const Asset & gltfAsset, const Mesh & gltfMesh)
         mesh->addGeometry(std::move(geometry));
     }
 
-    // Save mesh
-    m_meshes.push_back(std::move(mesh));
+    // Return mesh
+    return mesh;
 }
 
 void GltfConverter::generateScene(const Asset & gltfAsset, const Scene & gltfScene)
 {
+    auto start = std::chrono::steady_clock::now();
+
     // Create scene
     auto scene = cppassist::make_unique<rendercore::Scene>();
+    auto & arena = scene->arena();
 
-    // Get nodes
-    auto gltfNodes = gltfAsset.nodes();
+    // Scene nodes by GLTF node index (null for nodes outside of the scene)
+    std::vector<rendercore::SceneNode *> sceneNodes(gltfAsset.nodeCount(), nullptr);
 
-    // Helper function: Get scene node by index
-    auto getNode = [&gltfNodes] (unsigned int index) -> const Node * {
-        if (index < gltfNodes.size()) {
-            return gltfNodes[index];
-        }
+    // Mesh components that use a skin
+    std::vector< std::pair<MeshComponent *, int> > skinnedMeshes;
 
-        return nullptr;
-    };
+    // GLTF nodes that are yet to be created, with their parent scene node
+    std::vector< std::pair<rendercore::SceneNode *, unsigned int> > stack;
+
+    // Start at the root nodes (pushed in reverse order, so that they are created in order)
+    const auto & rootNodes = gltfScene.rootNodes();
+    for (auto it = rootNodes.rbegin(); it != rootNodes.rend(); ++it) {
+        stack.push_back(std::make_pair(scene->root(), *it));
+    }
+
+    unsigned int numNodes = 0;
+
+    while (!stack.empty()) {
+        rendercore::SceneNode * parent    = stack.back().first;
+        unsigned int            nodeIndex = stack.back().second;
+        stack.pop_back();
+
+        // Skip invalid nodes, and nodes that have already been created (the hierarchy must be a tree)
+        auto * gltfNode = gltfAsset.node(nodeIndex);
+        if (!gltfNode || sceneNodes[nodeIndex]) continue;
 
-    // Helper function: Parse scene node
-    std::function<void (rendercore::SceneNode & parent, const Node * gltfNode)> parseNode;
-    parseNode = [&] (rendercore::SceneNode & parent, const Node * gltfNode) {
         // Create scene node
-        auto node = cppassist::make_unique<rendercore::SceneNode>();
+        auto * node = arena.create<rendercore::SceneNode>();
+        sceneNodes[nodeIndex] = node;
+        parent->addChild(node);
+        numNodes++;
 
         // Set transformation
         Transform transform;
@@ -316,119 +842,1964 @@ void GltfConverter::generateScene(const Asset & gltfAsset, const Scene & gltfSce
         // Set mesh
         int meshIndex = gltfNode->mesh();
         if (meshIndex >= 0 && meshIndex < (int)m_meshes.size()) {
-            // Create mesh component
-            auto meshComponent = cppassist::make_unique<MeshComponent>();
-            meshComponent->setMesh(m_meshes[meshIndex].get());
+            // Create mesh component (instanced meshes are drawn with one call instead of one scene node per instance)
+            MeshComponent * meshComponent = nullptr;
+            if (!gltfNode->instanceAttributes().empty()) {
+                auto instances = generateInstances(gltfAsset, *gltfNode);
+                meshComponent = instances.get();
+                meshComponent->setMesh(m_meshes[meshIndex].get());
+                node->addComponent(std::move(instances));
+            } else {
+                meshComponent = arena.create<MeshComponent>();
+                meshComponent->setMesh(m_meshes[meshIndex].get());
+                node->addComponent(meshComponent);
+            }
+
+            // Remember skin (joints may not have been created yet)
+            if (gltfNode->skin() >= 0) {
+                skinnedMeshes.push_back(std::make_pair(meshComponent, gltfNode->skin()));
+            }
 
-            // Add component to scene node
-            node->addComponent(std::move(meshComponent));
+            // Set morph target weights (the node overrides the default weights of the mesh)
+            auto * gltfMesh = gltfAsset.mesh(meshIndex);
+            if (!gltfNode->weights().empty()) {
+                node->setMorphWeights(gltfNode->weights());
+            } else if (gltfMesh) {
+                node->setMorphWeights(gltfMesh->weights());
+            }
         }
 
-        // Process child nodes
-        for (unsigned int index : gltfNode->children()) {
-            auto * childNode = getNode(index);
-            if (childNode) parseNode(*node.get(), childNode);
+        // Process child nodes (pushed in reverse order, so that they are created in order)
+        const auto & children = gltfNode->children();
+        for (auto it = children.rbegin(); it != children.rend(); ++it) {
+            stack.push_back(std::make_pair(node, *it));
         }
+    }
 
-        // Add scene node to parent
-        parent.addChild(std::move(node));
-    };
+    // Generate skins and animations
+    generateSkins(gltfAsset, *scene.get(), sceneNodes, skinnedMeshes);
+    generateAnimations(gltfAsset, *scene.get(), sceneNodes);
 
-    // Parse scene starting at the root nodes
-    rendercore::SceneNode & root = *scene->root();
-    for (unsigned int index : gltfScene.rootNodes()) {
-        auto * rootNode = getNode(index);
-        if (rootNode) parseNode(root, rootNode);
-    }
+    // Calculate bounds
+    generateBounds(*scene.get());
+
+    // Report conversion time and memory
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    cppassist::info("rendercore-gltf") << "Generated scene with " << numNodes << " nodes in " << seconds * 1000.0 << " ms, "
+                                       << arena.count() << " objects in " << arena.size() / 1024 << " KB of arena memory";
 
     // Save scene
     m_scenes.push_back(std::move(scene));
 }
 
-rendercore::opengl::Texture * GltfConverter::loadTexture(const std::string & basePath, const Asset & gltfAsset, int textureInfoIndex)
+std::unique_ptr<InstancedMeshComponent> GltfConverter::generateInstances(const Asset & gltfAsset, const Node & gltfNode)
 {
-    // Check texture index
-    if (textureInfoIndex < 0 || textureInfoIndex >= (int)gltfAsset.textureInfos().size()) {
-        return nullptr;
-    }
-
-    // Get texture info
-    auto * gltfTextureInfo = gltfAsset.textureInfo(textureInfoIndex);
-    if (!gltfTextureInfo) return nullptr;
-
-    // Get texture
-    auto * gltfTexture = gltfAsset.texture(gltfTextureInfo->texture());
-    if (!gltfTexture) return nullptr;
+    auto component = cppassist::make_unique<InstancedMeshComponent>();
 
-    // Get image
-    auto * gltfImage = gltfAsset.image(gltfTexture->image());
-    if (!gltfImage) return nullptr;
+    // Read instance attributes
+    std::vector<float> attributes[3];
+    unsigned int       count = ~0u;
 
-    // Create texture
-    auto texture = cppassist::make_unique<rendercore::opengl::Texture>();
-    auto * texturePtr = texture.get();
+    static const char *       names[3]      = { "TRANSLATION", "ROTATION", "SCALE" };
+    static const unsigned int components[3] = { 3, 4, 3 };
 
-    // Set texture data
-    if (gltfImage->uri() != "") {
-        // Load from file
-        texture->load(basePath + gltfImage->uri());
-    } else if (gltfImage->bufferView() > -1) {
-        // Get buffer view
-        auto * gtlfBufferView = gltfAsset.bufferView(gltfImage->bufferView());
-        if (gtlfBufferView) {
-            // Get buffer index
-            auto bufferIndex = gtlfBufferView->buffer();
+    for (int i=0; i<3; i++) {
+        auto it = gltfNode.instanceAttributes().find(names[i]);
+        if (it == gltfNode.instanceAttributes().end()) continue;
 
-            // Get data
-            std::vector<char> * data = (bufferIndex < m_data.size()) ? m_data[bufferIndex].get() : nullptr;
-            if (data) {
-                // Create texture from data
-                ImageLoader loader;
-                auto image = loader.loadFromMemory(data->data() + gtlfBufferView->offset(), gtlfBufferView->size());
-                texture->setImage(std::move(image));
-            }
+        unsigned int numComponents = 0;
+        if (!readFloats(gltfAsset, it->second, attributes[i], numComponents) || numComponents != components[i]) {
+            cppassist::warning("rendercore-gltf") << "Invalid instance attribute " << names[i];
+            return component;
         }
+
+        count = std::min(count, static_cast<unsigned int>(attributes[i].size() / components[i]));
     }
 
-    // Set texture options
-    auto * gltfSampler = gltfAsset.sampler(gltfTexture->sampler());
-    if (gltfSampler) {
-        texture->setMinFilter((gl::GLenum)gltfSampler->minFilter());
-        texture->setMagFilter((gl::GLenum)gltfSampler->magFilter());
-        texture->setWrapS((gl::GLenum)gltfSampler->wrapS());
-        texture->setWrapT((gl::GLenum)gltfSampler->wrapT());
+    if (count == ~0u || count == 0) {
+        return component;
     }
 
-    // Save texture
-    m_textures.push_back(std::move(texture));
+    // Interleave translation, rotation and scale of each instance (missing attributes are set to identity)
+    std::vector<float> data(count * 10);
+
+    for (unsigned int i=0; i<count; i++) {
+        float * instance = &data[i * 10];
+
+        for (int c=0; c<3; c++) instance[c]     = attributes[0].empty() ? 0.0f : attributes[0][i * 3 + c];
+        for (int c=0; c<4; c++) instance[3 + c] = attributes[1].empty() ? (c == 3 ? 1.0f : 0.0f) : attributes[1][i * 4 + c];
+        for (int c=0; c<3; c++) instance[7 + c] = attributes[2].empty() ? 1.0f : attributes[2][i * 3 + c];
+    }
+
+    // Get bounding box of all instances
+    int meshIndex = gltfNode.mesh();
+    if (meshIndex >= 0 && meshIndex < (int)m_meshes.size() && m_meshes[meshIndex]->boundingBoxMin().x <= m_meshes[meshIndex]->boundingBoxMax().x) {
+        const auto & mesh = *m_meshes[meshIndex];
+
+        glm::vec3 boundsMin( std::numeric_limits<float>::max());
+        glm::vec3 boundsMax(-std::numeric_limits<float>::max());
+
+        for (unsigned int i=0; i<count; i++) {
+            const float * instance = &data[i * 10];
+
+            Transform transform;
+            transform.setTranslation(glm::vec3(instance[0], instance[1], instance[2]));
+            transform.setRotation(glm::vec4(instance[3], instance[4], instance[5], instance[6]));
+            transform.setScale(glm::vec3(instance[7], instance[8], instance[9]));
+
+            glm::vec3 instanceMin, instanceMax;
+            transformBounds(transform.transform(), mesh.boundingBoxMin(), mesh.boundingBoxMax(), instanceMin, instanceMax);
+
+            boundsMin = glm::min(boundsMin, instanceMin);
+            boundsMax = glm::max(boundsMax, instanceMax);
+        }
+
+        component->setBoundingBox(boundsMin, boundsMax);
+    }
+
+    // Create instance buffer
+    auto buffer = cppassist::make_unique<opengl::Buffer>();
+    buffer->setData(data);
+
+    component->setInstances(buffer.get(), count);
+    m_buffers.push_back(std::move(buffer));
+
+    return component;
+}
+
+void GltfConverter::generateAnimations(const Asset & gltfAsset, rendercore::Scene & scene, const std::vector<rendercore::SceneNode *> & sceneNodes) const
+{
+    for (auto * gltfAnimation : gltfAsset.animations()) {
+        // Create animation
+        auto animation = cppassist::make_unique<rendercore::Animation>();
+        animation->setName(gltfAnimation->name());
+
+        const auto & gltfSamplers = gltfAnimation->samplers();
+
+        for (const auto & gltfChannel : gltfAnimation->channels()) {
+            // Find animated scene node
+            auto * node = (gltfChannel.node >= 0 && gltfChannel.node < static_cast<int>(sceneNodes.size())) ? sceneNodes[gltfChannel.node] : nullptr;
+            if (!node || gltfChannel.sampler >= gltfSamplers.size()) continue;
+
+            // Get animated property
+            rendercore::Animation::Path path;
+            unsigned int                components;
+
+                 if (gltfChannel.path == "translation") { path = rendercore::Animation::Path::Translation; components = 3; }
+            else if (gltfChannel.path == "rotation")    { path = rendercore::Animation::Path::Rotation;    components = 4; }
+            else if (gltfChannel.path == "scale")       { path = rendercore::Animation::Path::Scale;       components = 3; }
+            else if (gltfChannel.path == "weights")     { path = rendercore::Animation::Path::Weights;     components = 1; }
+            else continue;
+
+            // Get interpolation
+            const auto & gltfSampler = gltfSamplers[gltfChannel.sampler];
+
+            rendercore::Animation::Interpolation interpolation = rendercore::Animation::Interpolation::Linear;
+                 if (gltfSampler.interpolation == "STEP")        interpolation = rendercore::Animation::Interpolation::Step;
+            else if (gltfSampler.interpolation == "CUBICSPLINE") interpolation = rendercore::Animation::Interpolation::CubicSpline;
+
+            // Read keyframes
+            std::vector<float> times;
+            std::vector<float> values;
+            unsigned int       timeComponents  = 0;
+            unsigned int       valueComponents = 0;
+
+            if (!readFloats(gltfAsset, gltfSampler.input, times, timeComponents) || timeComponents != 1) continue;
+            if (!readFloats(gltfAsset, gltfSampler.output, values, valueComponents) || valueComponents != components) continue;
+
+            const size_t valuesPerKey = (interpolation == rendercore::Animation::Interpolation::CubicSpline) ? 3 : 1;
+            if (values.size() < times.size() * valuesPerKey * components) continue;
+
+            // Add channels of morph target weights (one weight per target in each output element)
+            if (path == rendercore::Animation::Path::Weights) {
+                const unsigned int weightCount = static_cast<unsigned int>(values.size() / (times.size() * valuesPerKey));
+                animation->addWeightsChannel(node, interpolation, times.data(), values.data(), static_cast<unsigned int>(times.size()), weightCount);
+                continue;
+            }
+
+            // Add channel
+            animation->addChannel(node, path, interpolation, times.data(), values.data(), static_cast<unsigned int>(times.size()));
+        }
+
+        // Add animation to scene
+        if (animation->channelCount() > 0) {
+            scene.addAnimation(std::move(animation));
+        }
+    }
+}
+
+void GltfConverter::generateSkins(const Asset & gltfAsset, rendercore::Scene & scene, const std::vector<rendercore::SceneNode *> & sceneNodes, const std::vector< std::pair<MeshComponent *, int> > & skinnedMeshes) const
+{
+    // Skins by GLTF skin index (null if the skin could not be created)
+    std::unordered_map<int, rendercore::Skin *> skins;
+
+    for (const auto & skinnedMesh : skinnedMeshes) {
+        // Create skin on first use
+        auto skinIt = skins.find(skinnedMesh.second);
+        if (skinIt == skins.end()) {
+            skinIt = skins.insert(std::make_pair(skinnedMesh.second, nullptr)).first;
+
+            auto * gltfSkin = gltfAsset.skin(skinnedMesh.second);
+            if (!gltfSkin || gltfSkin->joints().empty()) continue;
+
+            // Find joints
+            std::vector<rendercore::SceneNode *> joints;
+            for (unsigned int index : gltfSkin->joints()) {
+                auto * node = index < sceneNodes.size() ? sceneNodes[index] : nullptr;
+                if (!node) break;
+
+                joints.push_back(node);
+            }
+
+            if (joints.size() != gltfSkin->joints().size()) {
+                cppassist::warning("rendercore-gltf") << "Skin " << skinnedMesh.second << " has joints outside of the scene";
+                continue;
+            }
+
+            if (joints.size() > 256) {
+                cppassist::warning("rendercore-gltf") << "Skin " << skinnedMesh.second << " has more than 256 joints, only the first 256 are used for rendering";
+            }
+
+            // Read inverse bind matrices (column-major)
+            std::vector<glm::mat4> inverseBindMatrices;
+            std::vector<float>     values;
+            unsigned int           components = 0;
+
+            if (gltfSkin->inverseBindMatrices() >= 0 && readFloats(gltfAsset, gltfSkin->inverseBindMatrices(), values, components) && components == 16) {
+                inverseBindMatrices.resize(values.size() / 16);
+                for (size_t i=0; i<inverseBindMatrices.size(); i++) {
+                    std::memcpy(&inverseBindMatrices[i][0][0], &values[i * 16], 16 * sizeof(float));
+                }
+            }
+
+            // Create skin
+            auto skin = cppassist::make_unique<rendercore::Skin>();
+            skin->setName(gltfSkin->name());
+            skin->setJoints(joints, inverseBindMatrices);
+
+            skinIt->second = skin.get();
+            scene.addSkin(std::move(skin));
+        }
+
+        // Attach skin to mesh
+        skinnedMesh.first->setSkin(skinIt->second);
+    }
+}
+
+void GltfConverter::generateBounds(rendercore::Scene & scene) const
+{
+    glm::vec3 sceneMin( std::numeric_limits<float>::max());
+    glm::vec3 sceneMax(-std::numeric_limits<float>::max());
+
+    // Traverse scene nodes with their transformation relative to the scene
+    std::vector< std::pair<const rendercore::SceneNode *, glm::mat4> > stack;
+    stack.push_back(std::make_pair(scene.root(), scene.root()->transform().transform()));
+
+    while (!stack.empty()) {
+        const rendercore::SceneNode * node      = stack.back().first;
+        const glm::mat4               transform = stack.back().second;
+        stack.pop_back();
+
+        // Add bounding boxes of the meshes
+        for (const auto * component : node->components()) {
+            auto * meshComponent = dynamic_cast<const MeshComponent *>(component);
+            if (!meshComponent || !meshComponent->mesh()) continue;
+
+            auto * instances = dynamic_cast<const InstancedMeshComponent *>(meshComponent);
+            const glm::vec3 & min = instances ? instances->boundingBoxMin() : meshComponent->mesh()->boundingBoxMin();
+            const glm::vec3 & max = instances ? instances->boundingBoxMax() : meshComponent->mesh()->boundingBoxMax();
+            if (min.x > max.x) continue;
+
+            glm::vec3 transformedMin, transformedMax;
+            transformBounds(transform, min, max, transformedMin, transformedMax);
+
+            sceneMin = glm::min(sceneMin, transformedMin);
+            sceneMax = glm::max(sceneMax, transformedMax);
+        }
+
+        // Process child nodes
+        for (const auto * child : node->children()) {
+            stack.push_back(std::make_pair(child, transform * child->transform().transform()));
+        }
+    }
+
+    scene.setBoundingBox(sceneMin, sceneMax);
+}
+
+void GltfConverter::optimizeGeometry(const Asset & gltfAsset, WorkerPool & pool)
+{
+    // Group indexed triangle lists by index accessor, other primitives prevent their accessors from being modified
+    std::map<int, const Primitive *>        groups;
+    std::set<int>                           excluded;
+    std::set<int>                           mixedAttributes;
+    std::map< unsigned int, std::set<int> > attributeUsers;
+
+    for (auto * gltfMesh : gltfAsset.meshes()) {
+        for (auto * gltfPrimitive : gltfMesh->primitives()) {
+            int  indexAccessor = gltfPrimitive->indices();
+            bool triangles     = gltfPrimitive->mode() == (unsigned int)gl::GL_TRIANGLES && indexAccessor >= 0;
+
+            // Vertices of morph targets and sparse accessors must keep their order
+            bool fixedVertices = !gltfPrimitive->targets().empty();
+            for (auto & it : gltfPrimitive->attributes()) {
+                auto * gltfAccessor = gltfAsset.accessor(it.second);
+                if (gltfAccessor && gltfAccessor->isSparse()) fixedVertices = true;
+            }
+
+            // Remember which index accessors use each vertex accessor
+            for (auto & it : gltfPrimitive->attributes()) {
+                attributeUsers[it.second].insert(triangles && !fixedVertices ? indexAccessor : -1);
+            }
+
+            if (!triangles) {
+                if (indexAccessor >= 0) excluded.insert(indexAccessor);
+                continue;
+            }
+
+            // Primitives that share indices but not vertices can only have their triangles reordered
+            auto it = groups.find(indexAccessor);
+            if (it == groups.end()) {
+                groups[indexAccessor] = gltfPrimitive;
+            } else if (it->second->attributes() != gltfPrimitive->attributes()) {
+                mixedAttributes.insert(indexAccessor);
+            }
+        }
+    }
+
+    // Optimize each index accessor once
+    struct Result
+    {
+        unsigned int                              triangles;
+        rendercore::GeometryOptimizer::Statistics before;
+        rendercore::GeometryOptimizer::Statistics after;
+    };
+
+    std::vector<Result> results;
+    results.reserve(groups.size());
+
+    for (auto & group : groups) {
+        if (excluded.count(group.first) > 0) {
+            continue;
+        }
+
+        // Vertices can only be reordered if no other index accessor references them
+        bool remapVertices = mixedAttributes.count(group.first) == 0;
+        for (auto & it : group.second->attributes()) {
+            const auto & users = attributeUsers[it.second];
+            if (users.size() != 1 || *users.begin() != group.first) {
+                remapVertices = false;
+            }
+        }
+
+        // Run optimization
+        results.push_back(Result());
+        Result * result = &results.back();
+        const Primitive * gltfPrimitive = group.second;
+
+        pool.run([this, &gltfAsset, gltfPrimitive, remapVertices, result] () {
+            result->triangles = optimizePrimitive(gltfAsset, *gltfPrimitive, remapVertices, result->before, result->after);
+        });
+    }
+
+    pool.wait();
+
+    // Report vertex cache efficiency
+    double triangles = 0.0, vertices = 0.0;
+    double missesBefore = 0.0, missesAfter = 0.0;
+    unsigned int geometries = 0;
+
+    for (const auto & result : results) {
+        if (result.triangles == 0 || result.after.atvr <= 0.0f) {
+            continue;
+        }
+
+        triangles    += result.triangles;
+        missesBefore += result.before.acmr * result.triangles;
+        missesAfter  += result.after.acmr  * result.triangles;
+        vertices     += result.after.acmr  * result.triangles / result.after.atvr;
+        geometries++;
+    }
+
+    if (geometries > 0) {
+        cppassist::info("rendercore-gltf") << "Optimized " << geometries << " geometries (" << static_cast<unsigned int>(triangles) << " triangles): "
+                                           << "ACMR " << missesBefore / triangles << " -> " << missesAfter / triangles << ", "
+                                           << "ATVR " << missesBefore / vertices  << " -> " << missesAfter / vertices;
+    }
+}
+
+unsigned int GltfConverter::optimizePrimitive(const Asset & gltfAsset, const Primitive & gltfPrimitive, bool remapVertices, rendercore::GeometryOptimizer::Statistics & before, rendercore::GeometryOptimizer::Statistics & after) const
+{
+    // Get index accessor
+    auto * gltfIndexAccessor = gltfAsset.accessor(gltfPrimitive.indices());
+    if (!gltfIndexAccessor) return 0;
+
+    auto * gltfIndexView = gltfAsset.bufferView(gltfIndexAccessor->bufferView());
+    if (!gltfIndexView) return 0;
+
+    const unsigned int indexType  = gltfIndexAccessor->componentType();
+    const unsigned int indexSize  = componentSize(indexType);
+    const unsigned int indexCount = gltfIndexAccessor->count();
+    if (indexType != (unsigned int)gl::GL_UNSIGNED_BYTE && indexType != (unsigned int)gl::GL_UNSIGNED_SHORT && indexType != (unsigned int)gl::GL_UNSIGNED_INT) return 0;
+    if (indexCount < 3 || indexCount % 3 != 0) return 0;
+
+    auto indexData = bufferData(gltfIndexView->buffer(), gltfIndexView->offset() + gltfIndexAccessor->offset(), indexCount * indexSize);
+    if (!indexData) return 0;
+
+    // Get vertex data
+    struct VertexData
+    {
+        char *       data;
+        unsigned int elementSize;
+        unsigned int stride;
+    };
+
+    std::vector<VertexData> vertexData;
+    std::set<unsigned int>  accessors;
+    unsigned int            vertexCount    = ~0u;
+    const char *            positions      = nullptr;
+    unsigned int            positionStride = 0;
+
+    for (auto & it : gltfPrimitive.attributes()) {
+        auto * gltfAccessor = gltfAsset.accessor(it.second);
+        if (!gltfAccessor) return 0;
+
+        auto * gltfBufferView = gltfAsset.bufferView(gltfAccessor->bufferView());
+        if (!gltfBufferView) return 0;
+
+        // Calculate vertex layout
+        unsigned int numComponents = componentCount(gltfAccessor->dataType());
+        unsigned int elementSize   = componentSize(gltfAccessor->componentType()) * numComponents;
+        unsigned int stride        = gltfBufferView->stride() > 0 ? gltfBufferView->stride() : elementSize;
+        unsigned int count         = gltfAccessor->count();
+        if (elementSize == 0 || count == 0) return 0;
+
+        auto data = bufferData(gltfBufferView->buffer(), gltfBufferView->offset() + gltfAccessor->offset(), (count - 1) * stride + elementSize);
+        if (!data) return 0;
+
+        vertexCount = std::min(vertexCount, count);
+
+        // Use positions to reduce overdraw
+        if (it.first == "POSITION" && gltfAccessor->componentType() == (unsigned int)gl::GL_FLOAT && numComponents == 3) {
+            positions      = data.get();
+            positionStride = stride;
+        }
+
+        // Each accessor must only be reordered once
+        if (accessors.insert(it.second).second) {
+            VertexData vertex;
+            vertex.data        = data.get();
+            vertex.elementSize = elementSize;
+            vertex.stride      = stride;
+            vertexData.push_back(vertex);
+        }
+    }
+
+    if (vertexCount == ~0u) return 0;
+
+    // Read indices
+    std::vector<unsigned int> indices;
+    if (!readIndices(indexData.get(), indexSize, indexCount, vertexCount, indices)) return 0;
+
+    before = GeometryOptimizer::analyzeVertexCache(indices, vertexCount);
+
+    // Hash source data, taking options that change the result into account
+    unsigned long long seed = positions ? FileCache::hash(positions, (vertexCount - 1) * positionStride + 12, vertexCount) : vertexCount;
+    unsigned long long key  = FileCache::hash(indices.data(), indices.size() * sizeof(unsigned int), seed * 2 + (remapVertices ? 1 : 0));
+
+    // Try to load optimized indices from cache
+    std::vector<unsigned int> remap;
+    bool cached = false;
+
+    if (auto file = m_cache.load(key, geometryCacheExtension)) {
+        CachedGeometryHeader header = CachedGeometryHeader();
+        if (file->size() >= sizeof(header)) {
+            std::memcpy(&header, file->data(), sizeof(header));
+        }
+
+        // Check header and size (computed in 64 bit to detect overflows)
+        const unsigned long long size = sizeof(header) + (static_cast<unsigned long long>(indexCount) + (header.remapped ? vertexCount : 0)) * sizeof(unsigned int);
+        bool valid = std::memcmp(header.magic, "RCGO", 4) == 0 && header.version == geometryCacheVersion &&
+                     header.indexCount == indexCount && header.vertexCount == vertexCount && file->size() >= size;
+
+        std::vector<unsigned int> cachedIndices;
+        std::vector<unsigned int> cachedRemap;
+
+        if (valid) {
+            const char * data = file->data() + sizeof(header);
+            cachedIndices.resize(indexCount);
+            std::memcpy(cachedIndices.data(), data, indexCount * sizeof(unsigned int));
+
+            if (header.remapped) {
+                cachedRemap.resize(vertexCount);
+                std::memcpy(cachedRemap.data(), data + indexCount * sizeof(unsigned int), vertexCount * sizeof(unsigned int));
+            }
+        }
+
+        // Check that all indices reference existing vertices
+        for (size_t i = 0; valid && i < cachedIndices.size(); i++) {
+            valid = (cachedIndices[i] < vertexCount);
+        }
+
+        // Check that the remap table is a permutation, as vertices are written to the remapped positions
+        if (valid && !cachedRemap.empty()) {
+            std::vector<bool> used(vertexCount, false);
+            for (size_t i = 0; valid && i < cachedRemap.size(); i++) {
+                valid = (cachedRemap[i] < vertexCount && !used[cachedRemap[i]]);
+                if (valid) used[cachedRemap[i]] = true;
+            }
+        }
+
+        // Otherwise, the cache entry is ignored and the indices are optimized again
+        if (valid) {
+            indices.swap(cachedIndices);
+            remap.swap(cachedRemap);
+            cached = true;
+        }
+    }
+
+    // Optimize indices
+    if (!cached) {
+        std::vector<unsigned int> clusters;
+        GeometryOptimizer::optimizeVertexCache(indices, vertexCount, &clusters);
+
+        if (positions) {
+            GeometryOptimizer::optimizeOverdraw(indices, clusters, positions, positionStride, vertexCount);
+        }
+
+        if (remapVertices) {
+            GeometryOptimizer::optimizeVertexFetch(indices, vertexCount, remap);
+        }
+
+        // Store optimized indices in cache
+        if (m_cache.enabled()) {
+            CachedGeometryHeader header;
+            std::memcpy(header.magic, "RCGO", 4);
+            header.version     = geometryCacheVersion;
+            header.indexCount  = indexCount;
+            header.vertexCount = vertexCount;
+            header.remapped    = remap.empty() ? 0 : 1;
+
+            std::vector<char> blob(sizeof(header) + (indices.size() + remap.size()) * sizeof(unsigned int));
+            std::memcpy(blob.data(), &header, sizeof(header));
+            std::memcpy(blob.data() + sizeof(header), indices.data(), indices.size() * sizeof(unsigned int));
+            if (!remap.empty()) {
+                std::memcpy(blob.data() + sizeof(header) + indices.size() * sizeof(unsigned int), remap.data(), remap.size() * sizeof(unsigned int));
+            }
+
+            m_cache.store(key, geometryCacheExtension, blob.data(), blob.size());
+        }
+    }
+
+    after = GeometryOptimizer::analyzeVertexCache(indices, vertexCount);
+
+    // Write vertices
+    if (!remap.empty()) {
+        for (auto & vertex : vertexData) {
+            GeometryOptimizer::remapVertices(vertex.data, vertex.elementSize, vertex.stride, remap);
+        }
+    }
+
+    // Write indices
+    writeIndices(indexData.get(), indexSize, indices);
+
+    return indexCount / 3;
+}
+
+std::map<int, const Primitive *> GltfConverter::triangleLists(const Asset & gltfAsset) const
+{
+    // Find indexed triangle lists, index accessors that are used with different positions or primitive modes are skipped
+    std::map<int, const Primitive *> groups;
+    std::set<int>                    excluded;
+
+    for (auto * gltfMesh : gltfAsset.meshes()) {
+        for (auto * gltfPrimitive : gltfMesh->primitives()) {
+            int indexAccessor = gltfPrimitive->indices();
+            if (indexAccessor < 0) continue;
+
+            if (gltfPrimitive->mode() != (unsigned int)gl::GL_TRIANGLES || gltfPrimitive->attributes().count("POSITION") == 0) {
+                excluded.insert(indexAccessor);
+                continue;
+            }
+
+            auto it = groups.find(indexAccessor);
+            if (it == groups.end()) {
+                groups[indexAccessor] = gltfPrimitive;
+            } else if (it->second->attributes().at("POSITION") != gltfPrimitive->attributes().at("POSITION")) {
+                excluded.insert(indexAccessor);
+            }
+        }
+    }
+
+    for (int indexAccessor : excluded) {
+        groups.erase(indexAccessor);
+    }
+
+    return groups;
+}
+
+void GltfConverter::generateLods(const Asset & gltfAsset, WorkerPool & pool)
+{
+    // Find triangle lists
+    auto groups = triangleLists(gltfAsset);
+
+    // Generate levels of detail for each index accessor
+    std::vector<int>     indexAccessors;
+    std::vector<LodData> results;
+    std::vector<char>    succeeded;
+
+    for (auto & group : groups) {
+        indexAccessors.push_back(group.first);
+    }
+
+    results.resize(indexAccessors.size());
+    succeeded.resize(indexAccessors.size(), 0);
+
+    for (size_t i=0; i<indexAccessors.size(); i++) {
+        const Primitive * gltfPrimitive = groups[indexAccessors[i]];
+
+        pool.run([this, &gltfAsset, gltfPrimitive, &results, &succeeded, i] () {
+            succeeded[i] = generatePrimitiveLods(gltfAsset, *gltfPrimitive, results[i]) ? 1 : 0;
+        });
+    }
+
+    pool.wait();
+
+    // Save results and count triangles of each level
+    std::vector<unsigned int> triangles;
+    unsigned int              geometries = 0;
+
+    for (size_t i=0; i<indexAccessors.size(); i++) {
+        if (!succeeded[i]) continue;
+
+        const auto & lods = results[i].lods;
+        if (triangles.size() < lods.size()) {
+            triangles.resize(lods.size(), 0);
+        }
+
+        for (size_t level=0; level<lods.size(); level++) {
+            triangles[level] += lods[level].count / 3;
+        }
+
+        m_lods[indexAccessors[i]] = std::move(results[i]);
+        geometries++;
+    }
+
+    // Output statistics
+    if (geometries > 0) {
+        auto info = cppassist::info("rendercore-gltf");
+        info << "Generated levels of detail for " << geometries << " geometries (triangles:";
+        for (auto count : triangles) {
+            info << " " << count;
+        }
+        info << ")";
+    }
+}
+
+bool GltfConverter::generatePrimitiveLods(const Asset & gltfAsset, const Primitive & gltfPrimitive, LodData & lodData) const
+{
+    // Get index accessor
+    auto * gltfIndexAccessor = gltfAsset.accessor(gltfPrimitive.indices());
+    if (!gltfIndexAccessor) return false;
+
+    auto * gltfIndexView = gltfAsset.bufferView(gltfIndexAccessor->bufferView());
+    if (!gltfIndexView) return false;
+
+    const unsigned int indexType  = gltfIndexAccessor->componentType();
+    const unsigned int indexSize  = componentSize(indexType);
+    const unsigned int indexCount = gltfIndexAccessor->count();
+    if (indexType != (unsigned int)gl::GL_UNSIGNED_BYTE && indexType != (unsigned int)gl::GL_UNSIGNED_SHORT && indexType != (unsigned int)gl::GL_UNSIGNED_INT) return false;
+    if (indexCount < 3 || indexCount % 3 != 0) return false;
+
+    auto indexData = bufferData(gltfIndexView->buffer(), gltfIndexView->offset() + gltfIndexAccessor->offset(), indexCount * indexSize);
+    if (!indexData) return false;
+
+    // Get positions
+    auto * gltfAccessor = gltfAsset.accessor(gltfPrimitive.attributes().at("POSITION"));
+    if (!gltfAccessor || gltfAccessor->componentType() != (unsigned int)gl::GL_FLOAT || componentCount(gltfAccessor->dataType()) != 3) return false;
+
+    auto * gltfBufferView = gltfAsset.bufferView(gltfAccessor->bufferView());
+    if (!gltfBufferView) return false;
+
+    const unsigned int vertexCount = gltfAccessor->count();
+    const unsigned int stride      = gltfBufferView->stride() > 0 ? gltfBufferView->stride() : 3 * sizeof(float);
+    if (vertexCount == 0) return false;
+
+    auto positionData = bufferData(gltfBufferView->buffer(), gltfBufferView->offset() + gltfAccessor->offset(), (vertexCount - 1) * stride + 3 * sizeof(float));
+    if (!positionData) return false;
+
+    const char * positions = positionData.get();
+
+    // Read indices
+    std::vector<unsigned int> indices;
+    if (!readIndices(indexData.get(), indexSize, indexCount, vertexCount, indices)) return false;
+
+    // Calculate bounding sphere around the center of the bounding box
+    glm::vec4 minValue, maxValue;
+    VertexQuantizer::bounds(positions, vertexCount, stride, 3, minValue, maxValue);
+
+    glm::vec3 center = glm::vec3(minValue + maxValue) * 0.5f;
+    float     radius = 0.0f;
+
+    for (unsigned int i=0; i<vertexCount; i++) {
+        float value[3];
+        std::memcpy(value, positions + static_cast<size_t>(i) * stride, sizeof(value));
+        radius = std::max(radius, glm::length(glm::vec3(value[0], value[1], value[2]) - center));
+    }
+
+    lodData.boundingSphere = glm::vec4(center, radius);
+
+    // Try to load levels of detail from cache
+    unsigned long long seed = FileCache::hash(positions, (vertexCount - 1) * stride + 3 * sizeof(float), vertexCount);
+    unsigned long long key  = FileCache::hash(indices.data(), indices.size() * sizeof(unsigned int), seed + m_lodLevels * 2 + (m_geometryOptimization ? 1 : 0));
+
+    if (auto file = m_cache.load(key, lodCacheExtension)) {
+        CachedLodHeader header = CachedLodHeader();
+        if (file->size() >= sizeof(header)) {
+            std::memcpy(&header, file->data(), sizeof(header));
+        }
+
+        // Check header and size (computed in 64 bit to detect overflows)
+        const unsigned long long size = sizeof(header) + static_cast<unsigned long long>(header.levels) * sizeof(opengl::Geometry::Lod) +
+                                        static_cast<unsigned long long>(header.indexCount) * sizeof(unsigned int);
+        bool valid = std::memcmp(header.magic, "RCLD", 4) == 0 && header.version == lodCacheVersion && header.levels > 1 && file->size() >= size;
+
+        std::vector<opengl::Geometry::Lod> cachedLods;
+        std::vector<unsigned int>          cachedIndices;
+
+        if (valid) {
+            const char * data = file->data() + sizeof(header);
+
+            cachedLods.resize(header.levels);
+            std::memcpy(cachedLods.data(), data, header.levels * sizeof(opengl::Geometry::Lod));
+
+            cachedIndices.resize(header.indexCount);
+            std::memcpy(cachedIndices.data(), data + header.levels * sizeof(opengl::Geometry::Lod), header.indexCount * sizeof(unsigned int));
+
+            // The first level must be the original triangle list
+            valid = (cachedLods[0].offset == 0 && cachedLods[0].count == indexCount);
+        }
+
+        // Check that all levels lie within the index data
+        for (size_t i = 0; valid && i < cachedLods.size(); i++) {
+            valid = (static_cast<unsigned long long>(cachedLods[i].offset) + cachedLods[i].count <= header.indexCount);
+        }
+
+        // Check that all indices reference existing vertices
+        for (size_t i = 0; valid && i < cachedIndices.size(); i++) {
+            valid = (cachedIndices[i] < vertexCount);
+        }
+
+        // Otherwise, the cache entry is ignored and the levels of detail are generated again
+        if (valid) {
+            lodData.lods.swap(cachedLods);
+            lodData.indices.swap(cachedIndices);
+            return true;
+        }
+    }
+
+    // The first level is the original triangle list
+    opengl::Geometry::Lod lod;
+    lod.offset = 0;
+    lod.count  = indexCount;
+    lod.error  = 0.0f;
+
+    lodData.indices = indices;
+    lodData.lods.push_back(lod);
+
+    // Halve the number of triangles for each further level
+    float error = 0.0f;
+    for (unsigned int level=0; level<m_lodLevels; level++) {
+        unsigned int target = static_cast<unsigned int>(indices.size() / 6 * 3);
+        if (target == 0) break;
+
+        std::vector<unsigned int> simplified = indices;
+        float stepError = MeshSimplifier::simplify(simplified, positions, stride, vertexCount, target, std::numeric_limits<float>::max());
+
+        // Stop if the mesh cannot be simplified noticeably any further, rather than emitting nearly identical levels
+        if (simplified.empty() || simplified.size() > indices.size() * 9 / 10) {
+            cppassist::info("rendercore-gltf") << "Stopped simplification of primitive with " << indexCount / 3 << " triangles after "
+                                               << level << " of " << m_lodLevels << " levels of detail (" << indices.size() / 3
+                                               << " triangles could not be reduced, e.g., due to borders or attribute seams)";
+            break;
+        }
+
+        if (m_geometryOptimization) {
+            GeometryOptimizer::optimizeVertexCache(simplified, vertexCount);
+        }
+
+        // Errors of subsequent simplifications add up
+        error += stepError;
+
+        lod.offset = static_cast<unsigned int>(lodData.indices.size());
+        lod.count  = static_cast<unsigned int>(simplified.size());
+        lod.error  = error;
+
+        lodData.indices.insert(lodData.indices.end(), simplified.begin(), simplified.end());
+        lodData.lods.push_back(lod);
+
+        indices.swap(simplified);
+    }
+
+    if (lodData.lods.size() < 2) {
+        return false;
+    }
+
+    // Store levels of detail in cache
+    if (m_cache.enabled()) {
+        CachedLodHeader header;
+        std::memcpy(header.magic, "RCLD", 4);
+        header.version    = lodCacheVersion;
+        header.levels     = static_cast<unsigned int>(lodData.lods.size());
+        header.indexCount = static_cast<unsigned int>(lodData.indices.size());
+
+        const size_t lodSize = lodData.lods.size() * sizeof(opengl::Geometry::Lod);
+
+        std::vector<char> blob(sizeof(header) + lodSize + lodData.indices.size() * sizeof(unsigned int));
+        std::memcpy(blob.data(), &header, sizeof(header));
+        std::memcpy(blob.data() + sizeof(header), lodData.lods.data(), lodSize);
+        std::memcpy(blob.data() + sizeof(header) + lodSize, lodData.indices.data(), lodData.indices.size() * sizeof(unsigned int));
+
+        m_cache.store(key, lodCacheExtension, blob.data(), blob.size());
+    }
+
+    return true;
+}
+
+void GltfConverter::buildMeshlets(const Asset & gltfAsset, WorkerPool & pool)
+{
+    // Find triangle lists that are large enough
+    std::vector<int>               indexAccessors;
+    std::vector<const Primitive *> primitives;
+
+    for (auto & group : triangleLists(gltfAsset)) {
+        auto * gltfAccessor = gltfAsset.accessor(group.first);
+        if (gltfAccessor && gltfAccessor->count() / 3 >= m_meshletThreshold) {
+            indexAccessors.push_back(group.first);
+            primitives.push_back(group.second);
+        }
+    }
+
+    // Build meshlets for each index accessor
+    std::vector< std::vector<MeshletBuilder::Meshlet> > results(indexAccessors.size());
+
+    for (size_t i=0; i<indexAccessors.size(); i++) {
+        pool.run([this, &gltfAsset, &primitives, &results, i] () {
+            buildPrimitiveMeshlets(gltfAsset, *primitives[i], results[i]);
+        });
+    }
+
+    pool.wait();
+
+    // Save results
+    size_t       meshlets   = 0;
+    size_t       triangles  = 0;
+    unsigned int geometries = 0;
+
+    for (size_t i=0; i<indexAccessors.size(); i++) {
+        if (results[i].empty()) continue;
+
+        for (const auto & meshlet : results[i]) {
+            triangles += meshlet.count / 3;
+        }
+
+        meshlets += results[i].size();
+        m_meshlets[indexAccessors[i]] = std::move(results[i]);
+        geometries++;
+    }
+
+    // Output statistics
+    if (geometries > 0) {
+        cppassist::info("rendercore-gltf") << "Built " << meshlets << " meshlets for " << geometries << " geometries ("
+                                           << static_cast<float>(triangles) / meshlets << " triangles per meshlet)";
+    }
+}
+
+void GltfConverter::buildPrimitiveMeshlets(const Asset & gltfAsset, const Primitive & gltfPrimitive, std::vector<MeshletBuilder::Meshlet> & meshlets)
+{
+    // Get positions
+    auto * gltfAccessor = gltfAsset.accessor(gltfPrimitive.attributes().at("POSITION"));
+    if (!gltfAccessor || gltfAccessor->componentType() != (unsigned int)gl::GL_FLOAT || componentCount(gltfAccessor->dataType()) != 3) return;
+
+    auto * gltfBufferView = gltfAsset.bufferView(gltfAccessor->bufferView());
+    if (!gltfBufferView) return;
+
+    const unsigned int vertexCount = gltfAccessor->count();
+    const unsigned int stride      = gltfBufferView->stride() > 0 ? gltfBufferView->stride() : 3 * sizeof(float);
+    if (vertexCount == 0) return;
+
+    auto positionData = bufferData(gltfBufferView->buffer(), gltfBufferView->offset() + gltfAccessor->offset(), (vertexCount - 1) * stride + 3 * sizeof(float));
+    if (!positionData) return;
+
+    // Reorder first level of detail, if levels of detail have been generated
+    auto lodIt = m_lods.find(gltfPrimitive.indices());
+    if (lodIt != m_lods.end()) {
+        auto & lodData = lodIt->second;
+
+        std::vector<unsigned int> indices(lodData.indices.begin(), lodData.indices.begin() + lodData.lods[0].count);
+        meshlets = MeshletBuilder::build(indices, positionData.get(), stride, vertexCount);
+        std::copy(indices.begin(), indices.end(), lodData.indices.begin());
+
+        return;
+    }
+
+    // Otherwise, reorder indices in the loaded buffer
+    auto * gltfIndexAccessor = gltfAsset.accessor(gltfPrimitive.indices());
+    if (!gltfIndexAccessor) return;
+
+    auto * gltfIndexView = gltfAsset.bufferView(gltfIndexAccessor->bufferView());
+    if (!gltfIndexView) return;
+
+    const unsigned int indexType  = gltfIndexAccessor->componentType();
+    const unsigned int indexSize  = componentSize(indexType);
+    const unsigned int indexCount = gltfIndexAccessor->count();
+    if (indexType != (unsigned int)gl::GL_UNSIGNED_BYTE && indexType != (unsigned int)gl::GL_UNSIGNED_SHORT && indexType != (unsigned int)gl::GL_UNSIGNED_INT) return;
+    if (indexCount < 3 || indexCount % 3 != 0) return;
+
+    auto indexData = bufferData(gltfIndexView->buffer(), gltfIndexView->offset() + gltfIndexAccessor->offset(), indexCount * indexSize);
+    if (!indexData) return;
+
+    std::vector<unsigned int> indices;
+    if (!readIndices(indexData.get(), indexSize, indexCount, vertexCount, indices)) return;
+
+    meshlets = MeshletBuilder::build(indices, positionData.get(), stride, vertexCount);
+    writeIndices(indexData.get(), indexSize, indices);
+}
+
+void GltfConverter::createBuffers(const Asset & gltfAsset)
+{
+    unsigned int originalSize      = 0;
+    unsigned int quantizedSize     = 0;
+    unsigned int originalIndexSize = 0;
+    unsigned int narrowedIndexSize = 0;
+
+    // Merge strips, fans and loops into batches with index buffers of their own
+    mergeStrips(gltfAsset);
+
+    // Find triangle lists, which can be split if their indices do not fit into 16 bit
+    auto triangles = triangleLists(gltfAsset);
+
+    for (auto * gltfMesh : gltfAsset.meshes()) {
+        for (auto * gltfPrimitive : gltfMesh->primitives()) {
+            // Vertex buffers are created per buffer view
+            for (auto & it : gltfPrimitive->attributes()) {
+                // Quantized attributes are created per accessor, decoded attributes per mesh
+                if (m_quantizedAttributes.count(it.second) > 0 || m_decodedAttributes.count(it.second) > 0) continue;
+
+                if (m_vertexQuantization && quantizeAttribute(gltfAsset, it.first, it.second, originalSize, quantizedSize)) {
+                    continue;
+                }
+
+                // Get buffer view
+                auto * gltfAccessor = gltfAsset.accessor(it.second);
+                if (!gltfAccessor) continue;
+
+                unsigned int bufferViewIndex = gltfAccessor->bufferView();
+                auto * gltfBufferView = gltfAsset.bufferView(bufferViewIndex);
+                if (!gltfBufferView || m_vertexBuffers.count(bufferViewIndex) > 0) continue;
+
+                // Get data
+                auto data = bufferData(gltfBufferView->buffer(), gltfBufferView->offset(), gltfBufferView->size());
+                if (!data) continue;
+
+                // Create buffer (referencing the loaded data)
+                auto buffer = cppassist::make_unique<opengl::Buffer>();
+                buffer->setExternalData(data.get(), gltfBufferView->size(), data);
+
+                m_vertexBuffers[bufferViewIndex] = buffer.get();
+                m_buffers.push_back(std::move(buffer));
+            }
+
+            // Index buffers are created per accessor (batches of merged primitives have their own)
+            int indexAccessor = gltfPrimitive->indices();
+            if (indexAccessor < 0 || m_indexBuffers.count(indexAccessor) > 0) continue;
+            if (m_restartBatches.count(gltfPrimitive) > 0 || m_mergedPrimitives.count(gltfPrimitive) > 0) continue;
+
+            // Get accessor
+            auto * gltfAccessor = gltfAsset.accessor(indexAccessor);
+            if (!gltfAccessor) continue;
+
+            const unsigned int indexType = gltfAccessor->componentType();
+            auto & ranges = m_indexBuffers[indexAccessor];
+
+            // Only triangle lists without levels of detail or meshlets can be split
+            bool splittable = triangles.count(indexAccessor) > 0 && m_lods.count(indexAccessor) == 0 && m_meshlets.count(indexAccessor) == 0;
+
+            // Create buffer with the decoded indices of a Draco compressed primitive
+            auto decodedIt = m_decodedIndices.find(indexAccessor);
+            if (decodedIt != m_decodedIndices.end()) {
+                const auto & indices = decodedIt->second;
+                if (createIndexBuffers(indices, indexType, splittable, ranges, originalIndexSize, narrowedIndexSize)) continue;
+
+                auto buffer = cppassist::make_unique<opengl::Buffer>();
+
+                     if (indexType == (unsigned int)gl::GL_UNSIGNED_BYTE)  buffer->setData(std::vector<unsigned char> (indices.begin(), indices.end()));
+                else if (indexType == (unsigned int)gl::GL_UNSIGNED_SHORT) buffer->setData(std::vector<unsigned short>(indices.begin(), indices.end()));
+                else                                                       buffer->setData(indices);
+
+                ranges.push_back(IndexRange{ buffer.get(), indexType, static_cast<unsigned int>(indices.size()), 0 });
+                m_buffers.push_back(std::move(buffer));
+                continue;
+            }
+
+            // Get buffer view
+            auto * gltfBufferView = gltfAsset.bufferView(gltfAccessor->bufferView());
+            if (!gltfBufferView) {
+                m_indexBuffers.erase(indexAccessor);
+                continue;
+            }
+
+            // Create buffer with the indices of all levels of detail
+            auto lodIt = m_lods.find(indexAccessor);
+            if (lodIt != m_lods.end()) {
+                const auto & indices = lodIt->second.indices;
+                if (createIndexBuffers(indices, indexType, false, ranges, originalIndexSize, narrowedIndexSize)) continue;
+
+                auto buffer = cppassist::make_unique<opengl::Buffer>();
+
+                     if (indexType == (unsigned int)gl::GL_UNSIGNED_BYTE)  buffer->setData(std::vector<unsigned char> (indices.begin(), indices.end()));
+                else if (indexType == (unsigned int)gl::GL_UNSIGNED_SHORT) buffer->setData(std::vector<unsigned short>(indices.begin(), indices.end()));
+                else                                                       buffer->setData(indices);
+
+                ranges.push_back(IndexRange{ buffer.get(), indexType, static_cast<unsigned int>(indices.size()), 0 });
+                m_buffers.push_back(std::move(buffer));
+                continue;
+            }
+
+            // Get data (only the indices that are actually used)
+            unsigned int indexSize = componentSize(indexType);
+            unsigned int size      = gltfAccessor->count() * indexSize;
+            if (size == 0 || gltfAccessor->offset() > gltfBufferView->size() || size > gltfBufferView->size() - gltfAccessor->offset()) {
+                m_indexBuffers.erase(indexAccessor);
+                continue;
+            }
+
+            auto data = bufferData(gltfBufferView->buffer(), gltfBufferView->offset() + gltfAccessor->offset(), size);
+            if (!data) {
+                m_indexBuffers.erase(indexAccessor);
+                continue;
+            }
+
+            // Create narrowed buffer
+            std::vector<unsigned int> indices;
+            if (readIndices(data.get(), indexSize, gltfAccessor->count(), restartIndex, indices) &&
+                createIndexBuffers(indices, indexType, splittable, ranges, originalIndexSize, narrowedIndexSize))
+            {
+                continue;
+            }
+
+            // Otherwise, create buffer (referencing the loaded data)
+            auto buffer = cppassist::make_unique<opengl::Buffer>();
+            buffer->setExternalData(data.get(), size, data);
+
+            ranges.push_back(IndexRange{ buffer.get(), indexType, gltfAccessor->count(), 0 });
+            m_buffers.push_back(std::move(buffer));
+        }
+    }
+
+    // Output statistics
+    if (originalSize > 0) {
+        cppassist::info("rendercore-gltf") << "Quantized " << m_quantizedAttributes.size() << " vertex attributes: "
+                                           << originalSize << " -> " << quantizedSize << " bytes";
+    }
+
+    if (originalIndexSize > 0) {
+        cppassist::info("rendercore-gltf") << "Narrowed index buffers: " << originalIndexSize << " -> " << narrowedIndexSize << " bytes";
+    }
+}
+
+void GltfConverter::mergeStrips(const Asset & gltfAsset)
+{
+    m_restartBatches.clear();
+    m_mergedPrimitives.clear();
+
+    unsigned int merged  = 0;
+    unsigned int batches = 0;
+
+    for (auto * gltfMesh : gltfAsset.meshes()) {
+        // Group indexed strips, fans and loops that can be drawn together
+        std::vector< std::vector<const Primitive *> > groups;
+
+        for (auto * gltfPrimitive : gltfMesh->primitives()) {
+            const unsigned int mode = gltfPrimitive->mode();
+            if (mode != (unsigned int)gl::GL_LINE_LOOP && mode != (unsigned int)gl::GL_LINE_STRIP &&
+                mode != (unsigned int)gl::GL_TRIANGLE_STRIP && mode != (unsigned int)gl::GL_TRIANGLE_FAN) continue;
+            if (gltfPrimitive->indices() < 0 || !gltfPrimitive->targets().empty()) continue;
+
+            auto it = std::find_if(groups.begin(), groups.end(), [gltfPrimitive] (const std::vector<const Primitive *> & group)
+            {
+                const Primitive * first = group.front();
+                return first->mode() == gltfPrimitive->mode() && first->material() == gltfPrimitive->material() && first->attributes() == gltfPrimitive->attributes();
+            });
+
+            if (it != groups.end()) {
+                it->push_back(gltfPrimitive);
+            } else {
+                groups.push_back(std::vector<const Primitive *>(1, gltfPrimitive));
+            }
+        }
+
+        // Concatenate indices of each group
+        for (const auto & group : groups) {
+            if (group.size() < 2) continue;
+
+            std::vector<unsigned int>      indices;
+            std::vector<unsigned int>      primitiveIndices;
+            std::vector<const Primitive *> primitives;
+
+            for (const Primitive * gltfPrimitive : group) {
+                if (!readPrimitiveIndices(gltfAsset, gltfPrimitive->indices(), primitiveIndices) || primitiveIndices.empty()) continue;
+
+                if (!indices.empty()) {
+                    indices.push_back(restartIndex);
+                }
+
+                indices.insert(indices.end(), primitiveIndices.begin(), primitiveIndices.end());
+                primitives.push_back(gltfPrimitive);
+            }
+
+            if (primitives.size() < 2) continue;
+
+            // Create index buffer
+            std::vector<IndexRange> ranges;
+            unsigned int originalIndexSize = 0;
+            unsigned int narrowedIndexSize = 0;
+
+            if (!createIndexBuffers(indices, (unsigned int)gl::GL_UNSIGNED_INT, false, ranges, originalIndexSize, narrowedIndexSize)) {
+                auto buffer = cppassist::make_unique<opengl::Buffer>();
+                buffer->setData(indices);
+
+                ranges.push_back(IndexRange{ buffer.get(), (unsigned int)gl::GL_UNSIGNED_INT, static_cast<unsigned int>(indices.size()), 0 });
+                m_buffers.push_back(std::move(buffer));
+            }
+
+            // The first primitive draws the whole batch
+            m_restartBatches[primitives.front()] = ranges.front();
+            m_mergedPrimitives.insert(primitives.begin() + 1, primitives.end());
+
+            merged += static_cast<unsigned int>(primitives.size());
+            batches++;
+        }
+    }
+
+    // Output statistics
+    if (batches > 0) {
+        cppassist::info("rendercore-gltf") << "Merged " << merged << " strips, fans and loops into " << batches << " batches";
+    }
+}
+
+bool GltfConverter::createIndexBuffers(const std::vector<unsigned int> & indices, unsigned int type, bool splittable, std::vector<IndexRange> & ranges, unsigned int & originalSize, unsigned int & narrowedSize)
+{
+    if (indices.empty()) {
+        return false;
+    }
+
+    // Find largest index
+    unsigned int maxIndex = 0;
+    for (unsigned int index : indices) {
+        if (index != restartIndex) maxIndex = std::max(maxIndex, index);
+    }
+
+    // Split triangle lists that exceed 16 bit indices into parts, each relative to its lowest index
+    std::vector< std::pair<size_t, unsigned int> > parts(1, std::make_pair(static_cast<size_t>(0), 0u));
+
+    if (splittable && narrowIndexType(maxIndex) == (unsigned int)gl::GL_UNSIGNED_INT) {
+        auto split = splitTriangles(indices);
+        if (!split.empty() && split.size() * minimumPartSize <= indices.size()) {
+            parts = split;
+        }
+    }
+
+    // Keep indices that cannot be narrowed
+    if (parts.size() == 1 && parts[0].second == 0 && componentSize(narrowIndexType(maxIndex)) >= componentSize(type)) {
+        return false;
+    }
+
+    // Create index buffer for each part
+    for (size_t i=0; i<parts.size(); i++) {
+        const size_t       first      = parts[i].first;
+        const size_t       count      = (i + 1 < parts.size() ? parts[i + 1].first : indices.size()) - first;
+        const unsigned int baseVertex = parts[i].second;
+
+        unsigned int partMax = 0;
+        for (size_t j=first; j<first+count; j++) {
+            if (indices[j] != restartIndex) partMax = std::max(partMax, indices[j] - baseVertex);
+        }
+
+        const unsigned int partType = narrowIndexType(partMax);
+        auto buffer = cppassist::make_unique<opengl::Buffer>();
+
+             if (partType == (unsigned int)gl::GL_UNSIGNED_BYTE)  buffer->setData(convertIndices<unsigned char> (indices.data() + first, count, baseVertex));
+        else if (partType == (unsigned int)gl::GL_UNSIGNED_SHORT) buffer->setData(convertIndices<unsigned short>(indices.data() + first, count, baseVertex));
+        else                                                      buffer->setData(convertIndices<unsigned int>  (indices.data() + first, count, baseVertex));
+
+        ranges.push_back(IndexRange{ buffer.get(), partType, static_cast<unsigned int>(count), baseVertex });
+        m_buffers.push_back(std::move(buffer));
+
+        narrowedSize += static_cast<unsigned int>(count * componentSize(partType));
+    }
+
+    originalSize += static_cast<unsigned int>(indices.size() * componentSize(type));
+    return true;
+}
+
+bool GltfConverter::quantizeAttribute(const Asset & gltfAsset, const std::string & name, unsigned int accessorIndex, unsigned int & originalSize, unsigned int & quantizedSize)
+{
+    // Only dense float attributes are quantized
+    auto * gltfAccessor = gltfAsset.accessor(accessorIndex);
+    if (!gltfAccessor || gltfAccessor->componentType() != (unsigned int)gl::GL_FLOAT || gltfAccessor->isSparse() || gltfAccessor->count() == 0) {
+        return false;
+    }
+
+    // Get buffer view
+    auto * gltfBufferView = gltfAsset.bufferView(gltfAccessor->bufferView());
+    if (!gltfBufferView) return false;
+
+    // Get data
+    unsigned int numComponents = componentCount(gltfAccessor->dataType());
+    unsigned int count         = gltfAccessor->count();
+    unsigned int stride        = gltfBufferView->stride() > 0 ? gltfBufferView->stride() : numComponents * sizeof(float);
+    unsigned int size          = (count - 1) * stride + numComponents * sizeof(float);
+    if (gltfAccessor->offset() > gltfBufferView->size() || size > gltfBufferView->size() - gltfAccessor->offset()) return false;
+
+    auto data = bufferData(gltfBufferView->buffer(), gltfBufferView->offset() + gltfAccessor->offset(), size);
+    if (!data) return false;
+
+    // Choose compact format
+    QuantizedAttribute quantized;
+    quantized.buffer         = nullptr;
+    quantized.normalize      = true;
+    quantized.dequantization = glm::mat4(1.0f);
+
+    auto buffer = cppassist::make_unique<opengl::Buffer>();
+
+    if (name == "POSITION" && numComponents == 3) {
+        // Positions: 16 bit integers relative to the bounding box
+        buffer->setData(rendercore::VertexQuantizer::quantizePositions(data.get(), count, stride, quantized.dequantization));
+        quantized.type       = (unsigned int)gl::GL_UNSIGNED_SHORT;
+        quantized.components = 3;
+        quantized.stride     = 4 * sizeof(unsigned short);
+    } else if ((name == "NORMAL" && numComponents == 3) || (name == "TANGENT" && numComponents == 4)) {
+        // Normals and tangents: 10:10:10:2 integers (packed formats always have four components)
+        buffer->setData(rendercore::VertexQuantizer::packSnorm10(data.get(), count, stride, numComponents));
+        quantized.type       = (unsigned int)gl::GL_INT_2_10_10_10_REV;
+        quantized.components = 4;
+        quantized.stride     = sizeof(unsigned int);
+    } else if (name.compare(0, 9, "TEXCOORD_") == 0 && numComponents == 2) {
+        // Get range of texture coordinates
+        glm::vec4 minValue, maxValue;
+        rendercore::VertexQuantizer::bounds(data.get(), count, stride, 2, minValue, maxValue);
+
+        // Texture coordinates in [0, 1]: 16 bit integers
+        if (minValue.x >= 0.0f && minValue.y >= 0.0f && maxValue.x <= 1.0f && maxValue.y <= 1.0f) {
+            buffer->setData(rendercore::VertexQuantizer::packUnorm16(data.get(), count, stride));
+            quantized.type = (unsigned int)gl::GL_UNSIGNED_SHORT;
+        }
+
+        // Texture coordinates in [-2, 2]: half floats (precision of at least 1/1024)
+        else if (minValue.x >= -2.0f && minValue.y >= -2.0f && maxValue.x <= 2.0f && maxValue.y <= 2.0f) {
+            buffer->setData(rendercore::VertexQuantizer::packHalf(data.get(), count, stride));
+            quantized.type      = (unsigned int)gl::GL_HALF_FLOAT;
+            quantized.normalize = false;
+        }
+
+        // Keep repeating texture coordinates as floats
+        else return false;
+
+        quantized.components = 2;
+        quantized.stride     = 2 * sizeof(unsigned short);
+    } else {
+        return false;
+    }
+
+    // Save quantized attribute
+    quantized.buffer = buffer.get();
+    m_quantizedAttributes[accessorIndex] = quantized;
+    m_buffers.push_back(std::move(buffer));
+
+    originalSize  += count * numComponents * sizeof(float);
+    quantizedSize += count * quantized.stride;
+
+    return true;
+}
+
+rendercore::opengl::Texture * GltfConverter::loadTexture(const Asset & gltfAsset, int textureInfoIndex)
+{
+    // Check texture index
+    if (textureInfoIndex < 0 || textureInfoIndex >= (int)gltfAsset.textureInfos().size()) {
+        return nullptr;
+    }
+
+    // Get texture info
+    auto * gltfTextureInfo = gltfAsset.textureInfo(textureInfoIndex);
+    if (!gltfTextureInfo) return nullptr;
+
+    // Get texture
+    auto * gltfTexture = gltfAsset.texture(gltfTextureInfo->texture());
+    if (!gltfTexture) return nullptr;
+
+    // Get image
+    int imageIndex = gltfTexture->image();
+    auto * gltfImage = gltfAsset.image(imageIndex);
+    if (!gltfImage) return nullptr;
+
+    // Textures are shared by all references to the same image
+    auto it = m_imageTextures.find(imageIndex);
+    if (it != m_imageTextures.end()) {
+        return it->second;
+    }
+
+    auto sharedIt = m_sharedTextures.find(imageIndex);
+    if (sharedIt != m_sharedTextures.end()) {
+        return sharedIt->second;
+    }
+
+    // Get path of image file
+    std::string path;
+    if (gltfImage->uri() != "" && gltfImage->uri().compare(0, 5, "data:") != 0) {
+        path = gltfAsset.basePath() + gltfImage->uri();
+    }
+
+    // Use existing texture for the image file
+    if (!path.empty() && m_textureLookup) {
+        auto * sharedTexture = m_textureLookup(path);
+        if (sharedTexture) {
+            m_sharedTextures[imageIndex] = sharedTexture;
+            return sharedTexture;
+        }
+    }
+
+    // Create texture
+    auto texture = cppassist::make_unique<rendercore::opengl::Texture>();
+    auto * texturePtr = texture.get();
+
+    // Save texture
+    m_imageTextures[imageIndex] = texturePtr;
+    m_textures.push_back(std::move(texture));
+    m_texturePaths.push_back(path);
 
     // Return texture
     return texturePtr;
 }
 
-void GltfConverter::loadData(const std::string & basePath, const std::string & filename)
+std::unique_ptr<rendercore::Image> GltfConverter::loadImage(const Asset & gltfAsset, int imageIndex) const
+{
+    // Get image
+    auto * gltfImage = gltfAsset.image(imageIndex);
+    if (!gltfImage) return nullptr;
+
+    ImageLoader loader;
+
+    if (gltfImage->uri().compare(0, 5, "data:") == 0) {
+        // Decode embedded data
+        unsigned int size = 0;
+        auto data = decodeDataUri(gltfImage->uri(), size);
+        if (data) {
+            return loader.loadFromMemory(data.get(), size);
+        }
+    } else if (gltfImage->uri() != "") {
+        // Load from file
+        return loader.load(gltfAsset.basePath() + gltfImage->uri());
+    } else if (gltfImage->bufferView() > -1) {
+        // Get buffer view
+        auto * gtlfBufferView = gltfAsset.bufferView(gltfImage->bufferView());
+        if (gtlfBufferView) {
+            // Get data
+            auto data = bufferData(gtlfBufferView->buffer(), gtlfBufferView->offset(), gtlfBufferView->size());
+            if (data) {
+                return loader.loadFromMemory(data.get(), gtlfBufferView->size());
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+rendercore::opengl::Sampler * GltfConverter::loadSampler(const Asset & gltfAsset, int textureInfoIndex)
+{
+    // Get texture
+    auto * gltfTextureInfo = gltfAsset.textureInfo(textureInfoIndex);
+    if (!gltfTextureInfo) return nullptr;
+
+    auto * gltfTexture = gltfAsset.texture(gltfTextureInfo->texture());
+    if (!gltfTexture) return nullptr;
+
+    // Get sampler (use default sampler if none is specified)
+    auto * gltfSampler = gltfAsset.sampler(gltfTexture->sampler());
+    int samplerIndex = gltfSampler ? gltfTexture->sampler() : -1;
+
+    // Samplers are shared by all textures that use them
+    auto it = m_samplerObjects.find(samplerIndex);
+    if (it != m_samplerObjects.end()) {
+        return it->second;
+    }
+
+    // Create sampler
+    auto sampler = cppassist::make_unique<rendercore::opengl::Sampler>();
+    auto * samplerPtr = sampler.get();
+
+    // Set sampler options
+    Sampler defaultSampler;
+    if (!gltfSampler) {
+        gltfSampler = &defaultSampler;
+    }
+
+    sampler->setMinFilter((gl::GLenum)gltfSampler->minFilter());
+    sampler->setMagFilter((gl::GLenum)gltfSampler->magFilter());
+    sampler->setWrapS((gl::GLenum)gltfSampler->wrapS());
+    sampler->setWrapT((gl::GLenum)gltfSampler->wrapT());
+
+    // Save sampler
+    m_samplerObjects[samplerIndex] = samplerPtr;
+    m_samplers.push_back(std::move(sampler));
+
+    // Return sampler
+    return samplerPtr;
+}
+
+void GltfConverter::setMaterialTexture(const Asset & gltfAsset, rendercore::opengl::Material & material, const std::string & name, int textureInfoIndex)
+{
+    // Get texture and sampler
+    auto * texture = loadTexture(gltfAsset, textureInfoIndex);
+    auto * sampler = texture ? loadSampler(gltfAsset, textureInfoIndex) : nullptr;
+
+    // Make sure that the texture provides mipmaps if any sampler needs them
+    if (texture && sampler) {
+        auto filter = sampler->minFilter();
+        if (filter == gl::GL_NEAREST_MIPMAP_NEAREST || filter == gl::GL_LINEAR_MIPMAP_NEAREST ||
+            filter == gl::GL_NEAREST_MIPMAP_LINEAR  || filter == gl::GL_LINEAR_MIPMAP_LINEAR)
+        {
+            texture->setMinFilter(filter);
+        }
+    }
+
+    // Set texture and sampler
+    material.setTexture(name, texture);
+    material.setSampler(name, sampler);
+}
+
+std::vector<bool> GltfConverter::writableBuffers(const Asset & asset) const
 {
-    // [TODO] Check if filename contains BASE64-encoded data
+    std::vector<bool> writable(asset.buffers().size(), false);
+
+    // Buffers that receive decompressed buffer views
+    for (auto * gltfBufferView : asset.bufferViews()) {
+        if (gltfBufferView->isCompressed() && gltfBufferView->buffer() < writable.size()) {
+            writable[gltfBufferView->buffer()] = true;
+        }
+    }
+
+    // Buffers with geometry that is optimized or reordered into meshlets in place
+    if (!m_geometryOptimization && m_meshletThreshold == 0) {
+        return writable;
+    }
+
+    auto markAccessor = [&asset, &writable] (int accessorIndex)
+    {
+        auto * gltfAccessor = accessorIndex >= 0 ? asset.accessor(accessorIndex) : nullptr;
+        if (!gltfAccessor || gltfAccessor->bufferView() < 0) return;
+
+        auto * gltfBufferView = asset.bufferView(gltfAccessor->bufferView());
+        if (gltfBufferView && gltfBufferView->buffer() < writable.size()) {
+            writable[gltfBufferView->buffer()] = true;
+        }
+    };
+
+    for (auto * gltfMesh : asset.meshes()) {
+        for (auto * gltfPrimitive : gltfMesh->primitives()) {
+            for (auto & it : gltfPrimitive->attributes()) {
+                markAccessor(static_cast<int>(it.second));
+            }
 
-    // Create data
-    auto data = cppassist::make_unique< std::vector<char> >();
+            markAccessor(gltfPrimitive->indices());
+        }
+    }
 
-    // Open file
-    auto f = fs::open(basePath + filename);
-    if (f.exists()) {
-        // Create input stream
-        auto inputStream = f.createInputStream(std::ios::binary);
-        if (inputStream && !inputStream->eof()) {
-            // Allocate data
-            data->resize(f.size());
+    return writable;
+}
 
-            // Read data
-            inputStream->read(data->data(), f.size());
+void GltfConverter::loadData(const Asset & asset, unsigned int bufferIndex, bool writable)
+{
+    BufferData data;
+    data.size = 0;
+
+    // Get buffer
+    auto * gltfBuffer = asset.buffer(bufferIndex);
+    bool mapped = false;
+    if (gltfBuffer) {
+        if (gltfBuffer->isFallback() || (writable && gltfBuffer->uri().empty() && bufferIndex != 0)) {
+            // Allocate storage for decompressed data
+            data.size = static_cast<unsigned int>(std::max(gltfBuffer->size(), 0));
+            data.data = std::shared_ptr<char>(new char[data.size > 0 ? data.size : 1](), std::default_delete<char[]>());
+        } else if (gltfBuffer->uri().empty()) {
+            // Use BIN chunk of binary GLTF file
+            if (bufferIndex == 0) {
+                data.data = asset.binaryChunk();
+                data.size = asset.binaryChunkSize();
+                mapped    = true;
+            }
+        } else if (gltfBuffer->uri().compare(0, 5, "data:") == 0) {
+            // Decode embedded data
+            data.data = decodeDataUri(gltfBuffer->uri(), data.size);
+        } else {
+            // Map file
+            auto file = std::make_shared<MappedFile>();
+            if (file->open(asset.basePath() + gltfBuffer->uri())) {
+                data.data = std::shared_ptr<char>(file, file->data());
+                data.size = static_cast<unsigned int>(file->size());
+                mapped    = true;
+            }
         }
     }
 
+    // Copy mapped data that is modified (the asset must not be changed)
+    if (writable && mapped && data.data) {
+        std::shared_ptr<char> copy(new char[data.size > 0 ? data.size : 1], std::default_delete<char[]>());
+        std::memcpy(copy.get(), data.data.get(), data.size);
+        data.data = copy;
+    }
+
     // Save data
-    m_data.push_back(std::move(data));
+    m_data[bufferIndex] = data;
+}
+
+void GltfConverter::decompress(const Asset & gltfAsset, WorkerPool & pool)
+{
+    decompress(gltfAsset, pool, std::vector<bool>(gltfAsset.bufferViews().size(), true), true);
+}
+
+void GltfConverter::decompress(const Asset & gltfAsset, WorkerPool & pool, const std::vector<bool> & bufferViews, bool primitives)
+{
+    // Decompress selected buffer views in place
+    auto gltfBufferViews = gltfAsset.bufferViews();
+    std::vector<char> succeeded(gltfBufferViews.size(), 0);
+    for (size_t i=0; i<gltfBufferViews.size(); i++) {
+        if (!gltfBufferViews[i]->isCompressed() || i >= bufferViews.size() || !bufferViews[i]) continue;
+
+        const BufferView * gltfBufferView = gltfBufferViews[i];
+        pool.run([this, &gltfAsset, gltfBufferView, &succeeded, i] () {
+            succeeded[i] = decompressBufferView(gltfAsset, *gltfBufferView) ? 1 : 0;
+        });
+    }
+
+    // Decompress Draco compressed primitives
+    struct DecodedPrimitive
+    {
+        const Primitive *                            primitive;
+        std::map<unsigned int, std::vector<float> >  attributes;
+        std::vector<unsigned int>                    indices;
+        bool                                         succeeded;
+    };
+
+    std::vector<DecodedPrimitive> decodedPrimitives;
+    for (auto * gltfMesh : gltfAsset.meshes()) {
+        for (auto * gltfPrimitive : gltfMesh->primitives()) {
+            if (!primitives || gltfPrimitive->dracoBufferView() < 0) continue;
+
+            decodedPrimitives.push_back(DecodedPrimitive());
+            decodedPrimitives.back().primitive = gltfPrimitive;
+            decodedPrimitives.back().succeeded = false;
+        }
+    }
+
+    for (auto & decoded : decodedPrimitives) {
+        DecodedPrimitive * result = &decoded;
+        pool.run([this, &gltfAsset, result] () {
+            result->succeeded = decompressPrimitive(gltfAsset, *result->primitive, result->attributes, result->indices);
+        });
+    }
+
+    pool.wait();
+
+    // Report buffer views
+    unsigned int compressedSize   = 0;
+    unsigned int decompressedSize = 0;
+    unsigned int decompressed     = 0;
+
+    for (size_t i=0; i<gltfBufferViews.size(); i++) {
+        if (!gltfBufferViews[i]->isCompressed() || i >= bufferViews.size() || !bufferViews[i]) continue;
+
+        if (!succeeded[i]) {
+            cppassist::warning("rendercore-gltf") << "Failed to decompress buffer view " << i;
+            continue;
+        }
+
+        const BufferView::Compression & compression = gltfBufferViews[i]->compression();
+        compressedSize   += compression.size;
+        decompressedSize += compression.count * compression.stride;
+        decompressed++;
+    }
+
+    if (decompressed > 0) {
+        cppassist::info("rendercore-gltf") << "Decompressed " << decompressed << " buffer views: "
+                                           << compressedSize << " -> " << decompressedSize << " bytes";
+    }
+
+    // Save decoded primitives
+    for (auto & decoded : decodedPrimitives) {
+        if (!decoded.succeeded) {
+            cppassist::warning("rendercore-gltf") << "Failed to decompress Draco compressed primitive";
+            continue;
+        }
+
+        for (auto & it : decoded.attributes) {
+            m_decodedAttributes[it.first] = std::move(it.second);
+        }
+
+        if (decoded.primitive->indices() >= 0) {
+            m_decodedIndices[decoded.primitive->indices()] = std::move(decoded.indices);
+        }
+    }
+}
+
+bool GltfConverter::decompressBufferView(const Asset &, const BufferView & gltfBufferView)
+{
+    const BufferView::Compression & compression = gltfBufferView.compression();
+
+    // Get compressed data
+    auto data = bufferData(compression.buffer, compression.offset, compression.size);
+    if (!data) return false;
+
+    // Get range of the buffer view, which receives the decompressed data
+    const unsigned long long size = static_cast<unsigned long long>(compression.count) * compression.stride;
+    if (size > gltfBufferView.size()) return false;
+
+    auto destination = bufferData(gltfBufferView.buffer(), gltfBufferView.offset(), static_cast<unsigned int>(size));
+    if (!destination) return false;
+
+    // Decode vertex attributes
+    if (compression.mode == "ATTRIBUTES") {
+        if (!MeshoptDecoder::decodeVertexBuffer(destination.get(), compression.count, compression.stride, data.get(), compression.size)) return false;
+
+        // Apply filter
+             if (compression.filter == "OCTAHEDRAL")  MeshoptDecoder::filterOctahedral (destination.get(), compression.count, compression.stride);
+        else if (compression.filter == "QUATERNION")  MeshoptDecoder::filterQuaternion (destination.get(), compression.count, compression.stride);
+        else if (compression.filter == "EXPONENTIAL") MeshoptDecoder::filterExponential(destination.get(), compression.count, compression.stride);
+
+        return true;
+    }
+
+    // Decode triangle indices
+    if (compression.mode == "TRIANGLES") {
+        return MeshoptDecoder::decodeIndexBuffer(destination.get(), compression.count, compression.stride, data.get(), compression.size);
+    }
+
+    // Decode index sequence
+    if (compression.mode == "INDICES") {
+        return MeshoptDecoder::decodeIndexSequence(destination.get(), compression.count, compression.stride, data.get(), compression.size);
+    }
+
+    // Unknown mode
+    return false;
+}
+
+#ifdef RENDERCORE_GLTF_DRACO
+
+bool GltfConverter::decompressPrimitive(const Asset & gltfAsset, const Primitive & gltfPrimitive, std::map<unsigned int, std::vector<float> > & attributes, std::vector<unsigned int> & indices) const
+{
+    // Get compressed data
+    auto * gltfBufferView = gltfAsset.bufferView(gltfPrimitive.dracoBufferView());
+    if (!gltfBufferView) return false;
+
+    auto data = bufferData(gltfBufferView->buffer(), gltfBufferView->offset(), gltfBufferView->size());
+    if (!data) return false;
+
+    // Decode mesh
+    draco::DecoderBuffer buffer;
+    buffer.Init(data.get(), gltfBufferView->size());
+
+    draco::Decoder decoder;
+    auto result = decoder.DecodeMeshFromBuffer(&buffer);
+    if (!result.ok()) return false;
+
+    std::unique_ptr<draco::Mesh> dracoMesh = std::move(result).value();
+    const unsigned int vertexCount = dracoMesh->num_points();
+
+    // Convert vertex attributes into the components of their accessors
+    const auto gltfAttributes = gltfPrimitive.attributes();
+    for (auto & it : gltfPrimitive.dracoAttributes()) {
+        auto attributeIt = gltfAttributes.find(it.first);
+        if (attributeIt == gltfAttributes.end()) continue;
+
+        auto * gltfAccessor = gltfAsset.accessor(attributeIt->second);
+        const draco::PointAttribute * dracoAttribute = dracoMesh->GetAttributeByUniqueId(it.second);
+        if (!gltfAccessor || !dracoAttribute || gltfAccessor->count() != vertexCount) return false;
+
+        const unsigned int components = componentCount(gltfAccessor->dataType());
+        std::vector<float> & values = attributes[attributeIt->second];
+        values.resize(vertexCount * components);
+
+        for (draco::PointIndex i(0); i < vertexCount; ++i) {
+            if (!dracoAttribute->ConvertValue<float>(dracoAttribute->mapped_index(i), static_cast<int8_t>(components), &values[i.value() * components])) return false;
+        }
+    }
+
+    // Convert faces into indices
+    auto * gltfIndexAccessor = gltfAsset.accessor(gltfPrimitive.indices());
+    if (gltfIndexAccessor) {
+        if (gltfIndexAccessor->count() != dracoMesh->num_faces() * 3) return false;
+
+        indices.resize(dracoMesh->num_faces() * 3);
+        for (draco::FaceIndex f(0); f < dracoMesh->num_faces(); ++f) {
+            const draco::Mesh::Face & face = dracoMesh->face(f);
+            for (int c=0; c<3; c++) {
+                indices[f.value() * 3 + c] = face[c].value();
+            }
+        }
+    }
+
+    return true;
+}
+
+#else
+
+bool GltfConverter::decompressPrimitive(const Asset &, const Primitive &, std::map<unsigned int, std::vector<float> > &, std::vector<unsigned int> &) const
+{
+    // Draco is not available
+    cppassist::warning("rendercore-gltf") << "Draco compression is not supported (enable OPTION_DRACO)";
+    return false;
+}
+
+#endif
+
+std::shared_ptr<char> GltfConverter::bufferData(unsigned int bufferIndex, unsigned int offset, unsigned int size) const
+{
+    // Check buffer
+    if (bufferIndex >= m_data.size() || !m_data[bufferIndex].data) {
+        return nullptr;
+    }
+
+    // Check range
+    const auto & data = m_data[bufferIndex];
+    if (offset > data.size || size > data.size - offset) {
+        return nullptr;
+    }
+
+    // Return pointer into buffer, sharing its ownership
+    return std::shared_ptr<char>(data.data, data.data.get() + offset);
+}
+
+bool GltfConverter::readFloats(const Asset & gltfAsset, unsigned int accessorIndex, std::vector<float> & values, unsigned int & components) const
+{
+    // Get accessor
+    auto * gltfAccessor = gltfAsset.accessor(accessorIndex);
+    if (!gltfAccessor) return false;
+
+    // Use decoded data of Draco compressed primitives
+    auto decodedIt = m_decodedAttributes.find(accessorIndex);
+    if (decodedIt != m_decodedAttributes.end()) {
+        components = componentCount(gltfAccessor->dataType());
+        values     = decodedIt->second;
+        return !values.empty();
+    }
+
+    // Only floats and normalized integers can be read
+    const unsigned int type = gltfAccessor->componentType();
+    if (type != (unsigned int)gl::GL_FLOAT && !(gltfAccessor->normalized() && componentSize(type) <= 2)) return false;
+
+    const unsigned int count       = gltfAccessor->count();
+    components                     = componentCount(gltfAccessor->dataType());
+    const unsigned int elementSize = componentSize(type) * components;
+    if (count == 0) return false;
+
+    // Accessors without buffer view are initialized with zeros
+    values.assign(count * components, 0.0f);
+
+    if (gltfAccessor->bufferView() >= 0) {
+        auto * gltfBufferView = gltfAsset.bufferView(gltfAccessor->bufferView());
+        if (!gltfBufferView) return false;
+
+        const unsigned int stride = gltfBufferView->stride() > 0 ? gltfBufferView->stride() : elementSize;
+
+        // Get data
+        auto data = bufferData(gltfBufferView->buffer(), gltfBufferView->offset() + gltfAccessor->offset(), (count - 1) * stride + elementSize);
+        if (!data) return false;
+
+        // Convert components
+        for (unsigned int i=0; i<count; i++) {
+            if (!convertComponents(data.get() + i * stride, type, components, &values[i * components])) return false;
+        }
+    }
+
+    // Replace sparse elements
+    if (gltfAccessor->isSparse()) {
+        std::vector<unsigned int> indices;
+        std::vector<float>        sparseValues;
+        if (!readSparse(gltfAsset, *gltfAccessor, indices, sparseValues)) return false;
+
+        for (size_t i=0; i<indices.size(); i++) {
+            std::copy(&sparseValues[i * components], &sparseValues[i * components] + components, &values[indices[i] * components]);
+        }
+    }
+
+    return true;
+}
+
+bool GltfConverter::readBounds(const Asset & gltfAsset, unsigned int accessorIndex, glm::vec3 & min, glm::vec3 & max) const
+{
+    // Get accessor
+    auto * gltfAccessor = gltfAsset.accessor(accessorIndex);
+    if (!gltfAccessor || componentCount(gltfAccessor->dataType()) != 3) return false;
+
+    // Use bounds of the accessor (given in the stored type, also for normalized integers)
+    auto minValue = gltfAccessor->minValue();
+    auto maxValue = gltfAccessor->maxValue();
+
+    if (minValue.size() == 3 && maxValue.size() == 3) {
+        const unsigned int type = gltfAccessor->normalized() ? gltfAccessor->componentType() : (unsigned int)gl::GL_FLOAT;
+
+        for (int c=0; c<3; c++) {
+            min[c] = normalizeComponent(minValue[c], type);
+            max[c] = normalizeComponent(maxValue[c], type);
+        }
+
+        return true;
+    }
+
+    // Scan positions
+    std::vector<float> values;
+    unsigned int       components = 0;
+    if (!readFloats(gltfAsset, accessorIndex, values, components) || components != 3) return false;
+
+    scanBounds(values.data(), values.size() / 3, min, max);
+    return min.x <= max.x;
+}
+
+bool GltfConverter::readPrimitiveIndices(const Asset & gltfAsset, int accessorIndex, std::vector<unsigned int> & indices) const
+{
+    // Use decoded indices of a Draco compressed primitive
+    auto decodedIt = m_decodedIndices.find(accessorIndex);
+    if (decodedIt != m_decodedIndices.end()) {
+        indices = decodedIt->second;
+        return true;
+    }
+
+    // Get accessor
+    auto * gltfAccessor = gltfAsset.accessor(accessorIndex);
+    if (!gltfAccessor) return false;
+
+    auto * gltfBufferView = gltfAsset.bufferView(gltfAccessor->bufferView());
+    if (!gltfBufferView) return false;
+
+    const unsigned int indexType = gltfAccessor->componentType();
+    const unsigned int indexSize = componentSize(indexType);
+    const unsigned int count     = gltfAccessor->count();
+    if (indexType != (unsigned int)gl::GL_UNSIGNED_BYTE && indexType != (unsigned int)gl::GL_UNSIGNED_SHORT && indexType != (unsigned int)gl::GL_UNSIGNED_INT) return false;
+
+    const unsigned int size = count * indexSize;
+    if (gltfAccessor->offset() > gltfBufferView->size() || size > gltfBufferView->size() - gltfAccessor->offset()) return false;
+
+    // Read indices
+    auto data = bufferData(gltfBufferView->buffer(), gltfBufferView->offset() + gltfAccessor->offset(), size);
+    if (!data) return false;
+
+    return readIndices(data.get(), indexSize, count, restartIndex, indices);
+}
+
+bool GltfConverter::readSparse(const Asset & gltfAsset, const Accessor & gltfAccessor, std::vector<unsigned int> & indices, std::vector<float> & values) const
+{
+    const Accessor::Sparse & sparse = gltfAccessor.sparse();
+
+    // Get buffer views
+    auto * gltfIndexView = gltfAsset.bufferView(sparse.indicesBufferView);
+    auto * gltfValueView = gltfAsset.bufferView(sparse.valuesBufferView);
+    if (!gltfAccessor.isSparse() || !gltfIndexView || !gltfValueView || sparse.count == 0) return false;
+
+    const unsigned int indexType   = sparse.indicesComponentType;
+    const unsigned int indexSize   = componentSize(indexType);
+    const unsigned int type        = gltfAccessor.componentType();
+    const unsigned int components  = componentCount(gltfAccessor.dataType());
+    const unsigned int elementSize = componentSize(type) * components;
+    if (indexType != (unsigned int)gl::GL_UNSIGNED_BYTE && indexType != (unsigned int)gl::GL_UNSIGNED_SHORT && indexType != (unsigned int)gl::GL_UNSIGNED_INT) return false;
+    if (type != (unsigned int)gl::GL_FLOAT && !(gltfAccessor.normalized() && componentSize(type) <= 2)) return false;
+
+    // Read indices
+    auto indexData = bufferData(gltfIndexView->buffer(), gltfIndexView->offset() + sparse.indicesOffset, sparse.count * indexSize);
+    if (!indexData || !readIndices(indexData.get(), indexSize, sparse.count, gltfAccessor.count(), indices)) return false;
+
+    // Read values (sparse values are always tightly packed)
+    auto valueData = bufferData(gltfValueView->buffer(), gltfValueView->offset() + sparse.valuesOffset, sparse.count * elementSize);
+    if (!valueData) return false;
+
+    values.resize(sparse.count * components);
+    for (unsigned int i=0; i<sparse.count; i++) {
+        if (!convertComponents(valueData.get() + i * elementSize, type, components, &values[i * components])) return false;
+    }
+
+    return true;
+}
+
+bool GltfConverter::readDisplacements(const Asset & gltfAsset, unsigned int accessorIndex, std::vector<unsigned int> & vertices, std::vector<glm::vec3> & displacements) const
+{
+    vertices.clear();
+    displacements.clear();
+
+    // Get accessor
+    auto * gltfAccessor = gltfAsset.accessor(accessorIndex);
+    if (!gltfAccessor || componentCount(gltfAccessor->dataType()) != 3) return false;
+
+    // Sparse accessor without buffer view: use the sparse elements directly (if sorted, as required by the specification)
+    std::vector<float> values;
+
+    if (gltfAccessor->isSparse() && gltfAccessor->bufferView() < 0 &&
+        readSparse(gltfAsset, *gltfAccessor, vertices, values) && std::is_sorted(vertices.begin(), vertices.end()))
+    {
+        displacements.resize(vertices.size());
+        for (size_t i=0; i<vertices.size(); i++) {
+            displacements[i] = glm::vec3(values[i * 3], values[i * 3 + 1], values[i * 3 + 2]);
+        }
+
+        return true;
+    }
+
+    // Otherwise read all elements and keep only the displaced vertices
+    vertices.clear();
+
+    unsigned int components = 0;
+    if (!readFloats(gltfAsset, accessorIndex, values, components)) return false;
+
+    for (unsigned int i=0; i<gltfAccessor->count(); i++) {
+        const glm::vec3 displacement(values[i * 3], values[i * 3 + 1], values[i * 3 + 2]);
+
+        if (displacement != glm::vec3(0.0f)) {
+            vertices.push_back(i);
+            displacements.push_back(displacement);
+        }
+    }
+
+    return true;
+}
+
+std::shared_ptr<char> GltfConverter::decodeDataUri(const std::string & uri, unsigned int & size)
+{
+    size = 0;
+
+    // Find beginning of data
+    auto pos = uri.find(',');
+    if (uri.compare(0, 5, "data:") != 0 || pos == std::string::npos) {
+        return nullptr;
+    }
+
+    // Only base64 encoding is supported
+    static const std::string encoding = ";base64";
+    if (pos < 5 + encoding.size() || uri.compare(pos - encoding.size(), encoding.size(), encoding) != 0) {
+        return nullptr;
+    }
+
+    // Allocate buffer
+    const char * encoded = uri.data() + pos + 1;
+    size_t encodedSize = uri.size() - pos - 1;
+    size_t decodedSize = Base64::decodedSize(encoded, encodedSize);
+
+    std::shared_ptr<char> data(new char[decodedSize > 0 ? decodedSize : 1], std::default_delete<char[]>());
+
+    // Decode data directly into the buffer
+    if (!Base64::decode(encoded, encodedSize, data.get())) {
+        return nullptr;
+    }
+
+    // Return data
+    size = static_cast<unsigned int>(decodedSize);
+    return data;
 }
 
 
@@ -2,17 +2,42 @@
 #include <rendercore-gltf/GltfLoader.h>
 
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 
+#include <cppassist/logging/logging.h>
 #include <cppassist/memory/make_unique.h>
 
 #include <cppfs/FilePath.h>
 
-#include <cppexpose/JSON.h>
-#include <cppexpose/Object.h>
+#include <rendercore/MappedFile.h>
+
+#include <rendercore-gltf/JsonReader.h>
 
 
 using namespace cppfs;
-using namespace cppexpose;
+
+
+namespace
+{
+
+
+// Binary GLTF magic numbers
+const uint32_t glbMagic     = 0x46546C67; // 'glTF'
+const uint32_t glbChunkJson = 0x4E4F534A; // 'JSON'
+const uint32_t glbChunkBin  = 0x004E4942; // 'BIN\0'
+
+uint32_t readUInt32(const char * data)
+{
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+
+} // namespace
 
 
 namespace rendercore
@@ -31,21 +56,109 @@ GltfLoader::~GltfLoader()
 
 std::unique_ptr<Asset> GltfLoader::load(const std::string & path)
 {
-    Object root;
-
     // Load GLTF file
-    if (!JSON::load(root, path)) {
-        return false;
+    auto file = std::make_shared<MappedFile>();
+    if (!file->open(path)) {
+        return nullptr;
+    }
+
+    // Get JSON document and binary data
+    const char *          json       = file->data();
+    size_t                jsonSize   = file->size();
+    std::shared_ptr<char> binary;
+    unsigned int          binarySize = 0;
+
+    if (file->size() >= 4 && readUInt32(file->data()) == glbMagic) {
+        if (!readBinaryChunks(file, json, jsonSize, binary, binarySize)) {
+            cppassist::warning("rendercore-gltf") << "Invalid binary GLTF file " << path;
+            return nullptr;
+        }
     }
 
     // Get base directory
     std::string basePath = FilePath(path).directoryPath();
 
     // Parse file
-    return parseFile(root, basePath);
+    auto start = std::chrono::steady_clock::now();
+
+    JsonReader reader(json, jsonSize);
+    auto asset = parseFile(reader, basePath);
+
+    auto end = std::chrono::steady_clock::now();
+
+    // Check for syntax errors
+    if (reader.error()) {
+        cppassist::warning("rendercore-gltf") << "JSON syntax error in " << path << " at offset " << reader.position();
+        return nullptr;
+    }
+
+    // Reference embedded binary data
+    if (asset) {
+        asset->setBinaryChunk(binary, binarySize);
+    }
+
+    // Report parse throughput
+    double seconds   = std::chrono::duration<double>(end - start).count();
+    double megabytes = static_cast<double>(jsonSize) / (1024.0 * 1024.0);
+    cppassist::info("rendercore-gltf") << "Parsed " << path << " (" << megabytes << " MB) in " << seconds * 1000.0 << " ms, "
+                                       << (seconds > 0.0 ? megabytes / seconds : 0.0) << " MB/s";
+
+    // Return asset
+    return asset;
+}
+
+bool GltfLoader::readBinaryChunks(const std::shared_ptr<MappedFile> & file, const char *& json, size_t & jsonSize, std::shared_ptr<char> & binary, unsigned int & binarySize)
+{
+    char * data = file->data();
+    size_t size = file->size();
+
+    // Check header (magic, version, length)
+    if (size < 12 || readUInt32(data) != glbMagic || readUInt32(data + 4) != 2) {
+        return false;
+    }
+
+    size = std::min(size, static_cast<size_t>(readUInt32(data + 8)));
+
+    // Read chunks
+    json     = nullptr;
+    jsonSize = 0;
+
+    size_t offset = 12;
+    while (offset + 8 <= size) {
+        // Get chunk header
+        uint32_t chunkSize = readUInt32(data + offset);
+        uint32_t chunkType = readUInt32(data + offset + 4);
+        offset += 8;
+
+        if (chunkSize > size - offset) {
+            return false;
+        }
+
+        // The first chunk contains the JSON document
+        if (!json) {
+            if (chunkType != glbChunkJson) {
+                return false;
+            }
+
+            json     = data + offset;
+            jsonSize = chunkSize;
+        }
+
+        // Reference the (first) BIN chunk in place
+        else if (chunkType == glbChunkBin && !binary) {
+            binary     = std::shared_ptr<char>(file, data + offset);
+            binarySize = chunkSize;
+        }
+
+        // Chunks are aligned to 4 bytes
+        offset += (chunkSize + 3) & ~3u;
+    }
+
+    // Done
+    return json != nullptr;
 }
 
-std::unique_ptr<Asset> GltfLoader::parseFile(const cppexpose::Object & root, const std::string & basePath)
+std::unique_ptr<Asset> GltfLoader::parseFile(JsonReader & reader, const std::string & basePath)
 {
     bool res = true;
 
@@ -53,262 +166,330 @@ std::unique_ptr<Asset> GltfLoader::parseFile(const cppexpose::Object & root, con
     std::unique_ptr<Asset> asset = cppassist::make_unique<Asset>();
     asset->setBasePath(basePath);
 
-    // Get object properties
-    const auto & properties = root.properties();
-
-    // Check if mandatory data is present
-    if (!root.propertyExists("asset")) {
-        // Error, 'asset' is mandatory
+    // Root must be an object
+    if (!reader.beginObject()) {
         return nullptr;
     }
 
     // Parse properties
-    for (auto it : properties) {
-        // Get name and value
-        std::string key = it.first;
-        auto * value    = it.second;
-
+    bool hasAsset = false;
+    std::string key;
+    while (reader.nextKey(key)) {
         // Parse element
         if (key == "asset") {
-            res &= parseAsset(*asset.get(), value);
+            res &= parseAsset(*asset.get(), reader);
+            hasAsset = true;
         } else if (key == "scene") {
-            res &= parseDefaultScene(*asset.get(), value);
+            res &= parseDefaultScene(*asset.get(), reader);
         } else if (key == "scenes") {
-            res &= parseScenes(*asset.get(), value);
+            res &= parseScenes(*asset.get(), reader);
         } else if (key == "nodes") {
-            res &= parseNodes(*asset.get(), value);
+            res &= parseNodes(*asset.get(), reader);
         } else if (key == "meshes") {
-            res &= parseMeshes(*asset.get(), value);
+            res &= parseMeshes(*asset.get(), reader);
         } else if (key == "animations") {
-            // [TODO]
-            // res &= parseAnimations(*asset.get(), value);
+            res &= parseAnimations(*asset.get(), reader);
+        } else if (key == "skins") {
+            res &= parseSkins(*asset.get(), reader);
         } else if (key == "accessors") {
-            res &= parseAccessors(*asset.get(), value);
+            res &= parseAccessors(*asset.get(), reader);
         } else if (key == "materials") {
-            res &= parseMaterials(*asset.get(), value);
+            res &= parseMaterials(*asset.get(), reader);
         } else if (key == "buffers") {
-            res &= parseBuffers(*asset.get(), value);
+            res &= parseBuffers(*asset.get(), reader);
         } else if (key == "bufferViews") {
-            res &= parseBufferViews(*asset.get(), value);
+            res &= parseBufferViews(*asset.get(), reader);
         } else if (key == "textures") {
-            res &= parseTextures(*asset.get(), value);
+            res &= parseTextures(*asset.get(), reader);
         } else if (key == "samplers") {
-            res &= parseSamplers(*asset.get(), value);
+            res &= parseSamplers(*asset.get(), reader);
         } else if (key == "images") {
-            res &= parseImages(*asset.get(), value);
+            res &= parseImages(*asset.get(), reader);
+        } else {
+            reader.skipValue();
         }
     }
 
+    // Check if mandatory data is present
+    if (reader.error() || !hasAsset) {
+        // Error, 'asset' is mandatory
+        return nullptr;
+    }
+
     // [TODO] Check for errors
     return std::move(asset);
 }
 
-bool GltfLoader::parseAsset(Asset & asset, const cppexpose::AbstractVar * value)
+bool GltfLoader::parseAsset(Asset & asset, JsonReader & reader)
 {
     // Value must be an object
-    if (!value->isObject()) {
+    if (!reader.beginObject()) {
         return false;
     }
 
-    // Get object
-    const cppexpose::Object & obj = *value->asObject();
+    // Parse properties
+    bool hasVersion = false;
+    std::string key;
+    while (reader.nextKey(key)) {
+        // 'version' (mandatory)
+        if (key == "version") {
+            asset.setVersion(static_cast<float>(std::atof(parseString(reader).c_str())));
+            hasVersion = true;
+        }
 
-    // 'version' (mandatory)
-    if (obj.propertyExists("version")) {
-        asset.setVersion(obj.property("version")->convert<float>());
-    } else return false;
+        // 'minVersion'
+        else if (key == "minVersion") {
+            asset.setMinimumVersion(static_cast<float>(std::atof(parseString(reader).c_str())));
+        }
 
-    // 'minVersion'
-    if (obj.propertyExists("minVersion")) {
-        asset.setMinimumVersion(obj.property("minVersion")->convert<float>());
+        else reader.skipValue();
     }
 
     // Done
-    return true;
+    return hasVersion && !reader.error();
 }
 
-bool GltfLoader::parseDefaultScene(Asset & asset, const cppexpose::AbstractVar * value)
+bool GltfLoader::parseDefaultScene(Asset & asset, JsonReader & reader)
 {
     // Get default scene
-    asset.setDefaultScene(value->convert<int>());
+    asset.setDefaultScene(reader.readInt());
 
     // Done
-    return true;
+    return !reader.error();
 }
 
-bool GltfLoader::parseScenes(Asset & asset, const cppexpose::AbstractVar * value)
+bool GltfLoader::parseScenes(Asset & asset, JsonReader & reader)
 {
     bool res = true;
 
     // Value must be an array
-    if (!value->isArray()) {
+    if (!reader.beginArray()) {
         return false;
     }
 
-    // Get array
-    const cppexpose::Array & array = *value->asArray();
-
     // Parse scenes
-    for (size_t i=0; i<array.size(); i++) {
-        res &= parseScene(asset, array.at(i));
+    while (reader.nextElement()) {
+        res &= parseScene(asset, reader);
     }
 
     // Done
-    return res;
+    return res && !reader.error();
 }
 
-bool GltfLoader::parseScene(Asset & asset, const cppexpose::AbstractVar * value)
+bool GltfLoader::parseScene(Asset & asset, JsonReader & reader)
 {
     // Value must be an object
-    if (!value->isObject()) {
+    if (!reader.beginObject()) {
         return false;
     }
 
     // Create scene
     auto scene = cppassist::make_unique<Scene>();
 
-    // Get object
-    const cppexpose::Object & obj = *value->asObject();
+    // Parse properties
+    std::string key;
+    while (reader.nextKey(key)) {
+        // 'name'
+        if (key == "name") {
+            scene->setName(parseString(reader));
+        }
 
-    // 'name'
-    if (obj.propertyExists("name")) {
-        scene->setName(obj.property("name")->convert<std::string>());
-    }
+        // 'nodes'
+        else if (key == "nodes") {
+            // Get node indices
+            scene->setRootNodes(parseIntArray(reader));
+        }
 
-    // 'nodes'
-    if (obj.propertyExists("nodes")) {
-        // Get node indices
-        scene->setRootNodes(parseIntArray(obj.property("nodes")));
+        else reader.skipValue();
     }
 
     // Add scene
     asset.addScene(std::move(scene));
 
     // Done
-    return true;
+    return !reader.error();
 }
 
-bool GltfLoader::parseNodes(Asset & asset, const cppexpose::AbstractVar * value)
+bool GltfLoader::parseNodes(Asset & asset, JsonReader & reader)
 {
     bool res = true;
 
     // Value must be an array
-    if (!value->isArray()) {
+    if (!reader.beginArray()) {
         return false;
     }
 
-    // Get array
-    const cppexpose::Array & array = *value->asArray();
-
     // Parse nodes
-    for (size_t i=0; i<array.size(); i++) {
-        res &= parseNode(asset, array.at(i));
+    while (reader.nextElement()) {
+        res &= parseNode(asset, reader);
     }
 
     // Done
-    return res;
+    return res && !reader.error();
 }
 
-bool GltfLoader::parseNode(Asset & asset, const cppexpose::AbstractVar * value)
+bool GltfLoader::parseNode(Asset & asset, JsonReader & reader)
 {
     // Value must be an object
-    if (!value->isObject()) {
+    if (!reader.beginObject()) {
         return false;
     }
 
     // Create node
     auto node = cppassist::make_unique<Node>();
 
-    // Get object
-    const cppexpose::Object & obj = *value->asObject();
+    // Parse properties
+    std::string key;
+    while (reader.nextKey(key)) {
+        // 'name'
+        if (key == "name") {
+            node->setName(parseString(reader));
+        }
 
-    // 'name'
-    if (obj.propertyExists("name")) {
-        node->setName(obj.property("name")->convert<std::string>());
-    }
+        // 'matrix'
+        else if (key == "matrix") {
+            node->setMatrix(parseMat4(reader));
+        }
 
-    // 'matrix'
-    if (obj.propertyExists("matrix")) {
-        node->setMatrix(parseMat4(obj.property("matrix")));
-    }
+        // 'translation'
+        else if (key == "translation") {
+            node->setTranslation(parseVec3(reader));
+        }
 
-    // 'translation'
-    if (obj.propertyExists("translation")) {
-        node->setTranslation(parseVec3(obj.property("translation")));
-    }
+        // 'rotation'
+        else if (key == "rotation") {
+            node->setRotation(parseVec4(reader));
+        }
 
-    // 'rotation'
-    if (obj.propertyExists("rotation")) {
-        node->setRotation(parseVec4(obj.property("rotation")));
-    }
+        // 'scale'
+        else if (key == "scale") {
+            node->setScale(parseVec3(reader));
+        }
 
-    // 'scale'
-    if (obj.propertyExists("scale")) {
-        node->setScale(parseVec3(obj.property("scale")));
-    }
+        // 'children'
+        else if (key == "children") {
+            node->setChildren(parseIntArray(reader));
+        }
 
-    // 'children'
-    if (obj.propertyExists("children")) {
-        node->setChildren(parseIntArray(obj.property("children")));
-    }
+        // 'mesh'
+        else if (key == "mesh") {
+            // Get attached mesh index
+            node->setMesh(reader.readInt());
+        }
 
-    // 'mesh'
-    if (obj.propertyExists("mesh")) {
-        // Get attached mesh index
-        node->setMesh(obj.property("mesh")->convert<int>());
-    }
+        // 'skin'
+        else if (key == "skin") {
+            // Get index of skin used by the attached mesh
+            node->setSkin(reader.readInt());
+        }
+
+        // 'weights'
+        else if (key == "weights") {
+            node->setWeights(parseFloatArray(reader));
+        }
+
+        // 'camera'
+        else if (key == "camera") {
+            // Get attached camera index
+            node->setCamera(reader.readInt());
+        }
+
+        // 'extensions'
+        else if (key == "extensions") {
+            parseNodeExtensions(*node.get(), reader);
+        }
 
-    // 'camera'
-    if (obj.propertyExists("camera")) {
-        // Get attached camera index
-        node->setCamera(obj.property("camera")->convert<int>());
+        else reader.skipValue();
     }
 
     // Add node
     asset.addNode(std::move(node));
 
     // Done
-    return true;
+    return !reader.error();
+}
+
+bool GltfLoader::parseNodeExtensions(Node & node, JsonReader & reader)
+{
+    // Value must be an object
+    if (!reader.beginObject()) {
+        return false;
+    }
+
+    // Parse extensions (unknown extensions are ignored)
+    std::string key;
+    while (reader.nextKey(key)) {
+        // 'EXT_mesh_gpu_instancing'
+        if (key == "EXT_mesh_gpu_instancing") {
+            // Value must be an object
+            if (!reader.beginObject()) {
+                return false;
+            }
+
+            // Get accessor of each instance attribute
+            std::string instancingKey;
+            while (reader.nextKey(instancingKey)) {
+                if (instancingKey == "attributes") node.setInstanceAttributes(parseIntMap(reader));
+                else reader.skipValue();
+            }
+        }
+
+        else reader.skipValue();
+    }
+
+    // Done
+    return !reader.error();
 }
 
-bool GltfLoader::parseMeshes(Asset & asset, const cppexpose::AbstractVar * value)
+bool GltfLoader::parseMeshes(Asset & asset, JsonReader & reader)
 {
     bool res = true;
 
     // Value must be an array
-    if (!value->isArray()) {
+    if (!reader.beginArray()) {
         return false;
     }
 
-    // Get array
-    const cppexpose::Array & array = *value->asArray();
-
     // Parse meshes
-    for (size_t i=0; i<array.size(); i++) {
-        res &= parseMesh(asset, array.at(i));
+    while (reader.nextElement()) {
+        res &= parseMesh(asset, reader);
     }
 
     // Done
-    return res;
+    return res && !reader.error();
 }
 
-bool GltfLoader::parseMesh(Asset & asset, const cppexpose::AbstractVar * value)
+bool GltfLoader::parseMesh(Asset & asset, JsonReader & reader)
 {
     // Value must be an object
-    if (!value->isObject()) {
+    if (!reader.beginObject()) {
         return false;
     }
 
     // Create mesh
     auto mesh = cppassist::make_unique<Mesh>();
 
-    // Get object
-    const cppexpose::Object & obj = *value->asObject();
+    // Parse properties
+    bool hasPrimitives = false;
+    std::string key;
+    while (reader.nextKey(key)) {
+        // 'primitives' (mandatory)
+        if (key == "primitives") {
+            parsePrimitives(*mesh.get(), reader);
+            hasPrimitives = true;
+        }
+
+        // 'weights'
+        else if (key == "weights") {
+            mesh->setWeights(parseFloatArray(reader));
+        }
 
-    // 'primitives' (mandatory)
-    if (obj.propertyExists("primitives")) {
-        parsePrimitives(*mesh.get(), obj.property("primitives"));
-    } else return false;
+        else reader.skipValue();
+    }
+
+    if (!hasPrimitives || reader.error()) {
+        return false;
+    }
 
     // Add mesh
     asset.addMesh(std::move(mesh));
@@ -317,63 +498,81 @@ bool GltfLoader::parseMesh(Asset & asset, const cppexpose::AbstractVar * value)
     return true;
 }
 
-bool GltfLoader::parsePrimitives(Mesh & mesh, const cppexpose::AbstractVar * value)
+bool GltfLoader::parsePrimitives(Mesh & mesh, JsonReader & reader)
 {
     bool res = true;
 
     // Value must be an array
-    if (!value->isArray()) {
+    if (!reader.beginArray()) {
         return false;
     }
 
-    // Get array
-    const cppexpose::Array & array = *value->asArray();
-
     // Parse primitives
-    for (size_t i=0; i<array.size(); i++) {
-        res &= parsePrimitive(mesh, array.at(i));
+    while (reader.nextElement()) {
+        res &= parsePrimitive(mesh, reader);
     }
 
     // Done
-    return res;
+    return res && !reader.error();
 }
 
-bool GltfLoader::parsePrimitive(Mesh & mesh, const cppexpose::AbstractVar * value)
+bool GltfLoader::parsePrimitive(Mesh & mesh, JsonReader & reader)
 {
     // Value must be an object
-    if (!value->isObject()) {
+    if (!reader.beginObject()) {
         return false;
     }
 
     // Create primitive
     auto primitive = cppassist::make_unique<Primitive>();
 
-    // Get object
-    const cppexpose::Object & obj = *value->asObject();
+    // Parse properties
+    bool hasAttributes = false;
+    std::string key;
+    while (reader.nextKey(key)) {
+        // 'mode'
+        if (key == "mode") {
+            primitive->setMode(reader.readUInt());
+        }
 
-    // 'mode'
-    if (obj.propertyExists("mode")) {
-        primitive->setMode(obj.property("mode")->convert<unsigned int>());
-    };
+        // 'material'
+        else if (key == "material") {
+            primitive->setMaterial(reader.readUInt());
+        }
 
-    // 'material'
-    if (obj.propertyExists("material")) {
-        primitive->setMaterial(obj.property("material")->convert<unsigned int>());
-    }
+        // 'indices'
+        else if (key == "indices") {
+            primitive->setIndices(reader.readInt());
+        }
 
-    // 'indices'
-    if (obj.propertyExists("indices")) {
-        primitive->setIndices(obj.property("indices")->convert<int>());
-    }
+        // 'attributes'
+        else if (key == "attributes") {
+            primitive->setAttributes(parseIntMap(reader));
+            hasAttributes = true;
+        }
 
-    // 'attributes'
-    if (obj.propertyExists("attributes")) {
-        primitive->setAttributes(parseIntMap(obj.property("attributes")));
-    } else return false;
+        // 'targets'
+        else if (key == "targets") {
+            // Value must be an array
+            if (!reader.beginArray()) {
+                return false;
+            }
+
+            // Parse morph targets
+            while (reader.nextElement()) {
+                primitive->addTarget(parseIntMap(reader));
+            }
+        }
 
-    // 'targets'
-    if (obj.propertyExists("targets")) {
-        // [TODO]
+        // 'extensions'
+        else if (key == "extensions") {
+            parsePrimitiveExtensions(*primitive.get(), reader);
+        }
+
+        else reader.skipValue();
+    }
+
+    if (!hasAttributes || reader.error()) {
         return false;
     }
 
@@ -384,373 +583,724 @@ bool GltfLoader::parsePrimitive(Mesh & mesh, const cppexpose::AbstractVar * valu
     return true;
 }
 
-bool GltfLoader::parseAnimations(Asset &, const cppexpose::AbstractVar * value)
+bool GltfLoader::parsePrimitiveExtensions(Primitive & primitive, JsonReader & reader)
 {
-    // Value must be an array
-    if (!value->isArray()) {
+    // Value must be an object
+    if (!reader.beginObject()) {
         return false;
     }
 
-    // Get array
-    // const cppexpose::Array & array = *value->asArray();
+    // Parse extensions (unknown extensions are ignored)
+    std::string key;
+    while (reader.nextKey(key)) {
+        // 'KHR_draco_mesh_compression'
+        if (key == "KHR_draco_mesh_compression") {
+            // Value must be an object
+            if (!reader.beginObject()) {
+                return false;
+            }
+
+            // Get compressed buffer view and the Draco id of each attribute
+            int                                 bufferView = -1;
+            std::map<std::string, unsigned int> attributes;
+            std::string dracoKey;
+            while (reader.nextKey(dracoKey)) {
+                     if (dracoKey == "bufferView") bufferView = reader.readInt();
+                else if (dracoKey == "attributes") attributes = parseIntMap(reader);
+                else reader.skipValue();
+            }
+
+            primitive.setDraco(bufferView, attributes);
+        }
+
+        else reader.skipValue();
+    }
 
-    // [TODO]
-    return false;
+    // Done
+    return !reader.error();
 }
 
-bool GltfLoader::parseAccessors(Asset & asset, const cppexpose::AbstractVar * value)
+bool GltfLoader::parseAnimations(Asset & asset, JsonReader & reader)
 {
     bool res = true;
 
     // Value must be an array
-    if (!value->isArray()) {
+    if (!reader.beginArray()) {
         return false;
     }
 
-    // Get array
-    const cppexpose::Array & array = *value->asArray();
-
-    // Parse accessors
-    for (size_t i=0; i<array.size(); i++) {
-        res &= parseAccessor(asset, array.at(i));
+    // Parse animations
+    while (reader.nextElement()) {
+        res &= parseAnimation(asset, reader);
     }
 
     // Done
-    return res;
+    return res && !reader.error();
 }
 
-bool GltfLoader::parseAccessor(Asset & asset, const cppexpose::AbstractVar * value)
+bool GltfLoader::parseAnimation(Asset & asset, JsonReader & reader)
 {
     // Value must be an object
-    if (!value->isObject()) {
+    if (!reader.beginObject()) {
         return false;
     }
 
-    // Create accessor
-    auto accessor = cppassist::make_unique<Accessor>();
+    // Create animation
+    auto animation = cppassist::make_unique<Animation>();
 
-    // Get object
-    const cppexpose::Object & obj = *value->asObject();
+    // Parse properties
+    bool hasChannels = false;
+    bool hasSamplers = false;
+    bool res         = true;
+    std::string key;
+    while (reader.nextKey(key)) {
+        // 'name'
+        if (key == "name") {
+            animation->setName(parseString(reader));
+        }
 
-    // 'bufferView'
-    if (obj.propertyExists("bufferView")) {
-        accessor->setBufferView(obj.property("bufferView")->convert<unsigned int>());
-    } else return false;
+        // 'channels' (mandatory)
+        else if (key == "channels") {
+            res &= parseAnimationChannels(*animation.get(), reader);
+            hasChannels = true;
+        }
 
-    // 'byteOffset'
-    if (obj.propertyExists("byteOffset")) {
-        accessor->setOffset(obj.property("byteOffset")->convert<unsigned int>());
-    };
+        // 'samplers' (mandatory)
+        else if (key == "samplers") {
+            res &= parseAnimationSamplers(*animation.get(), reader);
+            hasSamplers = true;
+        }
 
-    // 'count'
-    if (obj.propertyExists("count")) {
-        accessor->setCount(obj.property("count")->convert<unsigned int>());
-    } else return false;
+        else reader.skipValue();
+    }
 
-    // 'componentType'
-    if (obj.propertyExists("componentType")) {
-        accessor->setComponentType(obj.property("componentType")->convert<unsigned int>());
+    if (!hasChannels || !hasSamplers || !res || reader.error()) {
+        return false;
     }
 
-    // 'type'
-    if (obj.propertyExists("type")) {
-        accessor->setDataType(obj.property("type")->convert<std::string>());
+    // Add animation
+    asset.addAnimation(std::move(animation));
+
+    // Done
+    return true;
+}
+
+bool GltfLoader::parseAnimationChannels(Animation & animation, JsonReader & reader)
+{
+    bool res = true;
+
+    // Value must be an array
+    if (!reader.beginArray()) {
+        return false;
     }
 
-    // 'min'
-    if (obj.propertyExists("min")) {
-        accessor->setMinValue(parseFloatArray(obj.property("min")));
+    // Parse channels
+    while (reader.nextElement()) {
+        res &= parseAnimationChannel(animation, reader);
     }
 
-    // 'max'
-    if (obj.propertyExists("max")) {
-        accessor->setMaxValue(parseFloatArray(obj.property("max")));
+    // Done
+    return res && !reader.error();
+}
+
+bool GltfLoader::parseAnimationChannel(Animation & animation, JsonReader & reader)
+{
+    // Value must be an object
+    if (!reader.beginObject()) {
+        return false;
     }
 
-    // 'sparse'
-    if (obj.propertyExists("sparse")) {
-        // [TODO]
+    // Create channel
+    Animation::Channel channel;
+    channel.sampler = 0;
+    channel.node    = -1;
+
+    // Parse properties
+    bool hasSampler = false;
+    bool hasPath    = false;
+    std::string key;
+    while (reader.nextKey(key)) {
+        // 'sampler' (mandatory)
+        if (key == "sampler") {
+            channel.sampler = reader.readUInt();
+            hasSampler = true;
+        }
+
+        // 'target' (mandatory)
+        else if (key == "target") {
+            // Value must be an object
+            if (!reader.beginObject()) {
+                return false;
+            }
+
+            // Parse target
+            std::string targetKey;
+            while (reader.nextKey(targetKey)) {
+                // 'node'
+                if (targetKey == "node") {
+                    channel.node = reader.readInt();
+                }
+
+                // 'path' (mandatory)
+                else if (targetKey == "path") {
+                    channel.path = parseString(reader);
+                    hasPath = true;
+                }
+
+                else reader.skipValue();
+            }
+        }
+
+        else reader.skipValue();
+    }
+
+    if (!hasSampler || !hasPath || reader.error()) {
         return false;
     }
 
-    // Add buffer view
-    asset.addAccessor(std::move(accessor));
+    // Add channel
+    animation.addChannel(channel);
 
     // Done
     return true;
 }
 
-bool GltfLoader::parseMaterials(Asset & asset, const cppexpose::AbstractVar * value)
+bool GltfLoader::parseAnimationSamplers(Animation & animation, JsonReader & reader)
 {
     bool res = true;
 
     // Value must be an array
-    if (!value->isArray()) {
+    if (!reader.beginArray()) {
         return false;
     }
 
-    // Get array
-    const cppexpose::Array & array = *value->asArray();
-
-    // Parse materials
-    for (size_t i=0; i<array.size(); i++) {
-        res &= parseMaterial(asset, array.at(i));
+    // Parse samplers
+    while (reader.nextElement()) {
+        res &= parseAnimationSampler(animation, reader);
     }
 
     // Done
-    return res;
+    return res && !reader.error();
 }
 
-bool GltfLoader::parseMaterial(Asset & asset, const cppexpose::AbstractVar * value)
+bool GltfLoader::parseAnimationSampler(Animation & animation, JsonReader & reader)
 {
     // Value must be an object
-    if (!value->isObject()) {
+    if (!reader.beginObject()) {
         return false;
     }
 
-    // Create material
-    auto material = cppassist::make_unique<Material>();
+    // Create sampler
+    Animation::Sampler sampler;
+    sampler.input         = 0;
+    sampler.output        = 0;
+    sampler.interpolation = "LINEAR";
+
+    // Parse properties
+    bool hasInput  = false;
+    bool hasOutput = false;
+    std::string key;
+    while (reader.nextKey(key)) {
+        // 'input' (mandatory)
+        if (key == "input") {
+            sampler.input = reader.readUInt();
+            hasInput = true;
+        }
+
+        // 'output' (mandatory)
+        else if (key == "output") {
+            sampler.output = reader.readUInt();
+            hasOutput = true;
+        }
 
-    // Get object
-    const cppexpose::Object & obj = *value->asObject();
+        // 'interpolation'
+        else if (key == "interpolation") {
+            sampler.interpolation = parseString(reader);
+        }
 
-    // 'name'
-    if (obj.propertyExists("name")) {
-        material->setName(obj.property("name")->convert<std::string>());
+        else reader.skipValue();
     }
 
-    // 'pbrMetallicRoughness'
-    if (obj.propertyExists("pbrMetallicRoughness")) {
-        // Get object
-        const cppexpose::Object * subObj = obj.property("pbrMetallicRoughness")->asObject();
-        if (subObj) {
-            // 'baseColorFactor'
-            if (subObj->propertyExists("baseColorFactor")) {
-                material->setBaseColorFactor(parseVec4(subObj->property("baseColorFactor")));
-            }
+    if (!hasInput || !hasOutput || reader.error()) {
+        return false;
+    }
 
-            // 'baseColorTexture'
-            if (subObj->propertyExists("baseColorTexture")) {
-                // Get object
-                const cppexpose::Object * subObj2 = subObj->property("baseColorTexture")->asObject();
-                if (subObj2) {
-                    // Create texture info
-                    auto textureInfo = cppassist::make_unique<TextureInfo>();
-
-                    // 'index'
-                    if (subObj2->propertyExists("index")) {
-                        textureInfo->setTexture(subObj2->property("index")->convert<unsigned int>());
-                    }
-
-                    // 'texCoord'
-                    if (subObj2->propertyExists("texCoord")) {
-                        textureInfo->setUVSet(subObj2->property("texCoord")->convert<unsigned int>());
-                    }
-
-                    // Add texture info
-                    asset.addTextureInfo(std::move(textureInfo));
-
-                    // Set base color texture info
-                    material->setBaseColorTexture(asset.textureInfos().size() - 1);
-                }
-            }
+    // Add sampler
+    animation.addSampler(sampler);
 
-            // 'metallicFactor'
-            if (subObj->propertyExists("metallicFactor")) {
-                material->setMetallicFactor(subObj->property("metallicFactor")->convert<float>());
-            }
+    // Done
+    return true;
+}
 
-            // 'roughnessFactor'
-            if (subObj->propertyExists("roughnessFactor")) {
-                material->setRoughnessFactor(subObj->property("roughnessFactor")->convert<float>());
-            }
+bool GltfLoader::parseSkins(Asset & asset, JsonReader & reader)
+{
+    bool res = true;
 
-            // 'metallicRoughnessTexture'
-            if (subObj->propertyExists("metallicRoughnessTexture")) {
-                // Get object
-                const cppexpose::Object * subObj2 = subObj->property("metallicRoughnessTexture")->asObject();
-                if (subObj2) {
-                    // Create texture info
-                    auto textureInfo = cppassist::make_unique<TextureInfo>();
-
-                    // 'index'
-                    if (subObj2->propertyExists("index")) {
-                        textureInfo->setTexture(subObj2->property("index")->convert<unsigned int>());
-                    }
-
-                    // 'texCoord'
-                    if (subObj2->propertyExists("texCoord")) {
-                        textureInfo->setUVSet(subObj2->property("texCoord")->convert<unsigned int>());
-                    }
-
-                    // Add texture info
-                    asset.addTextureInfo(std::move(textureInfo));
-
-                    // Set base color texture info
-                    material->setMetallicRoughnessTexture(asset.textureInfos().size() - 1);
-                }
-            }
-        }
+    // Value must be an array
+    if (!reader.beginArray()) {
+        return false;
     }
 
-    // 'normalTexture'
-    if (obj.propertyExists("normalTexture")) {
-        // Get object
-        const cppexpose::Object * subObj = obj.property("normalTexture")->asObject();
-        if (subObj) {
-            // Create texture info
-            auto textureInfo = cppassist::make_unique<TextureInfo>();
+    // Parse skins
+    while (reader.nextElement()) {
+        res &= parseSkin(asset, reader);
+    }
 
-            // 'index'
-            if (subObj->propertyExists("index")) {
-                textureInfo->setTexture(subObj->property("index")->convert<unsigned int>());
-            }
+    // Done
+    return res && !reader.error();
+}
 
-            // 'texCoord'
-            if (subObj->propertyExists("texCoord")) {
-                textureInfo->setUVSet(subObj->property("texCoord")->convert<unsigned int>());
-            }
+bool GltfLoader::parseSkin(Asset & asset, JsonReader & reader)
+{
+    // Value must be an object
+    if (!reader.beginObject()) {
+        return false;
+    }
 
-            // 'scale'
-            if (subObj->propertyExists("scale")) {
-                textureInfo->setScale(subObj->property("scale")->convert<float>());
-            }
+    // Create skin
+    auto skin = cppassist::make_unique<Skin>();
 
-            // Add texture info
-            asset.addTextureInfo(std::move(textureInfo));
+    // Parse properties
+    bool hasJoints = false;
+    std::string key;
+    while (reader.nextKey(key)) {
+        // 'name'
+        if (key == "name") {
+            skin->setName(parseString(reader));
+        }
+
+        // 'inverseBindMatrices'
+        else if (key == "inverseBindMatrices") {
+            skin->setInverseBindMatrices(reader.readInt());
+        }
 
-            // Set normal texture info
-            material->setNormalTexture(asset.textureInfos().size() - 1);
+        // 'skeleton'
+        else if (key == "skeleton") {
+            skin->setSkeleton(reader.readInt());
         }
+
+        // 'joints' (mandatory)
+        else if (key == "joints") {
+            skin->setJoints(parseIntArray(reader));
+            hasJoints = true;
+        }
+
+        else reader.skipValue();
     }
 
-    // 'occlusionTexture'
-    if (obj.propertyExists("occlusionTexture")) {
-        // Get object
-        const cppexpose::Object * subObj = obj.property("occlusionTexture")->asObject();
-        if (subObj) {
-            // Create texture info
-            auto textureInfo = cppassist::make_unique<TextureInfo>();
+    if (!hasJoints || reader.error()) {
+        return false;
+    }
 
-            // 'index'
-            if (subObj->propertyExists("index")) {
-                textureInfo->setTexture(subObj->property("index")->convert<unsigned int>());
-            }
+    // Add skin
+    asset.addSkin(std::move(skin));
 
-            // 'texCoord'
-            if (subObj->propertyExists("texCoord")) {
-                textureInfo->setUVSet(subObj->property("texCoord")->convert<unsigned int>());
-            }
+    // Done
+    return true;
+}
 
-            // 'strength'
-            if (subObj->propertyExists("strength")) {
-                textureInfo->setStrength(subObj->property("strength")->convert<float>());
-            }
+bool GltfLoader::parseAccessors(Asset & asset, JsonReader & reader)
+{
+    bool res = true;
+
+    // Value must be an array
+    if (!reader.beginArray()) {
+        return false;
+    }
+
+    // Parse accessors
+    while (reader.nextElement()) {
+        res &= parseAccessor(asset, reader);
+    }
+
+    // Done
+    return res && !reader.error();
+}
+
+bool GltfLoader::parseAccessor(Asset & asset, JsonReader & reader)
+{
+    // Value must be an object
+    if (!reader.beginObject()) {
+        return false;
+    }
+
+    // Create accessor
+    auto accessor = cppassist::make_unique<Accessor>();
+
+    // Parse properties
+    bool hasCount  = false;
+    bool res       = true;
+    std::string key;
+    while (reader.nextKey(key)) {
+        // 'bufferView'
+        if (key == "bufferView") {
+            accessor->setBufferView(reader.readInt());
+        }
+
+        // 'byteOffset'
+        else if (key == "byteOffset") {
+            accessor->setOffset(reader.readUInt());
+        }
+
+        // 'count'
+        else if (key == "count") {
+            accessor->setCount(reader.readUInt());
+            hasCount = true;
+        }
+
+        // 'componentType'
+        else if (key == "componentType") {
+            accessor->setComponentType(reader.readUInt());
+        }
 
-            // Add texture info
-            asset.addTextureInfo(std::move(textureInfo));
+        // 'normalized'
+        else if (key == "normalized") {
+            bool normalized = false;
+            reader.readBool(normalized);
+            accessor->setNormalized(normalized);
+        }
+
+        // 'type'
+        else if (key == "type") {
+            accessor->setDataType(parseString(reader));
+        }
+
+        // 'min'
+        else if (key == "min") {
+            accessor->setMinValue(parseFloatArray(reader));
+        }
+
+        // 'max'
+        else if (key == "max") {
+            accessor->setMaxValue(parseFloatArray(reader));
+        }
 
-            // Set normal texture info
-            material->setOcclusionTexture(asset.textureInfos().size() - 1);
+        // 'sparse'
+        else if (key == "sparse") {
+            res &= parseSparse(*accessor.get(), reader);
         }
+
+        else reader.skipValue();
+    }
+
+    if (!hasCount || !res || reader.error()) {
+        return false;
+    }
+
+    // Add buffer view
+    asset.addAccessor(std::move(accessor));
+
+    // Done
+    return true;
+}
+
+bool GltfLoader::parseSparse(Accessor & accessor, JsonReader & reader)
+{
+    // Value must be an object
+    if (!reader.beginObject()) {
+        return false;
     }
 
-    // 'emissiveTexture'
-    if (obj.propertyExists("emissiveTexture")) {
-        // Get object
-        const cppexpose::Object * subObj = obj.property("emissiveTexture")->asObject();
-        if (subObj) {
-            // Create texture info
-            auto textureInfo = cppassist::make_unique<TextureInfo>();
+    // Create sparse storage
+    Accessor::Sparse sparse;
+    sparse.count                = 0;
+    sparse.indicesBufferView    = 0;
+    sparse.indicesOffset        = 0;
+    sparse.indicesComponentType = 0;
+    sparse.valuesBufferView     = 0;
+    sparse.valuesOffset         = 0;
 
-            // 'index'
-            if (subObj->propertyExists("index")) {
-                textureInfo->setTexture(subObj->property("index")->convert<unsigned int>());
+    // Parse properties
+    bool hasCount   = false;
+    bool hasIndices = false;
+    bool hasValues  = false;
+    std::string key;
+    while (reader.nextKey(key)) {
+        // 'count' (mandatory)
+        if (key == "count") {
+            sparse.count = reader.readUInt();
+            hasCount = true;
+        }
+
+        // 'indices' (mandatory)
+        else if (key == "indices") {
+            // Value must be an object
+            if (!reader.beginObject()) {
+                return false;
             }
 
-            // 'texCoord'
-            if (subObj->propertyExists("texCoord")) {
-                textureInfo->setUVSet(subObj->property("texCoord")->convert<unsigned int>());
+            // Parse indices
+            bool hasBufferView    = false;
+            bool hasComponentType = false;
+            std::string indicesKey;
+            while (reader.nextKey(indicesKey)) {
+                     if (indicesKey == "bufferView")    { sparse.indicesBufferView    = reader.readUInt(); hasBufferView    = true; }
+                else if (indicesKey == "byteOffset")    { sparse.indicesOffset        = reader.readUInt(); }
+                else if (indicesKey == "componentType") { sparse.indicesComponentType = reader.readUInt(); hasComponentType = true; }
+                else reader.skipValue();
             }
 
-            // Add texture info
-            asset.addTextureInfo(std::move(textureInfo));
+            hasIndices = hasBufferView && hasComponentType;
+        }
 
-            // Set emissive texture info
-            material->setEmissiveTexture(asset.textureInfos().size() - 1);
+        // 'values' (mandatory)
+        else if (key == "values") {
+            // Value must be an object
+            if (!reader.beginObject()) {
+                return false;
+            }
+
+            // Parse values
+            std::string valuesKey;
+            while (reader.nextKey(valuesKey)) {
+                     if (valuesKey == "bufferView") { sparse.valuesBufferView = reader.readUInt(); hasValues = true; }
+                else if (valuesKey == "byteOffset") { sparse.valuesOffset     = reader.readUInt(); }
+                else reader.skipValue();
+            }
         }
+
+        else reader.skipValue();
     }
 
-    // 'emissiveFactor'
-    if (obj.propertyExists("emissiveFactor")) {
-        material->setEmissiveFactor(parseVec3(obj.property("emissiveFactor")));
+    if (!hasCount || !hasIndices || !hasValues || reader.error()) {
+        return false;
     }
 
-    // 'alphaMode'
-    if (obj.propertyExists("alphaMode")) {
-        material->setAlphaMode(obj.property("alphaMode")->convert<std::string>());
+    // Set sparse storage
+    accessor.setSparse(sparse);
+
+    // Done
+    return true;
+}
+
+bool GltfLoader::parseMaterials(Asset & asset, JsonReader & reader)
+{
+    bool res = true;
+
+    // Value must be an array
+    if (!reader.beginArray()) {
+        return false;
     }
 
-    // 'alphaCutoff'
-    if (obj.propertyExists("alphaCutoff")) {
-        material->setAlphaCutoff(obj.property("alphaCutoff")->convert<float>());
+    // Parse materials
+    while (reader.nextElement()) {
+        res &= parseMaterial(asset, reader);
     }
 
-    // 'doubleSided'
-    if (obj.propertyExists("doubleSided")) {
-        material->setDoubleSided(obj.property("doubleSided")->convert<bool>());
+    // Done
+    return res && !reader.error();
+}
+
+bool GltfLoader::parseMaterial(Asset & asset, JsonReader & reader)
+{
+    // Value must be an object
+    if (!reader.beginObject()) {
+        return false;
+    }
+
+    // Create material
+    auto material = cppassist::make_unique<Material>();
+
+    // Parse properties
+    std::string key;
+    while (reader.nextKey(key)) {
+        // 'name'
+        if (key == "name") {
+            material->setName(parseString(reader));
+        }
+
+        // 'pbrMetallicRoughness'
+        else if (key == "pbrMetallicRoughness") {
+            // Get object
+            if (reader.peek() != JsonReader::Type::Object) {
+                reader.skipValue();
+                continue;
+            }
+
+            reader.beginObject();
+
+            while (reader.nextKey(key)) {
+                // 'baseColorFactor'
+                if (key == "baseColorFactor") {
+                    material->setBaseColorFactor(parseVec4(reader));
+                }
+
+                // 'baseColorTexture'
+                else if (key == "baseColorTexture") {
+                    int index = parseTextureInfo(asset, reader);
+                    if (index >= 0) material->setBaseColorTexture(index);
+                }
+
+                // 'metallicFactor'
+                else if (key == "metallicFactor") {
+                    material->setMetallicFactor(reader.readFloat());
+                }
+
+                // 'roughnessFactor'
+                else if (key == "roughnessFactor") {
+                    material->setRoughnessFactor(reader.readFloat());
+                }
+
+                // 'metallicRoughnessTexture'
+                else if (key == "metallicRoughnessTexture") {
+                    int index = parseTextureInfo(asset, reader);
+                    if (index >= 0) material->setMetallicRoughnessTexture(index);
+                }
+
+                else reader.skipValue();
+            }
+        }
+
+        // 'normalTexture'
+        else if (key == "normalTexture") {
+            int index = parseTextureInfo(asset, reader);
+            if (index >= 0) material->setNormalTexture(index);
+        }
+
+        // 'occlusionTexture'
+        else if (key == "occlusionTexture") {
+            int index = parseTextureInfo(asset, reader);
+            if (index >= 0) material->setOcclusionTexture(index);
+        }
+
+        // 'emissiveTexture'
+        else if (key == "emissiveTexture") {
+            int index = parseTextureInfo(asset, reader);
+            if (index >= 0) material->setEmissiveTexture(index);
+        }
+
+        // 'emissiveFactor'
+        else if (key == "emissiveFactor") {
+            material->setEmissiveFactor(parseVec3(reader));
+        }
+
+        // 'alphaMode'
+        else if (key == "alphaMode") {
+            material->setAlphaMode(parseString(reader));
+        }
+
+        // 'alphaCutoff'
+        else if (key == "alphaCutoff") {
+            material->setAlphaCutoff(reader.readFloat());
+        }
+
+        // 'doubleSided'
+        else if (key == "doubleSided") {
+            bool doubleSided = false;
+            reader.readBool(doubleSided);
+            material->setDoubleSided(doubleSided);
+        }
+
+        else reader.skipValue();
     }
 
     // Add material
     asset.addMaterial(std::move(material));
 
     // Done
-    return true;
+    return !reader.error();
+}
+
+int GltfLoader::parseTextureInfo(Asset & asset, JsonReader & reader)
+{
+    // Value must be an object
+    if (reader.peek() != JsonReader::Type::Object) {
+        reader.skipValue();
+        return -1;
+    }
+
+    reader.beginObject();
+
+    // Create texture info
+    auto textureInfo = cppassist::make_unique<TextureInfo>();
+
+    // Parse properties
+    std::string key;
+    while (reader.nextKey(key)) {
+        // 'index'
+        if (key == "index") {
+            textureInfo->setTexture(reader.readUInt());
+        }
+
+        // 'texCoord'
+        else if (key == "texCoord") {
+            textureInfo->setUVSet(reader.readUInt());
+        }
+
+        // 'scale' (normal textures)
+        else if (key == "scale") {
+            textureInfo->setScale(reader.readFloat());
+        }
+
+        // 'strength' (occlusion textures)
+        else if (key == "strength") {
+            textureInfo->setStrength(reader.readFloat());
+        }
+
+        else reader.skipValue();
+    }
+
+    // Add texture info
+    asset.addTextureInfo(std::move(textureInfo));
+
+    // Return index of texture info
+    return static_cast<int>(asset.textureInfos().size()) - 1;
 }
 
-bool GltfLoader::parseBuffers(Asset & asset, const cppexpose::AbstractVar * value)
+bool GltfLoader::parseBuffers(Asset & asset, JsonReader & reader)
 {
     bool res = true;
 
     // Value must be an array
-    if (!value->isArray()) {
+    if (!reader.beginArray()) {
         return false;
     }
 
-    // Get array
-    const cppexpose::Array & array = *value->asArray();
-
     // Parse buffers
-    for (size_t i=0; i<array.size(); i++) {
-        res &= parseBuffer(asset, array.at(i));
+    while (reader.nextElement()) {
+        res &= parseBuffer(asset, reader);
     }
 
     // Done
-    return res;
+    return res && !reader.error();
 }
 
-bool GltfLoader::parseBuffer(Asset & asset, const cppexpose::AbstractVar * value)
+bool GltfLoader::parseBuffer(Asset & asset, JsonReader & reader)
 {
     // Value must be an object
-    if (!value->isObject()) {
+    if (!reader.beginObject()) {
         return false;
     }
 
     // Create buffer
     auto buffer = cppassist::make_unique<Buffer>();
 
-    // Get object
-    const cppexpose::Object & obj = *value->asObject();
+    // Parse properties
+    bool hasSize = false;
+    std::string key;
+    while (reader.nextKey(key)) {
+        // 'byteLength'
+        if (key == "byteLength") {
+            buffer->setSize(reader.readUInt());
+            hasSize = true;
+        }
 
-    // 'byteLength'
-    if (obj.propertyExists("byteLength")) {
-        buffer->setSize(obj.property("byteLength")->convert<unsigned int>());
-    } else return false;
+        // 'uri' (not present for the BIN chunk of binary files)
+        else if (key == "uri") {
+            buffer->setUri(parseString(reader));
+        }
 
-    // 'uri'
-    if (obj.propertyExists("uri")) {
-        buffer->setUri(obj.property("uri")->convert<std::string>());
-    } else return false;
+        // 'extensions'
+        else if (key == "extensions") {
+            parseBufferExtensions(*buffer.get(), reader);
+        }
+
+        else reader.skipValue();
+    }
+
+    if (!hasSize || reader.error()) {
+        return false;
+    }
 
     // Add buffer
     asset.addBuffer(std::move(buffer));
@@ -759,63 +1309,113 @@ bool GltfLoader::parseBuffer(Asset & asset, const cppexpose::AbstractVar * value
     return true;
 }
 
-bool GltfLoader::parseBufferViews(Asset & asset, const cppexpose::AbstractVar * value)
+bool GltfLoader::parseBufferExtensions(Buffer & buffer, JsonReader & reader)
+{
+    // Value must be an object
+    if (!reader.beginObject()) {
+        return false;
+    }
+
+    // Parse extensions (unknown extensions are ignored)
+    std::string key;
+    while (reader.nextKey(key)) {
+        // 'EXT_meshopt_compression'
+        if (key == "EXT_meshopt_compression") {
+            // Value must be an object
+            if (!reader.beginObject()) {
+                return false;
+            }
+
+            // Check if the buffer only receives decompressed data
+            std::string meshoptKey;
+            while (reader.nextKey(meshoptKey)) {
+                if (meshoptKey == "fallback") {
+                    bool fallback = false;
+                    reader.readBool(fallback);
+                    buffer.setFallback(fallback);
+                }
+
+                else reader.skipValue();
+            }
+        }
+
+        else reader.skipValue();
+    }
+
+    // Done
+    return !reader.error();
+}
+
+bool GltfLoader::parseBufferViews(Asset & asset, JsonReader & reader)
 {
     bool res = true;
 
     // Value must be an array
-    if (!value->isArray()) {
+    if (!reader.beginArray()) {
         return false;
     }
 
-    // Get array
-    const cppexpose::Array & array = *value->asArray();
-
     // Parse buffer views
-    for (size_t i=0; i<array.size(); i++) {
-        res &= parseBufferView(asset, array.at(i));
+    while (reader.nextElement()) {
+        res &= parseBufferView(asset, reader);
     }
 
     // Done
-    return res;
+    return res && !reader.error();
 }
 
-bool GltfLoader::parseBufferView(Asset & asset, const cppexpose::AbstractVar * value)
+bool GltfLoader::parseBufferView(Asset & asset, JsonReader & reader)
 {
     // Value must be an object
-    if (!value->isObject()) {
+    if (!reader.beginObject()) {
         return false;
     }
 
     // Create buffer view
     auto bufferView = cppassist::make_unique<BufferView>();
 
-    // Get object
-    const cppexpose::Object & obj = *value->asObject();
+    // Parse properties
+    bool hasBuffer = false;
+    bool hasSize   = false;
+    std::string key;
+    while (reader.nextKey(key)) {
+        // 'buffer'
+        if (key == "buffer") {
+            bufferView->setBuffer(reader.readUInt());
+            hasBuffer = true;
+        }
 
-    // 'buffer'
-    if (obj.propertyExists("buffer")) {
-        bufferView->setBuffer(obj.property("buffer")->convert<unsigned int>());
-    } else return false;
+        // 'byteOffset'
+        else if (key == "byteOffset") {
+            bufferView->setOffset(reader.readUInt());
+        }
 
-    // 'byteOffset'
-    if (obj.propertyExists("byteOffset")) {
-        bufferView->setOffset(obj.property("byteOffset")->convert<unsigned int>());
-    };
+        // 'byteLength'
+        else if (key == "byteLength") {
+            bufferView->setSize(reader.readUInt());
+            hasSize = true;
+        }
 
-    // 'byteLength'
-    if (obj.propertyExists("byteLength")) {
-        bufferView->setSize(obj.property("byteLength")->convert<unsigned int>());
-    } else return false;
+        // 'byteStride'
+        else if (key == "byteStride") {
+            bufferView->setStride(reader.readUInt());
+        }
 
-    // 'byteStride'
-    if (obj.propertyExists("byteStride")) {
-        bufferView->setStride(obj.property("byteStride")->convert<unsigned int>());
+        // 'target'
+        else if (key == "target") {
+            bufferView->setTarget(reader.readUInt());
+        }
+
+        // 'extensions'
+        else if (key == "extensions") {
+            parseBufferViewExtensions(*bufferView.get(), reader);
+        }
+
+        else reader.skipValue();
     }
 
-    // 'target'
-    if (obj.propertyExists("target")) {
-        bufferView->setTarget(obj.property("target")->convert<unsigned int>());
+    if (!hasBuffer || !hasSize || reader.error()) {
+        return false;
     }
 
     // Add buffer view
@@ -825,338 +1425,383 @@ bool GltfLoader::parseBufferView(Asset & asset, const cppexpose::AbstractVar * v
     return true;
 }
 
-bool GltfLoader::parseTextures(Asset & asset, const cppexpose::AbstractVar * value)
+bool GltfLoader::parseBufferViewExtensions(BufferView & bufferView, JsonReader & reader)
+{
+    // Value must be an object
+    if (!reader.beginObject()) {
+        return false;
+    }
+
+    // Parse extensions (unknown extensions are ignored)
+    std::string key;
+    while (reader.nextKey(key)) {
+        // 'EXT_meshopt_compression'
+        if (key == "EXT_meshopt_compression") {
+            // Value must be an object
+            if (!reader.beginObject()) {
+                return false;
+            }
+
+            // Create compressed storage
+            BufferView::Compression compression;
+            compression.buffer = 0;
+            compression.offset = 0;
+            compression.size   = 0;
+            compression.stride = 0;
+            compression.count  = 0;
+            compression.filter = "NONE";
+
+            // Parse properties
+            bool hasBuffer = false;
+            bool hasSize   = false;
+            bool hasStride = false;
+            bool hasCount  = false;
+            bool hasMode   = false;
+            std::string meshoptKey;
+            while (reader.nextKey(meshoptKey)) {
+                     if (meshoptKey == "buffer")     { compression.buffer = reader.readUInt();   hasBuffer = true; }
+                else if (meshoptKey == "byteOffset") { compression.offset = reader.readUInt(); }
+                else if (meshoptKey == "byteLength") { compression.size   = reader.readUInt();   hasSize   = true; }
+                else if (meshoptKey == "byteStride") { compression.stride = reader.readUInt();   hasStride = true; }
+                else if (meshoptKey == "count")      { compression.count  = reader.readUInt();   hasCount  = true; }
+                else if (meshoptKey == "mode")       { compression.mode   = parseString(reader); hasMode   = true; }
+                else if (meshoptKey == "filter")     { compression.filter = parseString(reader); }
+                else reader.skipValue();
+            }
+
+            // Ignore incomplete extension (the buffer view is read uncompressed)
+            if (hasBuffer && hasSize && hasStride && hasCount && hasMode) {
+                bufferView.setCompression(compression);
+            }
+        }
+
+        else reader.skipValue();
+    }
+
+    // Done
+    return !reader.error();
+}
+
+bool GltfLoader::parseTextures(Asset & asset, JsonReader & reader)
 {
     bool res = true;
 
     // Value must be an array
-    if (!value->isArray()) {
+    if (!reader.beginArray()) {
         return false;
     }
 
-    // Get array
-    const cppexpose::Array & array = *value->asArray();
-
     // Parse textures
-    for (size_t i=0; i<array.size(); i++) {
-        res &= parseTexture(asset, array.at(i));
+    while (reader.nextElement()) {
+        res &= parseTexture(asset, reader);
     }
 
     // Done
-    return res;
+    return res && !reader.error();
 }
 
-bool GltfLoader::parseTexture(Asset & asset, const cppexpose::AbstractVar * value)
+bool GltfLoader::parseTexture(Asset & asset, JsonReader & reader)
 {
     // Value must be an object
-    if (!value->isObject()) {
+    if (!reader.beginObject()) {
         return false;
     }
 
     // Create texture
     auto texture = cppassist::make_unique<Texture>();
 
-    // Get object
-    const cppexpose::Object & obj = *value->asObject();
+    // Parse properties
+    std::string key;
+    while (reader.nextKey(key)) {
+        // 'name'
+        if (key == "name") {
+            texture->setName(parseString(reader));
+        }
 
-    // 'name'
-    if (obj.propertyExists("name")) {
-        texture->setName(obj.property("name")->convert<std::string>());
-    }
+        // 'sampler'
+        else if (key == "sampler") {
+            texture->setSampler(reader.readInt());
+        }
 
-    // 'sampler'
-    if (obj.propertyExists("sampler")) {
-        texture->setSampler(obj.property("sampler")->convert<int>());
-    }
+        // 'source'
+        else if (key == "source") {
+            texture->setImage(reader.readInt());
+        }
 
-    // 'source'
-    if (obj.propertyExists("source")) {
-        texture->setImage(obj.property("source")->convert<int>());
+        else reader.skipValue();
     }
 
     // Add texture
     asset.addTexture(std::move(texture));
 
     // Done
-    return true;
+    return !reader.error();
 }
 
-bool GltfLoader::parseSamplers(Asset & asset, const cppexpose::AbstractVar * value)
+bool GltfLoader::parseSamplers(Asset & asset, JsonReader & reader)
 {
     bool res = true;
 
     // Value must be an array
-    if (!value->isArray()) {
+    if (!reader.beginArray()) {
         return false;
     }
 
-    // Get array
-    const cppexpose::Array & array = *value->asArray();
-
     // Parse samplers
-    for (size_t i=0; i<array.size(); i++) {
-        res &= parseSampler(asset, array.at(i));
+    while (reader.nextElement()) {
+        res &= parseSampler(asset, reader);
     }
 
     // Done
-    return res;
+    return res && !reader.error();
 }
 
-bool GltfLoader::parseSampler(Asset & asset, const cppexpose::AbstractVar * value)
+bool GltfLoader::parseSampler(Asset & asset, JsonReader & reader)
 {
     // Value must be an object
-    if (!value->isObject()) {
+    if (!reader.beginObject()) {
         return false;
     }
 
     // Create sampler
     auto sampler = cppassist::make_unique<Sampler>();
 
-    // Get object
-    const cppexpose::Object & obj = *value->asObject();
+    // Parse properties
+    std::string key;
+    while (reader.nextKey(key)) {
+        // 'name'
+        if (key == "name") {
+            sampler->setName(parseString(reader));
+        }
 
-    // 'name'
-    if (obj.propertyExists("name")) {
-        sampler->setName(obj.property("name")->convert<std::string>());
-    }
+        // 'minFilter'
+        else if (key == "minFilter") {
+            sampler->setMinFilter(reader.readUInt());
+        }
 
-    // 'minFilter'
-    if (obj.propertyExists("minFilter")) {
-        sampler->setMinFilter(obj.property("minFilter")->convert<unsigned int>());
-    }
+        // 'magFilter'
+        else if (key == "magFilter") {
+            sampler->setMagFilter(reader.readUInt());
+        }
 
-    // 'magFilter'
-    if (obj.propertyExists("magFilter")) {
-        sampler->setMinFilter(obj.property("magFilter")->convert<unsigned int>());
-    }
+        // 'wrapS'
+        else if (key == "wrapS") {
+            sampler->setWrapS(reader.readUInt());
+        }
 
-    // 'wrapS'
-    if (obj.propertyExists("wrapS")) {
-        sampler->setWrapS(obj.property("wrapS")->convert<unsigned int>());
-    }
+        // 'wrapT'
+        else if (key == "wrapT") {
+            sampler->setWrapT(reader.readUInt());
+        }
 
-    // 'wrapT'
-    if (obj.propertyExists("wrapT")) {
-        sampler->setWrapS(obj.property("wrapT")->convert<unsigned int>());
+        else reader.skipValue();
     }
 
     // Add sampler
     asset.addSampler(std::move(sampler));
 
     // Done
-    return true;
+    return !reader.error();
 }
 
-bool GltfLoader::parseImages(Asset & asset, const cppexpose::AbstractVar * value)
+bool GltfLoader::parseImages(Asset & asset, JsonReader & reader)
 {
     bool res = true;
 
     // Value must be an array
-    if (!value->isArray()) {
+    if (!reader.beginArray()) {
         return false;
     }
 
-    // Get array
-    const cppexpose::Array & array = *value->asArray();
-
     // Parse images
-    for (size_t i=0; i<array.size(); i++) {
-        res &= parseImage(asset, array.at(i));
+    while (reader.nextElement()) {
+        res &= parseImage(asset, reader);
     }
 
     // Done
-    return res;
+    return res && !reader.error();
 }
 
-bool GltfLoader::parseImage(Asset & asset, const cppexpose::AbstractVar * value)
+bool GltfLoader::parseImage(Asset & asset, JsonReader & reader)
 {
     // Value must be an object
-    if (!value->isObject()) {
+    if (!reader.beginObject()) {
         return false;
     }
 
     // Create image
     auto image = cppassist::make_unique<Image>();
 
-    // Get object
-    const cppexpose::Object & obj = *value->asObject();
+    // Parse properties
+    std::string key;
+    while (reader.nextKey(key)) {
+        // 'name'
+        if (key == "name") {
+            image->setName(parseString(reader));
+        }
 
-    // 'name'
-    if (obj.propertyExists("name")) {
-        image->setName(obj.property("name")->convert<std::string>());
-    }
+        // 'uri'
+        else if (key == "uri") {
+            image->setURI(parseString(reader));
+        }
 
-    // 'uri'
-    if (obj.propertyExists("uri")) {
-        image->setURI(obj.property("uri")->convert<std::string>());
-    }
+        // 'mimeType'
+        else if (key == "mimeType") {
+            image->setMimeType(parseString(reader));
+        }
 
-    // 'mimeType'
-    if (obj.propertyExists("mimeType")) {
-        image->setMimeType(obj.property("mimeType")->convert<std::string>());
-    }
+        // 'bufferView'
+        else if (key == "bufferView") {
+            image->setBufferView(reader.readInt());
+        }
 
-    // 'bufferView'
-    if (obj.propertyExists("bufferView")) {
-        image->setBufferView(obj.property("bufferView")->convert<unsigned int>());
+        else reader.skipValue();
     }
 
     // Add image
     asset.addImage(std::move(image));
 
     // Done
-    return true;
+    return !reader.error();
 }
 
-std::map<std::string, unsigned int> GltfLoader::parseIntMap(const cppexpose::AbstractVar * value)
+std::string GltfLoader::parseString(JsonReader & reader)
+{
+    std::string str;
+
+    // Read string
+    reader.readString(str);
+
+    // Return value
+    return str;
+}
+
+std::map<std::string, unsigned int> GltfLoader::parseIntMap(JsonReader & reader)
 {
     std::map<std::string, unsigned int> map;
 
     // Value must be an object
-    if (!value->isObject()) {
+    if (!reader.beginObject()) {
         return map;
     }
 
-    // Get object
-    const cppexpose::Object & obj = *value->asObject();
-
-    // Get object properties
-    const auto & properties = obj.properties();
-
     // Parse map
-    for (auto it : properties) {
-        // Get name and value
-        std::string key = it.first;
-        auto * value    = it.second;
-
+    std::string key;
+    while (reader.nextKey(key)) {
         // Add value to map
-        map.insert({ key, value->convert<unsigned int>() });
+        map.insert({ key, reader.readUInt() });
     }
 
     // Return value
     return map;
 }
 
-std::vector<unsigned int> GltfLoader::parseIntArray(const cppexpose::AbstractVar * value)
+std::vector<unsigned int> GltfLoader::parseIntArray(JsonReader & reader)
 {
     std::vector<unsigned int> vec;
 
     // Value must be an array
-    if (!value->isArray()) {
+    if (!reader.beginArray()) {
         return vec;
     }
 
-    // Get array
-    const cppexpose::Array & array = *value->asArray();
-
     // Parse vector
-    for (size_t i=0; i<array.size(); i++) {
-        vec.push_back(array.at(i)->convert<unsigned int>());
+    while (reader.nextElement()) {
+        vec.push_back(reader.readUInt());
     }
 
     // Return value
     return vec;
 }
 
-std::vector<float> GltfLoader::parseFloatArray(const cppexpose::AbstractVar * value)
+std::vector<float> GltfLoader::parseFloatArray(JsonReader & reader)
 {
     std::vector<float> vec;
 
     // Value must be an array
-    if (!value->isArray()) {
+    if (!reader.beginArray()) {
         return vec;
     }
 
-    // Get array
-    const cppexpose::Array & array = *value->asArray();
-
     // Parse vector
-    for (size_t i=0; i<array.size(); i++) {
-        vec.push_back(array.at(i)->convert<float>());
+    while (reader.nextElement()) {
+        vec.push_back(reader.readFloat());
     }
 
     // Return value
     return vec;
 }
 
-glm::vec2 GltfLoader::parseVec2(const cppexpose::AbstractVar * value)
+glm::vec2 GltfLoader::parseVec2(JsonReader & reader)
 {
     glm::vec2 vec(0.0f);
 
     // Value must be an array
-    if (!value->isArray()) {
+    if (!reader.beginArray()) {
         return vec;
     }
 
-    // Get array
-    const cppexpose::Array & array = *value->asArray();
-
     // Parse vector
-    for (size_t i=0; i<std::min(array.size(), (size_t)2); i++) {
-        vec[i] = array.at(i)->convert<float>();
+    for (int i=0; reader.nextElement(); i++) {
+        if (i < 2) vec[i] = reader.readFloat();
+        else       reader.skipValue();
     }
 
     // Return value
     return vec;
 }
 
-glm::vec3 GltfLoader::parseVec3(const cppexpose::AbstractVar * value)
+glm::vec3 GltfLoader::parseVec3(JsonReader & reader)
 {
     glm::vec3 vec(0.0f);
 
     // Value must be an array
-    if (!value->isArray()) {
+    if (!reader.beginArray()) {
         return vec;
     }
 
-    // Get array
-    const cppexpose::Array & array = *value->asArray();
-
     // Parse vector
-    for (size_t i=0; i<std::min(array.size(), (size_t)3); i++) {
-        vec[i] = array.at(i)->convert<float>();
+    for (int i=0; reader.nextElement(); i++) {
+        if (i < 3) vec[i] = reader.readFloat();
+        else       reader.skipValue();
     }
 
     // Return value
     return vec;
 }
 
-glm::vec4 GltfLoader::parseVec4(const cppexpose::AbstractVar * value)
+glm::vec4 GltfLoader::parseVec4(JsonReader & reader)
 {
     glm::vec4 vec(0.0f);
 
     // Value must be an array
-    if (!value->isArray()) {
+    if (!reader.beginArray()) {
         return vec;
     }
 
-    // Get array
-    const cppexpose::Array & array = *value->asArray();
-
     // Parse vector
-    for (size_t i=0; i<std::min(array.size(), (size_t)4); i++) {
-        vec[i] = array.at(i)->convert<float>();
+    for (int i=0; reader.nextElement(); i++) {
+        if (i < 4) vec[i] = reader.readFloat();
+        else       reader.skipValue();
     }
 
     // Return value
     return vec;
 }
 
-glm::mat4 GltfLoader::parseMat4(const cppexpose::AbstractVar * value)
+glm::mat4 GltfLoader::parseMat4(JsonReader & reader)
 {
     glm::mat4 mat(0.0f);
 
     // Value must be an array
-    if (!value->isArray()) {
+    if (!reader.beginArray()) {
         return mat;
     }
 
-    // Get array
-    const cppexpose::Array & array = *value->asArray();
-
     // Parse matrix
-    for (size_t i=0; i<std::min(array.size(), (size_t)16); i++) {
-        mat[i/4][i%4] = array.at(i)->convert<float>();
+    for (int i=0; reader.nextElement(); i++) {
+        if (i < 16) mat[i/4][i%4] = reader.readFloat();
+        else        reader.skipValue();
     }
 
     // Return value
@@ -0,0 +1,809 @@
+
+#include <rendercore-gltf/GltfStreamer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <cppassist/logging/logging.h>
+#include <cppassist/memory/make_unique.h>
+
+#include <rendercore/Camera.h>
+#include <rendercore/Transform.h>
+#include <rendercore/WorkerPool.h>
+
+#include <rendercore-opengl/Box.h>
+#include <rendercore-opengl/scene/MeshComponent.h>
+
+#include <rendercore-gltf/Accessor.h>
+#include <rendercore-gltf/Asset.h>
+#include <rendercore-gltf/BufferView.h>
+#include <rendercore-gltf/GltfLoader.h>
+#include <rendercore-gltf/Material.h>
+#include <rendercore-gltf/Mesh.h>
+#include <rendercore-gltf/Primitive.h>
+#include <rendercore-gltf/Scene.h>
+#include <rendercore-gltf/Texture.h>
+#include <rendercore-gltf/TextureInfo.h>
+
+
+using namespace rendercore::opengl;
+
+
+namespace
+{
+
+
+// Names of the textures of a material (as set by GltfConverter)
+const char * const textureNames[] = { "baseColor", "metallicRoughness", "normal", "occlusion", "emissive" };
+
+
+// Get projected radius of a bounding sphere (relative to the viewport height, 0 if outside of the view frustum)
+float projectedRadius(const glm::vec4 & sphere, const glm::mat4 & transform, const glm::vec4 (&planes)[6], const rendercore::Camera & camera)
+{
+    // Get largest scale factor of the model transformation
+    float scale = std::sqrt(std::max(glm::dot(glm::vec3(transform[0]), glm::vec3(transform[0])),
+                            std::max(glm::dot(glm::vec3(transform[1]), glm::vec3(transform[1])),
+                                     glm::dot(glm::vec3(transform[2]), glm::vec3(transform[2])))));
+
+    // Get sphere in world space (meshes without bounds are treated as unit spheres)
+    glm::vec4 center = transform * glm::vec4(sphere.x, sphere.y, sphere.z, 1.0f);
+    float     radius = (sphere.w > 0.0f ? sphere.w : 1.0f) * scale;
+
+    // Check view frustum
+    for (const auto & plane : planes) {
+        if (glm::dot(plane, center) < -radius) {
+            return 0.0f;
+        }
+    }
+
+    // Orthographic projection: size does not depend on the distance
+    const glm::mat4 & projection = camera.projectionMatrix();
+    if (projection[2][3] == 0.0f) {
+        return radius * projection[1][1] * 0.5f;
+    }
+
+    // Perspective projection: the camera may be inside of the sphere
+    float distance = -(camera.viewMatrix() * center).z;
+    if (distance <= radius) {
+        return std::numeric_limits<float>::max();
+    }
+
+    return radius * projection[1][1] * 0.5f / distance;
+}
+
+
+} // namespace
+
+
+namespace rendercore
+{
+namespace gltf
+{
+
+
+GltfStreamer::GltfStreamer()
+: m_readBudget(0)
+, m_uploadBudget(16 * 1024 * 1024)
+, m_readBytes(0)
+, m_finished(false)
+, m_stop(false)
+{
+}
+
+GltfStreamer::~GltfStreamer()
+{
+    // Stop worker thread
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_signal.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+unsigned int GltfStreamer::readBudget() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_readBudget;
+}
+
+void GltfStreamer::setReadBudget(unsigned int budget)
+{
+    // The budget is read by the worker thread
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_readBudget = budget;
+}
+
+unsigned int GltfStreamer::uploadBudget() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_uploadBudget;
+}
+
+void GltfStreamer::setUploadBudget(unsigned int budget)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_uploadBudget = budget;
+}
+
+void GltfStreamer::load(const std::string & filename)
+{
+    // Streamer can only be used once
+    if (m_thread.joinable()) {
+        return;
+    }
+
+    // Start worker thread
+    m_filename = filename;
+    m_thread   = std::thread(&GltfStreamer::run, this);
+}
+
+bool GltfStreamer::busy() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (m_thread.joinable() && !m_finished) || !m_queue.scenes.empty() || !m_queue.meshes.empty() || !m_queue.images.empty() || !m_readyMeshes.empty();
+}
+
+bool GltfStreamer::update(const glm::mat4 & transform, const rendercore::Camera & camera)
+{
+    // Take objects that are ready
+    Results      results;
+    unsigned int uploadBudget = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::swap(results, m_queue);
+        uploadBudget = m_uploadBudget;
+    }
+
+    bool changed = !results.buffers.empty() || !results.textures.empty() || !results.scenes.empty() || !results.images.empty();
+
+    // Hand over new objects
+    for (auto & buffer   : results.buffers)   m_availableBuffers.push_back(std::move(buffer));
+    for (auto & texture  : results.textures)  m_availableTextures.push_back(std::move(texture));
+    for (auto & sampler  : results.samplers)  m_availableSamplers.push_back(std::move(sampler));
+    for (auto & material : results.materials) m_availableMaterials.push_back(std::move(material));
+    for (auto & mesh     : results.proxies)   m_availableMeshes.push_back(std::move(mesh));
+    for (auto & scene    : results.scenes)    m_availableScenes.push_back(std::move(scene));
+
+    // Remember pending components and textures
+    m_components.insert(m_components.end(), results.components.begin(), results.components.end());
+    m_bindings.insert(m_bindings.end(), results.bindings.begin(), results.bindings.end());
+    if (!results.bounds.empty()) {
+        m_bounds = std::move(results.bounds);
+    }
+
+    for (auto & it : results.meshes) {
+        m_readyMeshes[it.first] = std::move(it.second);
+    }
+
+    // Determine priority of each mesh from the projected size of its components
+    std::vector<float> priorities(m_bounds.size(), 0.0f);
+    if (!m_components.empty()) {
+        // Get view frustum planes in world space
+        const glm::mat4 & viewProjection = camera.viewProjectionMatrix();
+        glm::vec4 rows[4];
+        for (int i=0; i<4; i++) {
+            rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+        }
+
+        glm::vec4 planes[6] = {
+            rows[3] + rows[0], rows[3] - rows[0],
+            rows[3] + rows[1], rows[3] - rows[1],
+            rows[3] + rows[2], rows[3] - rows[2]
+        };
+
+        for (auto & plane : planes) {
+            float length = glm::length(glm::vec3(plane));
+            if (length > 0.0f) plane /= length;
+        }
+
+        // Components that share a mesh raise its priority
+        for (const auto & pending : m_components) {
+            if (pending.mesh >= priorities.size()) continue;
+
+            const glm::mat4 model = transform * pending.component->node()->globalTransform();
+            priorities[pending.mesh] = std::max(priorities[pending.mesh], projectedRadius(m_bounds[pending.mesh], model, planes, camera));
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_meshPriorities.size() == priorities.size()) {
+            m_meshPriorities = priorities;
+        }
+    }
+
+    // Hand over generated meshes in order of priority, within the upload budget
+    std::vector<opengl::Mesh *> attached(m_bounds.size(), nullptr);
+    unsigned int bytes     = 0;
+    bool         attaching = false;
+    while (!m_readyMeshes.empty()) {
+        // Select mesh with the highest priority
+        auto next = m_readyMeshes.begin();
+        for (auto it = m_readyMeshes.begin(); it != m_readyMeshes.end(); ++it) {
+            if (it->first < priorities.size() && (next->first >= priorities.size() || priorities[it->first] > priorities[next->first])) {
+                next = it;
+            }
+        }
+
+        // Get size of the buffers that have not been uploaded yet
+        unsigned int size = 0;
+        for (auto * buffer : next->second->buffers()) {
+            if (m_uploaded.count(buffer) == 0) size += buffer->size();
+        }
+
+        if (bytes > 0 && bytes + size > uploadBudget) {
+            break;
+        }
+
+        bytes += size;
+        for (auto * buffer : next->second->buffers()) {
+            m_uploaded.insert(buffer);
+        }
+
+        // Hand over mesh
+        if (next->first < attached.size()) {
+            attached[next->first] = next->second.get();
+        }
+
+        m_availableMeshes.push_back(std::move(next->second));
+        m_readyMeshes.erase(next);
+        attaching = true;
+    }
+
+    // Attach meshes to their components and remove the proxies
+    if (attaching) {
+        m_components.erase(std::remove_if(m_components.begin(), m_components.end(), [&attached] (const PendingComponent & pending) {
+            opengl::Mesh * mesh = pending.mesh < attached.size() ? attached[pending.mesh] : nullptr;
+            if (!mesh) {
+                return false;
+            }
+
+            pending.component->setMesh(mesh);
+            if (pending.proxy && pending.proxy->parent()) {
+                pending.proxy->parent()->removeChild(pending.proxy);
+            }
+
+            return true;
+        }), m_components.end());
+    }
+
+    // Assign decoded images (uploads are spread over several frames by the texture streamer)
+    if (!results.images.empty()) {
+        for (auto & it : results.images) {
+            it.first->setImage(std::move(it.second));
+        }
+
+        m_bindings.erase(std::remove_if(m_bindings.begin(), m_bindings.end(), [] (const TextureBinding & binding) {
+            if (!binding.texture->image()) {
+                return false;
+            }
+
+            binding.material->setTexture(binding.name, binding.texture);
+            return true;
+        }), m_bindings.end());
+    }
+
+    return changed || attaching;
+}
+
+std::vector< std::unique_ptr<rendercore::opengl::Buffer> > & GltfStreamer::buffers()
+{
+    return m_availableBuffers;
+}
+
+std::vector< std::unique_ptr<rendercore::opengl::Texture> > & GltfStreamer::textures()
+{
+    return m_availableTextures;
+}
+
+std::vector< std::unique_ptr<rendercore::opengl::Sampler> > & GltfStreamer::samplers()
+{
+    return m_availableSamplers;
+}
+
+std::vector< std::unique_ptr<rendercore::opengl::Material> > & GltfStreamer::materials()
+{
+    return m_availableMaterials;
+}
+
+std::vector< std::unique_ptr<rendercore::opengl::Mesh> > & GltfStreamer::meshes()
+{
+    return m_availableMeshes;
+}
+
+std::vector< std::unique_ptr<rendercore::Scene> > & GltfStreamer::scenes()
+{
+    return m_availableScenes;
+}
+
+void GltfStreamer::run()
+{
+    // Load and convert asset
+    stream();
+
+    // Done
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_finished = true;
+}
+
+void GltfStreamer::stream()
+{
+    auto start = std::chrono::steady_clock::now();
+
+    // Load GLTF asset
+    GltfLoader loader;
+    auto asset = loader.load(m_filename);
+    if (!asset) {
+        cppassist::warning("rendercore-gltf") << "Could not load '" << m_filename << "'";
+        return;
+    }
+
+    WorkerPool pool;
+
+    // Find buffers that are modified by the conversion
+    auto buffers = asset->buffers();
+    std::vector<bool> writable = writableBuffers(*asset);
+
+    // Load data buffers (files are mapped, their data is read when it is accessed)
+    m_data.clear();
+    m_data.resize(buffers.size());
+    for (size_t i=0; i<buffers.size(); i++) {
+        bool write = writable[i];
+        pool.run([this, &asset, i, write] () {
+            loadData(*asset, i, write);
+        });
+    }
+
+    pool.wait();
+
+    // Decompress buffer views that are needed for the scene hierarchy (animations and skins may use compressed data)
+    auto geometryViews = geometryBufferViews(*asset);
+
+    std::vector<bool> hierarchyViews(geometryViews.size());
+    for (size_t i=0; i<geometryViews.size(); i++) {
+        hierarchyViews[i] = !geometryViews[i];
+    }
+
+    m_decodedAttributes.clear();
+    m_decodedIndices.clear();
+    decompress(*asset, pool, hierarchyViews, false);
+
+    // Stage 1: Hand over scene hierarchy
+    {
+        Results results;
+        generateHierarchy(*asset, results);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stop) return;
+
+        m_meshPriorities.assign(results.bounds.size(), 0.0f);
+        std::swap(m_queue, results);
+    }
+
+    cppassist::info("rendercore-gltf") << "Scene hierarchy of '" << m_filename << "' available after "
+                                       << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count() << " ms";
+
+    // Decompress geometry
+    decompress(*asset, pool, geometryViews, true);
+
+    // Process geometry
+    if (m_geometryOptimization) {
+        optimizeGeometry(*asset, pool);
+    }
+
+    m_lods.clear();
+    if (m_lodLevels > 0) {
+        generateLods(*asset, pool);
+    }
+
+    m_meshlets.clear();
+    if (m_meshletThreshold > 0) {
+        buildMeshlets(*asset, pool);
+    }
+
+    // Create buffers that are shared by all meshes
+    m_vertexBuffers.clear();
+    m_indexBuffers.clear();
+    m_quantizedAttributes.clear();
+    createBuffers(*asset);
+
+    // Generate materials (this creates the textures, but does not load their images)
+    for (auto * material : asset->materials()) {
+        generateMaterial(*asset, *material);
+    }
+
+    // Stage 2: Hand over buffers and materials, textures are set when their images are available
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stop) return;
+
+        for (auto & material : m_materials) {
+            for (const char * name : textureNames) {
+                auto * texture = material->texture(name);
+                if (!texture) continue;
+
+                TextureBinding binding;
+                binding.material = material.get();
+                binding.name     = name;
+                binding.texture  = texture;
+                m_queue.bindings.push_back(binding);
+
+                material->setTexture(name, nullptr);
+            }
+        }
+
+        for (auto & buffer   : m_buffers)   m_queue.buffers.push_back(std::move(buffer));
+        for (auto & texture  : m_textures)  m_queue.textures.push_back(std::move(texture));
+        for (auto & sampler  : m_samplers)  m_queue.samplers.push_back(std::move(sampler));
+        for (auto & material : m_materials) m_queue.materials.push_back(std::move(material));
+    }
+
+    // Generate meshes in order of priority
+    m_readStart = std::chrono::steady_clock::now();
+    m_readBytes = 0;
+
+    auto gltfMeshes = asset->meshes();
+    std::vector<bool> generated(gltfMeshes.size(), false);
+    for (size_t n=0; n<gltfMeshes.size(); n++) {
+        // Select mesh with the highest priority
+        size_t next = gltfMeshes.size();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (size_t i=0; i<gltfMeshes.size(); i++) {
+                if (!generated[i] && (next == gltfMeshes.size() || priority(static_cast<unsigned int>(i)) > priority(static_cast<unsigned int>(next)))) {
+                    next = i;
+                }
+            }
+        }
+
+        generated[next] = true;
+
+        // Generate mesh and read its data
+        auto mesh = generateMesh(*asset, *gltfMeshes[next]);
+        unsigned int bytes = readAhead(*mesh);
+
+        // Hand over mesh
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queue.meshes.push_back(std::make_pair(static_cast<unsigned int>(next), std::move(mesh)));
+        }
+
+        if (!throttle(bytes)) {
+            return;
+        }
+    }
+
+    // Stage 3: Decode images in order of priority (one batch of images per thread at a time)
+    std::vector< std::vector<int> > imageMeshes(asset->images().size());
+    auto images = meshImages(*asset);
+    for (size_t i=0; i<images.size(); i++) {
+        for (int image : images[i]) {
+            imageMeshes[image].push_back(static_cast<int>(i));
+        }
+    }
+
+    std::vector<int> pending;
+    for (auto & it : m_imageTextures) {
+        pending.push_back(it.first);
+    }
+
+    const size_t batchSize = pool.numThreads() + 1;
+    while (!pending.empty()) {
+        // Select images used by the meshes with the highest priority
+        std::vector<float> priorities(pending.size(), 0.0f);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (size_t i=0; i<pending.size(); i++) {
+                for (int mesh : imageMeshes[pending[i]]) {
+                    priorities[i] = std::max(priorities[i], priority(static_cast<unsigned int>(mesh)));
+                }
+            }
+        }
+
+        std::vector<size_t> order(pending.size());
+        for (size_t i=0; i<order.size(); i++) order[i] = i;
+
+        size_t count = std::min(batchSize, pending.size());
+        std::partial_sort(order.begin(), order.begin() + count, order.end(), [&priorities] (size_t a, size_t b) {
+            return priorities[a] > priorities[b];
+        });
+
+        std::vector<int> batch;
+        for (size_t i=0; i<count; i++) {
+            batch.push_back(pending[order[i]]);
+        }
+
+        for (int image : batch) {
+            pending.erase(std::find(pending.begin(), pending.end(), image));
+        }
+
+        // Decode images
+        std::vector< std::unique_ptr<rendercore::Image> > decoded(batch.size());
+        for (size_t i=0; i<batch.size(); i++) {
+            pool.run([this, &asset, &batch, &decoded, i] () {
+                decoded[i] = loadImage(*asset, batch[i]);
+            });
+        }
+
+        pool.wait();
+
+        // Hand over images
+        unsigned int bytes = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (size_t i=0; i<batch.size(); i++) {
+                if (!decoded[i]) continue;
+
+                bytes += decoded[i]->size();
+                m_queue.images.push_back(std::make_pair(m_imageTextures[batch[i]], std::move(decoded[i])));
+            }
+        }
+
+        if (!throttle(bytes)) {
+            return;
+        }
+    }
+
+    cppassist::info("rendercore-gltf") << "Streamed '" << m_filename << "' in "
+                                       << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count() << " ms";
+}
+
+std::vector<bool> GltfStreamer::geometryBufferViews(const Asset & asset) const
+{
+    auto gltfAccessors = asset.accessors();
+
+    std::vector<bool> geometry(asset.bufferViews().size(), false);
+    std::vector<bool> meshAccessors(gltfAccessors.size(), false);
+    std::vector<bool> excluded(geometry.size(), false);
+
+    // Mark buffer views of the vertex attributes, morph targets and indices of all primitives
+    auto mark = [&asset, &geometry, &meshAccessors, &excluded] (int accessorIndex, bool needsBounds)
+    {
+        auto * gltfAccessor = accessorIndex >= 0 ? asset.accessor(accessorIndex) : nullptr;
+        if (!gltfAccessor || gltfAccessor->bufferView() < 0 || static_cast<size_t>(gltfAccessor->bufferView()) >= geometry.size()) return;
+
+        geometry[gltfAccessor->bufferView()] = true;
+        meshAccessors[accessorIndex]         = true;
+
+        if (needsBounds && (gltfAccessor->minValue().size() != 3 || gltfAccessor->maxValue().size() != 3)) {
+            excluded[gltfAccessor->bufferView()] = true;
+        }
+    };
+
+    for (auto * gltfMesh : asset.meshes()) {
+        for (auto * gltfPrimitive : gltfMesh->primitives()) {
+            for (auto & it : gltfPrimitive->attributes()) {
+                mark(static_cast<int>(it.second), it.first == "POSITION");
+            }
+
+            for (const auto & gltfTarget : gltfPrimitive->targets()) {
+                for (auto & it : gltfTarget) {
+                    mark(static_cast<int>(it.second), false);
+                }
+            }
+
+            mark(gltfPrimitive->indices(), false);
+        }
+    }
+
+    // Exclude buffer views that are also used by other accessors (e.g., of animations, skins or instances)
+    for (size_t i=0; i<gltfAccessors.size(); i++) {
+        int bufferView = gltfAccessors[i]->bufferView();
+        if (!meshAccessors[i] && bufferView >= 0 && static_cast<size_t>(bufferView) < excluded.size()) {
+            excluded[bufferView] = true;
+        }
+    }
+
+    for (size_t i=0; i<geometry.size(); i++) {
+        if (excluded[i]) geometry[i] = false;
+    }
+
+    return geometry;
+}
+
+void GltfStreamer::generateHierarchy(const Asset & asset, Results & results)
+{
+    auto gltfMeshes = asset.meshes();
+
+    // Get bounds of each mesh from the bounds of its positions
+    std::vector<glm::vec3> minimum(gltfMeshes.size(), glm::vec3( std::numeric_limits<float>::max()));
+    std::vector<glm::vec3> maximum(gltfMeshes.size(), glm::vec3(-std::numeric_limits<float>::max()));
+    results.bounds.assign(gltfMeshes.size(), glm::vec4(0.0f));
+
+    for (size_t i=0; i<gltfMeshes.size(); i++) {
+        for (auto * gltfPrimitive : gltfMeshes[i]->primitives()) {
+            auto attributes = gltfPrimitive->attributes();
+            auto it = attributes.find("POSITION");
+            if (it == attributes.end()) continue;
+
+            glm::vec3 boundsMin, boundsMax;
+            if (!readBounds(asset, it->second, boundsMin, boundsMax)) continue;
+
+            minimum[i] = glm::min(minimum[i], boundsMin);
+            maximum[i] = glm::max(maximum[i], boundsMax);
+        }
+
+        if (minimum[i].x <= maximum[i].x) {
+            results.bounds[i] = glm::vec4((minimum[i] + maximum[i]) * 0.5f, glm::length(maximum[i] - minimum[i]) * 0.5f);
+        }
+    }
+
+    // Create empty meshes with the bounds of the GLTF meshes, so that the scenes refer to them
+    std::unordered_map<const opengl::Mesh *, unsigned int> meshIndices;
+    m_meshes.clear();
+    for (size_t i=0; i<gltfMeshes.size(); i++) {
+        m_meshes.push_back(cppassist::make_unique<opengl::Mesh>());
+        m_meshes.back()->setBoundingBox(minimum[i], maximum[i]);
+        meshIndices[m_meshes.back().get()] = static_cast<unsigned int>(i);
+    }
+
+    // Generate scenes
+    m_scenes.clear();
+    for (auto * scene : asset.scenes()) {
+        generateScene(asset, *scene);
+    }
+
+    // Create proxy mesh (unit box)
+    auto material = cppassist::make_unique<opengl::Material>();
+    material->setValue<glm::vec4>("baseColorFactor", glm::vec4(0.5f, 0.5f, 0.5f, 1.0f));
+    material->setValue<float>    ("metallicFactor",  0.0f);
+    material->setValue<float>    ("roughnessFactor", 1.0f);
+
+    auto box = cppassist::make_unique<Box>(nullptr, 1.0f);
+    for (auto & geometry : box->geometries()) {
+        geometry->setMaterial(material.get());
+    }
+
+    // Replace the empty meshes by proxies that show their bounds
+    std::vector<SceneNode *> stack;
+    for (auto & scene : m_scenes) {
+        stack.push_back(scene->root());
+    }
+
+    while (!stack.empty()) {
+        SceneNode * node = stack.back();
+        stack.pop_back();
+
+        for (auto * child : node->children()) {
+            stack.push_back(child);
+        }
+
+        for (auto * component : node->components<MeshComponent>()) {
+            auto it = meshIndices.find(component->mesh());
+            if (it == meshIndices.end()) continue;
+
+            unsigned int meshIndex = it->second;
+            component->setMesh(nullptr);
+
+            PendingComponent pending;
+            pending.component = component;
+            pending.proxy     = nullptr;
+            pending.mesh      = meshIndex;
+
+            // Create proxy node (the box is scaled to the bounds of the mesh)
+            const glm::vec4 & sphere = results.bounds[meshIndex];
+            if (sphere.w > 0.0f) {
+                Transform transform;
+                transform.setTranslation(glm::vec3(sphere));
+                transform.setScale(glm::max(maximum[meshIndex] - minimum[meshIndex], glm::vec3(sphere.w * 0.01f)));
+
+                auto proxyComponent = cppassist::make_unique<MeshComponent>();
+                proxyComponent->setMesh(box.get());
+
+                auto proxy = cppassist::make_unique<SceneNode>();
+                proxy->setTransform(transform);
+                proxy->addComponent(std::move(proxyComponent));
+
+                pending.proxy = proxy.get();
+                node->addChild(std::move(proxy));
+            }
+
+            results.components.push_back(pending);
+        }
+    }
+
+    // Empty meshes are no longer used
+    m_meshes.clear();
+
+    // Save results
+    for (auto & scene : m_scenes) {
+        results.scenes.push_back(std::move(scene));
+    }
+
+    m_scenes.clear();
+    results.materials.push_back(std::move(material));
+    results.proxies.push_back(std::move(box));
+}
+
+std::vector< std::vector<int> > GltfStreamer::meshImages(const Asset & asset) const
+{
+    auto gltfMeshes = asset.meshes();
+    std::vector< std::vector<int> > images(gltfMeshes.size());
+
+    for (size_t i=0; i<gltfMeshes.size(); i++) {
+        for (auto * gltfPrimitive : gltfMeshes[i]->primitives()) {
+            // Get material
+            auto * gltfMaterial = asset.material(gltfPrimitive->material());
+            if (!gltfMaterial) continue;
+
+            // Get images of all textures
+            int textureInfos[] = {
+                gltfMaterial->baseColorTexture(),
+                gltfMaterial->metallicRoughnessTexture(),
+                gltfMaterial->normalTexture(),
+                gltfMaterial->occlusionTexture(),
+                gltfMaterial->emissiveTexture()
+            };
+
+            for (int textureInfo : textureInfos) {
+                if (textureInfo < 0) continue;
+
+                auto * gltfTextureInfo = asset.textureInfo(textureInfo);
+                auto * gltfTexture     = gltfTextureInfo ? asset.texture(gltfTextureInfo->texture()) : nullptr;
+                if (!gltfTexture || gltfTexture->image() < 0 || gltfTexture->image() >= (int)asset.images().size()) continue;
+
+                if (std::find(images[i].begin(), images[i].end(), gltfTexture->image()) == images[i].end()) {
+                    images[i].push_back(gltfTexture->image());
+                }
+            }
+        }
+    }
+
+    return images;
+}
+
+unsigned int GltfStreamer::readAhead(const opengl::Mesh & mesh)
+{
+    unsigned int bytes = 0;
+    unsigned int sum   = 0;
+
+    for (auto * buffer : mesh.buffers()) {
+        // Buffers are shared by several meshes
+        if (!m_readBuffers.insert(buffer).second) continue;
+
+        // Touch each page of the data
+        const char * data = buffer->data();
+        unsigned int size = buffer->size();
+        if (!data) continue;
+
+        for (unsigned int offset = 0; offset < size; offset += 4096) {
+            sum += static_cast<unsigned char>(data[offset]);
+        }
+
+        bytes += size;
+    }
+
+    // Make sure that the reads are not optimized away
+    static volatile unsigned int sink;
+    sink = sum;
+
+    return bytes;
+}
+
+bool GltfStreamer::throttle(unsigned int bytes)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    // Wait until the data is within the budget
+    m_readBytes += bytes;
+    if (m_readBudget > 0) {
+        auto due = m_readStart + std::chrono::microseconds(m_readBytes * 1000000ull / m_readBudget);
+        m_signal.wait_until(lock, due, [this] () { return m_stop; });
+    }
+
+    return !m_stop;
+}
+
+float GltfStreamer::priority(unsigned int mesh) const
+{
+    return mesh < m_meshPriorities.size() ? m_meshPriorities[mesh] : 0.0f;
+}
+
+
+} // namespace gltf
+} // namespace rendercore
@@ -0,0 +1,657 @@
+
+#include <rendercore-gltf/JsonReader.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define JSON_READER_SSE2
+    #include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+
+namespace
+{
+
+
+// Exactly representable powers of ten
+const double powersOfTen[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+inline bool isWhitespace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+inline bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+#ifdef JSON_READER_SSE2
+inline unsigned int firstBit(unsigned int mask)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned int>(index);
+#else
+    return static_cast<unsigned int>(__builtin_ctz(mask));
+#endif
+}
+#endif
+
+void appendUtf8(std::string & str, unsigned int codepoint)
+{
+    if (codepoint < 0x80) {
+        str += static_cast<char>(codepoint);
+    } else if (codepoint < 0x800) {
+        str += static_cast<char>(0xC0 | (codepoint >> 6));
+        str += static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else if (codepoint < 0x10000) {
+        str += static_cast<char>(0xE0 | (codepoint >> 12));
+        str += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        str += static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else {
+        str += static_cast<char>(0xF0 | (codepoint >> 18));
+        str += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+        str += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        str += static_cast<char>(0x80 | (codepoint & 0x3F));
+    }
+}
+
+bool parseHex4(const char * pos, const char * end, unsigned int & value)
+{
+    if (end - pos < 4) {
+        return false;
+    }
+
+    value = 0;
+    for (int i=0; i<4; i++) {
+        char c = pos[i];
+        value <<= 4;
+
+        if      (c >= '0' && c <= '9') value |= static_cast<unsigned int>(c - '0');
+        else if (c >= 'a' && c <= 'f') value |= static_cast<unsigned int>(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') value |= static_cast<unsigned int>(c - 'A' + 10);
+        else return false;
+    }
+
+    return true;
+}
+
+
+} // namespace
+
+
+namespace rendercore
+{
+namespace gltf
+{
+
+
+JsonReader::JsonReader(const char * data, size_t size)
+: m_begin(data)
+, m_end(data + size)
+, m_pos(data)
+, m_first(false)
+, m_error(false)
+{
+    // Skip UTF-8 byte order mark
+    if (size >= 3 && std::memcmp(data, "\xEF\xBB\xBF", 3) == 0) {
+        m_pos += 3;
+    }
+}
+
+JsonReader::~JsonReader()
+{
+}
+
+bool JsonReader::error() const
+{
+    return m_error;
+}
+
+size_t JsonReader::position() const
+{
+    return static_cast<size_t>(m_pos - m_begin);
+}
+
+JsonReader::Type JsonReader::peek()
+{
+    // Check state
+    if (m_error) {
+        return Type::Invalid;
+    }
+
+    // Get next character
+    skipWhitespace();
+    if (m_pos >= m_end) {
+        return Type::Invalid;
+    }
+
+    // Determine type
+    switch (*m_pos) {
+        case '{': return Type::Object;
+        case '[': return Type::Array;
+        case '"': return Type::String;
+        case 't':
+        case 'f': return Type::Boolean;
+        case 'n': return Type::Null;
+        case '-': return Type::Number;
+        default:  return isDigit(*m_pos) ? Type::Number : Type::Invalid;
+    }
+}
+
+bool JsonReader::beginObject()
+{
+    // Check for object
+    if (peek() != Type::Object) {
+        return fail();
+    }
+
+    // Enter object
+    m_pos++;
+    m_first = true;
+    return true;
+}
+
+bool JsonReader::nextKey(std::string & key)
+{
+    // Check for another key
+    if (!consumeSeparator('}')) {
+        return false;
+    }
+
+    // Read key
+    skipWhitespace();
+    if (m_pos >= m_end || *m_pos != '"' || !readString(key)) {
+        return fail();
+    }
+
+    // Read colon
+    skipWhitespace();
+    if (m_pos >= m_end || *m_pos != ':') {
+        return fail();
+    }
+
+    m_pos++;
+    return true;
+}
+
+bool JsonReader::beginArray()
+{
+    // Check for array
+    if (peek() != Type::Array) {
+        return fail();
+    }
+
+    // Enter array
+    m_pos++;
+    m_first = true;
+    return true;
+}
+
+bool JsonReader::nextElement()
+{
+    return consumeSeparator(']');
+}
+
+bool JsonReader::readString(std::string & value)
+{
+    // Check for string
+    if (peek() != Type::String) {
+        return fail();
+    }
+
+    const char * pos = m_pos + 1;
+
+    // Find end of string
+    const char * end = scanString(pos);
+    if (end >= m_end) {
+        return fail();
+    }
+
+    // Fast path: string without escape sequences
+    if (*end == '"') {
+        value.assign(pos, end);
+        m_pos = end + 1;
+        return true;
+    }
+
+    // Decode escape sequences
+    value.assign(pos, end);
+    pos = end;
+
+    while (pos < m_end) {
+        // End of string
+        if (*pos == '"') {
+            m_pos = pos + 1;
+            return true;
+        }
+
+        // Escape sequence
+        if (++pos >= m_end) {
+            break;
+        }
+
+        switch (*pos++) {
+            case '"':  value += '"';  break;
+            case '\\': value += '\\'; break;
+            case '/':  value += '/';  break;
+            case 'b':  value += '\b'; break;
+            case 'f':  value += '\f'; break;
+            case 'n':  value += '\n'; break;
+            case 'r':  value += '\r'; break;
+            case 't':  value += '\t'; break;
+
+            case 'u':
+            {
+                unsigned int codepoint;
+                if (!parseHex4(pos, m_end, codepoint)) {
+                    return fail();
+                }
+
+                pos += 4;
+
+                // Combine surrogate pair
+                if (codepoint >= 0xD800 && codepoint <= 0xDBFF) {
+                    unsigned int low;
+                    if (m_end - pos < 6 || pos[0] != '\\' || pos[1] != 'u' || !parseHex4(pos + 2, m_end, low) || low < 0xDC00 || low > 0xDFFF) {
+                        return fail();
+                    }
+
+                    codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                    pos += 6;
+                }
+
+                appendUtf8(value, codepoint);
+                break;
+            }
+
+            default:
+                return fail();
+        }
+
+        // Copy characters up to the next quote or backslash
+        end = scanString(pos);
+        value.append(pos, end);
+        pos = end;
+    }
+
+    // Unterminated string
+    return fail();
+}
+
+bool JsonReader::readNumber(double & value)
+{
+    // Check for number
+    if (peek() != Type::Number) {
+        return fail();
+    }
+
+    const char * pos = m_pos;
+
+    // Sign
+    bool negative = (*pos == '-');
+    if (negative) {
+        pos++;
+    }
+
+    // Integer part (up to 19 significant digits fit into the mantissa)
+    uint64_t mantissa = 0;
+    int      digits   = 0;
+    int      exponent = 0;
+    const char * start = pos;
+
+    while (pos < m_end && isDigit(*pos)) {
+        if (digits < 19) {
+            mantissa = mantissa * 10 + static_cast<uint64_t>(*pos - '0');
+            if (mantissa > 0) digits++;
+        } else {
+            exponent++;
+        }
+
+        pos++;
+    }
+
+    if (pos == start) {
+        return fail();
+    }
+
+    // Fractional part
+    if (pos < m_end && *pos == '.') {
+        pos++;
+        start = pos;
+
+        while (pos < m_end && isDigit(*pos)) {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*pos - '0');
+                if (mantissa > 0) digits++;
+                exponent--;
+            }
+
+            pos++;
+        }
+
+        if (pos == start) {
+            return fail();
+        }
+    }
+
+    // Exponent
+    if (pos < m_end && (*pos == 'e' || *pos == 'E')) {
+        pos++;
+
+        bool negativeExponent = false;
+        if (pos < m_end && (*pos == '-' || *pos == '+')) {
+            negativeExponent = (*pos == '-');
+            pos++;
+        }
+
+        start = pos;
+        int e = 0;
+
+        while (pos < m_end && isDigit(*pos)) {
+            if (e < 10000) {
+                e = e * 10 + (*pos - '0');
+            }
+
+            pos++;
+        }
+
+        if (pos == start) {
+            return fail();
+        }
+
+        exponent += negativeExponent ? -e : e;
+    }
+
+    // Convert exactly if mantissa and power of ten are representable as double
+    if (mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+        double result = static_cast<double>(mantissa);
+        result = (exponent < 0) ? result / powersOfTen[-exponent] : result * powersOfTen[exponent];
+        value = negative ? -result : result;
+    } else {
+        // Fall back to the standard library for correct rounding
+        std::string str(m_pos, pos);
+        value = std::strtod(str.c_str(), nullptr);
+    }
+
+    m_pos = pos;
+    return true;
+}
+
+bool JsonReader::readBool(bool & value)
+{
+    // Check for boolean
+    if (peek() != Type::Boolean) {
+        return fail();
+    }
+
+    // Read literal
+    value = (*m_pos == 't');
+    return value ? skipLiteral("true", 4) : skipLiteral("false", 5);
+}
+
+float JsonReader::readFloat()
+{
+    double value = 0.0;
+    readNumber(value);
+    return static_cast<float>(value);
+}
+
+int JsonReader::readInt()
+{
+    double value = 0.0;
+    readNumber(value);
+    return static_cast<int>(value);
+}
+
+unsigned int JsonReader::readUInt()
+{
+    double value = 0.0;
+    readNumber(value);
+    return value > 0.0 ? static_cast<unsigned int>(value) : 0u;
+}
+
+bool JsonReader::skipValue()
+{
+    // Determine type of value
+    switch (peek()) {
+        case Type::String:
+        {
+            // Find closing quote, skipping escaped characters
+            const char * pos = m_pos + 1;
+
+            while (true) {
+                pos = scanString(pos);
+                if (pos >= m_end) {
+                    return fail();
+                }
+
+                if (*pos == '"') {
+                    break;
+                }
+
+                pos += 2;
+            }
+
+            m_pos = pos + 1;
+            return true;
+        }
+
+        case Type::Number:
+        {
+            double value;
+            return readNumber(value);
+        }
+
+        case Type::Boolean:
+            return (*m_pos == 't') ? skipLiteral("true", 4) : skipLiteral("false", 5);
+
+        case Type::Null:
+            return skipLiteral("null", 4);
+
+        case Type::Object:
+        case Type::Array:
+        {
+            // Find matching bracket (nesting is counted, but not validated)
+            const char * pos   = m_pos + 1;
+            int          depth = 1;
+
+            while (pos < m_end) {
+#ifdef JSON_READER_SSE2
+                // Skip 16 characters at a time that are neither brackets nor quotes
+                // ('[' | 0x20 == '{', ']' | 0x20 == '}')
+                const __m128i quote = _mm_set1_epi8('"');
+                const __m128i open  = _mm_set1_epi8('{');
+                const __m128i close = _mm_set1_epi8('}');
+                const __m128i lower = _mm_set1_epi8(0x20);
+
+                while (m_end - pos >= 16) {
+                    __m128i chunk  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+                    __m128i folded = _mm_or_si128(chunk, lower);
+                    __m128i match  = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                                     _mm_or_si128(_mm_cmpeq_epi8(folded, open), _mm_cmpeq_epi8(folded, close)));
+
+                    unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(match));
+                    if (mask != 0) {
+                        pos += firstBit(mask);
+                        break;
+                    }
+
+                    pos += 16;
+                }
+
+                if (pos >= m_end) {
+                    break;
+                }
+#endif
+
+                char c = *pos;
+
+                if (c == '"') {
+                    // Skip string
+                    pos++;
+
+                    while (true) {
+                        pos = scanString(pos);
+                        if (pos >= m_end) {
+                            return fail();
+                        }
+
+                        if (*pos == '"') {
+                            break;
+                        }
+
+                        pos += 2;
+                    }
+                } else if (c == '{' || c == '[') {
+                    depth++;
+                } else if (c == '}' || c == ']') {
+                    if (--depth == 0) {
+                        m_pos   = pos + 1;
+                        m_first = false;
+                        return true;
+                    }
+                }
+
+                pos++;
+            }
+
+            // Unterminated object or array
+            return fail();
+        }
+
+        default:
+            return fail();
+    }
+}
+
+void JsonReader::skipWhitespace()
+{
+    // Most values are not preceded by whitespace
+    if (m_pos >= m_end || !isWhitespace(*m_pos)) {
+        return;
+    }
+
+#ifdef JSON_READER_SSE2
+    // Skip 16 characters at a time (indentation in pretty-printed files)
+    const __m128i space   = _mm_set1_epi8(' ');
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i cr      = _mm_set1_epi8('\r');
+    const __m128i tab     = _mm_set1_epi8('\t');
+
+    while (m_end - m_pos >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(m_pos));
+        __m128i ws    = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, newline)),
+                                     _mm_or_si128(_mm_cmpeq_epi8(chunk, cr),    _mm_cmpeq_epi8(chunk, tab)));
+
+        unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(ws)) ^ 0xFFFFu;
+        if (mask != 0) {
+            m_pos += firstBit(mask);
+            return;
+        }
+
+        m_pos += 16;
+    }
+#endif
+
+    while (m_pos < m_end && isWhitespace(*m_pos)) {
+        m_pos++;
+    }
+}
+
+const char * JsonReader::scanString(const char * pos) const
+{
+#ifdef JSON_READER_SSE2
+    // Scan 16 characters at a time
+    const __m128i quote     = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+
+    while (m_end - pos >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+        __m128i match = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash));
+
+        unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(match));
+        if (mask != 0) {
+            return pos + firstBit(mask);
+        }
+
+        pos += 16;
+    }
+#endif
+
+    while (pos < m_end && *pos != '"' && *pos != '\\') {
+        pos++;
+    }
+
+    return pos;
+}
+
+bool JsonReader::skipLiteral(const char * literal, size_t length)
+{
+    // Compare literal
+    if (static_cast<size_t>(m_end - m_pos) < length || std::memcmp(m_pos, literal, length) != 0) {
+        return fail();
+    }
+
+    m_pos += length;
+    return true;
+}
+
+bool JsonReader::consumeSeparator(char close)
+{
+    // Check state
+    if (m_error) {
+        return false;
+    }
+
+    skipWhitespace();
+    if (m_pos >= m_end) {
+        return fail();
+    }
+
+    // End of object or array
+    if (*m_pos == close) {
+        m_pos++;
+        m_first = false;
+        return false;
+    }
+
+    // Values after the first one are separated by commas
+    if (!m_first) {
+        if (*m_pos != ',') {
+            return fail();
+        }
+
+        m_pos++;
+
+        // No trailing comma
+        skipWhitespace();
+        if (m_pos >= m_end || *m_pos == close) {
+            return fail();
+        }
+    }
+
+    m_first = false;
+    return true;
+}
+
+bool JsonReader::fail()
+{
+    m_error = true;
+    return false;
+}
+
+
+} // namespace gltf
+} // namespace rendercore
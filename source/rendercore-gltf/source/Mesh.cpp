@@ -32,6 +32,16 @@ void Mesh::addPrimitive(std::unique_ptr<Primitive> && primitive)
     m_primitives.push_back(std::move(primitive));
 }
 
+const std::vector<float> & Mesh::weights() const
+{
+    return m_weights;
+}
+
+void Mesh::setWeights(const std::vector<float> & weights)
+{
+    m_weights = weights;
+}
+
 
 } // namespace gltf
 } // namespace rendercore
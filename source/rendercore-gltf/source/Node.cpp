@@ -11,6 +11,7 @@ namespace gltf
 Node::Node()
 : m_camera(-1)
 , m_mesh(-1)
+, m_skin(-1)
 , m_hasMatrix(false)
 , m_translation(0.0f, 0.0f, 0.0f)
 , m_rotation(0.0f, 0.0f, 0.0f, 1.0f)
@@ -108,6 +109,36 @@ void Node::setMesh(int mesh)
     m_mesh = mesh;
 }
 
+int Node::skin() const
+{
+    return m_skin;
+}
+
+void Node::setSkin(int skin)
+{
+    m_skin = skin;
+}
+
+const std::vector<float> & Node::weights() const
+{
+    return m_weights;
+}
+
+void Node::setWeights(const std::vector<float> & weights)
+{
+    m_weights = weights;
+}
+
+const std::map<std::string, unsigned int> & Node::instanceAttributes() const
+{
+    return m_instanceAttributes;
+}
+
+void Node::setInstanceAttributes(const std::map<std::string, unsigned int> & attributes)
+{
+    m_instanceAttributes = attributes;
+}
+
 
 } // namespace gltf
 } // namespace rendercore
@@ -12,6 +12,7 @@ Primitive::Primitive()
 : m_mode(4)
 , m_material(0)
 , m_indices(-1)
+, m_dracoBufferView(-1)
 {
 }
 
@@ -60,5 +61,31 @@ void Primitive::setAttributes(const std::map<std::string, unsigned int> & attrib
 }
 
 
+const std::vector< std::map<std::string, unsigned int> > & Primitive::targets() const
+{
+    return m_targets;
+}
+
+void Primitive::addTarget(const std::map<std::string, unsigned int> & target)
+{
+    m_targets.push_back(target);
+}
+
+int Primitive::dracoBufferView() const
+{
+    return m_dracoBufferView;
+}
+
+const std::map<std::string, unsigned int> & Primitive::dracoAttributes() const
+{
+    return m_dracoAttributes;
+}
+
+void Primitive::setDraco(int bufferView, const std::map<std::string, unsigned int> & attributes)
+{
+    m_dracoBufferView = bufferView;
+    m_dracoAttributes = attributes;
+}
+
 } // namespace gltf
 } // namespace rendercore
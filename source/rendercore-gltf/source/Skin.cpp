@@ -0,0 +1,63 @@
+
+#include <rendercore-gltf/Skin.h>
+
+
+namespace rendercore
+{
+namespace gltf
+{
+
+
+Skin::Skin()
+: m_inverseBindMatrices(-1)
+, m_skeleton(-1)
+{
+}
+
+Skin::~Skin()
+{
+}
+
+const std::string & Skin::name() const
+{
+    return m_name;
+}
+
+void Skin::setName(const std::string & name)
+{
+    m_name = name;
+}
+
+int Skin::inverseBindMatrices() const
+{
+    return m_inverseBindMatrices;
+}
+
+void Skin::setInverseBindMatrices(int inverseBindMatrices)
+{
+    m_inverseBindMatrices = inverseBindMatrices;
+}
+
+int Skin::skeleton() const
+{
+    return m_skeleton;
+}
+
+void Skin::setSkeleton(int skeleton)
+{
+    m_skeleton = skeleton;
+}
+
+const std::vector<unsigned int> & Skin::joints() const
+{
+    return m_joints;
+}
+
+void Skin::setJoints(const std::vector<unsigned int> & joints)
+{
+    m_joints = joints;
+}
+
+
+} // namespace gltf
+} // namespace rendercore
@@ -0,0 +1,213 @@
+
+#pragma once
+
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <rendercore/scene/Scene.h>
+
+#include <rendercore-opengl/Buffer.h>
+#include <rendercore-opengl/Mesh.h>
+#include <rendercore-opengl/Material.h>
+#include <rendercore-opengl/Texture.h>
+#include <rendercore-opengl/Sampler.h>
+
+#include <rendercore-opengl/rendercore-opengl_api.h>
+
+
+namespace rendercore
+{
+
+
+class MappedFile;
+
+
+namespace opengl
+{
+
+
+/**
+*  @brief
+*    Asset in a baked binary format that can be loaded without conversion
+*
+*  @remarks
+*    A baked asset file ('.rcasset') contains the objects that have been
+*    created by a converter (e.g., GltfConverter) in a GPU-ready form:
+*    vertex and index data, texture images with all mipmap levels,
+*    material values, and a flattened table of scene nodes.
+*
+*    The file consists of a header, fixed-size record tables, and data
+*    blocks aligned to 16 bytes. Loading maps the file into memory and
+*    only creates the objects from the records. Buffers and images
+*    reference the mapped data without a copy, so the data is read from
+*    disk when it is uploaded to the GPU. Files are stored in native
+*    byte order and are rejected if their version does not match.
+*
+*    Animations, skins, morph targets, and instanced meshes are not
+*    baked. Assets that rely on them must be converted on load.
+*/
+class RENDERCORE_OPENGL_API BakedAsset
+{
+public:
+    /**
+    *  @brief
+    *    Get version of the file format
+    *
+    *  @return
+    *    Version number (files of other versions are not loaded)
+    */
+    static unsigned int version();
+
+    /**
+    *  @brief
+    *    Save objects as baked asset
+    *
+    *  @param[in] filename
+    *    Filename of the baked asset
+    *  @param[in] buffers
+    *    List of buffers (buffers owned by meshes are saved as well)
+    *  @param[in] textures
+    *    List of textures
+    *  @param[in] samplers
+    *    List of samplers
+    *  @param[in] materials
+    *    List of materials
+    *  @param[in] meshes
+    *    List of meshes
+    *  @param[in] scenes
+    *    List of scenes
+    *
+    *  @return
+    *    'true' on success, else 'false'
+    *
+    *  @remarks
+    *    Texture images without mipmaps get their mipmaps generated, so
+    *    that they can be uploaded without further processing. The file
+    *    is written completely before it replaces an existing file.
+    */
+    static bool save(
+        const std::string & filename
+      , const std::vector< std::unique_ptr<Buffer> > & buffers
+      , const std::vector< std::unique_ptr<Texture> > & textures
+      , const std::vector< std::unique_ptr<Sampler> > & samplers
+      , const std::vector< std::unique_ptr<Material> > & materials
+      , const std::vector< std::unique_ptr<Mesh> > & meshes
+      , const std::vector< std::unique_ptr<rendercore::Scene> > & scenes);
+
+public:
+    /**
+    *  @brief
+    *    Constructor
+    */
+    BakedAsset();
+
+    /**
+    *  @brief
+    *    Destructor
+    */
+    ~BakedAsset();
+
+    /**
+    *  @brief
+    *    Load baked asset
+    *
+    *  @param[in] filename
+    *    Filename of the baked asset
+    *
+    *  @return
+    *    'true' on success, 'false' if the file does not exist, has another version, or is malformed
+    *
+    *  @remarks
+    *    Previously loaded objects are discarded. On success, the created
+    *    objects can be taken from the lists returned by buffers(),
+    *    textures(), samplers(), materials(), meshes(), and scenes().
+    */
+    bool load(const std::string & filename);
+
+    /**
+    *  @brief
+    *    Get buffers
+    *
+    *  @return
+    *    List of buffers (shared by the meshes)
+    */
+    std::vector< std::unique_ptr<Buffer> > & buffers();
+
+    /**
+    *  @brief
+    *    Get textures
+    *
+    *  @return
+    *    List of textures
+    */
+    std::vector< std::unique_ptr<Texture> > & textures();
+
+    /**
+    *  @brief
+    *    Get samplers
+    *
+    *  @return
+    *    List of samplers
+    */
+    std::vector< std::unique_ptr<Sampler> > & samplers();
+
+    /**
+    *  @brief
+    *    Get materials
+    *
+    *  @return
+    *    List of materials
+    */
+    std::vector< std::unique_ptr<Material> > & materials();
+
+    /**
+    *  @brief
+    *    Get meshes
+    *
+    *  @return
+    *    List of meshes
+    */
+    std::vector< std::unique_ptr<Mesh> > & meshes();
+
+    /**
+    *  @brief
+    *    Get scenes
+    *
+    *  @return
+    *    List of scenes
+    */
+    std::vector< std::unique_ptr<rendercore::Scene> > & scenes();
+
+protected:
+    /**
+    *  @brief
+    *    Create objects from the mapped file
+    *
+    *  @param[in] file
+    *    Mapped file
+    *
+    *  @return
+    *    'true' on success, 'false' if the file is malformed
+    */
+    bool createObjects(const std::shared_ptr<MappedFile> & file);
+
+    /**
+    *  @brief
+    *    Discard all objects
+    */
+    void clear();
+
+protected:
+    std::vector< std::unique_ptr<Buffer> >            m_buffers;   ///< List of buffers
+    std::vector< std::unique_ptr<Texture> >           m_textures;  ///< List of textures
+    std::vector< std::unique_ptr<Sampler> >           m_samplers;  ///< List of samplers
+    std::vector< std::unique_ptr<Material> >          m_materials; ///< List of materials
+    std::vector< std::unique_ptr<Mesh> >              m_meshes;    ///< List of meshes
+    std::vector< std::unique_ptr<rendercore::Scene> > m_scenes;    ///< List of scenes
+};
+
+
+} // namespace opengl
+} // namespace rendercore
@@ -28,8 +28,10 @@ public:
     *    Edge width, height, and depth
     *  @param[in] texCoords
     *    Generate texture coordinates?
+    *  @param[in] quantize
+    *    Store positions and texture coordinates as 16 bit normalized integers?
     */
-    Box(GpuContainer * container = nullptr, float size = 2.0f, bool texCoords = false);
+    Box(GpuContainer * container = nullptr, float size = 2.0f, bool texCoords = false, bool quantize = false);
 
     /**
     *  @brief
@@ -45,8 +47,15 @@ public:
     *    Edge depth
     *  @param[in] texCoords
     *    Generate texture coordinates?
+    *  @param[in] quantize
+    *    Store positions and texture coordinates as 16 bit normalized integers?
+    *
+    *  @remarks
+    *    Quantized positions are relative to the bounding box of the box
+    *    and need the position dequantization of the geometry to be applied
+    *    by the shader (as done by SceneRenderer).
     */
-    Box(GpuContainer * container, float width, float height, float depth, bool texCoords = false);
+    Box(GpuContainer * container, float width, float height, float depth, bool texCoords = false, bool quantize = false);
 
     /**
     *  @brief
@@ -105,6 +105,24 @@ public:
     template <typename Type, std::size_t Count>
     void setData(const std::array<Type, Count> & data);
 
+    /**
+    *  @brief
+    *    Reference data owned by another object
+    *
+    *  @param[in] data
+    *    Buffer data (can be null)
+    *  @param[in] size
+    *    Data size (in bytes)
+    *  @param[in] owner
+    *    Owner of the data
+    *
+    *  @remarks
+    *    The data is not copied. Instead, the buffer keeps a reference
+    *    to the owner (e.g., a memory-mapped file), which must keep the
+    *    data valid for as long as it lives.
+    */
+    void setExternalData(char * data, unsigned int size, std::shared_ptr<void> owner);
+
     /**
     *  @brief
     *    Allocate data
@@ -126,6 +144,24 @@ public:
     template <typename Type>
     void allocate(unsigned int numElements);
 
+    /**
+    *  @brief
+    *    Get usage hint
+    *
+    *  @return
+    *    Usage hint (default: GL_STATIC_DRAW)
+    */
+    gl::GLenum usage() const;
+
+    /**
+    *  @brief
+    *    Set usage hint
+    *
+    *  @param[in] usage
+    *    Usage hint (e.g., GL_STREAM_DRAW for data that changes every frame)
+    */
+    void setUsage(gl::GLenum usage);
+
     /**
     *  @brief
     *    Get OpenGL buffer
@@ -145,12 +181,17 @@ protected:
     /**
     *  @brief
     *    Create buffer from data
+    *
+    *  @remarks
+    *    An existing buffer is reused when only the data has changed.
     */
     void createFromData();
 
 protected:
     std::unique_ptr<globjects::Buffer> m_buffer; ///< OpenGL buffer (can be null)
-    std::vector<char>                  m_data;   ///< Buffer data
+    std::shared_ptr<char>              m_data;   ///< Buffer data (can be null)
+    unsigned int                       m_size;   ///< Data size (in bytes)
+    gl::GLenum                         m_usage;  ///< Usage hint
 };
 
 
@@ -4,11 +4,16 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
 
 #include <glbinding/gl/types.h>
 
 #include <globjects/VertexArray.h>
 
+#include <rendercore/MeshletBuilder.h>
+
 #include <rendercore-opengl/rendercore-opengl_api.h>
 
 
@@ -20,6 +25,7 @@ namespace opengl
 
 class Material;
 class Buffer;
+class MorphTargets;
 class VertexAttribute;
 
 
@@ -29,6 +35,22 @@ class VertexAttribute;
 */
 class RENDERCORE_OPENGL_API Geometry
 {
+public:
+    /**
+    *  @brief
+    *    Level of detail
+    *
+    *  @remarks
+    *    All levels of detail use the same vertices and index buffer,
+    *    each level is a range of indices within the index buffer.
+    */
+    struct Lod
+    {
+        unsigned int offset; ///< Index of the first element
+        unsigned int count;  ///< Number of elements to render
+        float        error;  ///< Geometric error compared to the original geometry (in model space)
+    };
+
 public:
     /**
     *  @brief
@@ -107,6 +129,151 @@ public:
     */
     void setCount(unsigned int count);
 
+    /**
+    *  @brief
+    *    Get base vertex
+    *
+    *  @return
+    *    Value that is added to each index before fetching the vertex
+    */
+    int baseVertex() const;
+
+    /**
+    *  @brief
+    *    Set base vertex
+    *
+    *  @param[in] baseVertex
+    *    Value that is added to each index before fetching the vertex
+    *
+    *  @remarks
+    *    This allows for narrow index types when a geometry references a
+    *    range of vertices far into a shared vertex buffer. It is not
+    *    applied when drawing meshlets.
+    */
+    void setBaseVertex(int baseVertex);
+
+    /**
+    *  @brief
+    *    Check if primitive restart is enabled
+    *
+    *  @return
+    *    'true' if the maximum value of the index type separates primitives, else 'false'
+    */
+    bool primitiveRestart() const;
+
+    /**
+    *  @brief
+    *    Enable or disable primitive restart
+    *
+    *  @param[in] enabled
+    *    'true' if the maximum value of the index type separates primitives, else 'false'
+    *
+    *  @remarks
+    *    This allows for drawing several strips, fans or loops with a
+    *    single draw call (uses GL_PRIMITIVE_RESTART, available since
+    *    OpenGL 3.1, with the maximum value of the index type).
+    */
+    void setPrimitiveRestart(bool enabled);
+
+    /**
+    *  @brief
+    *    Get levels of detail
+    *
+    *  @return
+    *    List of levels of detail, ordered from the most to the least detailed (empty if there is only the full geometry)
+    */
+    const std::vector<Lod> & lods() const;
+
+    /**
+    *  @brief
+    *    Add level of detail
+    *
+    *  @param[in] offset
+    *    Index of the first element in the index buffer
+    *  @param[in] count
+    *    Number of elements to render
+    *  @param[in] error
+    *    Geometric error compared to the original geometry (in model space)
+    *
+    *  @remarks
+    *    Levels of detail must be added in the order of increasing error,
+    *    starting with the full geometry.
+    */
+    void addLod(unsigned int offset, unsigned int count, float error);
+
+    /**
+    *  @brief
+    *    Get bounding sphere
+    *
+    *  @return
+    *    Center (xyz) and radius (w) in model space (radius 0 if unknown)
+    */
+    const glm::vec4 & boundingSphere() const;
+
+    /**
+    *  @brief
+    *    Set bounding sphere
+    *
+    *  @param[in] sphere
+    *    Center (xyz) and radius (w) in model space (radius 0 if unknown)
+    */
+    void setBoundingSphere(const glm::vec4 & sphere);
+
+    /**
+    *  @brief
+    *    Get minimum of the bounding box
+    *
+    *  @return
+    *    Minimum position in model space (greater than the maximum if unknown)
+    */
+    const glm::vec3 & boundingBoxMin() const;
+
+    /**
+    *  @brief
+    *    Get maximum of the bounding box
+    *
+    *  @return
+    *    Maximum position in model space (less than the minimum if unknown)
+    */
+    const glm::vec3 & boundingBoxMax() const;
+
+    /**
+    *  @brief
+    *    Set bounding box
+    *
+    *  @param[in] min
+    *    Minimum position in model space
+    *  @param[in] max
+    *    Maximum position in model space
+    *
+    *  @remarks
+    *    Deformations that are not known in advance (e.g., skinning)
+    *    can move the vertices outside of the box.
+    */
+    void setBoundingBox(const glm::vec3 & min, const glm::vec3 & max);
+
+    /**
+    *  @brief
+    *    Get meshlets
+    *
+    *  @return
+    *    Clusters of triangles of the full geometry, in model space (empty if none)
+    */
+    const std::vector<rendercore::MeshletBuilder::Meshlet> & meshlets() const;
+
+    /**
+    *  @brief
+    *    Set meshlets
+    *
+    *  @param[in] meshlets
+    *    Clusters of triangles of the full geometry, in model space (empty if none)
+    *
+    *  @remarks
+    *    The index ranges of the meshlets must cover the first level
+    *    of detail, so that they can be drawn instead of it.
+    */
+    void setMeshlets(const std::vector<rendercore::MeshletBuilder::Meshlet> & meshlets);
+
     /**
     *  @brief
     *    Get attribute bindings
@@ -151,6 +318,29 @@ public:
     */
     void bindAttribute(size_t index, const VertexAttribute * vertexAttribute);
 
+    /**
+    *  @brief
+    *    Get position dequantization
+    *
+    *  @return
+    *    Transformation from stored vertex positions into model space
+    *
+    *  @remarks
+    *    For quantized positions, this maps the normalized integer
+    *    coordinates back into the bounding box of the geometry.
+    *    Otherwise, it is the identity.
+    */
+    const glm::mat4 & positionDequantization() const;
+
+    /**
+    *  @brief
+    *    Set position dequantization
+    *
+    *  @param[in] dequantization
+    *    Transformation from stored vertex positions into model space
+    */
+    void setPositionDequantization(const glm::mat4 & dequantization);
+
     /**
     *  @brief
     *    Get material
@@ -169,10 +359,34 @@ public:
     */
     void setMaterial(Material * material);
 
+    /**
+    *  @brief
+    *    Get morph targets
+    *
+    *  @return
+    *    Morph targets (can be null)
+    */
+    MorphTargets * morphTargets() const;
+
+    /**
+    *  @brief
+    *    Set morph targets
+    *
+    *  @param[in] morphTargets
+    *    Morph targets (can be null)
+    *
+    *  @remarks
+    *    The morph targets are not owned by the geometry (see Mesh::addMorphTargets()).
+    */
+    void setMorphTargets(MorphTargets * morphTargets);
+
     /**
     *  @brief
     *    Draw geometry
     *
+    *  @param[in] lod
+    *    Level of detail (clamped to the available levels, ignored for geometries without index buffer)
+    *
     *  @remarks
     *    On the first call, the VAO for this geometry will be created
     *    and prepared according to the configuration of this object.
@@ -180,7 +394,44 @@ public:
     *  @notes
     *    - Requires an active rendering context
     */
-    void draw();
+    void draw(unsigned int lod = 0);
+
+    /**
+    *  @brief
+    *    Draw selected meshlets
+    *
+    *  @param[in] meshlets
+    *    Indices of the meshlets to draw
+    *
+    *  @remarks
+    *    All meshlets are submitted with a single call to glMultiDrawElements.
+    *    Geometries without index buffer are not drawn.
+    *
+    *  @notes
+    *    - Requires an active rendering context
+    */
+    void drawMeshlets(const std::vector<unsigned int> & meshlets);
+
+    /**
+    *  @brief
+    *    Draw instances of the geometry
+    *
+    *  @param[in] instanceCount
+    *    Number of instances
+    *  @param[in] instanceAttributes
+    *    Vertex attributes that are advanced per instance (by attribute index)
+    *  @param[in] lod
+    *    Level of detail (clamped to the available levels, ignored for geometries without index buffer)
+    *
+    *  @remarks
+    *    All instances are submitted with a single instanced draw call.
+    *    The instance attributes are only enabled during this call, so the
+    *    geometry can also be drawn without instances.
+    *
+    *  @notes
+    *    - Requires an active rendering context
+    */
+    void drawInstanced(unsigned int instanceCount, const std::unordered_map<size_t, const VertexAttribute *> & instanceAttributes, unsigned int lod = 0);
 
     /**
     *  @brief
@@ -197,6 +448,24 @@ public:
     void deinit();
 
 protected:
+    /**
+    *  @brief
+    *    Get size of an index
+    *
+    *  @return
+    *    Size of an element of the index buffer (in bytes)
+    */
+    size_t indexSize() const;
+
+    /**
+    *  @brief
+    *    Get restart index
+    *
+    *  @return
+    *    Maximum value of the index type, which separates primitives if primitive restart is enabled
+    */
+    gl::GLuint restartIndex() const;
+
     /**
     *  @brief
     *    Create VAO from data
@@ -208,11 +477,28 @@ protected:
 
 protected:
     // Geometry configuration
-    gl::GLenum     m_mode;        ///< Primitive mode (e.g., GL_TRIANGLES)
-    Buffer       * m_indexBuffer; ///< Index buffer (can be null)
-    gl::GLenum     m_indexType;   ///< Data type of index buffer (e.g., GL_UNSIGNED_INT)
-    unsigned int   m_count;       ///< Number of elements to render
-    Material *     m_material;    ///< Material (can be null)
+    gl::GLenum     m_mode;             ///< Primitive mode (e.g., GL_TRIANGLES)
+    Buffer       * m_indexBuffer;      ///< Index buffer (can be null)
+    gl::GLenum     m_indexType;        ///< Data type of index buffer (e.g., GL_UNSIGNED_INT)
+    unsigned int   m_count;            ///< Number of elements to render
+    int            m_baseVertex;       ///< Value that is added to each index before fetching the vertex
+    bool           m_primitiveRestart; ///< Does the maximum value of the index type separate primitives?
+    glm::mat4      m_dequantization;   ///< Transformation from stored vertex positions into model space
+    Material *     m_material;         ///< Material (can be null)
+    MorphTargets * m_morphTargets;     ///< Morph targets (can be null)
+
+    // Levels of detail
+    std::vector<Lod> m_lods;           ///< Levels of detail (empty if there is only the full geometry)
+    glm::vec4        m_boundingSphere; ///< Bounding sphere in model space (radius 0 if unknown)
+
+    // Bounds
+    glm::vec3 m_boundingBoxMin; ///< Minimum of the bounding box in model space (greater than the maximum if unknown)
+    glm::vec3 m_boundingBoxMax; ///< Maximum of the bounding box in model space
+
+    // Meshlets
+    std::vector<rendercore::MeshletBuilder::Meshlet> m_meshlets;    ///< Clusters of triangles of the full geometry
+    std::vector<gl::GLsizei>                         m_drawCounts;  ///< Number of elements of each drawn meshlet (reused between draw calls)
+    std::vector<const void *>                        m_drawOffsets; ///< Byte offset of each drawn meshlet (reused between draw calls)
 
     // Attributes
     std::unordered_map<size_t, const VertexAttribute *> m_attributes; ///< Vertex attribute bindings
@@ -30,8 +30,13 @@ public:
     /**
     *  @brief
     *    Data type for faces
+    *
+    *  @remarks
+    *    Indices have 32 bit, as refined geometries exceed the range of
+    *    16 bit indices after 7 levels. Narrow them for uploading when
+    *    the number of vertices allows it (see Sphere).
     */
-    using Face = std::array<gl::GLushort, 3>;
+    using Face = std::array<gl::GLuint, 3>;
 
 public:
     /**
@@ -88,7 +93,7 @@ public:
     *    Create and refine geometry
     *
     *  @param[in] iterations
-    *    Number of refinement iterations
+    *    Number of refinement iterations (clamped to 12)
     */
     void generateGeometry(gl::GLsizei iterations = 0);
 
@@ -127,7 +132,7 @@ public:
     *  @return
     *    Index array (describes a list of triangles)
     */
-    const std::vector<std::array<gl::GLushort, 3>> & indices() const;
+    const std::vector<Face> & indices() const;
 
 private:
     /**
@@ -150,11 +155,11 @@ private:
     *  @return
     *    Index of the new point
     */
-    static gl::GLushort split(
-        gl::GLushort a
-      , gl::GLushort b
+    static gl::GLuint split(
+        gl::GLuint a
+      , gl::GLuint b
       , std::vector<glm::vec3> & points
-      , std::unordered_map<glm::uint, gl::GLushort> & cache);
+      , std::unordered_map<unsigned long long, gl::GLuint> & cache);
 
 private:
     std::vector<glm::vec3> m_vertices;  ///< Vertex array
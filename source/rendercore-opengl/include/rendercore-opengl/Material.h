@@ -19,6 +19,7 @@ namespace opengl
 
 
 class Texture;
+class Sampler;
 
 
 /**
@@ -168,6 +169,44 @@ public:
     */
     void setTexture(const std::string & name, Texture * texture);
 
+    /**
+    *  @brief
+    *    Get sampler
+    *
+    *  @param[in] name
+    *    Texture name
+    *
+    *  @return
+    *    Sampler that is used with the texture (can be null)
+    */
+    const Sampler * sampler(const std::string & name) const;
+
+    /**
+    *  @brief
+    *    Get sampler
+    *
+    *  @param[in] name
+    *    Texture name
+    *
+    *  @return
+    *    Sampler that is used with the texture (can be null)
+    */
+    Sampler * sampler(const std::string & name);
+
+    /**
+    *  @brief
+    *    Set sampler
+    *
+    *  @param[in] name
+    *    Texture name
+    *  @param[in] sampler
+    *    Sampler that is used with the texture (can be null)
+    *
+    *  @remarks
+    *    If no sampler is set, the sampling parameters of the texture are used.
+    */
+    void setSampler(const std::string & name, Sampler * sampler);
+
 protected:
     // Virtual GpuObject functions
     virtual void onInit() override;
@@ -176,6 +215,7 @@ protected:
 protected:
     std::map< std::string, std::unique_ptr<AbstractMaterialAttribute> > m_attributes; ///< Material attributes
     std::map< std::string, Texture * >                                  m_textures;   ///< Textures
+    std::map< std::string, Sampler * >                                  m_samplers;   ///< Samplers (by texture name)
 };
 
 
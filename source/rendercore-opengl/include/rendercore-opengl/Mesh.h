@@ -12,6 +12,7 @@
 
 #include <rendercore-opengl/Buffer.h>
 #include <rendercore-opengl/Geometry.h>
+#include <rendercore-opengl/MorphTargets.h>
 #include <rendercore-opengl/VertexAttribute.h>
 
 
@@ -111,6 +112,22 @@ public:
     */
     Buffer * createBuffer(const void * data, unsigned int size);
 
+    /**
+    *  @brief
+    *    Create buffer that references data owned by another object
+    *
+    *  @param[in] data
+    *    Buffer data (can be null)
+    *  @param[in] size
+    *    Data size
+    *  @param[in] owner
+    *    Owner of the data (see Buffer::setExternalData())
+    *
+    *  @return
+    *    Buffer (can be null)
+    */
+    Buffer * createBuffer(char * data, unsigned int size, std::shared_ptr<void> owner);
+
     /**
     *  @brief
     *    Create buffer from typed vector
@@ -215,9 +232,62 @@ public:
     *
     *  @param[in] geometry
     *    Geometry
+    *
+    *  @remarks
+    *    The bounding box of the mesh is extended by the bounding box of the geometry.
     */
     void addGeometry(std::unique_ptr<Geometry> && geometry);
 
+    /**
+    *  @brief
+    *    Get minimum of the bounding box
+    *
+    *  @return
+    *    Minimum position in model space (greater than the maximum if unknown)
+    */
+    const glm::vec3 & boundingBoxMin() const;
+
+    /**
+    *  @brief
+    *    Get maximum of the bounding box
+    *
+    *  @return
+    *    Maximum position in model space (less than the minimum if unknown)
+    */
+    const glm::vec3 & boundingBoxMax() const;
+
+    /**
+    *  @brief
+    *    Set bounding box
+    *
+    *  @param[in] min
+    *    Minimum position in model space
+    *  @param[in] max
+    *    Maximum position in model space
+    *
+    *  @remarks
+    *    By default, the bounding box encloses the bounding boxes of all
+    *    geometries. It can be set explicitly, e.g., before the geometries
+    *    are available.
+    */
+    void setBoundingBox(const glm::vec3 & min, const glm::vec3 & max);
+
+    /**
+    *  @brief
+    *    Add morph targets
+    *
+    *  @param[in] morphTargets
+    *    Morph targets (must NOT be null!)
+    *
+    *  @return
+    *    Morph targets
+    *
+    *  @remarks
+    *    Transfers ownership over the morph targets to the mesh,
+    *    geometries reference them (see Geometry::setMorphTargets()).
+    */
+    MorphTargets * addMorphTargets(std::unique_ptr<MorphTargets> && morphTargets);
+
     // Virtual AbstractDrawable functions
     virtual void draw() const override;
 
@@ -234,7 +304,12 @@ protected:
     std::vector< std::unique_ptr<VertexAttribute> > m_vertexAttributes; ///< List of vertex attributes
 
     // Geometries
-    std::vector< std::unique_ptr<Geometry> > m_geometries; ///< List of geometries that are drawn
+    std::vector< std::unique_ptr<Geometry> >     m_geometries;   ///< List of geometries that are drawn
+    std::vector< std::unique_ptr<MorphTargets> > m_morphTargets; ///< Morph targets of the geometries
+
+    // Bounds
+    glm::vec3 m_boundingBoxMin; ///< Minimum of the bounding box in model space (greater than the maximum if unknown)
+    glm::vec3 m_boundingBoxMax; ///< Maximum of the bounding box in model space
 };
 
 
@@ -0,0 +1,210 @@
+
+#pragma once
+
+
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <globjects/Buffer.h>
+#include <globjects/Texture.h>
+
+#include <rendercore/GpuObject.h>
+
+#include <rendercore-opengl/rendercore-opengl_api.h>
+
+
+namespace rendercore
+{
+namespace opengl
+{
+
+
+/**
+*  @brief
+*    Morph targets of a geometry
+*
+*  @remarks
+*    Each morph target displaces the positions and normals of some
+*    vertices. The displacements are stored sparsely, i.e., only for the
+*    vertices that are actually moved by a target.
+*
+*    Geometries with up to maxShaderTargets() targets are blended in the
+*    vertex shader: the displacements of all targets are uploaded once
+*    into a buffer texture, and for each draw call only the indices and
+*    weights of the active targets are passed to the shader. Geometries
+*    with more targets are blended on the CPU into a single set of
+*    displacements, which only visits the active targets and uploads
+*    the range of vertices that has changed.
+*/
+class RENDERCORE_OPENGL_API MorphTargets : public rendercore::GpuObject
+{
+public:
+    /**
+    *  @brief
+    *    Displacements of a morph target
+    */
+    struct Target
+    {
+        std::vector<unsigned int> vertices;  ///< Indices of the displaced vertices (ascending)
+        std::vector<glm::vec3>    positions; ///< Position displacement of each vertex
+        std::vector<glm::vec3>    normals;   ///< Normal displacement of each vertex (empty if normals are not displaced)
+    };
+
+public:
+    /**
+    *  @brief
+    *    Get maximum number of targets that are blended in the vertex shader
+    *
+    *  @return
+    *    Maximum number of targets (size of the target arrays in the shader)
+    */
+    static unsigned int maxShaderTargets();
+
+public:
+    /**
+    *  @brief
+    *    Constructor
+    *
+    *  @param[in] container
+    *    GPU container (can be null)
+    */
+    MorphTargets(GpuContainer * container = nullptr);
+
+    /**
+    *  @brief
+    *    Destructor
+    */
+    virtual ~MorphTargets();
+
+    /**
+    *  @brief
+    *    Get number of vertices
+    *
+    *  @return
+    *    Number of vertices of the geometry
+    */
+    unsigned int vertexCount() const;
+
+    /**
+    *  @brief
+    *    Set number of vertices
+    *
+    *  @param[in] vertexCount
+    *    Number of vertices of the geometry
+    */
+    void setVertexCount(unsigned int vertexCount);
+
+    /**
+    *  @brief
+    *    Get morph targets
+    *
+    *  @return
+    *    List of morph targets
+    */
+    const std::vector<Target> & targets() const;
+
+    /**
+    *  @brief
+    *    Add morph target
+    *
+    *  @param[in] positionVertices
+    *    Indices of vertices with displaced positions (ascending)
+    *  @param[in] positions
+    *    Position displacement of each of these vertices
+    *  @param[in] normalVertices
+    *    Indices of vertices with displaced normals (ascending)
+    *  @param[in] normals
+    *    Normal displacement of each of these vertices
+    */
+    void addTarget(const std::vector<unsigned int> & positionVertices, const std::vector<glm::vec3> & positions,
+                   const std::vector<unsigned int> & normalVertices, const std::vector<glm::vec3> & normals);
+
+    /**
+    *  @brief
+    *    Check if targets are blended on the CPU
+    *
+    *  @return
+    *    'true' if the geometry has more targets than can be blended in the vertex shader, else 'false'
+    */
+    bool blendsOnCpu() const;
+
+    /**
+    *  @brief
+    *    Prepare blending for a draw call
+    *
+    *  @param[in] weights
+    *    Weight of each morph target (missing weights are zero)
+    *  @param[out] targets
+    *    Indices of the displacements in the buffer texture, which the shader has to blend
+    *  @param[out] targetWeights
+    *    Weight of each of these displacements
+    *
+    *  @return
+    *    Number of displacements the shader has to blend (at most maxShaderTargets())
+    *
+    *  @notes
+    *    - Requires an active rendering context
+    */
+    unsigned int update(const std::vector<float> & weights, std::vector<int> & targets, std::vector<float> & targetWeights);
+
+    /**
+    *  @brief
+    *    Get buffer texture with the displacements
+    *
+    *  @return
+    *    Buffer texture (can be null)
+    *
+    *  @remarks
+    *    The texture holds two RGBA32F texels per vertex and set of
+    *    displacements: position displacement and normal displacement.
+    *
+    *  @notes
+    *    - Requires an active rendering context
+    */
+    globjects::Texture * texture();
+
+protected:
+    // Virtual GpuObject functions
+    virtual void onDeinit() override;
+
+    /**
+    *  @brief
+    *    Discard blended displacements and flag texture invalid
+    */
+    void invalidate();
+
+    /**
+    *  @brief
+    *    Create buffer texture from data
+    */
+    void createFromData();
+
+    /**
+    *  @brief
+    *    Blend active targets on the CPU and upload the changed vertices
+    *
+    *  @param[in] weights
+    *    Weight of each morph target (missing weights are zero)
+    */
+    void blend(const std::vector<float> & weights);
+
+protected:
+    // Data
+    unsigned int        m_vertexCount; ///< Number of vertices of the geometry
+    std::vector<Target> m_targets;     ///< List of morph targets
+
+    // CPU blending
+    std::vector<float>        m_blendedWeights; ///< Weights of the last blend
+    std::vector<glm::vec4>    m_blended;        ///< Blended displacements (two per vertex, w marks displaced vertices)
+    std::vector<unsigned int> m_displaced;      ///< Vertices displaced by the last blend
+
+    // OpenGL objects
+    std::unique_ptr<globjects::Buffer>  m_buffer;  ///< Buffer with the displacements
+    std::unique_ptr<globjects::Texture> m_texture; ///< Buffer texture that exposes the buffer to the shader
+};
+
+
+} // namespace opengl
+} // namespace rendercore
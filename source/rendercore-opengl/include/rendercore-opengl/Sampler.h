@@ -0,0 +1,157 @@
+
+#pragma once
+
+
+#include <memory>
+
+#include <glbinding/gl/gl.h>
+
+#include <globjects/Sampler.h>
+
+#include <rendercore/GpuObject.h>
+
+#include <rendercore-opengl/rendercore-opengl_api.h>
+
+
+namespace rendercore
+{
+namespace opengl
+{
+
+
+/**
+*  @brief
+*    Sampler state that is independent of texture data
+*
+*  @remarks
+*    A sampler can be bound together with any texture, so textures that
+*    share the same image but use different filtering or wrapping modes
+*    do not need to store the image data more than once.
+*/
+class RENDERCORE_OPENGL_API Sampler : public rendercore::GpuObject
+{
+public:
+    /**
+    *  @brief
+    *    Constructor
+    *
+    *  @param[in] container
+    *    GPU container (can be null)
+    */
+    Sampler(GpuContainer * container = nullptr);
+
+    /**
+    *  @brief
+    *    Destructor
+    */
+    virtual ~Sampler();
+
+    /**
+    *  @brief
+    *    Get minification filter
+    *
+    *  @return
+    *    Minification filter (OpenGL enum, e.g., GL_NEAREST)
+    */
+    gl::GLenum minFilter() const;
+
+    /**
+    *  @brief
+    *    Set minification filter
+    *
+    *  @param[in] filter
+    *    Minification filter (OpenGL enum, e.g., GL_NEAREST)
+    */
+    void setMinFilter(gl::GLenum filter);
+
+    /**
+    *  @brief
+    *    Get magnification filter
+    *
+    *  @return
+    *    Magnification filter (OpenGL enum, e.g., GL_NEAREST)
+    */
+    gl::GLenum magFilter() const;
+
+    /**
+    *  @brief
+    *    Set magnification filter
+    *
+    *  @param[in] filter
+    *    Magnification filter (OpenGL enum, e.g., GL_NEAREST)
+    */
+    void setMagFilter(gl::GLenum filter);
+
+    /**
+    *  @brief
+    *    Get wrapping mode (S)
+    *
+    *  @return
+    *    Wrapping mode (OpenGL enum, e.g., GL_REPEAT)
+    */
+    gl::GLenum wrapS() const;
+
+    /**
+    *  @brief
+    *    Set wrapping mode (S)
+    *
+    *  @param[in] mode
+    *    Wrapping mode (OpenGL enum, e.g., GL_REPEAT)
+    */
+    void setWrapS(gl::GLenum mode);
+
+    /**
+    *  @brief
+    *    Get wrapping mode (T)
+    *
+    *  @return
+    *    Wrapping mode (OpenGL enum, e.g., GL_REPEAT)
+    */
+    gl::GLenum wrapT() const;
+
+    /**
+    *  @brief
+    *    Set wrapping mode (T)
+    *
+    *  @param[in] mode
+    *    Wrapping mode (OpenGL enum, e.g., GL_REPEAT)
+    */
+    void setWrapT(gl::GLenum mode);
+
+    /**
+    *  @brief
+    *    Get OpenGL sampler
+    *
+    *  @return
+    *    OpenGL sampler (can be null)
+    *
+    *  @notes
+    *    - Requires an active rendering context
+    */
+    globjects::Sampler * sampler();
+
+protected:
+    // Virtual GpuObject functions
+    virtual void onDeinit() override;
+
+    /**
+    *  @brief
+    *    Create sampler object
+    *
+    *  @notes
+    *    - Requires an active rendering context
+    */
+    void createSampler();
+
+protected:
+    gl::GLenum m_minFilter; ///< Minification filter
+    gl::GLenum m_magFilter; ///< Magnification filter
+    gl::GLenum m_wrapS;     ///< Wrapping mode
+    gl::GLenum m_wrapT;     ///< Wrapping mode
+
+    std::unique_ptr<globjects::Sampler> m_sampler; ///< OpenGL sampler (can be null)
+};
+
+
+} // namespace opengl
+} // namespace rendercore
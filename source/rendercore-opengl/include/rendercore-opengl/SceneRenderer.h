@@ -4,6 +4,8 @@
 
 #include <rendercore/GpuContainer.h>
 
+#include <vector>
+
 #include <glm/glm.hpp>
 
 #include <rendercore-opengl/Program.h>
@@ -23,7 +25,10 @@ namespace opengl
 {
 
 
+class Buffer;
+class Geometry;
 class Mesh;
+class MeshComponent;
 
 
 /**
@@ -54,6 +59,60 @@ public:
     */
     virtual ~SceneRenderer();
 
+    /**
+    *  @brief
+    *    Get threshold for level of detail selection
+    *
+    *  @return
+    *    Maximum projected geometric error (relative to the viewport height)
+    */
+    float lodThreshold() const;
+
+    /**
+    *  @brief
+    *    Set threshold for level of detail selection
+    *
+    *  @param[in] threshold
+    *    Maximum projected geometric error (relative to the viewport height)
+    */
+    void setLodThreshold(float threshold);
+
+    /**
+    *  @brief
+    *    Get hysteresis for level of detail selection
+    *
+    *  @return
+    *    Fraction by which the projected error must fall below the threshold before a coarser level is selected
+    */
+    float lodHysteresis() const;
+
+    /**
+    *  @brief
+    *    Set hysteresis for level of detail selection
+    *
+    *  @param[in] hysteresis
+    *    Fraction by which the projected error must fall below the threshold before a coarser level is selected
+    */
+    void setLodHysteresis(float hysteresis);
+
+    /**
+    *  @brief
+    *    Check if meshlets are culled
+    *
+    *  @return
+    *    'true' if meshlets outside the view frustum or facing away from the camera are skipped, else 'false'
+    */
+    bool meshletCulling() const;
+
+    /**
+    *  @brief
+    *    Set if meshlets are culled
+    *
+    *  @param[in] enabled
+    *    'true' to skip meshlets outside the view frustum or facing away from the camera, else 'false'
+    */
+    void setMeshletCulling(bool enabled);
+
     /**
     *  @brief
     *    Render scene
@@ -90,12 +149,65 @@ public:
     *    Model transformation
     *  @param[in] camera
     *    Camera (can be null)
+    *  @param[in] component
+    *    Mesh component that keeps the selected levels of detail (can be null)
+    *
+    *  @remarks
+    *    If a mesh component and a camera are given, the level of detail
+    *    of each geometry is chosen from the size of its bounding sphere
+    *    on screen. Otherwise, the full geometry is rendered. If the mesh
+    *    component has a skin, the joint matrices are calculated and the
+    *    mesh is rendered with a program that blends them on the GPU.
+    *    Morph targets are blended with the weights of the scene node of
+    *    the mesh component. All instances of an instanced mesh component
+    *    are rendered at full detail with one instanced draw call per geometry.
     */
-    void render(Mesh & mesh, const glm::mat4 & transform, Camera * camera);
+    void render(Mesh & mesh, const glm::mat4 & transform, Camera * camera, MeshComponent * component = nullptr);
 
 protected:
+    /**
+    *  @brief
+    *    Determine visible meshlets of a geometry
+    *
+    *  @param[in] geometry
+    *    Geometry with meshlets
+    *  @param[in] transform
+    *    Model transformation
+    *  @param[in] camera
+    *    Camera
+    *  @param[in] doubleSided
+    *    Is the material double-sided? (disables backface culling)
+    *  @param[out] visible
+    *    Indices of the meshlets that are inside the view frustum and not back-facing
+    *
+    *  @remarks
+    *    Backface culling is skipped for double-sided materials and for
+    *    transformations with non-uniform scaling or mirroring, which do
+    *    not preserve the normal cones.
+    */
+    void cullMeshlets(const Geometry & geometry, const glm::mat4 & transform, const Camera & camera, bool doubleSided, std::vector<unsigned int> & visible) const;
+
+protected:
+    // Level of detail selection
+    float m_lodThreshold;  ///< Maximum projected geometric error (relative to the viewport height)
+    float m_lodHysteresis; ///< Fraction by which the projected error must fall below the threshold before a coarser level is selected
+
+    // Meshlet culling
+    bool                      m_meshletCulling;  ///< Skip meshlets outside the view frustum or facing away from the camera?
+    std::vector<unsigned int> m_visibleMeshlets; ///< Visible meshlets of the current geometry (reused between draw calls)
+
+    // Skinning
+    std::vector<glm::mat4> m_jointMatrices;    ///< Joint matrices of the current skin (reused between draw calls)
+    bool                   m_jointLimitWarned; ///< Has a skin with more joints than the uniform block holds been reported?
+
+    // Morph targets
+    std::vector<int>   m_activeMorphTargets; ///< Displacements blended by the shader for the current geometry (reused between draw calls)
+    std::vector<float> m_activeMorphWeights; ///< Weight of each of these displacements (reused between draw calls)
+
     // GPU data
-    std::unique_ptr<rendercore::opengl::Program>  m_program;  ///< Program used for rendering
+    std::unique_ptr<rendercore::opengl::Program>  m_program;        ///< Program used for rendering
+    std::unique_ptr<rendercore::opengl::Program>  m_skinnedProgram; ///< Program used for rendering skinned meshes
+    std::unique_ptr<rendercore::opengl::Buffer>   m_jointBuffer;    ///< Uniform buffer holding the joint matrices
 };
 
 
@@ -3,6 +3,8 @@
 
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <globjects/Shader.h>
 #include <globjects/base/StaticStringSource.h>
@@ -89,6 +91,23 @@ public:
     */
     void load(gl::GLenum type, const std::string & filename);
 
+    /**
+    *  @brief
+    *    Load shader from file with preprocessor definitions
+    *
+    *  @param[in] type
+    *    Shader type
+    *  @param[in] filename
+    *    Path to shader file
+    *  @param[in] defines
+    *    Names of preprocessor symbols to define (e.g., 'SKINNING')
+    *
+    *  @remarks
+    *    The definitions are inserted after the '#version' directive,
+    *    so variants of a shader can be compiled from the same file.
+    */
+    void load(gl::GLenum type, const std::string & filename, const std::vector<std::string> & defines);
+
     /**
     *  @brief
     *    Get OpenGL shader
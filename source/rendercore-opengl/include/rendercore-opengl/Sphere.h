@@ -29,8 +29,15 @@ public:
     *    Sphere radius
     *  @param[in] texCoords
     *    Generate texture coordinates?
+    *  @param[in] quantize
+    *    Store positions and texture coordinates as 16 bit normalized integers?
+    *
+    *  @remarks
+    *    Quantized positions are relative to the bounding box of the sphere
+    *    and need the position dequantization of the geometry to be applied
+    *    by the shader (as done by SceneRenderer).
     */
-    Sphere(GpuContainer * container = nullptr, float radius = 1.0f, bool texCoords = false);
+    Sphere(GpuContainer * container = nullptr, float radius = 1.0f, bool texCoords = false, bool quantize = false);
 
     /**
     *  @brief
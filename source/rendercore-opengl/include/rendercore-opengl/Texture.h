@@ -20,12 +20,29 @@ namespace opengl
 {
 
 
+class TextureStreamer;
+
+
 /**
 *  @brief
 *    Texture
+*
+*  @remarks
+*    The texture target and internal format are derived from the image:
+*    images with 6 faces become cube maps (or cube map arrays), images
+*    with several layers become 2D arrays, images with a depth > 1 become
+*    3D textures. Storage is allocated with glTexStorage (if available),
+*    and updates of an image with the same layout are uploaded into the
+*    existing storage using glTexSubImage.
+*
+*    If a streamer is set, image data is uploaded asynchronously by the
+*    streamer instead of when the texture is first used (see
+*    TextureStreamer).
 */
 class RENDERCORE_OPENGL_API Texture : public rendercore::GpuObject
 {
+    friend class TextureStreamer;
+
 public:
     /**
     *  @brief
@@ -160,6 +177,71 @@ public:
     */
     void setWrapT(gl::GLenum mode);
 
+    /**
+    *  @brief
+    *    Check if color data is interpreted as sRGB
+    *
+    *  @return
+    *    'true' if an sRGB internal format is used for color data, else 'false'
+    */
+    bool srgb() const;
+
+    /**
+    *  @brief
+    *    Set if color data is interpreted as sRGB
+    *
+    *  @param[in] srgb
+    *    'true' if an sRGB internal format is used for color data, else 'false'
+    *
+    *  @remarks
+    *    This applies to 8 bit RGB(A) and to compressed formats that
+    *    have an sRGB variant. Images that already specify an sRGB
+    *    internal format are not affected.
+    */
+    void setSRGB(bool srgb);
+
+    /**
+    *  @brief
+    *    Get texture streamer
+    *
+    *  @return
+    *    Streamer that uploads the image data (can be null)
+    */
+    TextureStreamer * streamer() const;
+
+    /**
+    *  @brief
+    *    Set texture streamer
+    *
+    *  @param[in] streamer
+    *    Streamer that uploads the image data (can be null)
+    *
+    *  @remarks
+    *    If a streamer is set, the storage of the texture is still created
+    *    when it is first used, but the image data is uploaded asynchronously.
+    *    Until then, the texture is incomplete. The streamer must outlive
+    *    the texture.
+    */
+    void setStreamer(TextureStreamer * streamer);
+
+    /**
+    *  @brief
+    *    Get texture target
+    *
+    *  @return
+    *    Texture target (OpenGL enum, e.g., GL_TEXTURE_2D)
+    */
+    gl::GLenum target() const;
+
+    /**
+    *  @brief
+    *    Get internal format
+    *
+    *  @return
+    *    Internal format of the texture storage (OpenGL enum, e.g., GL_RGBA8)
+    */
+    gl::GLenum internalFormat() const;
+
     /**
     *  @brief
     *    Get OpenGL texture
@@ -187,11 +269,58 @@ protected:
     */
     void createFromImage();
 
+    /**
+    *  @brief
+    *    Allocate texture storage
+    *
+    *  @notes
+    *    - Requires an active rendering context
+    *    - Texture and storage information must have been set before
+    */
+    void allocateStorage();
+
+    /**
+    *  @brief
+    *    Upload image data into the texture storage
+    *
+    *  @notes
+    *    - Requires an active rendering context
+    */
+    void uploadImage();
+
+    /**
+    *  @brief
+    *    Upload a single level and slice of the image
+    *
+    *  @param[in] level
+    *    Mipmap level
+    *  @param[in] slice
+    *    Slice index (layer * faces + face)
+    *  @param[in] data
+    *    Image data, or offset into the bound pixel unpack buffer
+    *
+    *  @notes
+    *    - Requires an active rendering context
+    *    - The texture must be bound
+    */
+    void uploadRegion(unsigned int level, unsigned int slice, const void * data);
+
 protected:
     gl::GLenum m_minFilter; ///< Minification filter
     gl::GLenum m_magFilter; ///< Magnification filter
     gl::GLenum m_wrapS;     ///< Wrapping mode
     gl::GLenum m_wrapT;     ///< Wrapping mode
+    bool       m_srgb;      ///< Use sRGB internal formats for color data?
+
+    gl::GLenum   m_target;          ///< Texture target of the current storage
+    gl::GLenum   m_internalFormat;  ///< Internal format of the current storage
+    unsigned int m_width;           ///< Width of the current storage
+    unsigned int m_height;          ///< Height of the current storage
+    unsigned int m_depth;           ///< Depth or number of layers (and faces) of the current storage
+    unsigned int m_levels;          ///< Number of mipmap levels of the current storage
+    bool         m_generateMipmaps; ///< Generate mipmaps after uploading the first level?
+
+    TextureStreamer * m_streamer; ///< Streamer that uploads the image data (can be null)
 
     std::unique_ptr<globjects::Texture> m_texture; ///< OpenGL texture (can be null)
     std::unique_ptr<rendercore::Image>  m_image;   ///< Image that is the source for the texture (can be null)
@@ -0,0 +1,251 @@
+
+#pragma once
+
+
+#include <memory>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <globjects/Buffer.h>
+#include <globjects/Sync.h>
+
+#include <rendercore/GpuObject.h>
+
+#include <rendercore-opengl/rendercore-opengl_api.h>
+
+
+namespace rendercore
+{
+namespace opengl
+{
+
+
+class Texture;
+
+
+/**
+*  @brief
+*    Asynchronous uploader for texture data
+*
+*  @remarks
+*    The streamer copies image data into a persistently mapped pixel
+*    buffer (ring buffer) on a worker thread. On the rendering thread,
+*    update() issues the texture uploads from the pixel buffer and tracks
+*    their completion with fences, so that the ring buffer can be reused.
+*
+*    Mipmap levels are uploaded smallest-first. The base level of the
+*    texture is adjusted after each complete level, so a low-resolution
+*    version of the texture can be used right away.
+*
+*    If persistent mapping is not supported (ARB_buffer_storage), or if
+*    a single level does not fit into the ring buffer, the data is
+*    uploaded directly from the image, but still spread over several
+*    frames.
+*/
+class RENDERCORE_OPENGL_API TextureStreamer : public rendercore::GpuObject
+{
+public:
+    /**
+    *  @brief
+    *    Constructor
+    *
+    *  @param[in] container
+    *    GPU container (can be null)
+    *  @param[in] capacity
+    *    Size of the pixel buffer ring (in bytes)
+    */
+    TextureStreamer(GpuContainer * container = nullptr, unsigned int capacity = 32 * 1024 * 1024);
+
+    /**
+    *  @brief
+    *    Destructor
+    */
+    virtual ~TextureStreamer();
+
+    /**
+    *  @brief
+    *    Get upload budget
+    *
+    *  @return
+    *    Maximum number of bytes uploaded per call to update()
+    */
+    unsigned int budget() const;
+
+    /**
+    *  @brief
+    *    Set upload budget
+    *
+    *  @param[in] budget
+    *    Maximum number of bytes uploaded per call to update()
+    *
+    *  @remarks
+    *    At least one level is uploaded per call, even if it exceeds the budget.
+    */
+    void setBudget(unsigned int budget);
+
+    /**
+    *  @brief
+    *    Check if there is still data to be uploaded
+    *
+    *  @return
+    *    'true' if uploads are pending, else 'false'
+    */
+    bool busy() const;
+
+    /**
+    *  @brief
+    *    Schedule upload of a texture's image data
+    *
+    *  @param[in] texture
+    *    Texture (must NOT be null, storage must have been allocated)
+    *
+    *  @remarks
+    *    This is called by the texture when it is created. Pending
+    *    uploads for the same texture are cancelled.
+    *
+    *  @notes
+    *    - Requires an active rendering context
+    */
+    void stream(Texture * texture);
+
+    /**
+    *  @brief
+    *    Cancel pending uploads of a texture
+    *
+    *  @param[in] texture
+    *    Texture (must NOT be null)
+    *
+    *  @remarks
+    *    Blocks while the worker is copying data of the texture.
+    */
+    void cancel(Texture * texture);
+
+    /**
+    *  @brief
+    *    Issue pending uploads
+    *
+    *  @remarks
+    *    This has to be called regularly (e.g., once per frame).
+    *
+    *  @notes
+    *    - Requires an active rendering context
+    */
+    void update();
+
+protected:
+    /**
+    *  @brief
+    *    Upload job for a single level and slice of a texture
+    */
+    struct Job
+    {
+        Texture      * texture;    ///< Texture
+        unsigned int   level;      ///< Mipmap level
+        unsigned int   slice;      ///< Slice index (layer * faces + face)
+        const char   * data;       ///< Image data
+        unsigned int   size;       ///< Size of data (in bytes)
+        unsigned int   offset;     ///< Offset in the pixel buffer
+        unsigned int   allocation; ///< Sequence number of the allocation in the pixel buffer
+        bool           direct;     ///< Upload directly from the image data?
+    };
+
+    /**
+    *  @brief
+    *    Region of the pixel buffer that is in use
+    */
+    struct Allocation
+    {
+        unsigned int offset; ///< Offset in the pixel buffer
+        unsigned int size;   ///< Size (in bytes, including space that is skipped at the end of the buffer)
+        unsigned int fence;  ///< Fence after which the region can be reused (0 if still in use)
+    };
+
+    /**
+    *  @brief
+    *    Fence for uploads that have been issued
+    */
+    struct Fence
+    {
+        std::unique_ptr<globjects::Sync> sync; ///< OpenGL sync object
+        unsigned int                     id;   ///< Fence number
+    };
+
+protected:
+    // Virtual GpuObject functions
+    virtual void onInit() override;
+    virtual void onDeinit() override;
+
+    /**
+    *  @brief
+    *    Allocate region in the pixel buffer
+    *
+    *  @param[in] size
+    *    Size (in bytes)
+    *  @param[out] offset
+    *    Offset of the region
+    *
+    *  @return
+    *    'true' if the region has been allocated, else 'false'
+    *
+    *  @notes
+    *    - m_mutex must be locked
+    */
+    bool allocate(unsigned int size, unsigned int & offset);
+
+    /**
+    *  @brief
+    *    Mark allocation to be released after the next fence
+    *
+    *  @param[in] allocation
+    *    Sequence number of the allocation
+    *
+    *  @notes
+    *    - m_mutex must be locked
+    */
+    void release(unsigned int allocation);
+
+    /**
+    *  @brief
+    *    Release regions whose fences have been signaled
+    *
+    *  @notes
+    *    - Requires an active rendering context
+    *    - m_mutex must be locked
+    */
+    void checkFences();
+
+    /**
+    *  @brief
+    *    Worker thread
+    */
+    void run();
+
+protected:
+    unsigned int m_capacity; ///< Size of the pixel buffer ring (in bytes)
+    unsigned int m_budget;   ///< Maximum number of bytes uploaded per update
+
+    std::unique_ptr<globjects::Buffer> m_buffer; ///< Pixel buffer (can be null)
+    char                             * m_mapped; ///< Persistently mapped pixel buffer (can be null)
+
+    std::deque<Job>        m_pending;         ///< Jobs waiting to be copied into the pixel buffer
+    std::deque<Job>        m_ready;           ///< Jobs waiting to be uploaded
+    std::deque<Allocation> m_allocations;     ///< Regions of the pixel buffer that are in use
+    std::deque<Fence>      m_fences;          ///< Fences for issued uploads
+    unsigned int           m_firstAllocation; ///< Sequence number of the first entry in m_allocations
+    unsigned int           m_nextFence;       ///< Number of the next fence
+    unsigned int           m_head;            ///< Next free position in the pixel buffer
+    unsigned int           m_used;            ///< Number of bytes in use
+    bool                   m_fenceNeeded;     ///< Have allocations been released since the last fence?
+
+    std::thread             m_thread;  ///< Worker thread
+    mutable std::mutex      m_mutex;   ///< Mutex for all job and allocation data
+    std::condition_variable m_signal;  ///< Signals new jobs, released space, and finished copies
+    Texture               * m_copying; ///< Texture whose data is currently being copied (can be null)
+    bool                    m_stop;    ///< Stop the worker thread?
+};
+
+
+} // namespace opengl
+} // namespace rendercore
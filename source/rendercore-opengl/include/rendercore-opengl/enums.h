@@ -22,17 +22,22 @@ namespace opengl
 */
 enum class AttributeIndex : unsigned int
 {
-    Position = 0, ///< Vertex positions (vec3)
-    Normal,       ///< Normalized normal vectors (vec3)
-    Tangent,      ///< Tangent vectors (vec4)
-    TexCoord0,    ///< Texture coordinates #1 (vec2)
-    TexCoord1,    ///< Texture coordinates #2 (vec2)
-    TexCoord2,    ///< Texture coordinates #3 (vec2)
-    TexCoord3,    ///< Texture coordinates #4 (vec2)
-    Color0,       ///< Vertex colors #1 (vec3/vec4)
-    Color1,       ///< Vertex colors #1 (vec3/vec4)
-    Color2,       ///< Vertex colors #1 (vec3/vec4)
-    Color3        ///< Vertex colors #1 (vec3/vec4)
+    Position = 0,        ///< Vertex positions (vec3)
+    Normal,              ///< Normalized normal vectors (vec3)
+    Tangent,             ///< Tangent vectors (vec4)
+    TexCoord0,           ///< Texture coordinates #1 (vec2)
+    TexCoord1,           ///< Texture coordinates #2 (vec2)
+    TexCoord2,           ///< Texture coordinates #3 (vec2)
+    TexCoord3,           ///< Texture coordinates #4 (vec2)
+    Color0,              ///< Vertex colors #1 (vec3/vec4)
+    Color1,              ///< Vertex colors #1 (vec3/vec4)
+    Color2,              ///< Vertex colors #1 (vec3/vec4)
+    Color3,              ///< Vertex colors #1 (vec3/vec4)
+    Joints0,             ///< Indices of the joints that influence the vertex (vec4)
+    Weights0,            ///< Weights of the joints that influence the vertex (vec4)
+    InstanceTranslation, ///< Translation of each instance (vec3, advanced per instance)
+    InstanceRotation,    ///< Rotation quaternion of each instance (vec4, advanced per instance)
+    InstanceScale        ///< Scale of each instance (vec3, advanced per instance)
 };
 
 
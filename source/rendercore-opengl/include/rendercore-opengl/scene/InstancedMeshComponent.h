@@ -0,0 +1,129 @@
+
+#pragma once
+
+
+#include <memory>
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+
+#include <rendercore-opengl/VertexAttribute.h>
+#include <rendercore-opengl/scene/MeshComponent.h>
+
+
+namespace rendercore
+{
+namespace opengl
+{
+
+
+class Buffer;
+
+
+/**
+*  @brief
+*    Scene node component that displays many instances of a mesh
+*
+*  @remarks
+*    The transformation of each instance (relative to the scene node)
+*    is stored in a buffer as tightly packed floats: translation (vec3),
+*    rotation quaternion (vec4) and scale (vec3). All instances of a
+*    geometry are rendered with a single instanced draw call, no scene
+*    node is created per instance.
+*/
+class RENDERCORE_OPENGL_API InstancedMeshComponent : public MeshComponent
+{
+public:
+    /**
+    *  @brief
+    *    Constructor
+    */
+    InstancedMeshComponent();
+
+    /**
+    *  @brief
+    *    Destructor
+    */
+    virtual ~InstancedMeshComponent();
+
+    /**
+    *  @brief
+    *    Get number of instances
+    *
+    *  @return
+    *    Number of instances
+    */
+    unsigned int instanceCount() const;
+
+    /**
+    *  @brief
+    *    Get instance buffer
+    *
+    *  @return
+    *    Buffer with the transformation of each instance (can be null)
+    */
+    Buffer * instanceBuffer() const;
+
+    /**
+    *  @brief
+    *    Set instances
+    *
+    *  @param[in] buffer
+    *    Buffer with the transformation of each instance (must NOT be null, is not owned by the component)
+    *  @param[in] count
+    *    Number of instances
+    */
+    void setInstances(Buffer * buffer, unsigned int count);
+
+    /**
+    *  @brief
+    *    Get instance attributes
+    *
+    *  @return
+    *    Vertex attribute of each instance attribute index (see AttributeIndex)
+    */
+    const std::unordered_map<size_t, const VertexAttribute *> & instanceAttributes() const;
+
+    /**
+    *  @brief
+    *    Get minimum of the bounding box of all instances
+    *
+    *  @return
+    *    Minimum position relative to the scene node (greater than the maximum if unknown)
+    */
+    const glm::vec3 & boundingBoxMin() const;
+
+    /**
+    *  @brief
+    *    Get maximum of the bounding box of all instances
+    *
+    *  @return
+    *    Maximum position relative to the scene node (less than the minimum if unknown)
+    */
+    const glm::vec3 & boundingBoxMax() const;
+
+    /**
+    *  @brief
+    *    Set bounding box of all instances
+    *
+    *  @param[in] min
+    *    Minimum position relative to the scene node
+    *  @param[in] max
+    *    Maximum position relative to the scene node
+    */
+    void setBoundingBox(const glm::vec3 & min, const glm::vec3 & max);
+
+protected:
+    unsigned int                                        m_instanceCount;      ///< Number of instances
+    Buffer                                            * m_instanceBuffer;     ///< Buffer with the transformation of each instance (can be null)
+    std::unique_ptr<VertexAttribute>                    m_translation;        ///< Translation of each instance
+    std::unique_ptr<VertexAttribute>                    m_rotation;           ///< Rotation of each instance
+    std::unique_ptr<VertexAttribute>                    m_scale;              ///< Scale of each instance
+    std::unordered_map<size_t, const VertexAttribute *> m_instanceAttributes; ///< Vertex attribute of each instance attribute index
+    glm::vec3                                           m_boundingBoxMin;     ///< Minimum of the bounding box of all instances (greater than the maximum if unknown)
+    glm::vec3                                           m_boundingBoxMax;     ///< Maximum of the bounding box of all instances
+};
+
+
+} // namespace opengl
+} // namespace rendercore
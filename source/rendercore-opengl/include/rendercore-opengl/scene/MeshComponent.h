@@ -2,6 +2,9 @@
 #pragma once
 
 
+#include <cstddef>
+#include <vector>
+
 #include <rendercore/scene/SceneNodeComponent.h>
 
 #include <rendercore-opengl/rendercore-opengl_api.h>
@@ -9,10 +12,16 @@
 
 namespace rendercore
 {
+
+
+class Skin;
+
+
 namespace opengl
 {
 
 
+class Geometry;
 class Mesh;
 
 
@@ -62,8 +71,67 @@ public:
     */
     void setMesh(Mesh * mesh);
 
+    /**
+    *  @brief
+    *    Get skin
+    *
+    *  @return
+    *    Skin that deforms the mesh (can be null)
+    */
+    rendercore::Skin * skin() const;
+
+    /**
+    *  @brief
+    *    Set skin
+    *
+    *  @param[in] skin
+    *    Skin that deforms the mesh (can be null)
+    */
+    void setSkin(rendercore::Skin * skin);
+
+    /**
+    *  @brief
+    *    Get selected level of detail of a geometry
+    *
+    *  @param[in] index
+    *    Index of the geometry within the mesh
+    *
+    *  @return
+    *    Level of detail (0 if none has been selected yet)
+    */
+    unsigned int lod(size_t index) const;
+
+    /**
+    *  @brief
+    *    Select level of detail of a geometry
+    *
+    *  @param[in] index
+    *    Index of the geometry within the mesh
+    *  @param[in] geometry
+    *    Geometry
+    *  @param[in] errorScale
+    *    Projected size of a model space unit on screen (relative to the viewport height)
+    *  @param[in] threshold
+    *    Maximum projected error (relative to the viewport height)
+    *  @param[in] hysteresis
+    *    Fraction by which the projected error must fall below the threshold before a coarser level is selected
+    *
+    *  @return
+    *    Selected level of detail
+    *
+    *  @remarks
+    *    The coarsest level whose projected error does not exceed the
+    *    threshold is selected. Finer levels are selected immediately,
+    *    coarser levels only once their error is clearly below the
+    *    threshold, so that objects near the switching distance do not
+    *    alternate between levels from frame to frame.
+    */
+    unsigned int selectLod(size_t index, const Geometry & geometry, float errorScale, float threshold, float hysteresis);
+
 protected:
-    Mesh * m_mesh; ///< Associated mesh (can be null)
+    Mesh                      * m_mesh; ///< Associated mesh (can be null)
+    rendercore::Skin          * m_skin; ///< Skin that deforms the mesh (can be null)
+    std::vector<unsigned int>   m_lods; ///< Selected level of detail of each geometry
 };
 
 
@@ -0,0 +1,1087 @@
+
+#include <rendercore-opengl/BakedAsset.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+#include <cppassist/logging/logging.h>
+#include <cppassist/memory/make_unique.h>
+
+#include <glbinding/gl/enum.h>
+
+#include <rendercore/Image.h>
+#include <rendercore/MappedFile.h>
+#include <rendercore/MeshletBuilder.h>
+
+#include <rendercore-opengl/Geometry.h>
+#include <rendercore-opengl/MaterialAttribute.h>
+#include <rendercore-opengl/VertexAttribute.h>
+#include <rendercore-opengl/scene/InstancedMeshComponent.h>
+#include <rendercore-opengl/scene/MeshComponent.h>
+
+
+namespace
+{
+
+
+// Baked asset file: header, record tables, then data blocks (each aligned to 16 bytes)
+const unsigned int fileVersion = 3;
+
+enum Table
+{
+    BufferTable = 0,      // BlockRecord
+    SamplerTable,         // SamplerRecord
+    TextureTable,         // TextureRecord
+    RegionTable,          // BlockRecord (relative to the image data)
+    MaterialTable,        // MaterialRecord
+    ValueTable,           // ValueRecord
+    MaterialTextureTable, // MaterialTextureRecord
+    MeshTable,            // MeshRecord
+    MeshBufferTable,      // unsigned int (buffer index)
+    VertexAttributeTable, // VertexAttributeRecord
+    GeometryTable,        // GeometryRecord
+    BindingTable,         // BindingRecord
+    LodTable,             // Geometry::Lod
+    MeshletTable,         // MeshletBuilder::Meshlet
+    SceneTable,           // SceneRecord
+    NodeTable,            // NodeRecord
+    ComponentTable,       // unsigned int (mesh index)
+    TableCount
+};
+
+struct TableHeader
+{
+    unsigned int offset;
+    unsigned int count;
+};
+
+struct FileHeader
+{
+    char         magic[4];
+    unsigned int version;
+    unsigned int dataOffset;
+    unsigned int dataSize;
+    TableHeader  tables[TableCount];
+};
+
+struct BlockRecord
+{
+    unsigned int offset;
+    unsigned int size;
+};
+
+struct SamplerRecord
+{
+    unsigned int minFilter;
+    unsigned int magFilter;
+    unsigned int wrapS;
+    unsigned int wrapT;
+};
+
+struct TextureRecord
+{
+    unsigned int minFilter;
+    unsigned int magFilter;
+    unsigned int wrapS;
+    unsigned int wrapT;
+    unsigned int srgb;
+    unsigned int width;
+    unsigned int height;
+    unsigned int depth;
+    unsigned int format;
+    unsigned int type;
+    unsigned int internalFormat;
+    unsigned int levels;
+    unsigned int layers;
+    unsigned int faces;
+    unsigned int firstRegion;
+    BlockRecord  image;
+};
+
+struct MaterialRecord
+{
+    unsigned int firstValue;
+    unsigned int valueCount;
+    unsigned int firstTexture;
+    unsigned int textureCount;
+};
+
+struct ValueRecord
+{
+    BlockRecord  name;
+    unsigned int type;
+    float        data[16];
+    BlockRecord  string;
+};
+
+struct MaterialTextureRecord
+{
+    BlockRecord name;
+    int         texture;
+    int         sampler;
+};
+
+struct MeshRecord
+{
+    unsigned int firstBuffer;
+    unsigned int bufferCount;
+    unsigned int firstAttribute;
+    unsigned int attributeCount;
+    unsigned int firstGeometry;
+    unsigned int geometryCount;
+};
+
+struct VertexAttributeRecord
+{
+    unsigned int buffer;
+    unsigned int baseOffset;
+    unsigned int relativeOffset;
+    unsigned int stride;
+    unsigned int type;
+    unsigned int components;
+    unsigned int normalize;
+};
+
+struct GeometryRecord
+{
+    unsigned int mode;
+    int          material;
+    int          indexBuffer;
+    unsigned int indexType;
+    unsigned int count;
+    int          baseVertex;
+    unsigned int primitiveRestart;
+    unsigned int firstBinding;
+    unsigned int bindingCount;
+    unsigned int firstLod;
+    unsigned int lodCount;
+    unsigned int firstMeshlet;
+    unsigned int meshletCount;
+    float        boundingSphere[4];
+    float        boundingBox[6];
+    float        dequantization[16];
+};
+
+struct BindingRecord
+{
+    unsigned int index;
+    unsigned int attribute;
+};
+
+struct SceneRecord
+{
+    unsigned int firstNode;
+    unsigned int nodeCount;
+    float        boundingBox[6];
+};
+
+struct NodeRecord
+{
+    int          parent;
+    unsigned int firstComponent;
+    unsigned int componentCount;
+    float        transform[16];
+};
+
+// Records of all tables
+struct Tables
+{
+    std::vector<BlockRecord>                          buffers;
+    std::vector<SamplerRecord>                        samplers;
+    std::vector<TextureRecord>                        textures;
+    std::vector<BlockRecord>                          regions;
+    std::vector<MaterialRecord>                       materials;
+    std::vector<ValueRecord>                          values;
+    std::vector<MaterialTextureRecord>                materialTextures;
+    std::vector<MeshRecord>                           meshes;
+    std::vector<unsigned int>                         meshBuffers;
+    std::vector<VertexAttributeRecord>                vertexAttributes;
+    std::vector<GeometryRecord>                       geometries;
+    std::vector<BindingRecord>                        bindings;
+    std::vector<rendercore::opengl::Geometry::Lod>    lods;
+    std::vector<rendercore::MeshletBuilder::Meshlet>  meshlets;
+    std::vector<SceneRecord>                          scenes;
+    std::vector<NodeRecord>                           nodes;
+    std::vector<unsigned int>                         components;
+};
+
+size_t align(size_t offset)
+{
+    return (offset + 15) & ~static_cast<size_t>(15);
+}
+
+BlockRecord appendBlock(std::vector<char> & data, const void * block, size_t size)
+{
+    BlockRecord record;
+    record.offset = static_cast<unsigned int>(align(data.size()));
+    record.size   = static_cast<unsigned int>(size);
+
+    data.resize(record.offset + size, 0);
+    if (size > 0) {
+        std::memcpy(data.data() + record.offset, block, size);
+    }
+
+    return record;
+}
+
+BlockRecord appendString(std::vector<char> & data, const std::string & str)
+{
+    return appendBlock(data, str.data(), str.size());
+}
+
+template <typename Record>
+void writeTable(std::vector<char> & file, FileHeader & header, Table table, const std::vector<Record> & records)
+{
+    const size_t offset = align(file.size());
+    file.resize(offset + records.size() * sizeof(Record), 0);
+    if (!records.empty()) {
+        std::memcpy(file.data() + offset, records.data(), records.size() * sizeof(Record));
+    }
+
+    header.tables[table].offset = static_cast<unsigned int>(offset);
+    header.tables[table].count  = static_cast<unsigned int>(records.size());
+}
+
+template <typename Record>
+bool readTable(const char * file, size_t fileSize, const FileHeader & header, Table table, std::vector<Record> & records)
+{
+    const TableHeader & tableHeader = header.tables[table];
+    if (tableHeader.offset > fileSize || tableHeader.count > (fileSize - tableHeader.offset) / sizeof(Record)) {
+        return false;
+    }
+
+    records.resize(tableHeader.count);
+    if (tableHeader.count > 0) {
+        std::memcpy(records.data(), file + tableHeader.offset, tableHeader.count * sizeof(Record));
+    }
+
+    return true;
+}
+
+bool checkRange(unsigned int first, unsigned int count, size_t size)
+{
+    return first <= size && count <= size - first;
+}
+
+bool checkBlock(const BlockRecord & block, const FileHeader & header)
+{
+    return checkRange(block.offset, block.size, header.dataSize);
+}
+
+// Size of an element of an index buffer (0 for invalid index types)
+size_t indexTypeSize(unsigned int type)
+{
+    switch (static_cast<gl::GLenum>(type)) {
+        case gl::GL_UNSIGNED_BYTE:  return 1;
+        case gl::GL_UNSIGNED_SHORT: return 2;
+        case gl::GL_UNSIGNED_INT:   return 4;
+        default:                    return 0;
+    }
+}
+
+// Size of a vertex attribute (0 for invalid data types)
+size_t attributeSize(unsigned int type, unsigned int components)
+{
+    switch (static_cast<gl::GLenum>(type)) {
+        case gl::GL_BYTE:
+        case gl::GL_UNSIGNED_BYTE:               return components;
+        case gl::GL_SHORT:
+        case gl::GL_UNSIGNED_SHORT:
+        case gl::GL_HALF_FLOAT:                  return components * 2;
+        case gl::GL_INT:
+        case gl::GL_UNSIGNED_INT:
+        case gl::GL_FLOAT:                       return components * 4;
+        case gl::GL_DOUBLE:                      return components * 8;
+        case gl::GL_INT_2_10_10_10_REV:
+        case gl::GL_UNSIGNED_INT_2_10_10_10_REV: return 4;
+        default:                                 return 0;
+    }
+}
+
+// Check that a number of vertices of an attribute lie within its buffer
+bool checkAttribute(const VertexAttributeRecord & attribute, unsigned long long vertexCount, size_t bufferSize)
+{
+    const unsigned long long size   = attributeSize(attribute.type, attribute.components);
+    const unsigned long long stride = attribute.stride > 0 ? attribute.stride : size;
+    const unsigned long long offset = static_cast<unsigned long long>(attribute.baseOffset) + attribute.relativeOffset;
+
+    return size > 0 && attribute.components >= 1 && attribute.components <= 4 &&
+           (vertexCount == 0 || offset + (vertexCount - 1) * stride + size <= bufferSize);
+}
+
+template <typename Type>
+void storeValue(ValueRecord & record, const Type & value)
+{
+    static_assert(sizeof(Type) <= sizeof(record.data), "Value does not fit into record");
+    std::memcpy(record.data, &value, sizeof(Type));
+}
+
+template <typename Type>
+Type loadValue(const ValueRecord & record)
+{
+    Type value;
+    std::memcpy(&value, record.data, sizeof(Type));
+    return value;
+}
+
+
+} // namespace
+
+
+namespace rendercore
+{
+namespace opengl
+{
+
+
+unsigned int BakedAsset::version()
+{
+    return fileVersion;
+}
+
+bool BakedAsset::save(
+    const std::string & filename
+  , const std::vector< std::unique_ptr<Buffer> > & buffers
+  , const std::vector< std::unique_ptr<Texture> > & textures
+  , const std::vector< std::unique_ptr<Sampler> > & samplers
+  , const std::vector< std::unique_ptr<Material> > & materials
+  , const std::vector< std::unique_ptr<Mesh> > & meshes
+  , const std::vector< std::unique_ptr<rendercore::Scene> > & scenes)
+{
+    Tables            tables;
+    std::vector<char> data;
+
+    // Save buffers, including the buffers that are owned by meshes
+    std::unordered_map<const Buffer *, unsigned int> bufferIndices;
+    auto addBuffer = [&] (const Buffer * buffer) -> int {
+        if (!buffer) return -1;
+
+        auto it = bufferIndices.find(buffer);
+        if (it != bufferIndices.end()) return static_cast<int>(it->second);
+
+        const unsigned int index = static_cast<unsigned int>(tables.buffers.size());
+        tables.buffers.push_back(appendBlock(data, buffer->data(), buffer->data() ? buffer->size() : 0));
+        bufferIndices[buffer] = index;
+        return static_cast<int>(index);
+    };
+
+    for (const auto & buffer : buffers) {
+        addBuffer(buffer.get());
+    }
+
+    // Save samplers
+    std::unordered_map<const Sampler *, int> samplerIndices;
+    for (const auto & sampler : samplers) {
+        SamplerRecord record;
+        record.minFilter = static_cast<unsigned int>(sampler->minFilter());
+        record.magFilter = static_cast<unsigned int>(sampler->magFilter());
+        record.wrapS     = static_cast<unsigned int>(sampler->wrapS());
+        record.wrapT     = static_cast<unsigned int>(sampler->wrapT());
+
+        samplerIndices[sampler.get()] = static_cast<int>(tables.samplers.size());
+        tables.samplers.push_back(record);
+    }
+
+    // Save textures
+    std::unordered_map<const Texture *, int> textureIndices;
+    for (const auto & texture : textures) {
+        TextureRecord record;
+        std::memset(&record, 0, sizeof(record));
+        record.minFilter   = static_cast<unsigned int>(texture->minFilter());
+        record.magFilter   = static_cast<unsigned int>(texture->magFilter());
+        record.wrapS       = static_cast<unsigned int>(texture->wrapS());
+        record.wrapT       = static_cast<unsigned int>(texture->wrapT());
+        record.srgb        = texture->srgb() ? 1 : 0;
+        record.firstRegion = static_cast<unsigned int>(tables.regions.size());
+
+        // Save image with all mipmap levels
+        const rendercore::Image * image = texture->image();
+        if (image && !image->empty()) {
+            std::unique_ptr<rendercore::Image> mipmapped;
+            if (image->levels() == 1 && !image->compressed()) {
+                mipmapped = cppassist::make_unique<rendercore::Image>(*image);
+                if (mipmapped->generateMipmaps()) image = mipmapped.get();
+            }
+
+            record.width          = image->width();
+            record.height         = image->height();
+            record.depth          = image->depth();
+            record.format         = image->format();
+            record.type           = image->dataType();
+            record.internalFormat = image->internalFormat();
+            record.levels         = image->levels();
+            record.layers         = image->layers();
+            record.faces          = image->faces();
+            record.image          = appendBlock(data, image->data(), image->size());
+
+            const unsigned int slices = image->layers() * image->faces();
+            for (unsigned int i = 0; i < image->levels() * slices; i++) {
+                BlockRecord region;
+                region.offset = static_cast<unsigned int>(image->data(i / slices, i % slices) - image->data());
+                region.size   = image->size(i / slices, i % slices);
+                tables.regions.push_back(region);
+            }
+        }
+
+        textureIndices[texture.get()] = static_cast<int>(tables.textures.size());
+        tables.textures.push_back(record);
+    }
+
+    // Save materials
+    std::unordered_map<const Material *, int> materialIndices;
+    for (const auto & material : materials) {
+        MaterialRecord record;
+        record.firstValue   = static_cast<unsigned int>(tables.values.size());
+        record.firstTexture = static_cast<unsigned int>(tables.materialTextures.size());
+
+        // Save values
+        for (const auto & name : material->attributes()) {
+            ValueRecord value;
+            std::memset(&value, 0, sizeof(value));
+            value.name = appendString(data, name);
+            value.type = static_cast<unsigned int>(material->attribute(name)->type());
+
+            switch (material->attribute(name)->type())
+            {
+                case AttributeType::Integer:         storeValue(value, material->value<int>(name));          break;
+                case AttributeType::UnsignedInteger: storeValue(value, material->value<unsigned int>(name)); break;
+                case AttributeType::Float:           storeValue(value, material->value<float>(name));        break;
+                case AttributeType::Boolean:         storeValue(value, material->value<bool>(name) ? 1u : 0u); break;
+                case AttributeType::Vec2:            storeValue(value, material->value<glm::vec2>(name));    break;
+                case AttributeType::Vec3:            storeValue(value, material->value<glm::vec3>(name));    break;
+                case AttributeType::Vec4:            storeValue(value, material->value<glm::vec4>(name));    break;
+                case AttributeType::Mat3:            storeValue(value, material->value<glm::mat3>(name));    break;
+                case AttributeType::Mat4:            storeValue(value, material->value<glm::mat4>(name));    break;
+                case AttributeType::String:          value.string = appendString(data, material->value<std::string>(name)); break;
+                default: continue;
+            }
+
+            tables.values.push_back(value);
+        }
+
+        // Save textures and their samplers
+        for (const auto & name : material->textures()) {
+            MaterialTextureRecord texture;
+            texture.name = appendString(data, name);
+
+            auto textureIt = textureIndices.find(material->texture(name));
+            auto samplerIt = samplerIndices.find(material->sampler(name));
+            texture.texture = textureIt != textureIndices.end() ? textureIt->second : -1;
+            texture.sampler = samplerIt != samplerIndices.end() ? samplerIt->second : -1;
+
+            tables.materialTextures.push_back(texture);
+        }
+
+        record.valueCount   = static_cast<unsigned int>(tables.values.size())           - record.firstValue;
+        record.textureCount = static_cast<unsigned int>(tables.materialTextures.size()) - record.firstTexture;
+
+        materialIndices[material.get()] = static_cast<int>(tables.materials.size());
+        tables.materials.push_back(record);
+    }
+
+    // Save meshes
+    std::unordered_map<const Mesh *, unsigned int> meshIndices;
+    bool hasMorphTargets = false;
+    for (const auto & mesh : meshes) {
+        MeshRecord record;
+        record.firstBuffer    = static_cast<unsigned int>(tables.meshBuffers.size());
+        record.firstAttribute = static_cast<unsigned int>(tables.vertexAttributes.size());
+        record.firstGeometry  = static_cast<unsigned int>(tables.geometries.size());
+
+        // Save references to buffers
+        for (const auto * buffer : mesh->buffers()) {
+            tables.meshBuffers.push_back(static_cast<unsigned int>(addBuffer(buffer)));
+        }
+
+        // Save vertex attributes
+        std::unordered_map<const VertexAttribute *, unsigned int> attributeIndices;
+        for (const auto & vertexAttribute : mesh->vertexAttributes()) {
+            VertexAttributeRecord attribute;
+            attribute.buffer         = static_cast<unsigned int>(addBuffer(vertexAttribute->buffer()));
+            attribute.baseOffset     = vertexAttribute->baseOffset();
+            attribute.relativeOffset = vertexAttribute->relativeOffset();
+            attribute.stride         = vertexAttribute->stride();
+            attribute.type           = static_cast<unsigned int>(vertexAttribute->type());
+            attribute.components     = vertexAttribute->components();
+            attribute.normalize      = vertexAttribute->normalize() ? 1 : 0;
+
+            attributeIndices[vertexAttribute.get()] = static_cast<unsigned int>(tables.vertexAttributes.size()) - record.firstAttribute;
+            tables.vertexAttributes.push_back(attribute);
+        }
+
+        // Save geometries
+        for (const auto & geometry : mesh->geometries()) {
+            GeometryRecord geometryRecord;
+            auto materialIt = materialIndices.find(geometry->material());
+
+            geometryRecord.mode             = static_cast<unsigned int>(geometry->mode());
+            geometryRecord.material         = materialIt != materialIndices.end() ? materialIt->second : -1;
+            geometryRecord.indexBuffer      = addBuffer(geometry->indexBuffer());
+            geometryRecord.indexType        = static_cast<unsigned int>(geometry->indexBufferType());
+            geometryRecord.count            = geometry->count();
+            geometryRecord.baseVertex       = geometry->baseVertex();
+            geometryRecord.primitiveRestart = geometry->primitiveRestart() ? 1 : 0;
+            geometryRecord.firstBinding     = static_cast<unsigned int>(tables.bindings.size());
+            geometryRecord.firstLod         = static_cast<unsigned int>(tables.lods.size());
+            geometryRecord.firstMeshlet     = static_cast<unsigned int>(tables.meshlets.size());
+            std::memcpy(geometryRecord.boundingSphere,  &geometry->boundingSphere()[0],            sizeof(geometryRecord.boundingSphere));
+            std::memcpy(geometryRecord.boundingBox,     &geometry->boundingBoxMin()[0],            3 * sizeof(float));
+            std::memcpy(geometryRecord.boundingBox + 3, &geometry->boundingBoxMax()[0],            3 * sizeof(float));
+            std::memcpy(geometryRecord.dequantization,  &geometry->positionDequantization()[0][0], sizeof(geometryRecord.dequantization));
+
+            for (const auto & it : geometry->attributeBindings()) {
+                auto attributeIt = attributeIndices.find(it.second);
+                if (attributeIt == attributeIndices.end()) continue;
+
+                BindingRecord binding;
+                binding.index     = static_cast<unsigned int>(it.first);
+                binding.attribute = attributeIt->second;
+                tables.bindings.push_back(binding);
+            }
+
+            tables.lods.insert(tables.lods.end(), geometry->lods().begin(), geometry->lods().end());
+            tables.meshlets.insert(tables.meshlets.end(), geometry->meshlets().begin(), geometry->meshlets().end());
+
+            geometryRecord.bindingCount = static_cast<unsigned int>(tables.bindings.size()) - geometryRecord.firstBinding;
+            geometryRecord.lodCount     = static_cast<unsigned int>(tables.lods.size())     - geometryRecord.firstLod;
+            geometryRecord.meshletCount = static_cast<unsigned int>(tables.meshlets.size()) - geometryRecord.firstMeshlet;
+
+            hasMorphTargets |= geometry->morphTargets() != nullptr;
+            tables.geometries.push_back(geometryRecord);
+        }
+
+        record.bufferCount    = static_cast<unsigned int>(tables.meshBuffers.size())      - record.firstBuffer;
+        record.attributeCount = static_cast<unsigned int>(tables.vertexAttributes.size()) - record.firstAttribute;
+        record.geometryCount  = static_cast<unsigned int>(tables.geometries.size())       - record.firstGeometry;
+
+        meshIndices[mesh.get()] = static_cast<unsigned int>(tables.meshes.size());
+        tables.meshes.push_back(record);
+    }
+
+    // Save scenes as flat lists of nodes (parents precede their children)
+    bool hasUnsupportedComponents = false;
+    bool hasAnimations            = false;
+    for (const auto & scene : scenes) {
+        SceneRecord record;
+        record.firstNode = static_cast<unsigned int>(tables.nodes.size());
+
+        std::function<void (const rendercore::SceneNode & node, int parent)> saveNode;
+        saveNode = [&] (const rendercore::SceneNode & node, int parent) {
+            NodeRecord nodeRecord;
+            nodeRecord.parent         = parent;
+            nodeRecord.firstComponent = static_cast<unsigned int>(tables.components.size());
+            std::memcpy(nodeRecord.transform, &node.transform().transform()[0][0], sizeof(nodeRecord.transform));
+
+            // Save mesh components
+            for (const auto * component : node.components()) {
+                auto * meshComponent = dynamic_cast<const MeshComponent *>(component);
+                if (!meshComponent || dynamic_cast<const InstancedMeshComponent *>(component) || meshComponent->skin()) {
+                    hasUnsupportedComponents = true;
+                    continue;
+                }
+
+                auto meshIt = meshIndices.find(meshComponent->mesh());
+                if (meshIt != meshIndices.end()) {
+                    tables.components.push_back(meshIt->second);
+                }
+            }
+
+            nodeRecord.componentCount = static_cast<unsigned int>(tables.components.size()) - nodeRecord.firstComponent;
+
+            const int index = static_cast<int>(tables.nodes.size() - record.firstNode);
+            tables.nodes.push_back(nodeRecord);
+
+            // Save child nodes
+            for (const auto * child : node.children()) {
+                saveNode(*child, index);
+            }
+        };
+
+        saveNode(*scene->root(), -1);
+        hasAnimations |= !scene->animations().empty() || !scene->skins().empty();
+
+        record.nodeCount = static_cast<unsigned int>(tables.nodes.size()) - record.firstNode;
+        std::memcpy(record.boundingBox,     &scene->boundingBoxMin()[0], 3 * sizeof(float));
+        std::memcpy(record.boundingBox + 3, &scene->boundingBoxMax()[0], 3 * sizeof(float));
+        tables.scenes.push_back(record);
+    }
+
+    // Report data that can not be baked
+    if (hasMorphTargets)          cppassist::warning("rendercore") << "Baked asset '" << filename << "': morph targets are not baked";
+    if (hasUnsupportedComponents) cppassist::warning("rendercore") << "Baked asset '" << filename << "': skinned and instanced meshes are not baked";
+    if (hasAnimations)            cppassist::warning("rendercore") << "Baked asset '" << filename << "': animations and skins are not baked";
+
+    // Assemble file
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "RCBA", 4);
+    header.version = fileVersion;
+
+    std::vector<char> file(sizeof(header), 0);
+    writeTable(file, header, BufferTable,          tables.buffers);
+    writeTable(file, header, SamplerTable,         tables.samplers);
+    writeTable(file, header, TextureTable,         tables.textures);
+    writeTable(file, header, RegionTable,          tables.regions);
+    writeTable(file, header, MaterialTable,        tables.materials);
+    writeTable(file, header, ValueTable,           tables.values);
+    writeTable(file, header, MaterialTextureTable, tables.materialTextures);
+    writeTable(file, header, MeshTable,            tables.meshes);
+    writeTable(file, header, MeshBufferTable,      tables.meshBuffers);
+    writeTable(file, header, VertexAttributeTable, tables.vertexAttributes);
+    writeTable(file, header, GeometryTable,        tables.geometries);
+    writeTable(file, header, BindingTable,         tables.bindings);
+    writeTable(file, header, LodTable,             tables.lods);
+    writeTable(file, header, MeshletTable,         tables.meshlets);
+    writeTable(file, header, SceneTable,           tables.scenes);
+    writeTable(file, header, NodeTable,            tables.nodes);
+    writeTable(file, header, ComponentTable,       tables.components);
+
+    header.dataOffset = static_cast<unsigned int>(align(file.size()));
+    header.dataSize   = static_cast<unsigned int>(data.size());
+    if (static_cast<unsigned long long>(header.dataOffset) + data.size() > 0xffffffffull) {
+        cppassist::warning("rendercore") << "Baked asset '" << filename << "' exceeds 4 GiB";
+        return false;
+    }
+
+    file.resize(header.dataOffset, 0);
+    file.insert(file.end(), data.begin(), data.end());
+    std::memcpy(file.data(), &header, sizeof(header));
+
+    // Write to a file that is unique to this writer
+    static std::atomic<unsigned int> counter(0);
+    std::stringstream tmp;
+    tmp << filename << "." << std::hash<std::thread::id>()(std::this_thread::get_id()) << "." << counter++ << ".tmp";
+    const std::string tmpPath = tmp.str();
+
+    {
+        std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!stream.write(file.data(), static_cast<std::streamsize>(file.size()))) {
+            cppassist::warning("rendercore") << "Could not write baked asset '" << tmpPath << "'.";
+            stream.close();
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+
+    // Move the complete file into place
+#ifdef SYSTEM_WINDOWS
+    // Windows does not replace existing files on rename
+    std::remove(filename.c_str());
+#endif
+    if (std::rename(tmpPath.c_str(), filename.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+
+    // Done
+    cppassist::info("rendercore") << "Baked asset '" << filename << "': " << tables.meshes.size() << " meshes, "
+                                  << tables.textures.size() << " textures, " << file.size() << " bytes";
+    return true;
+}
+
+BakedAsset::BakedAsset()
+{
+}
+
+BakedAsset::~BakedAsset()
+{
+}
+
+bool BakedAsset::load(const std::string & filename)
+{
+    clear();
+
+    // Map file
+    auto file = std::make_shared<MappedFile>();
+    if (!file->open(filename)) {
+        return false;
+    }
+
+    // Create objects
+    if (!createObjects(file)) {
+        cppassist::warning("rendercore") << "Baked asset '" << filename << "' is invalid or has another version";
+        clear();
+        return false;
+    }
+
+    // Done
+    return true;
+}
+
+std::vector< std::unique_ptr<Buffer> > & BakedAsset::buffers()
+{
+    return m_buffers;
+}
+
+std::vector< std::unique_ptr<Texture> > & BakedAsset::textures()
+{
+    return m_textures;
+}
+
+std::vector< std::unique_ptr<Sampler> > & BakedAsset::samplers()
+{
+    return m_samplers;
+}
+
+std::vector< std::unique_ptr<Material> > & BakedAsset::materials()
+{
+    return m_materials;
+}
+
+std::vector< std::unique_ptr<Mesh> > & BakedAsset::meshes()
+{
+    return m_meshes;
+}
+
+std::vector< std::unique_ptr<rendercore::Scene> > & BakedAsset::scenes()
+{
+    return m_scenes;
+}
+
+bool BakedAsset::createObjects(const std::shared_ptr<MappedFile> & file)
+{
+    // Read header
+    FileHeader header;
+    if (file->size() < sizeof(header)) {
+        return false;
+    }
+
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (std::memcmp(header.magic, "RCBA", 4) != 0 || header.version != fileVersion ||
+        !checkRange(header.dataOffset, header.dataSize, file->size()))
+    {
+        return false;
+    }
+
+    // Read tables
+    Tables tables;
+    const char * fileData = file->data();
+    const size_t fileSize = file->size();
+    if (!readTable(fileData, fileSize, header, BufferTable,          tables.buffers)          ||
+        !readTable(fileData, fileSize, header, SamplerTable,         tables.samplers)         ||
+        !readTable(fileData, fileSize, header, TextureTable,         tables.textures)         ||
+        !readTable(fileData, fileSize, header, RegionTable,          tables.regions)          ||
+        !readTable(fileData, fileSize, header, MaterialTable,        tables.materials)        ||
+        !readTable(fileData, fileSize, header, ValueTable,           tables.values)           ||
+        !readTable(fileData, fileSize, header, MaterialTextureTable, tables.materialTextures) ||
+        !readTable(fileData, fileSize, header, MeshTable,            tables.meshes)           ||
+        !readTable(fileData, fileSize, header, MeshBufferTable,      tables.meshBuffers)      ||
+        !readTable(fileData, fileSize, header, VertexAttributeTable, tables.vertexAttributes) ||
+        !readTable(fileData, fileSize, header, GeometryTable,        tables.geometries)       ||
+        !readTable(fileData, fileSize, header, BindingTable,         tables.bindings)         ||
+        !readTable(fileData, fileSize, header, LodTable,             tables.lods)             ||
+        !readTable(fileData, fileSize, header, MeshletTable,         tables.meshlets)         ||
+        !readTable(fileData, fileSize, header, SceneTable,           tables.scenes)           ||
+        !readTable(fileData, fileSize, header, NodeTable,            tables.nodes)            ||
+        !readTable(fileData, fileSize, header, ComponentTable,       tables.components))
+    {
+        return false;
+    }
+
+    char * data = file->data() + header.dataOffset;
+    auto readString = [&] (const BlockRecord & block) -> std::string {
+        return checkBlock(block, header) ? std::string(data + block.offset, block.size) : std::string();
+    };
+
+    // Create buffers that reference the mapped data
+    for (const auto & record : tables.buffers) {
+        if (!checkBlock(record, header)) return false;
+
+        auto buffer = cppassist::make_unique<Buffer>();
+        buffer->setExternalData(data + record.offset, record.size, file);
+        m_buffers.push_back(std::move(buffer));
+    }
+
+    // Create samplers
+    for (const auto & record : tables.samplers) {
+        auto sampler = cppassist::make_unique<Sampler>();
+        sampler->setMinFilter(static_cast<gl::GLenum>(record.minFilter));
+        sampler->setMagFilter(static_cast<gl::GLenum>(record.magFilter));
+        sampler->setWrapS(static_cast<gl::GLenum>(record.wrapS));
+        sampler->setWrapT(static_cast<gl::GLenum>(record.wrapT));
+        m_samplers.push_back(std::move(sampler));
+    }
+
+    // Create textures with images that reference the mapped data
+    for (const auto & record : tables.textures) {
+        auto texture = cppassist::make_unique<Texture>();
+        texture->setMinFilter(static_cast<gl::GLenum>(record.minFilter));
+        texture->setMagFilter(static_cast<gl::GLenum>(record.magFilter));
+        texture->setWrapS(static_cast<gl::GLenum>(record.wrapS));
+        texture->setWrapT(static_cast<gl::GLenum>(record.wrapT));
+        texture->setSRGB(record.srgb != 0);
+
+        const unsigned long long regions = static_cast<unsigned long long>(record.levels) * record.layers * record.faces;
+        if (record.image.size > 0) {
+            if (!checkBlock(record.image, header) || regions == 0 || !checkRange(record.firstRegion, static_cast<unsigned int>(regions), tables.regions.size())) return false;
+
+            auto image = cppassist::make_unique<rendercore::Image>();
+            image->setExternalData(record.width, record.height, record.depth, record.format, record.type, record.image.size, data + record.image.offset, file);
+            image->setInternalFormat(record.internalFormat);
+            image->setLayout(record.levels, record.layers, record.faces);
+
+            const unsigned int slices = record.layers * record.faces;
+            for (unsigned int i = 0; i < regions; i++) {
+                const BlockRecord & region = tables.regions[record.firstRegion + i];
+                if (!checkRange(region.offset, region.size, record.image.size)) return false;
+
+                image->setRegion(i / slices, i % slices, region.offset, region.size);
+            }
+
+            texture->setImage(std::move(image));
+        }
+
+        m_textures.push_back(std::move(texture));
+    }
+
+    // Create materials
+    for (const auto & record : tables.materials) {
+        if (!checkRange(record.firstValue,   record.valueCount,   tables.values.size()) ||
+            !checkRange(record.firstTexture, record.textureCount, tables.materialTextures.size()))
+        {
+            return false;
+        }
+
+        auto material = cppassist::make_unique<Material>();
+
+        // Set values
+        for (unsigned int i = 0; i < record.valueCount; i++) {
+            const ValueRecord & value = tables.values[record.firstValue + i];
+            const std::string   name  = readString(value.name);
+
+            switch (static_cast<AttributeType>(value.type))
+            {
+                case AttributeType::Integer:         material->setValue(name, loadValue<int>(value));          break;
+                case AttributeType::UnsignedInteger: material->setValue(name, loadValue<unsigned int>(value)); break;
+                case AttributeType::Float:           material->setValue(name, loadValue<float>(value));        break;
+                case AttributeType::Boolean:         material->setValue(name, loadValue<unsigned int>(value) != 0); break;
+                case AttributeType::Vec2:            material->setValue(name, loadValue<glm::vec2>(value));    break;
+                case AttributeType::Vec3:            material->setValue(name, loadValue<glm::vec3>(value));    break;
+                case AttributeType::Vec4:            material->setValue(name, loadValue<glm::vec4>(value));    break;
+                case AttributeType::Mat3:            material->setValue(name, loadValue<glm::mat3>(value));    break;
+                case AttributeType::Mat4:            material->setValue(name, loadValue<glm::mat4>(value));    break;
+                case AttributeType::String:          material->setValue(name, readString(value.string));       break;
+                default: break;
+            }
+        }
+
+        // Set textures and samplers
+        for (unsigned int i = 0; i < record.textureCount; i++) {
+            const MaterialTextureRecord & texture = tables.materialTextures[record.firstTexture + i];
+            const std::string             name    = readString(texture.name);
+
+            if (texture.texture >= 0 && texture.texture < static_cast<int>(m_textures.size())) material->setTexture(name, m_textures[texture.texture].get());
+            if (texture.sampler >= 0 && texture.sampler < static_cast<int>(m_samplers.size())) material->setSampler(name, m_samplers[texture.sampler].get());
+        }
+
+        m_materials.push_back(std::move(material));
+    }
+
+    // Create meshes
+    for (const auto & record : tables.meshes) {
+        if (!checkRange(record.firstBuffer,    record.bufferCount,    tables.meshBuffers.size())      ||
+            !checkRange(record.firstAttribute, record.attributeCount, tables.vertexAttributes.size()) ||
+            !checkRange(record.firstGeometry,  record.geometryCount,  tables.geometries.size()))
+        {
+            return false;
+        }
+
+        auto mesh = cppassist::make_unique<Mesh>();
+
+        // Reference buffers
+        for (unsigned int i = 0; i < record.bufferCount; i++) {
+            const unsigned int buffer = tables.meshBuffers[record.firstBuffer + i];
+            if (buffer >= m_buffers.size()) return false;
+
+            mesh->addBuffer(m_buffers[buffer].get());
+        }
+
+        // Create vertex attributes
+        std::vector<VertexAttribute *> vertexAttributes;
+        for (unsigned int i = 0; i < record.attributeCount; i++) {
+            const VertexAttributeRecord & attribute = tables.vertexAttributes[record.firstAttribute + i];
+            if (attribute.buffer >= m_buffers.size() || !checkAttribute(attribute, 1, m_buffers[attribute.buffer]->size())) return false;
+
+            vertexAttributes.push_back(mesh->addVertexAttribute(
+                m_buffers[attribute.buffer].get(),
+                attribute.baseOffset,
+                attribute.relativeOffset,
+                static_cast<int>(attribute.stride),
+                static_cast<gl::GLenum>(attribute.type),
+                attribute.components,
+                attribute.normalize != 0
+            ));
+        }
+
+        // Create geometries
+        for (unsigned int i = 0; i < record.geometryCount; i++) {
+            const GeometryRecord & geometryRecord = tables.geometries[record.firstGeometry + i];
+            if (!checkRange(geometryRecord.firstBinding, geometryRecord.bindingCount, tables.bindings.size()) ||
+                !checkRange(geometryRecord.firstLod,     geometryRecord.lodCount,     tables.lods.size())     ||
+                !checkRange(geometryRecord.firstMeshlet, geometryRecord.meshletCount, tables.meshlets.size()))
+            {
+                return false;
+            }
+
+            // All index ranges must lie within the index buffer
+            const bool indexed = geometryRecord.indexBuffer >= 0 && geometryRecord.indexBuffer < static_cast<int>(m_buffers.size());
+            if (indexed) {
+                const size_t indexSize = indexTypeSize(geometryRecord.indexType);
+                if (indexSize == 0) return false;
+
+                const size_t indexCount = m_buffers[geometryRecord.indexBuffer]->size() / indexSize;
+                if (!checkRange(0, geometryRecord.count, indexCount)) return false;
+
+                for (unsigned int j = 0; j < geometryRecord.lodCount; j++) {
+                    const Geometry::Lod & lod = tables.lods[geometryRecord.firstLod + j];
+                    if (!checkRange(lod.offset, lod.count, indexCount)) return false;
+                }
+
+                for (unsigned int j = 0; j < geometryRecord.meshletCount; j++) {
+                    const rendercore::MeshletBuilder::Meshlet & meshlet = tables.meshlets[geometryRecord.firstMeshlet + j];
+                    if (!checkRange(meshlet.offset, meshlet.count, indexCount)) return false;
+                }
+            }
+
+            auto geometry = cppassist::make_unique<Geometry>();
+            geometry->setMode(static_cast<gl::GLenum>(geometryRecord.mode));
+            geometry->setCount(geometryRecord.count);
+
+            if (geometryRecord.material >= 0 && geometryRecord.material < static_cast<int>(m_materials.size())) {
+                geometry->setMaterial(m_materials[geometryRecord.material].get());
+            }
+
+            if (indexed) {
+                geometry->setIndexBuffer(m_buffers[geometryRecord.indexBuffer].get(), static_cast<gl::GLenum>(geometryRecord.indexType));
+                geometry->setCount(geometryRecord.count);
+                geometry->setBaseVertex(geometryRecord.baseVertex);
+                geometry->setPrimitiveRestart(geometryRecord.primitiveRestart != 0);
+            }
+
+            // Bind vertex attributes
+            for (unsigned int j = 0; j < geometryRecord.bindingCount; j++) {
+                const BindingRecord & binding = tables.bindings[geometryRecord.firstBinding + j];
+                if (binding.attribute >= vertexAttributes.size()) return false;
+
+                // Vertices drawn without index buffer must lie within the vertex buffers
+                const VertexAttributeRecord & attribute = tables.vertexAttributes[record.firstAttribute + binding.attribute];
+                if (!indexed && !checkAttribute(attribute, geometryRecord.count, m_buffers[attribute.buffer]->size())) return false;
+
+                geometry->bindAttribute(binding.index, vertexAttributes[binding.attribute]);
+            }
+
+            // Set levels of detail and meshlets
+            for (unsigned int j = 0; j < geometryRecord.lodCount; j++) {
+                const Geometry::Lod & lod = tables.lods[geometryRecord.firstLod + j];
+                geometry->addLod(lod.offset, lod.count, lod.error);
+            }
+
+            if (geometryRecord.meshletCount > 0) {
+                geometry->setMeshlets(std::vector<rendercore::MeshletBuilder::Meshlet>(
+                    tables.meshlets.begin() + geometryRecord.firstMeshlet,
+                    tables.meshlets.begin() + geometryRecord.firstMeshlet + geometryRecord.meshletCount
+                ));
+            }
+
+            glm::vec4 boundingSphere;
+            glm::vec3 boundingBoxMin;
+            glm::vec3 boundingBoxMax;
+            glm::mat4 dequantization;
+            std::memcpy(&boundingSphere[0],    geometryRecord.boundingSphere,  sizeof(geometryRecord.boundingSphere));
+            std::memcpy(&boundingBoxMin[0],    geometryRecord.boundingBox,     3 * sizeof(float));
+            std::memcpy(&boundingBoxMax[0],    geometryRecord.boundingBox + 3, 3 * sizeof(float));
+            std::memcpy(&dequantization[0][0], geometryRecord.dequantization,  sizeof(geometryRecord.dequantization));
+            geometry->setBoundingSphere(boundingSphere);
+            geometry->setBoundingBox(boundingBoxMin, boundingBoxMax);
+            geometry->setPositionDequantization(dequantization);
+
+            mesh->addGeometry(std::move(geometry));
+        }
+
+        m_meshes.push_back(std::move(mesh));
+    }
+
+    // Create scenes
+    for (const auto & record : tables.scenes) {
+        if (record.nodeCount == 0 || !checkRange(record.firstNode, record.nodeCount, tables.nodes.size())) {
+            return false;
+        }
+
+        auto scene = cppassist::make_unique<rendercore::Scene>();
+
+        // Create nodes (parents precede their children, the first node is the root)
+        std::vector<std::unique_ptr<rendercore::SceneNode> > nodes(record.nodeCount);
+        std::vector<rendercore::SceneNode *>                 nodePointers(record.nodeCount, nullptr);
+        for (unsigned int i = 0; i < record.nodeCount; i++) {
+            const NodeRecord & nodeRecord = tables.nodes[record.firstNode + i];
+            if ((i == 0) != (nodeRecord.parent < 0) || nodeRecord.parent >= static_cast<int>(i) ||
+                !checkRange(nodeRecord.firstComponent, nodeRecord.componentCount, tables.components.size()))
+            {
+                return false;
+            }
+
+            rendercore::SceneNode * node = scene->root();
+            if (i > 0) {
+                nodes[i] = cppassist::make_unique<rendercore::SceneNode>();
+                node = nodes[i].get();
+            }
+
+            nodePointers[i] = node;
+
+            // Set transformation
+            glm::mat4 matrix;
+            std::memcpy(&matrix[0][0], nodeRecord.transform, sizeof(nodeRecord.transform));
+
+            Transform transform;
+            transform.setTransform(matrix);
+            node->setTransform(transform);
+
+            // Add mesh components
+            for (unsigned int j = 0; j < nodeRecord.componentCount; j++) {
+                const unsigned int meshIndex = tables.components[nodeRecord.firstComponent + j];
+                if (meshIndex >= m_meshes.size()) return false;
+
+                auto meshComponent = cppassist::make_unique<MeshComponent>();
+                meshComponent->setMesh(m_meshes[meshIndex].get());
+                node->addComponent(std::move(meshComponent));
+            }
+        }
+
+        // Attach nodes to their parents
+        for (unsigned int i = 1; i < record.nodeCount; i++) {
+            const NodeRecord & nodeRecord = tables.nodes[record.firstNode + i];
+            nodePointers[nodeRecord.parent]->addChild(std::move(nodes[i]));
+        }
+
+        glm::vec3 boundingBoxMin;
+        glm::vec3 boundingBoxMax;
+        std::memcpy(&boundingBoxMin[0], record.boundingBox,     3 * sizeof(float));
+        std::memcpy(&boundingBoxMax[0], record.boundingBox + 3, 3 * sizeof(float));
+        scene->setBoundingBox(boundingBoxMin, boundingBoxMax);
+
+        m_scenes.push_back(std::move(scene));
+    }
+
+    // Done
+    return true;
+}
+
+void BakedAsset::clear()
+{
+    m_scenes.clear();
+    m_meshes.clear();
+    m_materials.clear();
+    m_textures.clear();
+    m_samplers.clear();
+    m_buffers.clear();
+}
+
+
+} // namespace opengl
+} // namespace rendercore
@@ -7,6 +7,8 @@
 
 #include <glbinding/gl/enum.h>
 
+#include <rendercore/VertexQuantizer.h>
+
 #include <rendercore-opengl/enums.h>
 
 
@@ -16,12 +18,12 @@ namespace opengl
 {
 
 
-Box::Box(GpuContainer * container, float size, bool texCoords)
-: Box(container, size, size, size, texCoords)
+Box::Box(GpuContainer * container, float size, bool texCoords, bool quantize)
+: Box(container, size, size, size, texCoords, quantize)
 {
 }
 
-Box::Box(GpuContainer * container, float width, float height, float depth, bool)
+Box::Box(GpuContainer * container, float width, float height, float depth, bool, bool quantize)
 : Mesh(container)
 {
     // Box geometry
@@ -131,34 +133,74 @@ Box::Box(GpuContainer * container, float width, float height, float depth, bool)
         vertex *= glm::vec3(width, height, depth);
     }
 
-    // Create buffers
-    auto * vertexBuffer   = createBuffer(scaledVertices);
-    auto * texCoordBuffer = createBuffer(texcoords);
-
-    // Create vertex attribute for positions
-    auto * positionAttribute = addVertexAttribute(
-        vertexBuffer,
-        0,
-        0,
-        sizeof(glm::vec3),
-        gl::GL_FLOAT,
-        3,
-        false
-    );
-
-    // Create vertex attribute for texture coordinates
-    auto * texCoordAttribute = addVertexAttribute(
-        texCoordBuffer,
-        0,
-        0,
-        sizeof(glm::vec2),
-        gl::GL_FLOAT,
-        2,
-        false
-    );
+    // Create geometry
+    auto geometry = cppassist::make_unique<opengl::Geometry>();
+
+    VertexAttribute * positionAttribute = nullptr;
+    VertexAttribute * texCoordAttribute = nullptr;
+
+    if (quantize) {
+        // Quantize positions relative to the bounding box, and texture coordinates in [0, 1]
+        glm::mat4 dequantization;
+        auto * vertexBuffer = createBuffer(VertexQuantizer::quantizePositions(
+            reinterpret_cast<const char *>(scaledVertices.data()), static_cast<unsigned int>(scaledVertices.size()), sizeof(glm::vec3), dequantization
+        ));
+        auto * texCoordBuffer = createBuffer(VertexQuantizer::packUnorm16(
+            reinterpret_cast<const char *>(texcoords.data()), static_cast<unsigned int>(texcoords.size()), sizeof(glm::vec2)
+        ));
+
+        // Create vertex attribute for positions
+        positionAttribute = addVertexAttribute(
+            vertexBuffer,
+            0,
+            0,
+            4 * sizeof(unsigned short),
+            gl::GL_UNSIGNED_SHORT,
+            3,
+            true
+        );
+
+        // Create vertex attribute for texture coordinates
+        texCoordAttribute = addVertexAttribute(
+            texCoordBuffer,
+            0,
+            0,
+            2 * sizeof(unsigned short),
+            gl::GL_UNSIGNED_SHORT,
+            2,
+            true
+        );
+
+        geometry->setPositionDequantization(dequantization);
+    } else {
+        // Create buffers
+        auto * vertexBuffer   = createBuffer(scaledVertices);
+        auto * texCoordBuffer = createBuffer(texcoords);
+
+        // Create vertex attribute for positions
+        positionAttribute = addVertexAttribute(
+            vertexBuffer,
+            0,
+            0,
+            sizeof(glm::vec3),
+            gl::GL_FLOAT,
+            3,
+            false
+        );
+
+        // Create vertex attribute for texture coordinates
+        texCoordAttribute = addVertexAttribute(
+            texCoordBuffer,
+            0,
+            0,
+            sizeof(glm::vec2),
+            gl::GL_FLOAT,
+            2,
+            false
+        );
+    }
 
     // Add geometry
-    auto geometry = cppassist::make_unique<opengl::Geometry>();
     geometry->setMode(gl::GL_TRIANGLES);
     geometry->setCount(vertices.size());
     geometry->bindAttribute((unsigned int)AttributeIndex::Position,  positionAttribute);
@@ -18,6 +18,8 @@ namespace opengl
 
 Buffer::Buffer(GpuContainer * container)
 : GpuObject(container)
+, m_size(0)
+, m_usage(gl::GL_STATIC_DRAW)
 {
 }
 
@@ -27,23 +29,24 @@ Buffer::~Buffer()
 
 unsigned int Buffer::size() const
 {
-    return m_data.size();
+    return m_size;
 }
 
 const char * Buffer::data() const
 {
-    return m_data.data();
+    return m_data.get();
 }
 
 char * Buffer::data()
 {
-    return m_data.data();
+    return m_data.get();
 }
 
 void Buffer::setData(const void * data, unsigned int size)
 {
     // Clear old data
-    m_data.clear();
+    m_data.reset();
+    m_size = 0;
 
     // Check if data is valid
     if (!data || size == 0) {
@@ -51,10 +54,26 @@ void Buffer::setData(const void * data, unsigned int size)
     }
 
     // Allocate data
-    m_data.resize(size);
+    allocate(size);
 
     // Copy data
-    std::memcpy(m_data.data(), data, size);
+    std::memcpy(m_data.get(), data, size);
+}
+
+void Buffer::setExternalData(char * data, unsigned int size, std::shared_ptr<void> owner)
+{
+    // Clear old data
+    m_data.reset();
+    m_size = 0;
+
+    // Check if data is valid
+    if (!data || size == 0) {
+        return;
+    }
+
+    // Reference data, keeping its owner alive
+    m_data = std::shared_ptr<char>(owner, data);
+    m_size = size;
 
     // Flag buffer invalid
     setValid(false);
@@ -63,15 +82,29 @@ void Buffer::setData(const void * data, unsigned int size)
 void Buffer::allocate(unsigned int size)
 {
     // Clear old data
-    m_data.clear();
+    m_data.reset();
+    m_size = 0;
 
-    // Set new size
-    m_data.resize(size);
+    // Allocate new data
+    if (size > 0) {
+        m_data = std::shared_ptr<char>(new char[size](), std::default_delete<char[]>());
+        m_size = size;
+    }
 
     // Flag buffer invalid
     setValid(false);
 }
 
+gl::GLenum Buffer::usage() const
+{
+    return m_usage;
+}
+
+void Buffer::setUsage(gl::GLenum usage)
+{
+    m_usage = usage;
+}
+
 globjects::Buffer * Buffer::buffer()
 {
     // Check if buffer needs to be updated or restored
@@ -92,7 +125,9 @@ void Buffer::onDeinit()
 void Buffer::createFromData()
 {
     // Create new buffer
-    m_buffer = cppassist::make_unique<globjects::Buffer>();
+    if (!m_buffer) {
+        m_buffer = cppassist::make_unique<globjects::Buffer>();
+    }
 
     // Check buffer
     if (!m_buffer) {
@@ -100,7 +135,7 @@ void Buffer::createFromData()
     }
 
     // Set buffer data
-    m_buffer->setData(m_data.size(), m_data.data(), gl::GL_STATIC_DRAW);
+    m_buffer->setData(m_size, m_data.get(), m_usage);
 
     // Flag buffer valid
     setValid(true);
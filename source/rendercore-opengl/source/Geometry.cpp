@@ -1,6 +1,9 @@
 
 #include <rendercore-opengl/Geometry.h>
 
+#include <algorithm>
+#include <limits>
+
 #include <cppassist/memory/make_unique.h>
 
 #include <glbinding/gl/gl.h>
@@ -22,7 +25,14 @@ Geometry::Geometry()
 , m_indexBuffer(nullptr)
 , m_indexType(gl::GL_UNSIGNED_INT)
 , m_count(0)
+, m_baseVertex(0)
+, m_primitiveRestart(false)
+, m_dequantization(1.0f)
 , m_material(nullptr)
+, m_morphTargets(nullptr)
+, m_boundingSphere(0.0f, 0.0f, 0.0f, 0.0f)
+, m_boundingBoxMin(std::numeric_limits<float>::max())
+, m_boundingBoxMax(-std::numeric_limits<float>::max())
 {
 }
 
@@ -66,6 +76,77 @@ void Geometry::setCount(unsigned int count)
     m_count = count;
 }
 
+int Geometry::baseVertex() const
+{
+    return m_baseVertex;
+}
+
+void Geometry::setBaseVertex(int baseVertex)
+{
+    m_baseVertex = baseVertex;
+}
+
+bool Geometry::primitiveRestart() const
+{
+    return m_primitiveRestart;
+}
+
+void Geometry::setPrimitiveRestart(bool enabled)
+{
+    m_primitiveRestart = enabled;
+}
+
+const std::vector<Geometry::Lod> & Geometry::lods() const
+{
+    return m_lods;
+}
+
+void Geometry::addLod(unsigned int offset, unsigned int count, float error)
+{
+    Lod lod;
+    lod.offset = offset;
+    lod.count  = count;
+    lod.error  = error;
+
+    m_lods.push_back(lod);
+}
+
+const glm::vec4 & Geometry::boundingSphere() const
+{
+    return m_boundingSphere;
+}
+
+void Geometry::setBoundingSphere(const glm::vec4 & sphere)
+{
+    m_boundingSphere = sphere;
+}
+
+const glm::vec3 & Geometry::boundingBoxMin() const
+{
+    return m_boundingBoxMin;
+}
+
+const glm::vec3 & Geometry::boundingBoxMax() const
+{
+    return m_boundingBoxMax;
+}
+
+void Geometry::setBoundingBox(const glm::vec3 & min, const glm::vec3 & max)
+{
+    m_boundingBoxMin = min;
+    m_boundingBoxMax = max;
+}
+
+const std::vector<rendercore::MeshletBuilder::Meshlet> & Geometry::meshlets() const
+{
+    return m_meshlets;
+}
+
+void Geometry::setMeshlets(const std::vector<rendercore::MeshletBuilder::Meshlet> & meshlets)
+{
+    m_meshlets = meshlets;
+}
+
 const std::unordered_map<size_t, const VertexAttribute *> & Geometry::attributeBindings() const
 {
     return m_attributes;
@@ -90,6 +171,16 @@ void Geometry::bindAttribute(size_t index, const VertexAttribute * vertexAttribu
     m_attributes[index] = vertexAttribute;
 }
 
+const glm::mat4 & Geometry::positionDequantization() const
+{
+    return m_dequantization;
+}
+
+void Geometry::setPositionDequantization(const glm::mat4 & dequantization)
+{
+    m_dequantization = dequantization;
+}
+
 Material * Geometry::material() const
 {
     return m_material;
@@ -100,7 +191,17 @@ void Geometry::setMaterial(Material * material)
     m_material = material;
 }
 
-void Geometry::draw()
+MorphTargets * Geometry::morphTargets() const
+{
+    return m_morphTargets;
+}
+
+void Geometry::setMorphTargets(MorphTargets * morphTargets)
+{
+    m_morphTargets = morphTargets;
+}
+
+void Geometry::draw(unsigned int lod)
 {
     // Check if VAO needs to be created
     if (!m_vao.get()) {
@@ -112,8 +213,33 @@ void Geometry::draw()
 
     // Draw with index buffer (DrawElements)
     if (m_indexBuffer) {
+        // Get index range of the level of detail
+        unsigned int offset = 0;
+        unsigned int count  = m_count;
+
+        if (!m_lods.empty()) {
+            const Lod & range = m_lods[std::min(static_cast<size_t>(lod), m_lods.size() - 1)];
+            offset = range.offset;
+            count  = range.count;
+        }
+
+        // Separate primitives by the maximum index value
+        if (m_primitiveRestart) {
+            gl::glEnable(gl::GL_PRIMITIVE_RESTART);
+            gl::glPrimitiveRestartIndex(restartIndex());
+        }
+
         m_indexBuffer->buffer()->bind(gl::GL_ELEMENT_ARRAY_BUFFER);
-        m_vao->drawElements(m_mode, m_count, m_indexType, nullptr);
+
+        if (m_baseVertex != 0) {
+            m_vao->drawElementsBaseVertex(m_mode, count, m_indexType, reinterpret_cast<const void *>(offset * indexSize()), m_baseVertex);
+        } else {
+            m_vao->drawElements(m_mode, count, m_indexType, reinterpret_cast<const void *>(offset * indexSize()));
+        }
+
+        if (m_primitiveRestart) {
+            gl::glDisable(gl::GL_PRIMITIVE_RESTART);
+        }
     }
 
     // Draw without buffer (DrawArrays)
@@ -126,12 +252,142 @@ void Geometry::draw()
     m_vao->unbind();
 }
 
+void Geometry::drawMeshlets(const std::vector<unsigned int> & meshlets)
+{
+    // Check if there is anything to draw
+    if (!m_indexBuffer || meshlets.empty()) {
+        return;
+    }
+
+    // Check if VAO needs to be created
+    if (!m_vao.get()) {
+        prepareVAO();
+    }
+
+    // Get index ranges of the meshlets
+    m_drawCounts.clear();
+    m_drawOffsets.clear();
+
+    for (unsigned int index : meshlets) {
+        if (index >= m_meshlets.size()) continue;
+
+        const auto & meshlet = m_meshlets[index];
+        m_drawCounts.push_back(static_cast<gl::GLsizei>(meshlet.count));
+        m_drawOffsets.push_back(reinterpret_cast<const void *>(meshlet.offset * indexSize()));
+    }
+
+    // Bind VAO
+    m_vao->bind();
+
+    // Draw all meshlets at once
+    m_indexBuffer->buffer()->bind(gl::GL_ELEMENT_ARRAY_BUFFER);
+    m_vao->multiDrawElements(m_mode, m_drawCounts.data(), m_indexType, m_drawOffsets.data(), static_cast<gl::GLsizei>(m_drawCounts.size()));
+
+    // Release VAO
+    m_vao->unbind();
+}
+
+void Geometry::drawInstanced(unsigned int instanceCount, const std::unordered_map<size_t, const VertexAttribute *> & instanceAttributes, unsigned int lod)
+{
+    // Check if there is anything to draw
+    if (instanceCount == 0) {
+        return;
+    }
+
+    // Check if VAO needs to be created
+    if (!m_vao.get()) {
+        prepareVAO();
+    }
+
+    // Bind VAO
+    m_vao->bind();
+
+    // Enable instance attributes (bindings are numbered by attribute index, which is above the per-vertex bindings)
+    for (auto it : instanceAttributes) {
+        size_t index = it.first;
+        auto * attr  = it.second;
+
+        if (!attr || !attr->buffer()) {
+            continue;
+        }
+
+        m_vao->enable(index);
+        m_vao->binding(index)->setAttribute(index);
+        m_vao->binding(index)->setBuffer(attr->buffer()->buffer(), attr->baseOffset(), attr->stride());
+        m_vao->binding(index)->setFormat(attr->components(), attr->type(), attr->normalize(), attr->relativeOffset());
+        m_vao->binding(index)->setDivisor(1);
+    }
+
+    // Draw with index buffer (DrawElementsInstanced)
+    if (m_indexBuffer) {
+        // Get index range of the level of detail
+        unsigned int offset = 0;
+        unsigned int count  = m_count;
+
+        if (!m_lods.empty()) {
+            const Lod & range = m_lods[std::min(static_cast<size_t>(lod), m_lods.size() - 1)];
+            offset = range.offset;
+            count  = range.count;
+        }
+
+        // Separate primitives by the maximum index value
+        if (m_primitiveRestart) {
+            gl::glEnable(gl::GL_PRIMITIVE_RESTART);
+            gl::glPrimitiveRestartIndex(restartIndex());
+        }
+
+        m_indexBuffer->buffer()->bind(gl::GL_ELEMENT_ARRAY_BUFFER);
+
+        if (m_baseVertex != 0) {
+            m_vao->drawElementsInstancedBaseVertex(m_mode, count, m_indexType, reinterpret_cast<const void *>(offset * indexSize()), instanceCount, m_baseVertex);
+        } else {
+            m_vao->drawElementsInstanced(m_mode, count, m_indexType, reinterpret_cast<const void *>(offset * indexSize()), instanceCount);
+        }
+
+        if (m_primitiveRestart) {
+            gl::glDisable(gl::GL_PRIMITIVE_RESTART);
+        }
+    }
+
+    // Draw without buffer (DrawArraysInstanced)
+    else {
+        globjects::Buffer::unbind(gl::GL_ELEMENT_ARRAY_BUFFER);
+        m_vao->drawArraysInstanced(m_mode, 0, m_count, instanceCount);
+    }
+
+    // Disable instance attributes
+    for (auto it : instanceAttributes) {
+        m_vao->disable(it.first);
+    }
+
+    // Release VAO
+    m_vao->unbind();
+}
+
 void Geometry::deinit()
 {
     // Release VAO
     m_vao.reset();
 }
 
+size_t Geometry::indexSize() const
+{
+    switch (m_indexType) {
+        case gl::GL_UNSIGNED_BYTE:  return 1;
+        case gl::GL_UNSIGNED_SHORT: return 2;
+        default:                    return 4;
+    }
+}
+
+gl::GLuint Geometry::restartIndex() const
+{
+    switch (m_indexType) {
+        case gl::GL_UNSIGNED_BYTE:  return 0xff;
+        case gl::GL_UNSIGNED_SHORT: return 0xffff;
+        default:                    return 0xffffffff;
+    }
+}
+
 void Geometry::prepareVAO()
 {
     // Create VAO
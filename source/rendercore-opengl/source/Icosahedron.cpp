@@ -84,7 +84,8 @@ void Icosahedron::generateGeometry(gl::GLsizei iterations)
     m_vertices = std::vector<vec3>(v.begin(), v.end());
     m_indices  = std::vector<Face>(i.begin(), i.end());
 
-    refine(m_vertices, m_indices, static_cast<char>(glm::clamp(iterations, 0, 8)));
+    // Limit the number of levels, so that the vertex and face counts stay well within 32 bit
+    refine(m_vertices, m_indices, static_cast<unsigned char>(glm::clamp(iterations, 0, 12)));
 }
 
 void Icosahedron::generateTextureCoordinates()
@@ -115,7 +116,7 @@ const std::vector<glm::vec2> & Icosahedron::texcoords() const
     return m_texcoords;
 }
 
-const std::vector<std::array<gl::GLushort, 3>> & Icosahedron::indices() const
+const std::vector<Icosahedron::Face> & Icosahedron::indices() const
 {
     return m_indices;
 }
@@ -125,21 +126,25 @@ void Icosahedron::refine(
   , std::vector<Face> & indices
   , const unsigned char levels)
 {
-    std::unordered_map<uint, gl::GLushort> cache;
+    std::unordered_map<unsigned long long, gl::GLuint> cache;
 
     for(int i = 0; i < levels; ++i) {
-        const int size(static_cast<int>(indices.size()));
+        const size_t size(indices.size());
 
-        for(int f = 0; f < size; ++f) {
+        // Each face is split into 4, each level adds about one vertex per face
+        indices.reserve(size * 4);
+        vertices.reserve(vertices.size() + size);
+
+        for(size_t f = 0; f < size; ++f) {
             Face & face = indices[f];
 
-            const gl::GLushort a(face[0]);
-            const gl::GLushort b(face[1]);
-            const gl::GLushort c(face[2]);
+            const gl::GLuint a(face[0]);
+            const gl::GLuint b(face[1]);
+            const gl::GLuint c(face[2]);
 
-            const gl::GLushort ab(split(a, b, vertices, cache));
-            const gl::GLushort bc(split(b, c, vertices, cache));
-            const gl::GLushort ca(split(c, a, vertices, cache));
+            const gl::GLuint ab(split(a, b, vertices, cache));
+            const gl::GLuint bc(split(b, c, vertices, cache));
+            const gl::GLuint ca(split(c, a, vertices, cache));
 
             face = {{ ab, bc, ca }};
 
@@ -150,17 +155,17 @@ void Icosahedron::refine(
     }
 }
 
-gl::GLushort Icosahedron::split(
-    const gl::GLushort a
-  , const gl::GLushort b
+gl::GLuint Icosahedron::split(
+    const gl::GLuint a
+  , const gl::GLuint b
   , std::vector<vec3> & points
-  , std::unordered_map<uint, gl::GLushort> & cache)
+  , std::unordered_map<unsigned long long, gl::GLuint> & cache)
 {
     const bool aSmaller(a < b);
 
-    const uint smaller(aSmaller ? a : b);
-    const uint greater(aSmaller ? b : a);
-    const uint hash((smaller << 16) + greater);
+    const unsigned long long smaller(aSmaller ? a : b);
+    const unsigned long long greater(aSmaller ? b : a);
+    const unsigned long long hash((smaller << 32) | greater);
 
     auto h(cache.find(hash));
     if(cache.end() != h) {
@@ -169,7 +174,7 @@ gl::GLushort Icosahedron::split(
 
     points.push_back(normalize((points[a] + points[b]) * 0.5f));
 
-    const gl::GLushort i = static_cast<gl::GLushort>(points.size() - 1);
+    const gl::GLuint i = static_cast<gl::GLuint>(points.size() - 1);
 
     cache[hash] = i;
 
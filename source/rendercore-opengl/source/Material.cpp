@@ -98,6 +98,36 @@ void Material::setTexture(const std::string & name, Texture * texture)
     m_textures[name] = texture;
 }
 
+const Sampler * Material::sampler(const std::string & name) const
+{
+    // Check if sampler exists
+    if (m_samplers.count(name) > 0) {
+        // Get sampler
+        return m_samplers.at(name);
+    }
+
+    // Sampler does not exist
+    return nullptr;
+}
+
+Sampler * Material::sampler(const std::string & name)
+{
+    // Check if sampler exists
+    if (m_samplers.count(name) > 0) {
+        // Get sampler
+        return m_samplers.at(name);
+    }
+
+    // Sampler does not exist
+    return nullptr;
+}
+
+void Material::setSampler(const std::string & name, Sampler * sampler)
+{
+    // Set sampler
+    m_samplers[name] = sampler;
+}
+
 void Material::onInit()
 {
 }
@@ -1,6 +1,8 @@
 
 #include <rendercore-opengl/Mesh.h>
 
+#include <limits>
+
 #include <cppassist/memory/make_unique.h>
 
 #include <glbinding/gl/gl.h>
@@ -14,6 +16,8 @@ namespace opengl
 
 Mesh::Mesh(GpuContainer * container)
 : GpuContainer(container)
+, m_boundingBoxMin(std::numeric_limits<float>::max())
+, m_boundingBoxMax(-std::numeric_limits<float>::max())
 {
 }
 
@@ -85,6 +89,22 @@ Buffer * Mesh::createBuffer(const void * data, unsigned int size)
     return bufferPtr;
 }
 
+Buffer * Mesh::createBuffer(char * data, unsigned int size, std::shared_ptr<void> owner)
+{
+    // Create new buffer
+    auto buffer = cppassist::make_unique<Buffer>(this);
+
+    // Reference buffer data
+    buffer->setExternalData(data, size, owner);
+
+    // Add buffer
+    auto * bufferPtr = buffer.get();
+    addBuffer(std::move(buffer));
+
+    // Return buffer
+    return bufferPtr;
+}
+
 const std::vector< std::unique_ptr<VertexAttribute> > & Mesh::vertexAttributes() const
 {
     // Return list of vertex attributes
@@ -148,10 +168,42 @@ Geometry * Mesh::geometry(size_t index)
 
 void Mesh::addGeometry(std::unique_ptr<Geometry> && geometry)
 {
+    // Extend bounding box
+    if (geometry) {
+        m_boundingBoxMin = glm::min(m_boundingBoxMin, geometry->boundingBoxMin());
+        m_boundingBoxMax = glm::max(m_boundingBoxMax, geometry->boundingBoxMax());
+    }
+
     // Add geometry
     m_geometries.push_back(std::move(geometry));
 }
 
+const glm::vec3 & Mesh::boundingBoxMin() const
+{
+    return m_boundingBoxMin;
+}
+
+const glm::vec3 & Mesh::boundingBoxMax() const
+{
+    return m_boundingBoxMax;
+}
+
+void Mesh::setBoundingBox(const glm::vec3 & min, const glm::vec3 & max)
+{
+    m_boundingBoxMin = min;
+    m_boundingBoxMax = max;
+}
+
+MorphTargets * Mesh::addMorphTargets(std::unique_ptr<MorphTargets> && morphTargets)
+{
+    // Make the mesh responsible for releasing the GPU data
+    morphTargets->setContainer(this);
+
+    // Add morph targets
+    m_morphTargets.push_back(std::move(morphTargets));
+    return m_morphTargets.back().get();
+}
+
 void Mesh::draw() const
 {
     // Draw geometry
@@ -0,0 +1,263 @@
+
+#include <rendercore-opengl/MorphTargets.h>
+
+#include <algorithm>
+
+#include <cppassist/memory/make_unique.h>
+
+#include <glbinding/gl/gl.h>
+#include <glbinding/gl/enum.h>
+
+
+namespace rendercore
+{
+namespace opengl
+{
+
+
+unsigned int MorphTargets::maxShaderTargets()
+{
+    return 8;
+}
+
+MorphTargets::MorphTargets(GpuContainer * container)
+: GpuObject(container)
+, m_vertexCount(0)
+{
+}
+
+MorphTargets::~MorphTargets()
+{
+}
+
+unsigned int MorphTargets::vertexCount() const
+{
+    return m_vertexCount;
+}
+
+void MorphTargets::setVertexCount(unsigned int vertexCount)
+{
+    m_vertexCount = vertexCount;
+
+    // Flag data invalid
+    invalidate();
+}
+
+const std::vector<MorphTargets::Target> & MorphTargets::targets() const
+{
+    return m_targets;
+}
+
+void MorphTargets::addTarget(const std::vector<unsigned int> & positionVertices, const std::vector<glm::vec3> & positions,
+                             const std::vector<unsigned int> & normalVertices, const std::vector<glm::vec3> & normals)
+{
+    Target target;
+
+    // Merge displaced vertices of positions and normals
+    const bool   hasNormals   = !normalVertices.empty();
+    const size_t numPositions = std::min(positionVertices.size(), positions.size());
+    const size_t numNormals   = std::min(normalVertices.size(),   normals.size());
+
+    size_t p = 0;
+    size_t n = 0;
+    while (p < numPositions || n < numNormals) {
+        // Get next vertex of either list
+        unsigned int vertex = std::min(p < numPositions ? positionVertices[p] : ~0u,
+                                       n < numNormals   ? normalVertices[n]   : ~0u);
+
+        target.vertices.push_back(vertex);
+        target.positions.push_back(p < numPositions && positionVertices[p] == vertex ? positions[p++] : glm::vec3(0.0f));
+
+        if (hasNormals) {
+            target.normals.push_back(n < numNormals && normalVertices[n] == vertex ? normals[n++] : glm::vec3(0.0f));
+        }
+    }
+
+    m_targets.push_back(std::move(target));
+
+    // Flag data invalid
+    invalidate();
+}
+
+bool MorphTargets::blendsOnCpu() const
+{
+    return m_targets.size() > maxShaderTargets();
+}
+
+unsigned int MorphTargets::update(const std::vector<float> & weights, std::vector<int> & targets, std::vector<float> & targetWeights)
+{
+    targets.clear();
+    targetWeights.clear();
+
+    // Make sure that the displacements have been uploaded
+    if (!texture()) {
+        return 0;
+    }
+
+    // Few targets: let the shader blend the active ones
+    if (!blendsOnCpu()) {
+        for (size_t i=0; i<m_targets.size() && i<weights.size(); i++) {
+            if (weights[i] != 0.0f) {
+                targets.push_back(static_cast<int>(i));
+                targetWeights.push_back(weights[i]);
+            }
+        }
+
+        return static_cast<unsigned int>(targets.size());
+    }
+
+    // Many targets: blend on the CPU, unless the weights have not changed
+    bool changed = m_blendedWeights.size() != m_targets.size();
+    for (size_t i=0; i<m_targets.size() && !changed; i++) {
+        changed = m_blendedWeights[i] != (i < weights.size() ? weights[i] : 0.0f);
+    }
+
+    if (changed) {
+        blend(weights);
+    }
+
+    // Let the shader add the blended displacements
+    if (!m_displaced.empty()) {
+        targets.push_back(0);
+        targetWeights.push_back(1.0f);
+    }
+
+    return static_cast<unsigned int>(targets.size());
+}
+
+globjects::Texture * MorphTargets::texture()
+{
+    // Check if texture needs to be updated or restored
+    if (!m_texture.get() || !valid()) {
+        createFromData();
+    }
+
+    // Return texture
+    return m_texture.get();
+}
+
+void MorphTargets::onDeinit()
+{
+    // Release texture and buffer
+    m_texture.reset();
+    m_buffer.reset();
+}
+
+void MorphTargets::invalidate()
+{
+    // Discard blended displacements
+    m_blendedWeights.clear();
+    m_blended.clear();
+    m_displaced.clear();
+
+    // Flag texture invalid
+    setValid(false);
+}
+
+void MorphTargets::createFromData()
+{
+    // Check data
+    if (m_vertexCount == 0 || m_targets.empty()) {
+        return;
+    }
+
+    // Expand displacements, one set per target or a single blended set
+    std::vector<glm::vec4> data;
+
+    if (blendsOnCpu()) {
+        m_blended.resize(m_vertexCount * 2, glm::vec4(0.0f));
+        data = m_blended;
+    } else {
+        data.assign(m_targets.size() * m_vertexCount * 2, glm::vec4(0.0f));
+
+        for (size_t t=0; t<m_targets.size(); t++) {
+            const Target & target = m_targets[t];
+            glm::vec4    * slot   = &data[t * m_vertexCount * 2];
+
+            for (size_t i=0; i<target.vertices.size(); i++) {
+                const unsigned int vertex = target.vertices[i];
+                if (vertex >= m_vertexCount) continue;
+
+                slot[vertex * 2] = glm::vec4(target.positions[i], 0.0f);
+                if (!target.normals.empty()) {
+                    slot[vertex * 2 + 1] = glm::vec4(target.normals[i], 0.0f);
+                }
+            }
+        }
+    }
+
+    // Create buffer
+    if (!m_buffer) {
+        m_buffer = cppassist::make_unique<globjects::Buffer>();
+    }
+
+    m_buffer->setData(data.size() * sizeof(glm::vec4), data.data(), blendsOnCpu() ? gl::GL_STREAM_DRAW : gl::GL_STATIC_DRAW);
+
+    // Create buffer texture
+    if (!m_texture) {
+        m_texture = globjects::Texture::create(gl::GL_TEXTURE_BUFFER);
+    }
+
+    m_texture->texBuffer(gl::GL_RGBA32F, m_buffer.get());
+
+    // Flag texture valid
+    setValid(true);
+}
+
+void MorphTargets::blend(const std::vector<float> & weights)
+{
+    // Remember range of changed vertices
+    unsigned int first = m_vertexCount;
+    unsigned int last  = 0;
+
+    // Reset vertices displaced by the last blend
+    for (unsigned int vertex : m_displaced) {
+        m_blended[vertex * 2]     = glm::vec4(0.0f);
+        m_blended[vertex * 2 + 1] = glm::vec4(0.0f);
+
+        first = std::min(first, vertex);
+        last  = std::max(last,  vertex);
+    }
+
+    m_displaced.clear();
+    m_blendedWeights.assign(m_targets.size(), 0.0f);
+
+    // Add displacements of the active targets
+    for (size_t t=0; t<m_targets.size() && t<weights.size(); t++) {
+        const float weight = weights[t];
+        m_blendedWeights[t] = weight;
+        if (weight == 0.0f) continue;
+
+        const Target & target = m_targets[t];
+        for (size_t i=0; i<target.vertices.size(); i++) {
+            const unsigned int vertex = target.vertices[i];
+            if (vertex >= m_vertexCount) continue;
+
+            glm::vec4 & position = m_blended[vertex * 2];
+            if (position.w == 0.0f) {
+                position.w = 1.0f;
+                m_displaced.push_back(vertex);
+
+                first = std::min(first, vertex);
+                last  = std::max(last,  vertex);
+            }
+
+            position += glm::vec4(weight * target.positions[i], 0.0f);
+            if (!target.normals.empty()) {
+                m_blended[vertex * 2 + 1] += glm::vec4(weight * target.normals[i], 0.0f);
+            }
+        }
+    }
+
+    // Upload changed vertices
+    if (first <= last) {
+        const size_t offset = static_cast<size_t>(first) * 2 * sizeof(glm::vec4);
+        const size_t size   = static_cast<size_t>(last - first + 1) * 2 * sizeof(glm::vec4);
+
+        m_buffer->setSubData(offset, size, &m_blended[first * 2]);
+    }
+}
+
+
+} // namespace opengl
+} // namespace rendercore
@@ -0,0 +1,108 @@
+
+#include <rendercore-opengl/Sampler.h>
+
+#include <cppassist/memory/make_unique.h>
+
+#include <glbinding/gl/enum.h>
+
+
+namespace rendercore
+{
+namespace opengl
+{
+
+
+Sampler::Sampler(GpuContainer * container)
+: GpuObject(container)
+, m_minFilter(gl::GL_LINEAR)
+, m_magFilter(gl::GL_LINEAR)
+, m_wrapS(gl::GL_REPEAT)
+, m_wrapT(gl::GL_REPEAT)
+{
+}
+
+Sampler::~Sampler()
+{
+}
+
+gl::GLenum Sampler::minFilter() const
+{
+    return m_minFilter;
+}
+
+void Sampler::setMinFilter(gl::GLenum filter)
+{
+    m_minFilter = filter;
+    setValid(false);
+}
+
+gl::GLenum Sampler::magFilter() const
+{
+    return m_magFilter;
+}
+
+void Sampler::setMagFilter(gl::GLenum filter)
+{
+    m_magFilter = filter;
+    setValid(false);
+}
+
+gl::GLenum Sampler::wrapS() const
+{
+    return m_wrapS;
+}
+
+void Sampler::setWrapS(gl::GLenum mode)
+{
+    m_wrapS = mode;
+    setValid(false);
+}
+
+gl::GLenum Sampler::wrapT() const
+{
+    return m_wrapT;
+}
+
+void Sampler::setWrapT(gl::GLenum mode)
+{
+    m_wrapT = mode;
+    setValid(false);
+}
+
+globjects::Sampler * Sampler::sampler()
+{
+    // Check if sampler needs to be updated or restored
+    if (!m_sampler.get() || !valid()) {
+        createSampler();
+    }
+
+    // Return sampler
+    return m_sampler.get();
+}
+
+void Sampler::onDeinit()
+{
+    // Release sampler
+    m_sampler.reset();
+}
+
+void Sampler::createSampler()
+{
+    // Create sampler object
+    if (!m_sampler) {
+        m_sampler = cppassist::make_unique<globjects::Sampler>();
+    }
+
+    // Set sampler parameters
+    m_sampler->setParameter(gl::GL_TEXTURE_MIN_FILTER, m_minFilter);
+    m_sampler->setParameter(gl::GL_TEXTURE_MAG_FILTER, m_magFilter);
+    m_sampler->setParameter(gl::GL_TEXTURE_WRAP_S,     m_wrapS);
+    m_sampler->setParameter(gl::GL_TEXTURE_WRAP_T,     m_wrapT);
+
+    // Flag sampler valid
+    setValid(true);
+}
+
+
+} // namespace opengl
+} // namespace rendercore
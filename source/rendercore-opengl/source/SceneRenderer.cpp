@@ -1,8 +1,13 @@
 
 #include <rendercore-opengl/SceneRenderer.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include <glbinding/gl/gl.h>
 
+#include <cppassist/logging/logging.h>
 #include <cppassist/memory/make_unique.h>
 
 #include <rendercore/rendercore.h>
@@ -10,15 +15,56 @@
 #include <rendercore/Transform.h>
 #include <rendercore/scene/Scene.h>
 #include <rendercore/scene/SceneNode.h>
+#include <rendercore/scene/Skin.h>
 
 #include <rendercore-opengl/enums.h>
+#include <rendercore-opengl/Buffer.h>
+#include <rendercore-opengl/Geometry.h>
 #include <rendercore-opengl/Mesh.h>
 #include <rendercore-opengl/Material.h>
+#include <rendercore-opengl/MorphTargets.h>
 #include <rendercore-opengl/Shader.h>
 #include <rendercore-opengl/Texture.h>
+#include <rendercore-opengl/Sampler.h>
+#include <rendercore-opengl/scene/InstancedMeshComponent.h>
 #include <rendercore-opengl/scene/MeshComponent.h>
 
 
+namespace
+{
+
+
+// Maximum number of joints per skin (size of the uniform block in the shader)
+const size_t maxJoints = 256;
+
+// Get projected size of a model space unit at the nearest point of a bounding sphere (relative to the viewport height)
+float projectedScale(const glm::vec4 & sphere, const glm::mat4 & transform, const rendercore::Camera & camera)
+{
+    // Get largest scale factor of the model transformation
+    float scale = std::sqrt(std::max(glm::dot(glm::vec3(transform[0]), glm::vec3(transform[0])),
+                            std::max(glm::dot(glm::vec3(transform[1]), glm::vec3(transform[1])),
+                                     glm::dot(glm::vec3(transform[2]), glm::vec3(transform[2])))));
+
+    // Orthographic projection: size does not depend on the distance
+    const glm::mat4 & projection = camera.projectionMatrix();
+    if (projection[2][3] == 0.0f) {
+        return scale * projection[1][1] * 0.5f;
+    }
+
+    // Perspective projection: get distance of the nearest point of the sphere
+    glm::vec4 center = camera.viewMatrix() * transform * glm::vec4(sphere.x, sphere.y, sphere.z, 1.0f);
+    float distance = -center.z - sphere.w * scale;
+    if (distance <= 0.0f) {
+        return std::numeric_limits<float>::max();
+    }
+
+    return scale * projection[1][1] * 0.5f / distance;
+}
+
+
+} // namespace
+
+
 namespace rendercore
 {
 namespace opengl
@@ -27,6 +73,10 @@ namespace opengl
 
 SceneRenderer::SceneRenderer(GpuContainer * container)
 : GpuContainer(container)
+, m_lodThreshold(0.001f)
+, m_lodHysteresis(0.25f)
+, m_meshletCulling(true)
+, m_jointLimitWarned(false)
 {
     // Create program
     m_program = cppassist::make_unique<Program>(this);
@@ -40,12 +90,57 @@ SceneRenderer::SceneRenderer(GpuContainer * container)
     auto fragShader = cppassist::make_unique<Shader>(this);
     fragShader->load(gl::GL_FRAGMENT_SHADER, rendercore::dataPath() + "/rendercore/shaders/pbr/pbr.frag");
     m_program->attach(std::move(fragShader));
+
+    // Create program for skinned meshes
+    m_skinnedProgram = cppassist::make_unique<Program>(this);
+
+    auto skinnedVertShader = cppassist::make_unique<Shader>(this);
+    skinnedVertShader->load(gl::GL_VERTEX_SHADER, rendercore::dataPath() + "/rendercore/shaders/pbr/pbr.vert", { "SKINNING" });
+    m_skinnedProgram->attach(std::move(skinnedVertShader));
+
+    auto skinnedFragShader = cppassist::make_unique<Shader>(this);
+    skinnedFragShader->load(gl::GL_FRAGMENT_SHADER, rendercore::dataPath() + "/rendercore/shaders/pbr/pbr.frag");
+    m_skinnedProgram->attach(std::move(skinnedFragShader));
+
+    // Create buffer for joint matrices (updated for every skinned mesh)
+    m_jointBuffer = cppassist::make_unique<Buffer>(this);
+    m_jointBuffer->setUsage(gl::GL_STREAM_DRAW);
 }
 
 SceneRenderer::~SceneRenderer()
 {
 }
 
+float SceneRenderer::lodThreshold() const
+{
+    return m_lodThreshold;
+}
+
+void SceneRenderer::setLodThreshold(float threshold)
+{
+    m_lodThreshold = threshold;
+}
+
+float SceneRenderer::lodHysteresis() const
+{
+    return m_lodHysteresis;
+}
+
+void SceneRenderer::setLodHysteresis(float hysteresis)
+{
+    m_lodHysteresis = hysteresis;
+}
+
+bool SceneRenderer::meshletCulling() const
+{
+    return m_meshletCulling;
+}
+
+void SceneRenderer::setMeshletCulling(bool enabled)
+{
+    m_meshletCulling = enabled;
+}
+
 void SceneRenderer::render(Scene & scene, const glm::mat4 & transform, Camera * camera)
 {
     // Get root scene node
@@ -68,40 +163,78 @@ void SceneRenderer::render(SceneNode & node, const glm::mat4 & transform, Camera
         auto * mesh = meshComponent->mesh();
         if (mesh) {
             // Render mesh
-            render(*mesh, trans, camera);
+            render(*mesh, trans, camera, meshComponent);
         }
     }
 
     // Render child nodes
-    for (auto & child : node.children()) {
-        render(*child.get(), trans, camera);
+    for (auto * child : node.children()) {
+        render(*child, trans, camera);
     }
 }
 
-void SceneRenderer::render(Mesh & mesh, const glm::mat4 & transform, Camera * camera)
+void SceneRenderer::render(Mesh & mesh, const glm::mat4 & transform, Camera * camera, MeshComponent * component)
 {
+    // Get morph target weights
+    static const std::vector<float> noWeights;
+    const std::vector<float> & morphWeights = (component && component->node()) ? component->node()->morphWeights() : noWeights;
+
+    // Get instances (the bounds of the geometries do not enclose all instances)
+    auto * instances = dynamic_cast<InstancedMeshComponent *>(component);
+
+    // Select program
+    Skin * skin = component ? component->skin() : nullptr;
+    globjects::Program * program = skin ? m_skinnedProgram->program() : m_program->program();
+
     // Set camera and model uniforms
-    m_program->program()->setUniform<glm::mat4>("modelMatrix", transform);
+    program->setUniform<bool>     ("hasInstances", instances != nullptr);
+    program->setUniform<glm::mat4>("modelMatrix", transform);
     if (camera) {
-        m_program->program()->setUniform<glm::mat4>("modelMatrix",                  transform);
-        m_program->program()->setUniform<glm::mat4>("modelViewProjectionMatrix",    camera->viewProjectionMatrix() * transform);
-        m_program->program()->setUniform<glm::mat4>("viewProjectionMatrix",         camera->viewProjectionMatrix());
-        m_program->program()->setUniform<glm::mat4>("viewProjectionInvertedMatrix", camera->viewProjectionInvertedMatrix());
-        m_program->program()->setUniform<glm::mat4>("viewMatrix",                   camera->viewMatrix());
-        m_program->program()->setUniform<glm::mat4>("viewInvertexMatrix",           camera->viewInvertedMatrix());
-        m_program->program()->setUniform<glm::mat4>("projectionMatrix",             camera->projectionMatrix());
-        m_program->program()->setUniform<glm::mat4>("projectionInvertedMatrix",     camera->projectionInvertedMatrix());
-        m_program->program()->setUniform<glm::mat3>("normalMatrix",                 camera->normalMatrix());
-        m_program->program()->setUniform<glm::vec3>("eyePosition",                  camera->eyeFromViewMatrix());
-        m_program->program()->setUniform<glm::vec3>("lightPosition",                camera->eyeFromViewMatrix());
+        program->setUniform<glm::mat4>("modelViewProjectionMatrix",    camera->viewProjectionMatrix() * transform);
+        program->setUniform<glm::mat4>("viewProjectionMatrix",         camera->viewProjectionMatrix());
+        program->setUniform<glm::mat4>("viewProjectionInvertedMatrix", camera->viewProjectionInvertedMatrix());
+        program->setUniform<glm::mat4>("viewMatrix",                   camera->viewMatrix());
+        program->setUniform<glm::mat4>("viewInvertexMatrix",           camera->viewInvertedMatrix());
+        program->setUniform<glm::mat4>("projectionMatrix",             camera->projectionMatrix());
+        program->setUniform<glm::mat4>("projectionInvertedMatrix",     camera->projectionInvertedMatrix());
+        program->setUniform<glm::mat3>("normalMatrix",                 camera->normalMatrix());
+        program->setUniform<glm::vec3>("eyePosition",                  camera->eyeFromViewMatrix());
+        program->setUniform<glm::vec3>("lightPosition",                camera->eyeFromViewMatrix());
+    }
+
+    // Upload joint matrices
+    if (skin) {
+        const glm::mat4 meshTransform = component->node() ? component->node()->globalTransform() : glm::mat4(1.0f);
+        skin->computeJointMatrices(meshTransform, m_jointMatrices);
+
+        if (m_jointMatrices.size() > maxJoints && !m_jointLimitWarned) {
+            cppassist::warning("rendercore") << "Skin has " << m_jointMatrices.size() << " joints, only the first " << maxJoints << " are used for rendering";
+            m_jointLimitWarned = true;
+        }
+
+        // Always upload the whole uniform block (unused joints are set to identity)
+        m_jointMatrices.resize(maxJoints, glm::mat4(1.0f));
+
+        m_jointBuffer->setData(m_jointMatrices);
+        m_jointBuffer->buffer()->bindBase(gl::GL_UNIFORM_BUFFER, 0);
+        program->uniformBlock("JointMatrices")->setBinding(0);
     }
 
     // Bind program
-    m_program->program()->use();
+    program->use();
 
     // Render geometries
     auto & geometries = mesh.geometries();
-    for (auto & geometry : geometries) {
+    for (size_t i=0; i<geometries.size(); i++) {
+        auto & geometry = geometries[i];
+
+        // Select level of detail
+        unsigned int lod = 0;
+        if (component && !instances && camera && !geometry->lods().empty() && geometry->boundingSphere().w > 0.0f) {
+            float errorScale = projectedScale(geometry->boundingSphere(), transform, *camera);
+            lod = component->selectLod(i, *geometry, errorScale, m_lodThreshold, m_lodHysteresis);
+        }
+
         // Material options (defaults)
         glm::vec4   baseColorFactor(1.0f, 1.0f, 1.0f, 1.0f);
         glm::vec3   emissiveFactor (0.0f, 0.0f, 0.0f);
@@ -118,6 +251,13 @@ void SceneRenderer::render(Mesh & mesh, const glm::mat4 & transform, Camera * ca
         Texture * occlusionTexture         = nullptr;
         Texture * emissiveTexture          = nullptr;
 
+        // Samplers (defaults)
+        Sampler * baseColorSampler         = nullptr;
+        Sampler * metallicRoughnessSampler = nullptr;
+        Sampler * normalSampler            = nullptr;
+        Sampler * occlusionSampler         = nullptr;
+        Sampler * emissiveSampler          = nullptr;
+
         // Get material
         auto * material = geometry->material();
         if (material) {
@@ -136,57 +276,92 @@ void SceneRenderer::render(Mesh & mesh, const glm::mat4 & transform, Camera * ca
             normalTexture            = material->texture("normal");
             occlusionTexture         = material->texture("occlusion");
             emissiveTexture          = material->texture("emissive");
+
+            // Get material samplers
+            baseColorSampler         = material->sampler("baseColor");
+            metallicRoughnessSampler = material->sampler("metallicRoughness");
+            normalSampler            = material->sampler("normal");
+            occlusionSampler         = material->sampler("occlusion");
+            emissiveSampler          = material->sampler("emissive");
+        }
+
+        // Set geometry uniforms
+        program->setUniform<glm::mat4>("positionDequantization", geometry->positionDequantization());
+
+        // Prepare morph targets (only active targets are blended)
+        MorphTargets * morphTargets     = geometry->morphTargets();
+        unsigned int   morphTargetCount = 0;
+        if (morphTargets) {
+            morphTargetCount = morphTargets->update(morphWeights, m_activeMorphTargets, m_activeMorphWeights);
+        }
+
+        program->setUniform<int>("morphTargetCount",   static_cast<int>(morphTargetCount));
+        program->setUniform<int>("morphDisplacements", 5);
+        if (morphTargetCount > 0) {
+            morphTargets->texture()->bindActive(5);
+            program->setUniform<int>               ("morphVertexCount", static_cast<int>(morphTargets->vertexCount()));
+            program->setUniform<std::vector<int>>  ("morphTargets",     m_activeMorphTargets);
+            program->setUniform<std::vector<float>>("morphWeights",     m_activeMorphWeights);
         }
 
         // Set material uniforms
-        m_program->program()->setUniform<bool>     ("hasColors",         geometry->hasAttributeBinding((unsigned int)AttributeIndex::Color0));
-        m_program->program()->setUniform<bool>     ("hasTexCoords",      geometry->hasAttributeBinding((unsigned int)AttributeIndex::TexCoord0));
-        m_program->program()->setUniform<bool>     ("hasNormals",        geometry->hasAttributeBinding((unsigned int)AttributeIndex::Normal));
-        m_program->program()->setUniform<bool>     ("hasTangents",       geometry->hasAttributeBinding((unsigned int)AttributeIndex::Tangent));
-        m_program->program()->setUniform<glm::vec4>("baseColorFactor",   baseColorFactor);
-        m_program->program()->setUniform<float>    ("metallicFactor",    metallicFactor);
-        m_program->program()->setUniform<float>    ("roughnessFactor",   roughnessFactor);
-        m_program->program()->setUniform<glm::vec3>("emissiveFactor",    emissiveFactor);
+        program->setUniform<bool>     ("hasColors",         geometry->hasAttributeBinding((unsigned int)AttributeIndex::Color0));
+        program->setUniform<bool>     ("hasTexCoords",      geometry->hasAttributeBinding((unsigned int)AttributeIndex::TexCoord0));
+        program->setUniform<bool>     ("hasNormals",        geometry->hasAttributeBinding((unsigned int)AttributeIndex::Normal));
+        program->setUniform<bool>     ("hasTangents",       geometry->hasAttributeBinding((unsigned int)AttributeIndex::Tangent));
+        if (skin) {
+            program->setUniform<bool> ("hasJoints",         geometry->hasAttributeBinding((unsigned int)AttributeIndex::Joints0) &&
+                                                            geometry->hasAttributeBinding((unsigned int)AttributeIndex::Weights0));
+        }
+        program->setUniform<glm::vec4>("baseColorFactor",   baseColorFactor);
+        program->setUniform<float>    ("metallicFactor",    metallicFactor);
+        program->setUniform<float>    ("roughnessFactor",   roughnessFactor);
+        program->setUniform<glm::vec3>("emissiveFactor",    emissiveFactor);
         if (alphaMode == "MASK") {
-            m_program->program()->setUniform<float>("alphaCutoff",       alphaCutoff);
-            m_program->program()->setUniform<float>("alphaBlendEnabled", 1.0f);
+            program->setUniform<float>("alphaCutoff",       alphaCutoff);
+            program->setUniform<float>("alphaBlendEnabled", 1.0f);
         } else if (alphaMode == "BLEND") {
-            m_program->program()->setUniform<float>("alphaCutoff",       1.0f);
-            m_program->program()->setUniform<float>("alphaBlendEnabled", 1.0f);
+            program->setUniform<float>("alphaCutoff",       1.0f);
+            program->setUniform<float>("alphaBlendEnabled", 1.0f);
         } else {
-            m_program->program()->setUniform<float>("alphaCutoff",       1.0f);
-            m_program->program()->setUniform<float>("alphaBlendEnabled", 0.0f);
+            program->setUniform<float>("alphaCutoff",       1.0f);
+            program->setUniform<float>("alphaBlendEnabled", 0.0f);
         }
 
         // Bind textures
-        m_program->program()->setUniform<bool> ("hasBaseColorTexture", (baseColorTexture != nullptr));
+        program->setUniform<bool> ("hasBaseColorTexture", (baseColorTexture != nullptr));
         if (baseColorTexture) {
             baseColorTexture->texture()->bindActive(0);
-            m_program->program()->setUniform<int>("baseColorTexture", 0);
+            if (baseColorSampler) baseColorSampler->sampler()->bind(0);
+            program->setUniform<int>("baseColorTexture", 0);
         }
 
-        m_program->program()->setUniform<bool> ("hasMetallicRoughnessTexture", (metallicRoughnessTexture != nullptr));
+        program->setUniform<bool> ("hasMetallicRoughnessTexture", (metallicRoughnessTexture != nullptr));
         if (metallicRoughnessTexture) {
             metallicRoughnessTexture->texture()->bindActive(1);
-            m_program->program()->setUniform<int>("metallicRoughnessTexture", 1);
+            if (metallicRoughnessSampler) metallicRoughnessSampler->sampler()->bind(1);
+            program->setUniform<int>("metallicRoughnessTexture", 1);
         }
 
-        m_program->program()->setUniform<bool> ("hasNormalTexture", (normalTexture != nullptr));
+        program->setUniform<bool> ("hasNormalTexture", (normalTexture != nullptr));
         if (normalTexture) {
             normalTexture->texture()->bindActive(2);
-            m_program->program()->setUniform<int>("normalTexture", 2);
+            if (normalSampler) normalSampler->sampler()->bind(2);
+            program->setUniform<int>("normalTexture", 2);
         }
 
-        m_program->program()->setUniform<bool> ("hasOcclusionTexture", (occlusionTexture != nullptr));
+        program->setUniform<bool> ("hasOcclusionTexture", (occlusionTexture != nullptr));
         if (occlusionTexture) {
             occlusionTexture->texture()->bindActive(3);
-            m_program->program()->setUniform<int>("occlusionTexture", 3);
+            if (occlusionSampler) occlusionSampler->sampler()->bind(3);
+            program->setUniform<int>("occlusionTexture", 3);
         }
 
-        m_program->program()->setUniform<bool> ("hasEmissiveTexture", (emissiveTexture != nullptr));
+        program->setUniform<bool> ("hasEmissiveTexture", (emissiveTexture != nullptr));
         if (emissiveTexture) {
             emissiveTexture->texture()->bindActive(4);
-            m_program->program()->setUniform<int>("emissiveTexture", 4);
+            if (emissiveSampler) emissiveSampler->sampler()->bind(4);
+            program->setUniform<int>("emissiveTexture", 4);
         }
 
         // Set rendering states
@@ -198,8 +373,17 @@ void SceneRenderer::render(Mesh & mesh, const glm::mat4 & transform, Camera * ca
             gl::glCullFace(gl::GL_BACK);
         }
 
-        // Render geometry
-        geometry->draw();
+        // Render geometry (only visible meshlets of the full geometry, the bounds of deformed geometry are not valid)
+        if (instances) {
+            geometry->drawInstanced(instances->instanceCount(), instances->instanceAttributes(), lod);
+        } else if (m_meshletCulling && !skin && morphTargetCount == 0 && camera && lod == 0 && !geometry->meshlets().empty()) {
+            cullMeshlets(*geometry, transform, *camera, doubleSided, m_visibleMeshlets);
+
+                 if (m_visibleMeshlets.size() == geometry->meshlets().size()) geometry->draw(lod);
+            else if (!m_visibleMeshlets.empty())                              geometry->drawMeshlets(m_visibleMeshlets);
+        } else {
+            geometry->draw(lod);
+        }
 
         // Release textures
         if (baseColorTexture)         baseColorTexture->texture()->unbindActive(0);
@@ -207,10 +391,79 @@ void SceneRenderer::render(Mesh & mesh, const glm::mat4 & transform, Camera * ca
         if (normalTexture)            normalTexture->texture()->unbindActive(2);
         if (occlusionTexture)         occlusionTexture->texture()->unbindActive(3);
         if (emissiveTexture)          emissiveTexture->texture()->unbindActive(4);
+        if (morphTargetCount > 0)     morphTargets->texture()->unbindActive(5);
+
+        // Release samplers
+        if (baseColorSampler)         globjects::Sampler::unbind(0);
+        if (metallicRoughnessSampler) globjects::Sampler::unbind(1);
+        if (normalSampler)            globjects::Sampler::unbind(2);
+        if (occlusionSampler)         globjects::Sampler::unbind(3);
+        if (emissiveSampler)          globjects::Sampler::unbind(4);
     }
 
     // Release program
-    m_program->program()->release();
+    program->release();
+}
+
+void SceneRenderer::cullMeshlets(const Geometry & geometry, const glm::mat4 & transform, const Camera & camera, bool doubleSided, std::vector<unsigned int> & visible) const
+{
+    visible.clear();
+
+    // Get view frustum planes in model space
+    glm::mat4 mvp = camera.viewProjectionMatrix() * transform;
+    glm::vec4 rows[4];
+    for (int i=0; i<4; i++) {
+        rows[i] = glm::vec4(mvp[0][i], mvp[1][i], mvp[2][i], mvp[3][i]);
+    }
+
+    glm::vec4 planes[6] = {
+        rows[3] + rows[0], rows[3] - rows[0],
+        rows[3] + rows[1], rows[3] - rows[1],
+        rows[3] + rows[2], rows[3] - rows[2]
+    };
+
+    for (auto & plane : planes) {
+        float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f) plane /= length;
+    }
+
+    // Normal cones are only valid for rotations, translations and uniform scaling (back faces of double-sided materials are visible)
+    glm::vec3 axes[3] = { glm::vec3(transform[0]), glm::vec3(transform[1]), glm::vec3(transform[2]) };
+    float scaleX = glm::length(axes[0]);
+    float scaleY = glm::length(axes[1]);
+    float scaleZ = glm::length(axes[2]);
+
+    bool backfaceCulling = !doubleSided &&
+                           glm::dot(glm::cross(axes[0], axes[1]), axes[2]) > 0.0f &&
+                           std::abs(scaleX - scaleY) <= 0.01f * scaleX &&
+                           std::abs(scaleX - scaleZ) <= 0.01f * scaleX;
+
+    // Get camera position in model space
+    glm::vec4 eye = glm::inverse(transform) * glm::vec4(camera.eyeFromViewMatrix(), 1.0f);
+    glm::vec3 cameraPosition = glm::vec3(eye) / eye.w;
+
+    // Test meshlets
+    const auto & meshlets = geometry.meshlets();
+    for (size_t i=0; i<meshlets.size(); i++) {
+        const auto & meshlet = meshlets[i];
+        glm::vec4 center(meshlet.boundingSphere.x, meshlet.boundingSphere.y, meshlet.boundingSphere.z, 1.0f);
+
+        // Frustum culling
+        bool inside = true;
+        for (const auto & plane : planes) {
+            if (glm::dot(plane, center) < -meshlet.boundingSphere.w) {
+                inside = false;
+                break;
+            }
+        }
+
+        if (!inside) continue;
+
+        // Backface culling
+        if (backfaceCulling && rendercore::MeshletBuilder::isBackFacing(meshlet, cameraPosition)) continue;
+
+        visible.push_back(static_cast<unsigned int>(i));
+    }
 }
 
 
@@ -68,6 +68,35 @@ void Shader::load(gl::GLenum type, const std::string & filename)
     setCode(type, code);
 }
 
+void Shader::load(gl::GLenum type, const std::string & filename, const std::vector<std::string> & defines)
+{
+    std::string code = "";
+
+    // Read file
+    auto f = fs::open(filename);
+    if (f.exists()) {
+        code = f.readFile();
+    }
+
+    // Build definitions
+    std::string definitions;
+    for (const auto & define : defines) {
+        definitions += "#define " + define + "\n";
+    }
+
+    // Insert definitions after the version directive, which must come first
+    size_t pos = code.find("#version");
+    pos = (pos != std::string::npos) ? code.find('\n', pos) : std::string::npos;
+    if (pos != std::string::npos) {
+        code.insert(pos + 1, definitions);
+    } else {
+        code = definitions + code;
+    }
+
+    // Set shader code
+    setCode(type, code);
+}
+
 globjects::Shader * Shader::shader()
 {
     // Check if shader is empty
@@ -7,6 +7,8 @@
 
 #include <glbinding/gl/enum.h>
 
+#include <rendercore/VertexQuantizer.h>
+
 #include <rendercore-opengl/enums.h>
 
 
@@ -16,7 +18,7 @@ namespace opengl
 {
 
 
-Sphere::Sphere(GpuContainer * container, float radius, bool texCoords)
+Sphere::Sphere(GpuContainer * container, float radius, bool texCoords, bool quantize)
 : Mesh(container)
 {
     // Create icosahedron
@@ -34,19 +36,40 @@ Sphere::Sphere(GpuContainer * container, float radius, bool texCoords)
     geometry->setMode(gl::GL_TRIANGLES);
     geometry->setCount(m_icosahedron->indices().size() * std::tuple_size<Icosahedron::Face>::value);
 
-    // Create vertex buffer
-    auto * vertexBuffer = createBuffer(scaledVertices);
+    // Create vertex buffer and vertex attribute for positions
+    VertexAttribute * positionAttribute = nullptr;
+
+    if (quantize) {
+        // Quantize positions relative to the bounding box
+        glm::mat4 dequantization;
+        auto * vertexBuffer = createBuffer(VertexQuantizer::quantizePositions(
+            reinterpret_cast<const char *>(scaledVertices.data()), static_cast<unsigned int>(scaledVertices.size()), sizeof(glm::vec3), dequantization
+        ));
+
+        positionAttribute = addVertexAttribute(
+            vertexBuffer,
+            0,
+            0,
+            4 * sizeof(unsigned short),
+            gl::GL_UNSIGNED_SHORT,
+            3,
+            true
+        );
 
-    // Create vertex attribute for positions
-    auto * positionAttribute = addVertexAttribute(
-        vertexBuffer,
-        0,
-        0,
-        sizeof(glm::vec3),
-        gl::GL_FLOAT,
-        3,
-        false
-    );
+        geometry->setPositionDequantization(dequantization);
+    } else {
+        auto * vertexBuffer = createBuffer(scaledVertices);
+
+        positionAttribute = addVertexAttribute(
+            vertexBuffer,
+            0,
+            0,
+            sizeof(glm::vec3),
+            gl::GL_FLOAT,
+            3,
+            false
+        );
+    }
 
     // Bind attribute
     geometry->bindAttribute((unsigned int)AttributeIndex::Position, positionAttribute);
@@ -56,27 +79,58 @@ Sphere::Sphere(GpuContainer * container, float radius, bool texCoords)
         // Generate texture coordinates
         m_icosahedron->generateTextureCoordinates();
 
-        // Create texture coordinate buffer
-        auto * texCoordBuffer = createBuffer(m_icosahedron->texcoords());
-
-        // Create vertex attribute for texture coordinates
-        auto * texCoordAttribute = addVertexAttribute(
-            texCoordBuffer,
-            0,
-            0,
-            sizeof(glm::vec2),
-            gl::GL_FLOAT,
-            2,
-            false
-        );
+        // Create texture coordinate buffer and vertex attribute (texture coordinates lie in [0, 1])
+        const auto & texcoords = m_icosahedron->texcoords();
+
+        VertexAttribute * texCoordAttribute = nullptr;
+
+        if (quantize) {
+            auto * texCoordBuffer = createBuffer(VertexQuantizer::packUnorm16(
+                reinterpret_cast<const char *>(texcoords.data()), static_cast<unsigned int>(texcoords.size()), sizeof(glm::vec2)
+            ));
+
+            texCoordAttribute = addVertexAttribute(
+                texCoordBuffer,
+                0,
+                0,
+                2 * sizeof(unsigned short),
+                gl::GL_UNSIGNED_SHORT,
+                2,
+                true
+            );
+        } else {
+            auto * texCoordBuffer = createBuffer(texcoords);
+
+            texCoordAttribute = addVertexAttribute(
+                texCoordBuffer,
+                0,
+                0,
+                sizeof(glm::vec2),
+                gl::GL_FLOAT,
+                2,
+                false
+            );
+        }
 
         // Bind attribute
         geometry->bindAttribute((unsigned int)AttributeIndex::TexCoord0, texCoordAttribute);
     }
 
-    // Create index buffer
-    auto * indexBuffer = createBuffer(m_icosahedron->indices());
-    geometry->setIndexBuffer(indexBuffer, gl::GL_UNSIGNED_SHORT);
+    // Create index buffer (narrowed to 16 bit, if the number of vertices allows it)
+    const auto & faces = m_icosahedron->indices();
+
+    if (m_icosahedron->vertices().size() <= 0xffff) {
+        std::vector<gl::GLushort> indices;
+        indices.reserve(faces.size() * 3);
+
+        for (const auto & face : faces) {
+            indices.insert(indices.end(), face.begin(), face.end());
+        }
+
+        geometry->setIndexBuffer(createBuffer(indices), gl::GL_UNSIGNED_SHORT);
+    } else {
+        geometry->setIndexBuffer(createBuffer(faces), gl::GL_UNSIGNED_INT);
+    }
 
     // Add geometry
     addGeometry(std::move(geometry));
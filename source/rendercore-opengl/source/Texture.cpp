@@ -1,12 +1,119 @@
 
 #include <rendercore-opengl/Texture.h>
 
+#include <algorithm>
+
 #include <glbinding/gl/gl.h>
 #include <glbinding/gl/enum.h>
+#include <glbinding/gl/extension.h>
+
+#include <globjects/globjects.h>
 
 #include <rendercore/ImageLoader.h>
 #include <rendercore/Image.h>
 
+#include <rendercore-opengl/TextureStreamer.h>
+
+
+namespace
+{
+
+
+gl::GLenum textureTarget(const rendercore::Image & image)
+{
+    // Determine texture target from image layout
+    if (image.faces() == 6) {
+        return image.layers() > 1 ? gl::GL_TEXTURE_CUBE_MAP_ARRAY : gl::GL_TEXTURE_CUBE_MAP;
+    } else if (image.layers() > 1) {
+        return gl::GL_TEXTURE_2D_ARRAY;
+    } else if (image.depth() > 1) {
+        return gl::GL_TEXTURE_3D;
+    } else {
+        return gl::GL_TEXTURE_2D;
+    }
+}
+
+gl::GLenum textureFormat(const rendercore::Image & image)
+{
+    // Use internal format provided by the image
+    if (image.internalFormat() != 0) {
+        return static_cast<gl::GLenum>(image.internalFormat());
+    }
+
+    // Compressed images are identified by their internal format
+    if (image.compressed()) {
+        return static_cast<gl::GLenum>(image.dataType());
+    }
+
+    // Determine number of channels
+    const auto format = static_cast<gl::GLenum>(image.format());
+    unsigned int channels = 4;
+    if (format == gl::GL_RED)                              channels = 1;
+    else if (format == gl::GL_RG)                          channels = 2;
+    else if (format == gl::GL_RGB || format == gl::GL_BGR) channels = 3;
+
+    // Determine internal format from data type
+    static const gl::GLenum ubyteFormats[]  = { gl::GL_R8,   gl::GL_RG8,   gl::GL_RGB8,   gl::GL_RGBA8   };
+    static const gl::GLenum ushortFormats[] = { gl::GL_R16,  gl::GL_RG16,  gl::GL_RGB16,  gl::GL_RGBA16  };
+    static const gl::GLenum halfFormats[]   = { gl::GL_R16F, gl::GL_RG16F, gl::GL_RGB16F, gl::GL_RGBA16F };
+    static const gl::GLenum floatFormats[]  = { gl::GL_R32F, gl::GL_RG32F, gl::GL_RGB32F, gl::GL_RGBA32F };
+
+    switch (static_cast<gl::GLenum>(image.dataType()))
+    {
+        case gl::GL_UNSIGNED_SHORT:               return ushortFormats[channels - 1];
+        case gl::GL_HALF_FLOAT:                   return halfFormats[channels - 1];
+        case gl::GL_FLOAT:                        return floatFormats[channels - 1];
+        case gl::GL_UNSIGNED_INT_10F_11F_11F_REV: return gl::GL_R11F_G11F_B10F;
+        case gl::GL_UNSIGNED_INT_5_9_9_9_REV:     return gl::GL_RGB9_E5;
+        default:                                  return ubyteFormats[channels - 1];
+    }
+}
+
+gl::GLenum srgbFormat(gl::GLenum internalFormat)
+{
+    // Get sRGB variant of an internal format
+    switch (internalFormat)
+    {
+        case gl::GL_RGB8:                                return gl::GL_SRGB8;
+        case gl::GL_RGBA8:                               return gl::GL_SRGB8_ALPHA8;
+        case gl::GL_COMPRESSED_RGB_S3TC_DXT1_EXT:        return gl::GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+        case gl::GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:       return gl::GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+        case gl::GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:       return gl::GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+        case gl::GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:       return gl::GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+        case gl::GL_COMPRESSED_RGBA_BPTC_UNORM:          return gl::GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+        case gl::GL_COMPRESSED_RGB8_ETC2:                return gl::GL_COMPRESSED_SRGB8_ETC2;
+        case gl::GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2: return gl::GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+        case gl::GL_COMPRESSED_RGBA8_ETC2_EAC:           return gl::GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC;
+        default:                                         return internalFormat;
+    }
+}
+
+bool usesMipmaps(gl::GLenum filter)
+{
+    return filter == gl::GL_NEAREST_MIPMAP_NEAREST || filter == gl::GL_LINEAR_MIPMAP_NEAREST ||
+           filter == gl::GL_NEAREST_MIPMAP_LINEAR  || filter == gl::GL_LINEAR_MIPMAP_LINEAR;
+}
+
+unsigned int mipmapLevels(unsigned int width, unsigned int height, unsigned int depth)
+{
+    unsigned int size   = std::max(width, std::max(height, depth));
+    unsigned int levels = 1;
+    while (size > 1) {
+        size >>= 1;
+        levels++;
+    }
+
+    return levels;
+}
+
+bool hasTextureStorage()
+{
+    return globjects::hasExtension(gl::GLextension::GL_ARB_texture_storage);
+}
+
+
+} // namespace
+
 
 namespace rendercore
 {
@@ -20,11 +127,24 @@ Texture::Texture(GpuContainer * container)
 , m_magFilter(gl::GL_LINEAR)
 , m_wrapS(gl::GL_CLAMP_TO_EDGE)
 , m_wrapT(gl::GL_CLAMP_TO_EDGE)
+, m_srgb(false)
+, m_target(gl::GL_TEXTURE_2D)
+, m_internalFormat(gl::GL_RGBA8)
+, m_width(0)
+, m_height(0)
+, m_depth(0)
+, m_levels(0)
+, m_generateMipmaps(false)
+, m_streamer(nullptr)
 {
 }
 
 Texture::~Texture()
 {
+    // Stop streaming of image data
+    if (m_streamer) {
+        m_streamer->cancel(this);
+    }
 }
 
 const rendercore::Image * Texture::image() const
@@ -39,6 +159,11 @@ rendercore::Image * Texture::image()
 
 void Texture::setImage(std::unique_ptr<rendercore::Image> image)
 {
+    // Stop streaming of the old image data
+    if (m_streamer) {
+        m_streamer->cancel(this);
+    }
+
     // Store image
     m_image = std::move(image);
 
@@ -93,6 +218,49 @@ void Texture::setWrapT(gl::GLenum filter)
     m_wrapT = filter;
 }
 
+bool Texture::srgb() const
+{
+    return m_srgb;
+}
+
+void Texture::setSRGB(bool srgb)
+{
+    // Internal format changes, so the storage has to be recreated
+    if (m_srgb != srgb) {
+        m_srgb = srgb;
+        setValid(false);
+    }
+}
+
+TextureStreamer * Texture::streamer() const
+{
+    return m_streamer;
+}
+
+void Texture::setStreamer(TextureStreamer * streamer)
+{
+    // Stop streaming with the old streamer
+    if (m_streamer) {
+        m_streamer->cancel(this);
+    }
+
+    // Set streamer
+    m_streamer = streamer;
+
+    // Restart upload
+    setValid(false);
+}
+
+gl::GLenum Texture::target() const
+{
+    return m_target;
+}
+
+gl::GLenum Texture::internalFormat() const
+{
+    return m_internalFormat;
+}
+
 globjects::Texture * Texture::texture()
 {
     // Check if texture needs to be updated or restored
@@ -106,40 +274,167 @@ globjects::Texture * Texture::texture()
 
 void Texture::onDeinit()
 {
+    // Stop streaming of image data
+    if (m_streamer) {
+        m_streamer->cancel(this);
+    }
+
     // Release texture
     m_texture.reset();
+    m_levels = 0;
 }
 
 void Texture::createFromImage()
 {
-    // Create new texture
-    m_texture = globjects::Texture::createDefault(gl::GL_TEXTURE_2D);
-
     // Check image
-    if (!m_image) {
+    if (!m_image || m_image->empty()) {
+        // Create empty texture
+        m_texture = globjects::Texture::createDefault(gl::GL_TEXTURE_2D);
+        m_target  = gl::GL_TEXTURE_2D;
+        m_levels  = 0;
+        setValid(true);
         return;
     }
 
-    // Create texture
-    m_texture->image2D(
-        0,
-        gl::GL_RGBA8,
-        m_image->width(),
-        m_image->height(),
-        0,
-        static_cast<gl::GLenum>(m_image->format()),
-        static_cast<gl::GLenum>(m_image->dataType()),
-        m_image->data()
-    );
+    // Determine texture layout
+    const gl::GLenum   target         = textureTarget(*m_image);
+    const gl::GLenum   internalFormat = m_srgb ? srgbFormat(textureFormat(*m_image)) : textureFormat(*m_image);
+    const unsigned int width          = m_image->width();
+    const unsigned int height         = m_image->height();
+    const unsigned int depth          = (target == gl::GL_TEXTURE_3D) ? m_image->depth() : m_image->layers() * (target == gl::GL_TEXTURE_CUBE_MAP ? 1 : m_image->faces());
+
+    // Allocate full mipmap chain if the filter needs mipmaps that are not part of the image
+    m_generateMipmaps = m_image->levels() == 1 && !m_image->compressed() && usesMipmaps(m_minFilter);
+    const unsigned int levels = m_generateMipmaps ? mipmapLevels(width, height, target == gl::GL_TEXTURE_3D ? depth : 1) : m_image->levels();
+
+    // Create new storage, unless the existing one matches the image
+    if (!m_texture || m_target != target || m_internalFormat != internalFormat ||
+        m_width != width || m_height != height || m_depth != depth || m_levels != levels)
+    {
+        m_target         = target;
+        m_internalFormat = internalFormat;
+        m_width          = width;
+        m_height         = height;
+        m_depth          = depth;
+        m_levels         = levels;
+
+        m_texture = globjects::Texture::createDefault(m_target);
+        allocateStorage();
+    }
 
     // Set texture parameters
     m_texture->setParameter(gl::GL_TEXTURE_MIN_FILTER, m_minFilter);
     m_texture->setParameter(gl::GL_TEXTURE_MAG_FILTER, m_magFilter);
     m_texture->setParameter(gl::GL_TEXTURE_WRAP_S,     m_wrapS);
     m_texture->setParameter(gl::GL_TEXTURE_WRAP_T,     m_wrapT);
+    m_texture->setParameter(gl::GL_TEXTURE_MAX_LEVEL,  static_cast<gl::GLint>(m_levels - 1));
 
     // Flag texture valid
     setValid(true);
+
+    // Let the streamer upload the image data asynchronously
+    if (m_streamer) {
+        m_streamer->stream(this);
+        return;
+    }
+
+    // Upload image data
+    uploadImage();
+
+    // Create remaining mipmap levels
+    if (m_generateMipmaps) {
+        m_texture->generateMipmap();
+    }
+}
+
+void Texture::allocateStorage()
+{
+    const bool compressed = m_image->compressed();
+    const auto format     = compressed ? gl::GL_RGBA : static_cast<gl::GLenum>(m_image->format());
+    const auto type       = compressed ? gl::GL_UNSIGNED_BYTE : static_cast<gl::GLenum>(m_image->dataType());
+
+    // Allocate immutable storage
+    if (hasTextureStorage()) {
+        if (m_target == gl::GL_TEXTURE_2D || m_target == gl::GL_TEXTURE_CUBE_MAP) {
+            m_texture->storage2D(m_levels, m_internalFormat, m_width, m_height);
+        } else {
+            m_texture->storage3D(m_levels, m_internalFormat, m_width, m_height, m_depth);
+        }
+
+        return;
+    }
+
+    // Fall back to allocating each level separately
+    m_texture->bind();
+
+    for (unsigned int level = 0; level < m_levels; level++) {
+        const unsigned int width  = std::max(m_width  >> level, 1u);
+        const unsigned int height = std::max(m_height >> level, 1u);
+        const unsigned int depth  = (m_target == gl::GL_TEXTURE_3D) ? std::max(m_depth >> level, 1u) : m_depth;
+
+        if (m_target == gl::GL_TEXTURE_2D) {
+            if (compressed) gl::glCompressedTexImage2D(m_target, level, m_internalFormat, width, height, 0, m_image->size(level, 0), nullptr);
+            else            m_texture->image2D(level, m_internalFormat, width, height, 0, format, type, nullptr);
+        } else if (m_target == gl::GL_TEXTURE_CUBE_MAP) {
+            if (compressed) {
+                for (unsigned int face = 0; face < 6; face++) {
+                    const auto faceTarget = static_cast<gl::GLenum>(static_cast<unsigned int>(gl::GL_TEXTURE_CUBE_MAP_POSITIVE_X) + face);
+                    gl::glCompressedTexImage2D(faceTarget, level, m_internalFormat, width, height, 0, m_image->size(level, face), nullptr);
+                }
+            } else {
+                m_texture->cubeMapImage(level, m_internalFormat, width, height, 0, format, type, nullptr);
+            }
+        } else {
+            if (compressed) gl::glCompressedTexImage3D(m_target, level, m_internalFormat, width, height, depth, 0, m_image->size(level, 0) * (m_target == gl::GL_TEXTURE_3D ? 1 : depth), nullptr);
+            else            m_texture->image3D(level, m_internalFormat, width, height, depth, 0, format, type, nullptr);
+        }
+    }
+}
+
+void Texture::uploadImage()
+{
+    const unsigned int levels = std::min(m_image->levels(), m_levels);
+    const unsigned int slices = m_image->layers() * m_image->faces();
+
+    // Image rows are tightly packed
+    m_texture->bind();
+    gl::glPixelStorei(gl::GL_UNPACK_ALIGNMENT, 1);
+
+    // Upload all levels and slices
+    for (unsigned int level = 0; level < levels; level++) {
+        for (unsigned int slice = 0; slice < slices; slice++) {
+            uploadRegion(level, slice, m_image->data(level, slice));
+        }
+    }
+
+    // Restore default alignment
+    gl::glPixelStorei(gl::GL_UNPACK_ALIGNMENT, 4);
+}
+
+void Texture::uploadRegion(unsigned int level, unsigned int slice, const void * data)
+{
+    const bool compressed = m_image->compressed();
+    const auto format     = static_cast<gl::GLenum>(m_image->format());
+    const auto type       = static_cast<gl::GLenum>(m_image->dataType());
+    const auto size       = static_cast<gl::GLsizei>(m_image->size(level, slice));
+    const unsigned int width  = m_image->levelWidth(level);
+    const unsigned int height = m_image->levelHeight(level);
+    const unsigned int depth  = m_image->levelDepth(level);
+
+    if (m_target == gl::GL_TEXTURE_2D || m_target == gl::GL_TEXTURE_CUBE_MAP) {
+        // Upload level (or cube map face)
+        const auto target = (m_target == gl::GL_TEXTURE_CUBE_MAP) ? static_cast<gl::GLenum>(static_cast<unsigned int>(gl::GL_TEXTURE_CUBE_MAP_POSITIVE_X) + slice) : m_target;
+        if (compressed) gl::glCompressedTexSubImage2D(target, level, 0, 0, width, height, m_internalFormat, size, data);
+        else            gl::glTexSubImage2D(target, level, 0, 0, width, height, format, type, data);
+    } else if (m_target == gl::GL_TEXTURE_3D) {
+        // Upload volume
+        if (compressed) gl::glCompressedTexSubImage3D(m_target, level, 0, 0, 0, width, height, depth, m_internalFormat, size, data);
+        else            gl::glTexSubImage3D(m_target, level, 0, 0, 0, width, height, depth, format, type, data);
+    } else {
+        // Upload layer (or layer-face of a cube map array)
+        if (compressed) gl::glCompressedTexSubImage3D(m_target, level, 0, 0, slice, width, height, 1, m_internalFormat, size, data);
+        else            gl::glTexSubImage3D(m_target, level, 0, 0, slice, width, height, 1, format, type, data);
+    }
 }
 
 
@@ -0,0 +1,387 @@
+
+#include <rendercore-opengl/TextureStreamer.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include <cppassist/memory/make_unique.h>
+
+#include <glbinding/gl/gl.h>
+#include <glbinding/gl/enum.h>
+#include <glbinding/gl/bitfield.h>
+#include <glbinding/gl/extension.h>
+
+#include <globjects/globjects.h>
+
+#include <rendercore/Image.h>
+
+#include <rendercore-opengl/Texture.h>
+
+
+namespace rendercore
+{
+namespace opengl
+{
+
+
+TextureStreamer::TextureStreamer(GpuContainer * container, unsigned int capacity)
+: GpuObject(container)
+, m_capacity(capacity)
+, m_budget(8 * 1024 * 1024)
+, m_mapped(nullptr)
+, m_firstAllocation(0)
+, m_nextFence(1)
+, m_head(0)
+, m_used(0)
+, m_fenceNeeded(false)
+, m_copying(nullptr)
+, m_stop(false)
+{
+    // Start worker thread
+    m_thread = std::thread(&TextureStreamer::run, this);
+}
+
+TextureStreamer::~TextureStreamer()
+{
+    // Stop worker thread
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_signal.notify_all();
+    m_thread.join();
+}
+
+unsigned int TextureStreamer::budget() const
+{
+    return m_budget;
+}
+
+void TextureStreamer::setBudget(unsigned int budget)
+{
+    m_budget = budget;
+}
+
+bool TextureStreamer::busy() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return !m_pending.empty() || !m_ready.empty();
+}
+
+void TextureStreamer::stream(Texture * texture)
+{
+    // Make sure that the pixel buffer exists
+    init();
+
+    // Remove old jobs for the texture
+    cancel(texture);
+
+    // Check texture
+    const Image * image = texture->image();
+    if (!image || !texture->m_texture) {
+        return;
+    }
+
+    const unsigned int levels = std::min(image->levels(), texture->m_levels);
+    const unsigned int slices = image->layers() * image->faces();
+
+    // Only the smallest level will be available at first
+    texture->m_texture->setParameter(gl::GL_TEXTURE_BASE_LEVEL, static_cast<gl::GLint>(levels - 1));
+
+    // Schedule uploads, smallest level first
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (unsigned int level = levels; level-- > 0; ) {
+            for (unsigned int slice = 0; slice < slices; slice++) {
+                Job job;
+                job.texture    = texture;
+                job.level      = level;
+                job.slice      = slice;
+                job.data       = image->data(level, slice);
+                job.size       = image->size(level, slice);
+                job.offset     = 0;
+                job.allocation = 0;
+                job.direct     = !m_mapped || job.size > m_capacity;
+
+                m_pending.push_back(job);
+            }
+        }
+    }
+
+    // Wake up worker
+    m_signal.notify_all();
+}
+
+void TextureStreamer::cancel(Texture * texture)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    // Wait until the worker is not copying data of the texture
+    m_signal.wait(lock, [this, texture] () { return m_copying != texture; });
+
+    // Remove jobs that have not been copied yet
+    m_pending.erase(std::remove_if(m_pending.begin(), m_pending.end(), [texture] (const Job & job) {
+        return job.texture == texture;
+    }), m_pending.end());
+
+    // Remove jobs that have not been uploaded yet
+    for (const auto & job : m_ready) {
+        if (job.texture == texture && !job.direct) {
+            release(job.allocation);
+        }
+    }
+
+    m_ready.erase(std::remove_if(m_ready.begin(), m_ready.end(), [texture] (const Job & job) {
+        return job.texture == texture;
+    }), m_ready.end());
+}
+
+void TextureStreamer::update()
+{
+    // Make sure that the pixel buffer exists
+    init();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Reuse regions of the pixel buffer that are no longer accessed by the GPU
+    checkFences();
+
+    // Image rows are tightly packed
+    if (!m_ready.empty()) {
+        gl::glPixelStorei(gl::GL_UNPACK_ALIGNMENT, 1);
+    }
+
+    // Issue uploads within the budget
+    unsigned int bytes = 0;
+    bool bound = false;
+    while (!m_ready.empty() && (bytes == 0 || bytes + m_ready.front().size <= m_budget)) {
+        Job job = m_ready.front();
+        m_ready.pop_front();
+
+        Texture * texture = job.texture;
+        bytes += job.size;
+
+        // Bind pixel buffer, or upload directly from image data
+        if (bound && job.direct) {
+            globjects::Buffer::unbind(gl::GL_PIXEL_UNPACK_BUFFER);
+            bound = false;
+        } else if (!bound && !job.direct) {
+            m_buffer->bind(gl::GL_PIXEL_UNPACK_BUFFER);
+            bound = true;
+        }
+
+        // Upload level
+        texture->m_texture->bind();
+        texture->uploadRegion(job.level, job.slice, job.direct ? job.data : reinterpret_cast<const char *>(static_cast<std::uintptr_t>(job.offset)));
+
+        if (!job.direct) {
+            release(job.allocation);
+        }
+
+        // Make level available when all its slices have been uploaded
+        const Image * image = texture->image();
+        if (job.slice + 1 == image->layers() * image->faces()) {
+            texture->m_texture->setParameter(gl::GL_TEXTURE_BASE_LEVEL, static_cast<gl::GLint>(job.level));
+
+            if (job.level == 0 && texture->m_generateMipmaps) {
+                texture->m_texture->generateMipmap();
+            }
+        }
+    }
+
+    if (bound) {
+        globjects::Buffer::unbind(gl::GL_PIXEL_UNPACK_BUFFER);
+    }
+
+    if (bytes > 0) {
+        // Restore default alignment
+        gl::glPixelStorei(gl::GL_UNPACK_ALIGNMENT, 4);
+    }
+
+    // Create fence for the regions that have been used
+    if (m_fenceNeeded) {
+        Fence fence;
+        fence.sync = globjects::Sync::fence(gl::GL_SYNC_GPU_COMMANDS_COMPLETE);
+        fence.id   = m_nextFence++;
+        m_fences.push_back(std::move(fence));
+
+        m_fenceNeeded = false;
+    }
+}
+
+void TextureStreamer::onInit()
+{
+    // Persistent mapping is required to write from the worker thread
+    if (!globjects::hasExtension(gl::GLextension::GL_ARB_buffer_storage)) {
+        return;
+    }
+
+    // Create pixel buffer
+    m_buffer = cppassist::make_unique<globjects::Buffer>();
+    m_buffer->setStorage(m_capacity, nullptr, gl::GL_MAP_WRITE_BIT | gl::GL_MAP_PERSISTENT_BIT | gl::GL_MAP_COHERENT_BIT);
+
+    // Map pixel buffer
+    void * mapped = m_buffer->mapRange(0, m_capacity, gl::GL_MAP_WRITE_BIT | gl::GL_MAP_PERSISTENT_BIT | gl::GL_MAP_COHERENT_BIT);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_mapped = static_cast<char *>(mapped);
+}
+
+void TextureStreamer::onDeinit()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    // Wait until the worker has finished copying
+    m_signal.wait(lock, [this] () { return m_copying == nullptr; });
+
+    // Discard all jobs, the textures will be streamed again when they are restored
+    m_pending.clear();
+    m_ready.clear();
+    m_fences.clear();
+    m_firstAllocation += static_cast<unsigned int>(m_allocations.size());
+    m_allocations.clear();
+    m_head        = 0;
+    m_used        = 0;
+    m_fenceNeeded = false;
+
+    // Release pixel buffer
+    if (m_buffer) {
+        m_buffer->unmap();
+        m_buffer.reset();
+    }
+
+    m_mapped = nullptr;
+}
+
+bool TextureStreamer::allocate(unsigned int size, unsigned int & offset)
+{
+    // Keep regions aligned
+    size = (std::max(size, 1u) + 15) & ~15u;
+
+    // Start from the beginning when the buffer is empty
+    if (m_used == 0) {
+        m_head = 0;
+    }
+
+    const unsigned int tail = m_allocations.empty() ? m_head : m_allocations.front().offset;
+    unsigned int allocated = size;
+
+    if (m_used == 0 || m_head > tail) {
+        // Free space is at the end and at the beginning of the buffer
+        if (m_capacity - m_head >= size) {
+            offset = m_head;
+        } else if (tail >= size) {
+            // Skip the rest of the buffer
+            allocated += m_capacity - m_head;
+            offset = 0;
+        } else {
+            return false;
+        }
+    } else {
+        // Free space is between head and tail
+        if (tail - m_head >= size) {
+            offset = m_head;
+        } else {
+            return false;
+        }
+    }
+
+    // Add allocation
+    Allocation allocation;
+    allocation.offset = (offset == 0 && allocated > size) ? m_head : offset;
+    allocation.size   = allocated;
+    allocation.fence  = 0;
+    m_allocations.push_back(allocation);
+
+    m_head  = offset + size;
+    m_used += allocated;
+
+    return true;
+}
+
+void TextureStreamer::release(unsigned int allocation)
+{
+    const unsigned int index = allocation - m_firstAllocation;
+    if (index < m_allocations.size()) {
+        m_allocations[index].fence = m_nextFence;
+        m_fenceNeeded = true;
+    }
+}
+
+void TextureStreamer::checkFences()
+{
+    // Find last fence that has been signaled
+    unsigned int signaled = 0;
+    while (!m_fences.empty()) {
+        const auto status = m_fences.front().sync->clientWait(gl::GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if (status != gl::GL_ALREADY_SIGNALED && status != gl::GL_CONDITION_SATISFIED) {
+            break;
+        }
+
+        signaled = m_fences.front().id;
+        m_fences.pop_front();
+    }
+
+    // Release regions in order
+    bool released = false;
+    while (!m_allocations.empty() && m_allocations.front().fence != 0 && m_allocations.front().fence <= signaled) {
+        m_used -= m_allocations.front().size;
+        m_allocations.pop_front();
+        m_firstAllocation++;
+        released = true;
+    }
+
+    // Wake up worker
+    if (released) {
+        m_signal.notify_all();
+    }
+}
+
+void TextureStreamer::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (!m_stop) {
+        // Wait for jobs
+        if (m_pending.empty()) {
+            m_signal.wait(lock);
+            continue;
+        }
+
+        Job job = m_pending.front();
+
+        if (!job.direct) {
+            // Wait for free space in the pixel buffer
+            if (!m_mapped || !allocate(job.size, job.offset)) {
+                m_signal.wait(lock);
+                continue;
+            }
+
+            job.allocation = m_firstAllocation + static_cast<unsigned int>(m_allocations.size()) - 1;
+        }
+
+        m_pending.pop_front();
+
+        if (!job.direct) {
+            // Copy data into the pixel buffer
+            m_copying = job.texture;
+            lock.unlock();
+
+            std::memcpy(m_mapped + job.offset, job.data, job.size);
+
+            lock.lock();
+            m_copying = nullptr;
+        }
+
+        // Job is ready to be uploaded
+        m_ready.push_back(job);
+        m_signal.notify_all();
+    }
+}
+
+
+} // namespace opengl
+} // namespace rendercore
@@ -0,0 +1,82 @@
+
+#include <rendercore-opengl/scene/InstancedMeshComponent.h>
+
+#include <limits>
+
+#include <cppassist/memory/make_unique.h>
+
+#include <glbinding/gl/enum.h>
+
+#include <rendercore-opengl/enums.h>
+
+
+namespace rendercore
+{
+namespace opengl
+{
+
+
+InstancedMeshComponent::InstancedMeshComponent()
+: m_instanceCount(0)
+, m_instanceBuffer(nullptr)
+, m_boundingBoxMin(std::numeric_limits<float>::max())
+, m_boundingBoxMax(-std::numeric_limits<float>::max())
+{
+}
+
+InstancedMeshComponent::~InstancedMeshComponent()
+{
+}
+
+unsigned int InstancedMeshComponent::instanceCount() const
+{
+    return m_instanceCount;
+}
+
+Buffer * InstancedMeshComponent::instanceBuffer() const
+{
+    return m_instanceBuffer;
+}
+
+void InstancedMeshComponent::setInstances(Buffer * buffer, unsigned int count)
+{
+    m_instanceBuffer = buffer;
+    m_instanceCount  = count;
+
+    // Create vertex attributes (translation, rotation and scale of each instance)
+    const int stride = 10 * sizeof(float);
+
+    m_translation = cppassist::make_unique<VertexAttribute>(buffer, 0, 0,                 stride, gl::GL_FLOAT, 3, false);
+    m_rotation    = cppassist::make_unique<VertexAttribute>(buffer, 0, 3 * sizeof(float), stride, gl::GL_FLOAT, 4, false);
+    m_scale       = cppassist::make_unique<VertexAttribute>(buffer, 0, 7 * sizeof(float), stride, gl::GL_FLOAT, 3, false);
+
+    m_instanceAttributes.clear();
+    m_instanceAttributes[(size_t)AttributeIndex::InstanceTranslation] = m_translation.get();
+    m_instanceAttributes[(size_t)AttributeIndex::InstanceRotation]    = m_rotation.get();
+    m_instanceAttributes[(size_t)AttributeIndex::InstanceScale]       = m_scale.get();
+}
+
+const std::unordered_map<size_t, const VertexAttribute *> & InstancedMeshComponent::instanceAttributes() const
+{
+    return m_instanceAttributes;
+}
+
+const glm::vec3 & InstancedMeshComponent::boundingBoxMin() const
+{
+    return m_boundingBoxMin;
+}
+
+const glm::vec3 & InstancedMeshComponent::boundingBoxMax() const
+{
+    return m_boundingBoxMax;
+}
+
+void InstancedMeshComponent::setBoundingBox(const glm::vec3 & min, const glm::vec3 & max)
+{
+    m_boundingBoxMin = min;
+    m_boundingBoxMax = max;
+}
+
+
+} // namespace opengl
+} // namespace rendercore
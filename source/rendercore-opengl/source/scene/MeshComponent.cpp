@@ -1,6 +1,10 @@
 
 #include <rendercore-opengl/scene/MeshComponent.h>
 
+#include <algorithm>
+
+#include <rendercore-opengl/Geometry.h>
+
 
 namespace rendercore
 {
@@ -10,6 +14,7 @@ namespace opengl
 
 MeshComponent::MeshComponent()
 : m_mesh(nullptr)
+, m_skin(nullptr)
 {
 }
 
@@ -30,6 +35,55 @@ Mesh * MeshComponent::mesh()
 void MeshComponent::setMesh(Mesh * mesh)
 {
     m_mesh = mesh;
+    m_lods.clear();
+}
+
+rendercore::Skin * MeshComponent::skin() const
+{
+    return m_skin;
+}
+
+void MeshComponent::setSkin(rendercore::Skin * skin)
+{
+    m_skin = skin;
+}
+
+unsigned int MeshComponent::lod(size_t index) const
+{
+    return index < m_lods.size() ? m_lods[index] : 0;
+}
+
+unsigned int MeshComponent::selectLod(size_t index, const Geometry & geometry, float errorScale, float threshold, float hysteresis)
+{
+    // Check if geometry has levels of detail
+    const auto & lods = geometry.lods();
+    if (lods.empty()) {
+        return 0;
+    }
+
+    // Get current level of detail
+    if (index >= m_lods.size()) {
+        m_lods.resize(index + 1, 0);
+    }
+
+    unsigned int current = std::min(m_lods[index], static_cast<unsigned int>(lods.size() - 1));
+
+    // Find coarsest level that is precise enough
+    unsigned int lod = 0;
+    for (unsigned int i=static_cast<unsigned int>(lods.size()); i>0; i--) {
+        if (lods[i - 1].error * errorScale <= threshold) {
+            lod = i - 1;
+            break;
+        }
+    }
+
+    // Switch to coarser levels only if their error is clearly below the threshold
+    while (lod > current && lods[lod].error * errorScale > threshold * (1.0f - hysteresis)) {
+        lod--;
+    }
+
+    m_lods[index] = lod;
+    return lod;
 }
 
 
@@ -0,0 +1,63 @@
+
+#pragma once
+
+
+#include <cstddef>
+
+#include <rendercore/rendercore_api.h>
+
+
+namespace rendercore
+{
+
+
+/**
+*  @brief
+*    Base64 decoder
+*
+*  @remarks
+*    Decodes the standard base64 alphabet (RFC 4648), as used in data URIs.
+*    Padding at the end of the input is optional. On x86 processors, input
+*    is decoded 32 (AVX2) or 16 (SSSE3) characters at a time if the CPU
+*    supports it, with a scalar fallback for the remaining characters.
+*/
+class RENDERCORE_API Base64
+{
+public:
+    /**
+    *  @brief
+    *    Get size of decoded data
+    *
+    *  @param[in] data
+    *    Base64 encoded data (can be null if size is 0)
+    *  @param[in] size
+    *    Size of encoded data (in bytes)
+    *
+    *  @return
+    *    Size of decoded data (in bytes)
+    */
+    static size_t decodedSize(const char * data, size_t size);
+
+    /**
+    *  @brief
+    *    Decode base64 data
+    *
+    *  @param[in] data
+    *    Base64 encoded data (can be null if size is 0)
+    *  @param[in] size
+    *    Size of encoded data (in bytes)
+    *  @param[out] output
+    *    Output buffer (must hold at least decodedSize() bytes)
+    *
+    *  @return
+    *    'true' if the data has been decoded, 'false' if it contains invalid characters
+    *
+    *  @remarks
+    *    Decoded data is written directly into the output buffer, which
+    *    is never written beyond decodedSize() bytes.
+    */
+    static bool decode(const char * data, size_t size, char * output);
+};
+
+
+} // namespace rendercore
@@ -0,0 +1,147 @@
+
+#pragma once
+
+
+#include <memory>
+#include <string>
+
+#include <rendercore/rendercore_api.h>
+
+
+namespace rendercore
+{
+
+
+class MappedFile;
+
+
+/**
+*  @brief
+*    Persistent cache for derived binary data
+*
+*  @remarks
+*    The cache stores blobs in a directory on disk, keyed by a 64 bit
+*    content hash (xxHash64) of the data they have been derived from.
+*    Cached blobs are memory-mapped when loaded, so they should be laid
+*    out in a way that allows them to be used directly from memory.
+*
+*    Blobs are written to a temporary file first and renamed afterwards,
+*    so concurrent readers will never see partially written files.
+*/
+class RENDERCORE_API FileCache
+{
+public:
+    /**
+    *  @brief
+    *    Compute 64 bit hash of data (xxHash64)
+    *
+    *  @param[in] data
+    *    Data (can be null if size is 0)
+    *  @param[in] size
+    *    Data size (in bytes)
+    *  @param[in] seed
+    *    Hash seed
+    *
+    *  @return
+    *    Hash value
+    */
+    static unsigned long long hash(const void * data, size_t size, unsigned long long seed = 0);
+
+public:
+    /**
+    *  @brief
+    *    Constructor
+    *
+    *  @param[in] directory
+    *    Cache directory ('' to disable the cache)
+    */
+    FileCache(const std::string & directory = "");
+
+    /**
+    *  @brief
+    *    Destructor
+    */
+    ~FileCache();
+
+    /**
+    *  @brief
+    *    Get cache directory
+    *
+    *  @return
+    *    Cache directory ('' if the cache is disabled)
+    */
+    const std::string & directory() const;
+
+    /**
+    *  @brief
+    *    Set cache directory
+    *
+    *  @param[in] directory
+    *    Cache directory ('' to disable the cache)
+    *
+    *  @remarks
+    *    The directory is created if it does not exist.
+    */
+    void setDirectory(const std::string & directory);
+
+    /**
+    *  @brief
+    *    Check if the cache is enabled
+    *
+    *  @return
+    *    'true' if a cache directory has been set, else 'false'
+    */
+    bool enabled() const;
+
+    /**
+    *  @brief
+    *    Get path of a cache entry
+    *
+    *  @param[in] key
+    *    Cache key
+    *  @param[in] extension
+    *    File extension (including the '.')
+    *
+    *  @return
+    *    Path to cache file
+    */
+    std::string path(unsigned long long key, const std::string & extension) const;
+
+    /**
+    *  @brief
+    *    Load cache entry
+    *
+    *  @param[in] key
+    *    Cache key
+    *  @param[in] extension
+    *    File extension (including the '.')
+    *
+    *  @return
+    *    Mapped cache file, null if the entry does not exist
+    */
+    std::shared_ptr<MappedFile> load(unsigned long long key, const std::string & extension) const;
+
+    /**
+    *  @brief
+    *    Store cache entry
+    *
+    *  @param[in] key
+    *    Cache key
+    *  @param[in] extension
+    *    File extension (including the '.')
+    *  @param[in] data
+    *    Data (must NOT be null)
+    *  @param[in] size
+    *    Data size (in bytes)
+    *
+    *  @return
+    *    'true' if the entry has been written, else 'false'
+    */
+    bool store(unsigned long long key, const std::string & extension, const char * data, size_t size) const;
+
+protected:
+    std::string m_directory; ///< Cache directory ('' if disabled)
+};
+
+
+} // namespace rendercore
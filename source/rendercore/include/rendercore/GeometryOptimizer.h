@@ -0,0 +1,142 @@
+
+#pragma once
+
+
+#include <cstddef>
+#include <vector>
+
+#include <rendercore/rendercore_api.h>
+
+
+namespace rendercore
+{
+
+
+/**
+*  @brief
+*    Reordering of indexed triangle lists for faster rendering
+*
+*  @remarks
+*    The optimizations are meant to be applied in order:
+*    optimizeVertexCache() reorders triangles for post-transform vertex
+*    cache locality (Tipsify, see Sander et al., "Fast Triangle Reordering
+*    for Vertex Locality and Reduced Overdraw") and returns clusters of
+*    triangles, which optimizeOverdraw() sorts so that triangles on the
+*    outside of the mesh are drawn first. optimizeVertexFetch() finally
+*    reorders the vertices in the order in which they are referenced.
+*/
+class RENDERCORE_API GeometryOptimizer
+{
+public:
+    /**
+    *  @brief
+    *    Vertex cache statistics
+    */
+    struct Statistics
+    {
+        float acmr; ///< Average cache miss ratio (transformed vertices per triangle)
+        float atvr; ///< Average transformed vertex ratio (transformed vertices per vertex)
+    };
+
+public:
+    /**
+    *  @brief
+    *    Simulate FIFO vertex cache
+    *
+    *  @param[in] indices
+    *    Triangle list
+    *  @param[in] vertexCount
+    *    Number of vertices (all indices must be smaller)
+    *  @param[in] cacheSize
+    *    Number of entries in the vertex cache
+    *
+    *  @return
+    *    Cache statistics
+    */
+    static Statistics analyzeVertexCache(const std::vector<unsigned int> & indices, unsigned int vertexCount, unsigned int cacheSize = 16);
+
+    /**
+    *  @brief
+    *    Reorder triangles for vertex cache locality
+    *
+    *  @param[in,out] indices
+    *    Triangle list
+    *  @param[in] vertexCount
+    *    Number of vertices (all indices must be smaller)
+    *  @param[out] clusters
+    *    Index of the first triangle of each cluster (can be null)
+    *  @param[in] cacheSize
+    *    Number of entries in the vertex cache
+    *
+    *  @remarks
+    *    A new cluster is started whenever the algorithm runs out of
+    *    triangles around the vertices in the cache, so clusters can be
+    *    reordered without a large effect on cache efficiency.
+    */
+    static void optimizeVertexCache(std::vector<unsigned int> & indices, unsigned int vertexCount, std::vector<unsigned int> * clusters = nullptr, unsigned int cacheSize = 16);
+
+    /**
+    *  @brief
+    *    Reorder clusters of triangles to reduce overdraw
+    *
+    *  @param[in,out] indices
+    *    Triangle list (as returned by optimizeVertexCache())
+    *  @param[in] clusters
+    *    Index of the first triangle of each cluster (as returned by optimizeVertexCache())
+    *  @param[in] positions
+    *    Vertex positions (three floats per vertex, must NOT be null)
+    *  @param[in] stride
+    *    Number of bytes between two positions
+    *  @param[in] vertexCount
+    *    Number of vertices (all indices must be smaller)
+    *  @param[in] threshold
+    *    Maximum factor by which the cache miss ratio may increase
+    *
+    *  @remarks
+    *    Clusters that face away from the center of the mesh are drawn
+    *    first, as they are likely to occlude the others. If this would
+    *    increase the cache miss ratio by more than the threshold, the
+    *    triangle list is left unchanged.
+    */
+    static void optimizeOverdraw(std::vector<unsigned int> & indices, const std::vector<unsigned int> & clusters, const char * positions, unsigned int stride, unsigned int vertexCount, float threshold = 1.05f);
+
+    /**
+    *  @brief
+    *    Reorder vertices for fetch locality
+    *
+    *  @param[in,out] indices
+    *    Triangle list (indices are replaced by the new vertex indices)
+    *  @param[in] vertexCount
+    *    Number of vertices (all indices must be smaller)
+    *  @param[out] remap
+    *    New index of each vertex
+    *
+    *  @remarks
+    *    Vertices are numbered in the order of their first reference.
+    *    Unreferenced vertices are moved to the end. The vertex data must
+    *    be reordered with remapVertices() accordingly.
+    */
+    static void optimizeVertexFetch(std::vector<unsigned int> & indices, unsigned int vertexCount, std::vector<unsigned int> & remap);
+
+    /**
+    *  @brief
+    *    Reorder vertex data
+    *
+    *  @param[in,out] data
+    *    Vertex data (must NOT be null)
+    *  @param[in] elementSize
+    *    Size of a vertex (in bytes)
+    *  @param[in] stride
+    *    Number of bytes between two vertices
+    *  @param[in] remap
+    *    New index of each vertex (as returned by optimizeVertexFetch())
+    *
+    *  @remarks
+    *    Only elementSize bytes of each vertex are moved, so interleaved
+    *    attributes can be remapped one at a time.
+    */
+    static void remapVertices(char * data, unsigned int elementSize, unsigned int stride, const std::vector<unsigned int> & remap);
+};
+
+
+} // namespace rendercore
@@ -3,6 +3,7 @@
 
 
 #include <memory>
+#include <vector>
 
 #include <rendercore/rendercore_api.h>
 
@@ -23,7 +24,15 @@ namespace rendercore
 *    corresponds to the given size and format of the image).
 *
 *    The image format and data type values are compatible with OpenGL enums
-*    and are not interpreted by the image class.
+*    and are not interpreted by the image class. Compressed images are
+*    stored with a format of 0 and the compressed internal format as
+*    data type.
+*
+*    Besides a single image, the image data can describe a complete texture
+*    with several mipmap levels, array layers, and cube map faces. The data
+*    of each level and slice (layer * faces + face) is located through a
+*    region table, so container formats can be used as-is without having
+*    to reorder their data.
 */
 class RENDERCORE_API Image
 {
@@ -165,6 +174,64 @@ public:
     */
     unsigned int dataType() const;
 
+    /**
+    *  @brief
+    *    Get internal format
+    *
+    *  @return
+    *    Suggested internal format (OpenGL enum, 0 if it shall be derived from format and type)
+    */
+    unsigned int internalFormat() const;
+
+    /**
+    *  @brief
+    *    Set internal format
+    *
+    *  @param[in] internalFormat
+    *    Suggested internal format (OpenGL enum, 0 if it shall be derived from format and type)
+    *
+    *  @remarks
+    *    Image loaders use this to pass on information that cannot be expressed
+    *    by format and type alone, e.g., whether the data is in sRGB color space.
+    */
+    void setInternalFormat(unsigned int internalFormat);
+
+    /**
+    *  @brief
+    *    Check if image data is compressed
+    *
+    *  @return
+    *    'true' if the image contains compressed data, else 'false'
+    */
+    bool compressed() const;
+
+    /**
+    *  @brief
+    *    Get number of mipmap levels
+    *
+    *  @return
+    *    Number of mipmap levels (at least 1)
+    */
+    unsigned int levels() const;
+
+    /**
+    *  @brief
+    *    Get number of array layers
+    *
+    *  @return
+    *    Number of array layers (1 for non-array images)
+    */
+    unsigned int layers() const;
+
+    /**
+    *  @brief
+    *    Get number of faces
+    *
+    *  @return
+    *    Number of faces (6 for cube maps, else 1)
+    */
+    unsigned int faces() const;
+
     /**
     *  @brief
     *    Get image size
@@ -192,6 +259,116 @@ public:
     */
     char * data();
 
+    /**
+    *  @brief
+    *    Get size of a single level and slice
+    *
+    *  @param[in] level
+    *    Mipmap level
+    *  @param[in] slice
+    *    Slice index (layer * faces + face)
+    *
+    *  @return
+    *    Size of the image data (in bytes, 0 if level or slice is invalid)
+    */
+    unsigned int size(unsigned int level, unsigned int slice) const;
+
+    /**
+    *  @brief
+    *    Get data of a single level and slice
+    *
+    *  @param[in] level
+    *    Mipmap level
+    *  @param[in] slice
+    *    Slice index (layer * faces + face)
+    *
+    *  @return
+    *    Pointer to raw image data (can be null)
+    */
+    const char * data(unsigned int level, unsigned int slice) const;
+
+    /**
+    *  @brief
+    *    Get data of a single level and slice
+    *
+    *  @param[in] level
+    *    Mipmap level
+    *  @param[in] slice
+    *    Slice index (layer * faces + face)
+    *
+    *  @return
+    *    Pointer to raw image data (can be null)
+    */
+    char * data(unsigned int level, unsigned int slice);
+
+    /**
+    *  @brief
+    *    Get width of a mipmap level
+    *
+    *  @param[in] level
+    *    Mipmap level
+    *
+    *  @return
+    *    Width of the level (at least 1)
+    */
+    unsigned int levelWidth(unsigned int level) const;
+
+    /**
+    *  @brief
+    *    Get height of a mipmap level
+    *
+    *  @param[in] level
+    *    Mipmap level
+    *
+    *  @return
+    *    Height of the level (at least 1)
+    */
+    unsigned int levelHeight(unsigned int level) const;
+
+    /**
+    *  @brief
+    *    Get depth of a mipmap level
+    *
+    *  @param[in] level
+    *    Mipmap level
+    *
+    *  @return
+    *    Depth of the level (at least 1)
+    */
+    unsigned int levelDepth(unsigned int level) const;
+
+    /**
+    *  @brief
+    *    Set layout of image data
+    *
+    *  @param[in] levels
+    *    Number of mipmap levels
+    *  @param[in] layers
+    *    Number of array layers
+    *  @param[in] faces
+    *    Number of faces (1 or 6)
+    *
+    *  @remarks
+    *    This resets the region table. All regions are empty afterwards
+    *    and have to be specified using setRegion().
+    */
+    void setLayout(unsigned int levels, unsigned int layers, unsigned int faces);
+
+    /**
+    *  @brief
+    *    Set location of a single level and slice within the image data
+    *
+    *  @param[in] level
+    *    Mipmap level
+    *  @param[in] slice
+    *    Slice index (layer * faces + face)
+    *  @param[in] offset
+    *    Offset into the image data (in bytes)
+    *  @param[in] size
+    *    Size of the data (in bytes)
+    */
+    void setRegion(unsigned int level, unsigned int slice, unsigned int offset, unsigned int size);
+
     /**
     *  @brief
     *    Clear image
@@ -228,6 +405,49 @@ public:
     */
     void setData(unsigned int width, unsigned int height, unsigned int depth, unsigned int format, unsigned int type, unsigned int size, const char * data);
 
+    /**
+    *  @brief
+    *    Create image that references external data
+    *
+    *  @param[in] width
+    *    Image width
+    *  @param[in] height
+    *    Image height
+    *  @param[in] depth
+    *    Image depth
+    *  @param[in] format
+    *    Image format (OpenGL enum)
+    *  @param[in] type
+    *    Data type (OpenGL enum)
+    *  @param[in] size
+    *    Image data size
+    *  @param[in] data
+    *    Pointer to image data (must NOT be null!)
+    *  @param[in] owner
+    *    Object that owns the data (e.g., a memory-mapped file)
+    *
+    *  @remarks
+    *    The image data is not copied. Instead, the image keeps a reference
+    *    to the owner, which must keep the data valid for as long as it lives.
+    *    Any existing image data is released.
+    */
+    void setExternalData(unsigned int width, unsigned int height, unsigned int depth, unsigned int format, unsigned int type, unsigned int size, char * data, std::shared_ptr<void> owner);
+
+    /**
+    *  @brief
+    *    Generate full mipmap chain on the CPU
+    *
+    *  @return
+    *    'true' if mipmaps have been generated, else 'false'
+    *
+    *  @remarks
+    *    Levels are computed with a 2x2 box filter. This is only supported
+    *    for uncompressed 2D images with a single level and slice and
+    *    8 bit unsigned channels (GL_RED, GL_RG, GL_RGB(A), GL_BGR(A)).
+    *    The image data is reallocated to hold all levels.
+    */
+    bool generateMipmaps();
+
 protected:
     /**
     *  @brief
@@ -248,14 +468,39 @@ protected:
     */
     void initializeImage(unsigned int width, unsigned int height, unsigned int depth, unsigned int format, unsigned int type, unsigned int size);
 
+    /**
+    *  @brief
+    *    Copy layout information from another image
+    *
+    *  @param[in] image
+    *    Source image
+    */
+    void copyLayout(const Image & image);
+
+protected:
+    /**
+    *  @brief
+    *    Location of a single level and slice within the image data
+    */
+    struct Region
+    {
+        unsigned int offset; ///< Offset into the image data (in bytes)
+        unsigned int size;   ///< Size of the data (in bytes)
+    };
+
 protected:
-    unsigned int            m_width;  ///< Image width
-    unsigned int            m_height; ///< Image height
-    unsigned int            m_depth;  ///< Image depth
-    unsigned int            m_format; ///< Image format (OpenGL enum)
-    unsigned int            m_type;   ///< Data type (OpenGL enum)
-    unsigned int            m_size;   ///< Size of image data (in bytes)
-    std::unique_ptr<char[]> m_data;   ///< Image data (can be null)
+    unsigned int          m_width;          ///< Image width
+    unsigned int          m_height;         ///< Image height
+    unsigned int          m_depth;          ///< Image depth
+    unsigned int          m_format;         ///< Image format (OpenGL enum)
+    unsigned int          m_type;           ///< Data type (OpenGL enum)
+    unsigned int          m_internalFormat; ///< Suggested internal format (OpenGL enum, 0 if none)
+    unsigned int          m_size;           ///< Size of image data (in bytes)
+    unsigned int          m_levels;         ///< Number of mipmap levels
+    unsigned int          m_layers;         ///< Number of array layers
+    unsigned int          m_faces;          ///< Number of faces
+    std::vector<Region>   m_regions;        ///< Location of each level and slice (level * layers * faces + slice)
+    std::shared_ptr<char> m_data;           ///< Image data (can be null)
 };
 
 
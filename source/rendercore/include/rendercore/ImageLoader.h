@@ -14,10 +14,66 @@ namespace rendercore
 
 /**
 *  @brief
-*    Image loader from .raw or .glraw files
+*    Image loader for common image formats and GPU texture containers
+*
+*  @remarks
+*    Common formats (.png, .jpg, .bmp) are decoded into RGBA images.
+*    Texture containers (.ktx2, .dds, .glraw) already contain GPU-ready
+*    data, including all mipmap levels, array layers and cube map faces,
+*    as well as compressed formats (BCn, ETC2/EAC, ASTC). They are
+*    memory-mapped and referenced by the image without being decoded.
+*
+*    Decoding common formats is slow, so decoded images can be stored in
+*    a persistent cache directory (see setCacheDirectory()). Entries are
+*    keyed by a hash of the source file content and memory-mapped when
+*    loaded, so warm starts skip decoding entirely.
 */
 class RENDERCORE_API ImageLoader
 {
+public:
+    /**
+    *  @brief
+    *    Get cache directory for decoded images
+    *
+    *  @return
+    *    Cache directory ('' if caching is disabled)
+    */
+    static const std::string & cacheDirectory();
+
+    /**
+    *  @brief
+    *    Set cache directory for decoded images
+    *
+    *  @param[in] directory
+    *    Cache directory ('' to disable caching)
+    *
+    *  @remarks
+    *    This should be set before any images are loaded.
+    */
+    static void setCacheDirectory(const std::string & directory);
+
+    /**
+    *  @brief
+    *    Check if mipmaps are generated for cached images
+    *
+    *  @return
+    *    'true' if mipmaps are generated, else 'false'
+    */
+    static bool cacheMipmaps();
+
+    /**
+    *  @brief
+    *    Set if mipmaps are generated for cached images
+    *
+    *  @param[in] mipmaps
+    *    'true' if mipmaps are generated when decoding images, else 'false'
+    *
+    *  @remarks
+    *    If enabled, decoded images get a full mipmap chain computed on the
+    *    CPU, which is stored in the cache together with the base level.
+    */
+    static void setCacheMipmaps(bool mipmaps);
+
 public:
     /**
     *  @brief
@@ -93,6 +149,90 @@ protected:
     *    Loaded image, null on error
     */
     std::unique_ptr<Image> loadRawImage(const std::string & filename) const;
+
+    /**
+    *  @brief
+    *    Create image from .ktx2 file
+    *
+    *  @param[in] filename
+    *    path of the .ktx2 file
+    *
+    *  @return
+    *    Loaded image, null on error
+    */
+    std::unique_ptr<Image> loadKtx2Image(const std::string & filename) const;
+
+    /**
+    *  @brief
+    *    Create image from .dds file
+    *
+    *  @param[in] filename
+    *    path of the .dds file
+    *
+    *  @return
+    *    Loaded image, null on error
+    */
+    std::unique_ptr<Image> loadDdsImage(const std::string & filename) const;
+
+    /**
+    *  @brief
+    *    Create image from KTX2 data
+    *
+    *  @param[in] data
+    *    KTX2 file data (must NOT be null)
+    *  @param[in] size
+    *    Data size
+    *  @param[in] owner
+    *    Object that owns the data
+    *
+    *  @return
+    *    Image that references the data, null on error
+    */
+    std::unique_ptr<Image> createKtx2Image(char * data, size_t size, std::shared_ptr<void> owner) const;
+
+    /**
+    *  @brief
+    *    Create image from DDS data
+    *
+    *  @param[in] data
+    *    DDS file data (must NOT be null)
+    *  @param[in] size
+    *    Data size
+    *  @param[in] owner
+    *    Object that owns the data
+    *
+    *  @return
+    *    Image that references the data, null on error
+    */
+    std::unique_ptr<Image> createDdsImage(char * data, size_t size, std::shared_ptr<void> owner) const;
+
+    /**
+    *  @brief
+    *    Load image from common file formats in memory, using the cache
+    *
+    *  @param[in] data
+    *    Encoded image data (must NOT be null)
+    *  @param[in] size
+    *    Data size
+    *
+    *  @return
+    *    Loaded image, null on error
+    */
+    std::unique_ptr<Image> loadCachedImage(const char * data, size_t size) const;
+
+    /**
+    *  @brief
+    *    Decode image from common file formats in memory
+    *
+    *  @param[in] data
+    *    Encoded image data (must NOT be null)
+    *  @param[in] size
+    *    Data size
+    *
+    *  @return
+    *    Decoded image, null on error
+    */
+    std::unique_ptr<Image> decodeCommonImage(const char * data, size_t size) const;
 };
 
 
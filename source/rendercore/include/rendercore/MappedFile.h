@@ -0,0 +1,111 @@
+
+#pragma once
+
+
+#include <string>
+
+#include <rendercore/rendercore_api.h>
+
+
+namespace rendercore
+{
+
+
+/**
+*  @brief
+*    Read-only view of a file that is mapped into memory
+*
+*  @remarks
+*    The file is mapped copy-on-write, so the data pointer can be handed
+*    out as writable memory without modifying the file on disk. The
+*    mapping stays valid until close() is called or the object is
+*    destroyed, so anything that references the data must keep the
+*    mapped file alive (e.g., by holding a shared pointer to it).
+*/
+class RENDERCORE_API MappedFile
+{
+public:
+    /**
+    *  @brief
+    *    Constructor
+    */
+    MappedFile();
+
+    // Copying a mapped file is not allowed
+    MappedFile(const MappedFile &) = delete;
+
+    // Copying a mapped file is not allowed
+    MappedFile & operator=(const MappedFile &) = delete;
+
+    /**
+    *  @brief
+    *    Destructor
+    */
+    ~MappedFile();
+
+    /**
+    *  @brief
+    *    Map file into memory
+    *
+    *  @param[in] filename
+    *    Path to file
+    *
+    *  @return
+    *    'true' if the file has been mapped, else 'false'
+    *
+    *  @remarks
+    *    A file that is already mapped will be closed first.
+    */
+    bool open(const std::string & filename);
+
+    /**
+    *  @brief
+    *    Release mapping
+    */
+    void close();
+
+    /**
+    *  @brief
+    *    Check if a file is mapped
+    *
+    *  @return
+    *    'true' if a file is mapped, else 'false'
+    */
+    bool isOpen() const;
+
+    /**
+    *  @brief
+    *    Get file size
+    *
+    *  @return
+    *    Size of the mapped file (in bytes)
+    */
+    size_t size() const;
+
+    /**
+    *  @brief
+    *    Get file data
+    *
+    *  @return
+    *    Pointer to mapped data (can be null)
+    */
+    const char * data() const;
+
+    /**
+    *  @brief
+    *    Get file data
+    *
+    *  @return
+    *    Pointer to mapped data (can be null)
+    */
+    char * data();
+
+protected:
+    char   * m_data;    ///< Mapped data (can be null)
+    size_t   m_size;    ///< Size of mapped data (in bytes)
+    void   * m_handle;  ///< Platform specific file handle (can be null)
+    void   * m_mapping; ///< Platform specific mapping handle (can be null)
+};
+
+
+} // namespace rendercore
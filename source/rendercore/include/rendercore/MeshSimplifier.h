@@ -0,0 +1,67 @@
+
+#pragma once
+
+
+#include <vector>
+
+#include <rendercore/rendercore_api.h>
+
+
+namespace rendercore
+{
+
+
+/**
+*  @brief
+*    Simplification of indexed triangle lists
+*
+*  @remarks
+*    Triangles are removed by collapsing edges onto one of their
+*    vertices, choosing the collapses with the lowest quadric error
+*    first (see Garland and Heckbert, "Surface Simplification Using
+*    Quadric Error Metrics"). Since no new vertices are created, the
+*    simplified index list can be used with the original vertex data,
+*    so several levels of detail can share the same vertex buffers.
+*
+*    Vertices on borders are never moved, so the outline of the mesh is
+*    preserved. Vertices on attribute seams (vertices that share their
+*    position with other vertices) are only moved if each of their
+*    copies shares an edge with a copy of the target position, so the
+*    seam stays closed and no triangle receives foreign attributes.
+*    Meshes without shared vertices (e.g., flat shaded meshes) can
+*    therefore not be simplified.
+*/
+class RENDERCORE_API MeshSimplifier
+{
+public:
+    /**
+    *  @brief
+    *    Simplify triangle list
+    *
+    *  @param[in,out] indices
+    *    Triangle list (replaced by the simplified triangle list)
+    *  @param[in] positions
+    *    Vertex positions (three floats per vertex, must NOT be null)
+    *  @param[in] stride
+    *    Number of bytes between two positions
+    *  @param[in] vertexCount
+    *    Number of vertices (all indices must be smaller)
+    *  @param[in] targetIndexCount
+    *    Number of indices at which the simplification stops
+    *  @param[in] maxError
+    *    Maximum error of a single edge collapse (in units of the positions)
+    *
+    *  @return
+    *    Error of the simplified triangle list (in units of the positions)
+    *
+    *  @remarks
+    *    The error is the square root of the mean squared distance of the
+    *    moved vertices to the planes of the original triangles around them.
+    *    The target count may not be reached if the error bound is hit, or
+    *    if no more edges can be collapsed without flipping triangles.
+    */
+    static float simplify(std::vector<unsigned int> & indices, const char * positions, unsigned int stride, unsigned int vertexCount, unsigned int targetIndexCount, float maxError);
+};
+
+
+} // namespace rendercore
@@ -0,0 +1,85 @@
+
+#pragma once
+
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <rendercore/rendercore_api.h>
+
+
+namespace rendercore
+{
+
+
+/**
+*  @brief
+*    Splitting of indexed triangle lists into small clusters of triangles
+*
+*  @remarks
+*    Meshlets are contiguous ranges of the triangle list that reference
+*    only a few vertices and cover a small, coherent part of the surface.
+*    Their bounding spheres and normal cones allow to skip whole clusters
+*    that are outside of the view frustum or face away from the camera.
+*/
+class RENDERCORE_API MeshletBuilder
+{
+public:
+    /**
+    *  @brief
+    *    Cluster of triangles
+    */
+    struct Meshlet
+    {
+        unsigned int offset;         ///< Index of the first element
+        unsigned int count;          ///< Number of elements
+        glm::vec4    boundingSphere; ///< Center (xyz) and radius (w)
+        glm::vec4    cone;           ///< Average normal (xyz) and cutoff (w, 1 if the cluster can not be backface culled)
+    };
+
+public:
+    /**
+    *  @brief
+    *    Split triangle list into meshlets
+    *
+    *  @param[in,out] indices
+    *    Triangle list (triangles are reordered so that each meshlet is contiguous)
+    *  @param[in] positions
+    *    Vertex positions (three floats per vertex, must NOT be null)
+    *  @param[in] stride
+    *    Number of bytes between two positions
+    *  @param[in] vertexCount
+    *    Number of vertices (all indices must be smaller)
+    *  @param[in] maxVertices
+    *    Maximum number of vertices per meshlet
+    *  @param[in] maxTriangles
+    *    Maximum number of triangles per meshlet
+    *
+    *  @return
+    *    List of meshlets
+    *
+    *  @remarks
+    *    Meshlets are grown greedily from the input order, preferring
+    *    adjacent triangles that add the fewest new vertices. Input that
+    *    has been optimized for the vertex cache works best.
+    */
+    static std::vector<Meshlet> build(std::vector<unsigned int> & indices, const char * positions, unsigned int stride, unsigned int vertexCount, unsigned int maxVertices = 64, unsigned int maxTriangles = 124);
+
+    /**
+    *  @brief
+    *    Check if a meshlet faces away from the camera
+    *
+    *  @param[in] meshlet
+    *    Meshlet
+    *  @param[in] cameraPosition
+    *    Camera position (in the same space as the meshlet)
+    *
+    *  @return
+    *    'true' if all triangles of the meshlet are back-facing, else 'false'
+    */
+    static bool isBackFacing(const Meshlet & meshlet, const glm::vec3 & cameraPosition);
+};
+
+
+} // namespace rendercore
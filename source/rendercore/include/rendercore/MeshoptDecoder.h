@@ -0,0 +1,130 @@
+
+#pragma once
+
+
+#include <rendercore/rendercore_api.h>
+
+
+namespace rendercore
+{
+
+
+/**
+*  @brief
+*    Decoder for geometry compressed with meshoptimizer (EXT_meshopt_compression)
+*
+*  @remarks
+*    Vertex data is stored in blocks of byte deltas, which are decoded
+*    one byte stream at a time. Index data is stored either as triangles
+*    (edge and vertex FIFOs) or as an index sequence (delta coded). Filters
+*    are applied to decoded vertex data in place, they are vectorized with
+*    SSE2 if available.
+*
+*    All functions check the size of the encoded data and return 'false'
+*    if it is malformed, so untrusted data can be decoded safely.
+*/
+class RENDERCORE_API MeshoptDecoder
+{
+public:
+    /**
+    *  @brief
+    *    Decode vertex data
+    *
+    *  @param[out] destination
+    *    Decoded vertices (must hold count * stride bytes)
+    *  @param[in] count
+    *    Number of vertices
+    *  @param[in] stride
+    *    Size of a vertex (in bytes, multiple of 4 and at most 256)
+    *  @param[in] data
+    *    Encoded data
+    *  @param[in] size
+    *    Size of encoded data (in bytes)
+    *
+    *  @return
+    *    'true' on success, 'false' if the data is malformed
+    */
+    static bool decodeVertexBuffer(char * destination, unsigned int count, unsigned int stride, const char * data, unsigned int size);
+
+    /**
+    *  @brief
+    *    Decode triangle indices
+    *
+    *  @param[out] destination
+    *    Decoded indices (must hold count * indexSize bytes)
+    *  @param[in] count
+    *    Number of indices (multiple of 3)
+    *  @param[in] indexSize
+    *    Size of an index (2 or 4 bytes)
+    *  @param[in] data
+    *    Encoded data
+    *  @param[in] size
+    *    Size of encoded data (in bytes)
+    *
+    *  @return
+    *    'true' on success, 'false' if the data is malformed
+    */
+    static bool decodeIndexBuffer(char * destination, unsigned int count, unsigned int indexSize, const char * data, unsigned int size);
+
+    /**
+    *  @brief
+    *    Decode index sequence (e.g., for lines, points or non-index data)
+    *
+    *  @param[out] destination
+    *    Decoded indices (must hold count * indexSize bytes)
+    *  @param[in] count
+    *    Number of indices
+    *  @param[in] indexSize
+    *    Size of an index (2 or 4 bytes)
+    *  @param[in] data
+    *    Encoded data
+    *  @param[in] size
+    *    Size of encoded data (in bytes)
+    *
+    *  @return
+    *    'true' on success, 'false' if the data is malformed
+    */
+    static bool decodeIndexSequence(char * destination, unsigned int count, unsigned int indexSize, const char * data, unsigned int size);
+
+    /**
+    *  @brief
+    *    Reconstruct unit vectors from octahedral encoding (in place)
+    *
+    *  @param[in,out] data
+    *    Decoded vertices (four signed 8 or 16 bit components each)
+    *  @param[in] count
+    *    Number of vertices
+    *  @param[in] stride
+    *    Size of a vertex (4 or 8 bytes)
+    */
+    static void filterOctahedral(char * data, unsigned int count, unsigned int stride);
+
+    /**
+    *  @brief
+    *    Reconstruct quaternions from the three smallest components (in place)
+    *
+    *  @param[in,out] data
+    *    Decoded vertices (four signed 16 bit components each)
+    *  @param[in] count
+    *    Number of vertices
+    *  @param[in] stride
+    *    Size of a vertex (8 bytes)
+    */
+    static void filterQuaternion(char * data, unsigned int count, unsigned int stride);
+
+    /**
+    *  @brief
+    *    Reconstruct floats from shared exponent encoding (in place)
+    *
+    *  @param[in,out] data
+    *    Decoded vertices (32 bit values each)
+    *  @param[in] count
+    *    Number of vertices
+    *  @param[in] stride
+    *    Size of a vertex (multiple of 4 bytes)
+    */
+    static void filterExponential(char * data, unsigned int count, unsigned int stride);
+};
+
+
+} // namespace rendercore
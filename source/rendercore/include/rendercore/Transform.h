@@ -75,7 +75,7 @@ public:
     *    Set rotation
     *
     *  @param[in] rotation
-    *    Rotation quaternion
+    *    Rotation quaternion (x, y, z, w)
     */
     void setRotation(const glm::vec4 & rotation);
 
@@ -121,6 +121,9 @@ public:
     *
     *  @return
     *    Transformation matrix
+    *
+    *  @remarks
+    *    The object is scaled first, then rotated and then translated.
     */
     const glm::mat4 & transform() const;
 
@@ -0,0 +1,135 @@
+
+#pragma once
+
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <rendercore/rendercore_api.h>
+
+
+namespace rendercore
+{
+
+
+/**
+*  @brief
+*    Conversion of float vertex attributes into compact formats
+*
+*  @remarks
+*    All functions read 'count' vertices of 32 bit float components,
+*    'stride' bytes apart, and return the packed data as a tightly packed
+*    array that can be uploaded directly. Each packed vertex takes four
+*    bytes, or eight bytes for positions, so vertex data stays 4-byte
+*    aligned.
+*/
+class RENDERCORE_API VertexQuantizer
+{
+public:
+    /**
+    *  @brief
+    *    Get bounding box of vertex data
+    *
+    *  @param[in] data
+    *    Vertex data (must NOT be null if count > 0)
+    *  @param[in] count
+    *    Number of vertices
+    *  @param[in] stride
+    *    Number of bytes between two vertices
+    *  @param[in] components
+    *    Number of components per vertex (1-4)
+    *  @param[out] minValue
+    *    Minimum value of each component (components not present are set to 0)
+    *  @param[out] maxValue
+    *    Maximum value of each component (components not present are set to 0)
+    */
+    static void bounds(const char * data, unsigned int count, unsigned int stride, unsigned int components, glm::vec4 & minValue, glm::vec4 & maxValue);
+
+    /**
+    *  @brief
+    *    Pack unit vectors into signed normalized 10:10:10:2 values (GL_INT_2_10_10_10_REV)
+    *
+    *  @param[in] data
+    *    Vertex data (must NOT be null if count > 0)
+    *  @param[in] count
+    *    Number of vertices
+    *  @param[in] stride
+    *    Number of bytes between two vertices
+    *  @param[in] components
+    *    Number of components (3 for normals, 4 for tangents)
+    *
+    *  @return
+    *    One packed value per vertex
+    *
+    *  @remarks
+    *    The fourth component is stored as its sign (-1 or 1), as used
+    *    for the handedness of tangents. For three components, it is 0.
+    */
+    static std::vector<unsigned int> packSnorm10(const char * data, unsigned int count, unsigned int stride, unsigned int components);
+
+    /**
+    *  @brief
+    *    Pack two-component values in [0, 1] into unsigned normalized 16 bit values (GL_UNSIGNED_SHORT)
+    *
+    *  @param[in] data
+    *    Vertex data (must NOT be null if count > 0)
+    *  @param[in] count
+    *    Number of vertices
+    *  @param[in] stride
+    *    Number of bytes between two vertices
+    *
+    *  @return
+    *    Two values per vertex
+    */
+    static std::vector<unsigned short> packUnorm16(const char * data, unsigned int count, unsigned int stride);
+
+    /**
+    *  @brief
+    *    Pack two-component values into half floats (GL_HALF_FLOAT)
+    *
+    *  @param[in] data
+    *    Vertex data (must NOT be null if count > 0)
+    *  @param[in] count
+    *    Number of vertices
+    *  @param[in] stride
+    *    Number of bytes between two vertices
+    *
+    *  @return
+    *    Two values per vertex
+    */
+    static std::vector<unsigned short> packHalf(const char * data, unsigned int count, unsigned int stride);
+
+    /**
+    *  @brief
+    *    Quantize positions to unsigned normalized 16 bit values relative to their bounding box
+    *
+    *  @param[in] data
+    *    Vertex data (three components, must NOT be null if count > 0)
+    *  @param[in] count
+    *    Number of vertices
+    *  @param[in] stride
+    *    Number of bytes between two vertices
+    *  @param[out] dequantization
+    *    Transformation from quantized coordinates in [0, 1] to the original positions
+    *
+    *  @return
+    *    Four values per vertex (the fourth value is padding)
+    */
+    static std::vector<unsigned short> quantizePositions(const char * data, unsigned int count, unsigned int stride, glm::mat4 & dequantization);
+
+    /**
+    *  @brief
+    *    Convert float to half float
+    *
+    *  @param[in] value
+    *    Value
+    *
+    *  @return
+    *    Half float bits (rounded to nearest even)
+    */
+    static unsigned short toHalf(float value);
+};
+
+
+} // namespace rendercore
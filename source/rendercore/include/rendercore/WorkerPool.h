@@ -0,0 +1,113 @@
+
+#pragma once
+
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <rendercore/rendercore_api.h>
+
+
+namespace rendercore
+{
+
+
+/**
+*  @brief
+*    Pool of worker threads that execute tasks
+*
+*  @remarks
+*    Tasks are executed in the order in which they have been added,
+*    but may run concurrently and finish in any order. Tasks must not
+*    touch objects that are used by other tasks at the same time, and
+*    must not call into OpenGL.
+*
+*    While the owning thread is blocked in wait(), it helps executing
+*    the remaining tasks, so a pool with N threads keeps N + 1 cores busy.
+*/
+class RENDERCORE_API WorkerPool
+{
+public:
+    /**
+    *  @brief
+    *    Constructor
+    *
+    *  @param[in] numThreads
+    *    Number of worker threads (0 for one thread per available core, minus the owning thread)
+    */
+    explicit WorkerPool(unsigned int numThreads = 0);
+
+    // Copying a worker pool is not allowed
+    WorkerPool(const WorkerPool &) = delete;
+
+    // Copying a worker pool is not allowed
+    WorkerPool & operator=(const WorkerPool &) = delete;
+
+    /**
+    *  @brief
+    *    Destructor
+    *
+    *  @remarks
+    *    Waits for all tasks to finish before the threads are stopped.
+    */
+    ~WorkerPool();
+
+    /**
+    *  @brief
+    *    Get number of worker threads
+    *
+    *  @return
+    *    Number of worker threads
+    */
+    unsigned int numThreads() const;
+
+    /**
+    *  @brief
+    *    Add task
+    *
+    *  @param[in] task
+    *    Task function
+    */
+    void run(std::function<void ()> task);
+
+    /**
+    *  @brief
+    *    Wait until all tasks have finished
+    *
+    *  @remarks
+    *    Must only be called by the owning thread, not from within a task.
+    */
+    void wait();
+
+protected:
+    /**
+    *  @brief
+    *    Execute next pending task
+    *
+    *  @param[in] lock
+    *    Lock on m_mutex (locked on entry and on return)
+    */
+    void execute(std::unique_lock<std::mutex> & lock);
+
+    /**
+    *  @brief
+    *    Worker thread
+    */
+    void work();
+
+protected:
+    std::vector<std::thread>             m_threads;      ///< Worker threads
+    std::deque< std::function<void ()> > m_tasks;        ///< Pending tasks
+    unsigned int                         m_active;       ///< Number of tasks that are currently executed
+    bool                                 m_stop;         ///< Stop the worker threads?
+    std::mutex                           m_mutex;        ///< Mutex for tasks and state
+    std::condition_variable              m_taskAdded;    ///< Signals new tasks and stop requests
+    std::condition_variable              m_taskFinished; ///< Signals finished tasks
+};
+
+
+} // namespace rendercore
@@ -0,0 +1,292 @@
+
+#pragma once
+
+
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <rendercore/rendercore_api.h>
+
+
+namespace rendercore
+{
+
+
+class SceneNode;
+
+
+/**
+*  @brief
+*    Keyframe animation of scene node transformations
+*
+*  @remarks
+*    An animation consists of channels, each of which animates the
+*    translation, rotation, scale or morph target weights of one scene
+*    node. The keyframes of
+*    all channels are stored in flat arrays, and a channel remembers the
+*    last keyframe it has used, so playing an animation forward only
+*    needs a short search.
+*
+*    Sampling is done in two steps: first, the keyframes around the
+*    requested time are gathered for every channel into arrays of single
+*    components (x, y, z, w of the surrounding keyframes and the
+*    interpolation factor). Then, all channels of the same kind are
+*    interpolated in one loop, which handles four channels at once with
+*    SSE2 if available.
+*/
+class RENDERCORE_API Animation
+{
+public:
+    /**
+    *  @brief
+    *    Animated property of a scene node
+    */
+    enum class Path
+    {
+        Translation,
+        Rotation,
+        Scale,
+        Weights
+    };
+
+    /**
+    *  @brief
+    *    Interpolation between keyframes
+    */
+    enum class Interpolation
+    {
+        Step,
+        Linear,
+        CubicSpline
+    };
+
+protected:
+    /**
+    *  @brief
+    *    Animation channel
+    */
+    struct Channel
+    {
+        SceneNode     * node;          ///< Animated scene node
+        Path            path;          ///< Animated property
+        Interpolation   interpolation; ///< Interpolation between keyframes
+        unsigned int    firstTime;     ///< Index of the first keyframe time
+        unsigned int    firstValue;    ///< Index of the first keyframe value
+        unsigned int    keyCount;      ///< Number of keyframes
+        unsigned int    cursor;        ///< Keyframe used by the last sample
+        unsigned int    firstWeight;   ///< Index of the first animated morph target weight (only for weights)
+        unsigned int    weightCount;   ///< Number of animated morph target weights (at most three, only for weights)
+    };
+
+    /**
+    *  @brief
+    *    Channels that are interpolated in the same way
+    *
+    *  @remarks
+    *    The samples are stored as nine rows of 'stride' floats each:
+    *    x, y, z and w of the first keyframe (which receive the result),
+    *    x, y, z and w of the second keyframe, and the interpolation factor.
+    */
+    struct Batch
+    {
+        std::vector<Channel> channels; ///< Channels of the batch
+        std::vector<float>   samples;  ///< Gathered keyframes (one column per channel)
+        size_t               stride;   ///< Number of floats per row (multiple of four)
+    };
+
+public:
+    /**
+    *  @brief
+    *    Constructor
+    */
+    Animation();
+
+    /**
+    *  @brief
+    *    Destructor
+    */
+    ~Animation();
+
+    /**
+    *  @brief
+    *    Get name
+    *
+    *  @return
+    *    Animation name
+    */
+    const std::string & name() const;
+
+    /**
+    *  @brief
+    *    Set name
+    *
+    *  @param[in] name
+    *    Animation name
+    */
+    void setName(const std::string & name);
+
+    /**
+    *  @brief
+    *    Get duration
+    *
+    *  @return
+    *    Time of the last keyframe (in seconds)
+    */
+    float duration() const;
+
+    /**
+    *  @brief
+    *    Get number of channels
+    *
+    *  @return
+    *    Number of channels
+    */
+    size_t channelCount() const;
+
+    /**
+    *  @brief
+    *    Add channel
+    *
+    *  @param[in] node
+    *    Animated scene node (must NOT be null)
+    *  @param[in] path
+    *    Animated property
+    *  @param[in] interpolation
+    *    Interpolation between keyframes
+    *  @param[in] times
+    *    Keyframe times (in seconds, ascending, must NOT be null)
+    *  @param[in] values
+    *    Keyframe values (must NOT be null)
+    *  @param[in] keyCount
+    *    Number of keyframes
+    *
+    *  @remarks
+    *    Each value has three components for translation and scale, and four
+    *    for rotation (a quaternion in x, y, z, w order). For cubic spline
+    *    interpolation, each keyframe has three values: in-tangent, value
+    *    and out-tangent. Channels without keyframes are ignored.
+    */
+    void addChannel(SceneNode * node, Path path, Interpolation interpolation, const float * times, const float * values, unsigned int keyCount);
+
+    /**
+    *  @brief
+    *    Add channel that animates morph target weights
+    *
+    *  @param[in] node
+    *    Animated scene node (must NOT be null)
+    *  @param[in] interpolation
+    *    Interpolation between keyframes
+    *  @param[in] times
+    *    Keyframe times (in seconds, ascending, must NOT be null)
+    *  @param[in] values
+    *    Keyframe values (must NOT be null)
+    *  @param[in] keyCount
+    *    Number of keyframes
+    *  @param[in] weightCount
+    *    Number of weights per value
+    *
+    *  @remarks
+    *    The weights are split into groups of three, which are interpolated
+    *    like translations, so they share the batched interpolation.
+    */
+    void addWeightsChannel(SceneNode * node, Interpolation interpolation, const float * times, const float * values, unsigned int keyCount, unsigned int weightCount);
+
+    /**
+    *  @brief
+    *    Apply animation at the given time to the scene nodes
+    *
+    *  @param[in] time
+    *    Time (in seconds, clamped to the keyframes)
+    *
+    *  @remarks
+    *    Rotations are interpolated linearly and normalized afterwards,
+    *    which closely matches spherical interpolation for the small angles
+    *    between keyframes.
+    */
+    void apply(float time);
+
+protected:
+    /**
+    *  @brief
+    *    Copy keyframes and add channel to its batch
+    *
+    *  @param[in] channel
+    *    Channel (keyframe indices are set by this function)
+    *  @param[in] times
+    *    Keyframe times
+    *  @param[in] values
+    *    Keyframe values
+    *  @param[in] stride
+    *    Number of floats per value
+    *  @param[in] offset
+    *    Index of the first component of the channel in each value
+    *  @param[in] components
+    *    Number of components of the channel (at most four)
+    */
+    void insertChannel(Channel & channel, const float * times, const float * values, unsigned int stride, unsigned int offset, unsigned int components);
+
+    /**
+    *  @brief
+    *    Gather keyframes of all channels of a batch
+    *
+    *  @param[in,out] batch
+    *    Batch
+    *  @param[in] time
+    *    Time (in seconds)
+    */
+    void gather(Batch & batch, float time);
+
+    /**
+    *  @brief
+    *    Find keyframe that starts the interval containing the given time
+    *
+    *  @param[in,out] channel
+    *    Channel
+    *  @param[in] time
+    *    Time (in seconds)
+    *
+    *  @return
+    *    Keyframe index
+    */
+    unsigned int findKey(Channel & channel, float time) const;
+
+    /**
+    *  @brief
+    *    Interpolate vectors of a batch
+    *
+    *  @param[in,out] batch
+    *    Batch
+    */
+    static void interpolateVectors(Batch & batch);
+
+    /**
+    *  @brief
+    *    Interpolate and normalize quaternions of a batch
+    *
+    *  @param[in,out] batch
+    *    Batch
+    */
+    static void interpolateRotations(Batch & batch);
+
+    /**
+    *  @brief
+    *    Write results of a batch to the scene nodes
+    *
+    *  @param[in] batch
+    *    Batch
+    */
+    static void scatter(const Batch & batch);
+
+protected:
+    std::string            m_name;      ///< Animation name
+    float                  m_duration;  ///< Time of the last keyframe (in seconds)
+    std::vector<float>     m_times;     ///< Keyframe times of all channels
+    std::vector<glm::vec4> m_values;    ///< Keyframe values of all channels
+    Batch                  m_vectors;   ///< Translation and scale channels
+    Batch                  m_rotations; ///< Rotation channels
+};
+
+
+} // namespace rendercore
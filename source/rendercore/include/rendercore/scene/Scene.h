@@ -2,7 +2,13 @@
 #pragma once
 
 
+#include <memory>
+#include <vector>
+
+#include <rendercore/scene/Animation.h>
+#include <rendercore/scene/SceneArena.h>
 #include <rendercore/scene/SceneNode.h>
+#include <rendercore/scene/Skin.h>
 
 
 namespace rendercore
@@ -55,8 +61,91 @@ public:
     */
     void setRoot(std::unique_ptr<SceneNode> && node);
 
+    /**
+    *  @brief
+    *    Get memory arena
+    *
+    *  @return
+    *    Arena for nodes and components that live as long as the scene
+    */
+    SceneArena & arena();
+
+    /**
+    *  @brief
+    *    Get animations
+    *
+    *  @return
+    *    List of animations
+    */
+    std::vector<Animation *> animations() const;
+
+    /**
+    *  @brief
+    *    Add animation
+    *
+    *  @param[in] animation
+    *    Animation (must NOT be null, its channels must animate nodes of this scene)
+    */
+    void addAnimation(std::unique_ptr<Animation> && animation);
+
+    /**
+    *  @brief
+    *    Get skins
+    *
+    *  @return
+    *    List of skins
+    */
+    std::vector<Skin *> skins() const;
+
+    /**
+    *  @brief
+    *    Add skin
+    *
+    *  @param[in] skin
+    *    Skin (must NOT be null, its joints must be nodes of this scene)
+    */
+    void addSkin(std::unique_ptr<Skin> && skin);
+
+    /**
+    *  @brief
+    *    Get minimum of the bounding box
+    *
+    *  @return
+    *    Minimum position in scene coordinates (greater than the maximum if unknown)
+    */
+    const glm::vec3 & boundingBoxMin() const;
+
+    /**
+    *  @brief
+    *    Get maximum of the bounding box
+    *
+    *  @return
+    *    Maximum position in scene coordinates (less than the minimum if unknown)
+    */
+    const glm::vec3 & boundingBoxMax() const;
+
+    /**
+    *  @brief
+    *    Set bounding box
+    *
+    *  @param[in] min
+    *    Minimum position in scene coordinates
+    *  @param[in] max
+    *    Maximum position in scene coordinates
+    *
+    *  @remarks
+    *    The bounding box is not updated automatically, it describes
+    *    the scene in its initial state (e.g., before animations).
+    */
+    void setBoundingBox(const glm::vec3 & min, const glm::vec3 & max);
+
 protected:
-    std::unique_ptr<SceneNode> m_root; ///< Root node of the scene
+    SceneArena                                m_arena;          ///< Arena for nodes and components (destroyed after everything that refers to them)
+    std::unique_ptr<SceneNode>                m_root;           ///< Root node of the scene
+    std::vector< std::unique_ptr<Animation> > m_animations;     ///< Animations of the scene
+    std::vector< std::unique_ptr<Skin> >      m_skins;          ///< Skins of the scene
+    glm::vec3                                 m_boundingBoxMin; ///< Minimum of the bounding box (greater than the maximum if unknown)
+    glm::vec3                                 m_boundingBoxMax; ///< Maximum of the bounding box
 };
 
 
@@ -0,0 +1,133 @@
+
+#pragma once
+
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <rendercore/rendercore_api.h>
+
+
+namespace rendercore
+{
+
+
+/**
+*  @brief
+*    Memory arena for the nodes and components of a scene
+*
+*  @remarks
+*    Objects are constructed in large blocks of memory instead of being
+*    allocated one by one, and are destroyed together with the arena (in
+*    reverse order of their creation). This avoids one heap allocation
+*    per object when creating scenes with a large number of nodes.
+*
+*    Objects created by the arena must not be deleted by their users, so
+*    they are attached to scene nodes without passing ownership (see
+*    SceneNode::addChild(SceneNode *)).
+*/
+class RENDERCORE_API SceneArena
+{
+public:
+    /**
+    *  @brief
+    *    Constructor
+    */
+    SceneArena();
+
+    // Copying an arena is not allowed
+    SceneArena(const SceneArena &) = delete;
+
+    // Copying an arena is not allowed
+    SceneArena & operator=(const SceneArena &) = delete;
+
+    /**
+    *  @brief
+    *    Destructor
+    *
+    *  @remarks
+    *    Destroys all objects created by the arena.
+    */
+    ~SceneArena();
+
+    /**
+    *  @brief
+    *    Create object
+    *
+    *  @tparam
+    *    Type Type of the object (its alignment must not exceed that of std::max_align_t)
+    *  @param[in] args
+    *    Arguments passed to the constructor
+    *
+    *  @return
+    *    Object (never null, owned by the arena)
+    */
+    template <typename Type, typename... Args>
+    Type * create(Args &&... args);
+
+    /**
+    *  @brief
+    *    Get number of objects
+    *
+    *  @return
+    *    Number of objects created by the arena
+    */
+    size_t count() const;
+
+    /**
+    *  @brief
+    *    Get size of the arena
+    *
+    *  @return
+    *    Number of bytes allocated for the objects (including unused space)
+    */
+    size_t size() const;
+
+protected:
+    /**
+    *  @brief
+    *    Allocate memory
+    *
+    *  @param[in] size
+    *    Number of bytes
+    *  @param[in] alignment
+    *    Alignment (power of two)
+    *
+    *  @return
+    *    Memory (never null)
+    */
+    void * allocate(size_t size, size_t alignment);
+
+    /**
+    *  @brief
+    *    Destroy object of a specific type
+    *
+    *  @param[in] object
+    *    Object (must NOT be null)
+    */
+    template <typename Type>
+    static void destroy(void * object);
+
+    /**
+    *  @brief
+    *    Get size of a block
+    *
+    *  @return
+    *    Number of bytes allocated at once (larger objects get a block of their own)
+    */
+    static size_t blockSize();
+
+protected:
+    std::vector< std::unique_ptr<char[]> >             m_blocks;  ///< Allocated blocks of memory
+    size_t                                             m_used;    ///< Number of bytes used in the current block
+    size_t                                             m_size;    ///< Number of bytes allocated in all blocks
+    std::vector< std::pair<void *, void (*)(void *)> > m_objects; ///< Created objects and their destroy functions
+};
+
+
+} // namespace rendercore
+
+
+#include <rendercore/scene/SceneArena.inl>
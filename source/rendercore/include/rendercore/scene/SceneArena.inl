@@ -0,0 +1,34 @@
+
+#pragma once
+
+
+#include <new>
+
+
+namespace rendercore
+{
+
+
+template <typename Type, typename... Args>
+Type * SceneArena::create(Args &&... args)
+{
+    // Reserve entry first, so that registering the object cannot fail after it has been constructed
+    m_objects.emplace_back(nullptr, &SceneArena::destroy<Type>);
+
+    // Construct object
+    void * memory = allocate(sizeof(Type), alignof(Type));
+    Type * object = new (memory) Type(std::forward<Args>(args)...);
+
+    // Register object
+    m_objects.back().first = object;
+    return object;
+}
+
+template <typename Type>
+void SceneArena::destroy(void * object)
+{
+    static_cast<Type *>(object)->~Type();
+}
+
+
+} // namespace rendercore
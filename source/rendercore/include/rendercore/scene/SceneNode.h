@@ -48,7 +48,7 @@ public:
     *  @return
     *    List of child nodes
     */
-    const std::vector< std::unique_ptr<SceneNode> > & children() const;
+    const std::vector<SceneNode *> & children() const;
 
     /**
     *  @brief
@@ -59,6 +59,27 @@ public:
     */
     void addChild(std::unique_ptr<SceneNode> && node);
 
+    /**
+    *  @brief
+    *    Add child node that is not owned by this node
+    *
+    *  @param[in] node
+    *    Scene node (must NOT be null, must outlive this node, e.g., created by the scene arena)
+    */
+    void addChild(SceneNode * node);
+
+    /**
+    *  @brief
+    *    Remove child node
+    *
+    *  @param[in] node
+    *    Scene node (must be a child of this node)
+    *
+    *  @return
+    *    Removed scene node (null if it is not a child of this node or is not owned by it)
+    */
+    std::unique_ptr<SceneNode> removeChild(SceneNode * node);
+
     /**
     *  @brief
     *    Get components
@@ -66,7 +87,7 @@ public:
     *  @return
     *    List of components
     */
-    const std::vector< std::unique_ptr<SceneNodeComponent> > & components() const;
+    const std::vector<SceneNodeComponent *> & components() const;
 
     /**
     *  @brief
@@ -129,6 +150,15 @@ public:
     */
     void addComponent(std::unique_ptr<SceneNodeComponent> && component);
 
+    /**
+    *  @brief
+    *    Add component that is not owned by this node
+    *
+    *  @param[in] component
+    *    Scene node component (must NOT be null, must outlive this node, e.g., created by the scene arena)
+    */
+    void addComponent(SceneNodeComponent * component);
+
     /**
     *  @brief
     *    Get transformation
@@ -138,6 +168,19 @@ public:
     */
     const Transform & transform() const;
 
+    /**
+    *  @brief
+    *    Get transformation
+    *
+    *  @return
+    *    Transformation of node in 3D space
+    *
+    *  @remarks
+    *    Allows to change single components of the transformation,
+    *    e.g., when the node is animated.
+    */
+    Transform & transform();
+
     /**
     *  @brief
     *    Set transformation
@@ -147,11 +190,53 @@ public:
     */
     void setTransform(const Transform & transform);
 
+    /**
+    *  @brief
+    *    Get transformation relative to the scene root
+    *
+    *  @return
+    *    Product of the transformations of this node and all its parents
+    */
+    glm::mat4 globalTransform() const;
+
+    /**
+    *  @brief
+    *    Get morph target weights
+    *
+    *  @return
+    *    Weight of each morph target of the meshes attached to the node
+    */
+    const std::vector<float> & morphWeights() const;
+
+    /**
+    *  @brief
+    *    Get morph target weights
+    *
+    *  @return
+    *    Weight of each morph target of the meshes attached to the node
+    *
+    *  @remarks
+    *    Allows animations to change single weights.
+    */
+    std::vector<float> & morphWeights();
+
+    /**
+    *  @brief
+    *    Set morph target weights
+    *
+    *  @param[in] weights
+    *    Weight of each morph target of the meshes attached to the node
+    */
+    void setMorphWeights(const std::vector<float> & weights);
+
 protected:
-    SceneNode                                          * m_parent;     ///< Parent node (can be null)
-    std::vector< std::unique_ptr<SceneNode> >            m_children;   ///< List of child nodes
-    std::vector< std::unique_ptr<SceneNodeComponent> >   m_components; ///< List of components
-    Transform                                            m_transform;  ///< Transformation of node in 3D space
+    SceneNode                                          * m_parent;          ///< Parent node (can be null)
+    std::vector<SceneNode *>                             m_children;        ///< List of child nodes
+    std::vector< std::unique_ptr<SceneNode> >            m_ownedChildren;   ///< Child nodes that are owned by this node
+    std::vector<SceneNodeComponent *>                    m_components;      ///< List of components
+    std::vector< std::unique_ptr<SceneNodeComponent> >   m_ownedComponents; ///< Components that are owned by this node
+    Transform                                            m_transform;       ///< Transformation of node in 3D space
+    std::vector<float>                                   m_morphWeights;    ///< Morph target weights
 };
 
 
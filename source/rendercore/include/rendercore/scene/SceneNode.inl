@@ -12,9 +12,9 @@ std::vector<const Type *> SceneNode::components() const
     std::vector<const Type *> list;
 
     // Iterate over components
-    for (auto & it : m_components) {
+    for (auto * it : m_components) {
         // Get component
-        const auto * component = it.get();
+        const auto * component = it;
 
         // Check component type
         const auto * typedComponent = dynamic_cast<const Type *>(component);
@@ -34,9 +34,9 @@ std::vector<Type *> SceneNode::components()
     std::vector<Type *> list;
 
     // Iterate over components
-    for (auto & it : m_components) {
+    for (auto * it : m_components) {
         // Get component
-        auto * component = it.get();
+        auto * component = it;
 
         // Check component type
         auto * typedComponent = dynamic_cast<Type *>(component);
@@ -54,9 +54,9 @@ template <typename Type>
 const Type * SceneNode::component() const
 {
     // Iterate over components
-    for (auto & it : m_components) {
+    for (auto * it : m_components) {
         // Get component
-        const auto * component = it.get();
+        const auto * component = it;
 
         // Check component type
         const auto * typedComponent = dynamic_cast<const Type *>(component);
@@ -74,9 +74,9 @@ template <typename Type>
 Type * SceneNode::component()
 {
     // Iterate over components
-    for (auto & it : m_components) {
+    for (auto * it : m_components) {
         // Get component
-        auto * component = it.get();
+        auto * component = it;
 
         // Check component type
         auto * typedComponent = dynamic_cast<Type *>(component);
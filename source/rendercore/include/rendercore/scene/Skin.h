@@ -0,0 +1,121 @@
+
+#pragma once
+
+
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <rendercore/rendercore_api.h>
+
+
+namespace rendercore
+{
+
+
+class SceneNode;
+
+
+/**
+*  @brief
+*    Skeleton for vertex skinning
+*
+*  @remarks
+*    A skin consists of joints, which are scene nodes, and the inverse
+*    bind matrix of each joint, which transforms a vertex from model
+*    space into the local space of the joint at the time of binding.
+*    From the current transformations of the joints, the joint matrices
+*    are calculated, which are used to blend the vertices on the GPU.
+*/
+class RENDERCORE_API Skin
+{
+public:
+    /**
+    *  @brief
+    *    Constructor
+    */
+    Skin();
+
+    /**
+    *  @brief
+    *    Destructor
+    */
+    ~Skin();
+
+    /**
+    *  @brief
+    *    Get name
+    *
+    *  @return
+    *    Skin name
+    */
+    const std::string & name() const;
+
+    /**
+    *  @brief
+    *    Set name
+    *
+    *  @param[in] name
+    *    Skin name
+    */
+    void setName(const std::string & name);
+
+    /**
+    *  @brief
+    *    Get joints
+    *
+    *  @return
+    *    List of joints
+    */
+    const std::vector<SceneNode *> & joints() const;
+
+    /**
+    *  @brief
+    *    Get inverse bind matrices
+    *
+    *  @return
+    *    Inverse bind matrix of each joint
+    */
+    const std::vector<glm::mat4> & inverseBindMatrices() const;
+
+    /**
+    *  @brief
+    *    Set joints
+    *
+    *  @param[in] joints
+    *    List of joints (must NOT contain null)
+    *  @param[in] inverseBindMatrices
+    *    Inverse bind matrix of each joint (missing matrices are set to identity)
+    */
+    void setJoints(const std::vector<SceneNode *> & joints, const std::vector<glm::mat4> & inverseBindMatrices);
+
+    /**
+    *  @brief
+    *    Calculate joint matrices
+    *
+    *  @param[in] meshTransform
+    *    Transformation of the skinned mesh relative to the scene root
+    *  @param[out] jointMatrices
+    *    Joint matrix of each joint
+    *
+    *  @remarks
+    *    The joint matrices transform the vertices in model space of the
+    *    mesh, so the transformation of the mesh itself must still be
+    *    applied afterwards. The transformations of the joints are
+    *    accumulated along the hierarchy, so each joint is only visited
+    *    once, and the matrix products are calculated with SSE2 if available.
+    */
+    void computeJointMatrices(const glm::mat4 & meshTransform, std::vector<glm::mat4> & jointMatrices);
+
+protected:
+    std::string              m_name;                ///< Skin name
+    std::vector<SceneNode *> m_joints;              ///< List of joints
+    std::vector<glm::mat4>   m_inverseBindMatrices; ///< Inverse bind matrix of each joint
+    std::vector<int>         m_parents;             ///< Index of the parent joint of each joint (-1 if the parent is no joint)
+    std::vector<size_t>      m_order;               ///< Joint indices, parents before their children
+    std::vector<glm::mat4>   m_globals;             ///< Transformation of each joint relative to the scene root
+};
+
+
+} // namespace rendercore
@@ -0,0 +1,284 @@
+
+#include <rendercore/Base64.h>
+
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    // Select implementation at runtime
+    #define BASE64_SSSE3
+    #define BASE64_AVX2
+    #define BASE64_TARGET(isa) __attribute__((target(isa)))
+    #include <immintrin.h>
+#elif defined(_MSC_VER) && defined(__AVX2__)
+    // Instruction sets are enabled at compile time
+    #define BASE64_SSSE3
+    #define BASE64_AVX2
+    #define BASE64_TARGET(isa)
+    #include <immintrin.h>
+#endif
+
+
+namespace
+{
+
+
+/**
+*  @brief
+*    Lookup table from base64 characters to 6 bit values (0xFF for invalid characters)
+*/
+struct DecodeTable
+{
+    unsigned char values[256];
+
+    DecodeTable()
+    {
+        static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        std::memset(values, 0xFF, sizeof(values));
+        for (unsigned int i=0; i<64; i++) {
+            values[static_cast<unsigned char>(alphabet[i])] = static_cast<unsigned char>(i);
+        }
+    }
+};
+
+const DecodeTable decodeTable;
+
+// Strip padding from the end of the input
+size_t stripPadding(const char * data, size_t size)
+{
+    for (int i=0; i<2 && size > 0 && data[size - 1] == '='; i++) {
+        size--;
+    }
+
+    return size;
+}
+
+// Decode groups of four characters, returns 'false' on invalid characters
+bool decodeScalar(const unsigned char * src, size_t size, unsigned char * dst)
+{
+    const unsigned char * table = decodeTable.values;
+
+    // Full groups
+    while (size >= 4) {
+        unsigned int a = table[src[0]];
+        unsigned int b = table[src[1]];
+        unsigned int c = table[src[2]];
+        unsigned int d = table[src[3]];
+
+        if ((a | b | c | d) & 0x80) {
+            return false;
+        }
+
+        unsigned int value = (a << 18) | (b << 12) | (c << 6) | d;
+        dst[0] = static_cast<unsigned char>(value >> 16);
+        dst[1] = static_cast<unsigned char>(value >> 8);
+        dst[2] = static_cast<unsigned char>(value);
+
+        src  += 4;
+        dst  += 3;
+        size -= 4;
+    }
+
+    // Remaining characters (without padding)
+    if (size >= 2) {
+        unsigned int a = table[src[0]];
+        unsigned int b = table[src[1]];
+        unsigned int c = (size == 3) ? table[src[2]] : 0;
+
+        if ((a | b | c) & 0x80) {
+            return false;
+        }
+
+        unsigned int value = (a << 18) | (b << 12) | (c << 6);
+        dst[0] = static_cast<unsigned char>(value >> 16);
+        if (size == 3) {
+            dst[1] = static_cast<unsigned char>(value >> 8);
+        }
+    }
+
+    return true;
+}
+
+#ifdef BASE64_SSSE3
+// Decode blocks of 16 characters into 12 bytes, returns number of characters consumed
+BASE64_TARGET("ssse3")
+size_t decodeSsse3(const unsigned char * src, size_t size, unsigned char * dst, size_t capacity)
+{
+    // Classify characters by their high and low nibbles (see W. Mula, "Base64 decoding with SIMD instructions")
+    const __m128i lutLo   = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lutHi   = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask2F  = _mm_set1_epi8(0x2F);
+    const __m128i zero    = _mm_setzero_si128();
+
+    // Pack 4 x 6 bits into 3 bytes
+    const __m128i mergeAB = _mm_set1_epi32(0x01400140);
+    const __m128i mergeBC = _mm_set1_epi32(0x00011000);
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+    size_t consumed = 0;
+    size_t written  = 0;
+
+    // Each store writes 16 bytes, of which 12 are valid
+    while (size - consumed >= 16 && written + 16 <= capacity) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + consumed));
+
+        // Check for invalid characters
+        __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(in, 4), mask2F);
+        __m128i loNibbles = _mm_and_si128(in, mask2F);
+        __m128i lo        = _mm_shuffle_epi8(lutLo, loNibbles);
+        __m128i hi        = _mm_shuffle_epi8(lutHi, hiNibbles);
+
+        if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), zero)) != 0) {
+            break;
+        }
+
+        // Translate characters to 6 bit values
+        __m128i eq2F = _mm_cmpeq_epi8(in, mask2F);
+        __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(eq2F, hiNibbles));
+        __m128i values = _mm_add_epi8(in, roll);
+
+        // Pack values
+        __m128i merged = _mm_madd_epi16(_mm_maddubs_epi16(values, mergeAB), mergeBC);
+        __m128i out    = _mm_shuffle_epi8(merged, shuffle);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + written), out);
+
+        consumed += 16;
+        written  += 12;
+    }
+
+    return consumed;
+}
+#endif
+
+#ifdef BASE64_AVX2
+// Decode blocks of 32 characters into 24 bytes, returns number of characters consumed
+BASE64_TARGET("avx2")
+size_t decodeAvx2(const unsigned char * src, size_t size, unsigned char * dst, size_t capacity)
+{
+    // Same algorithm as decodeSsse3(), on two 128 bit lanes
+    const __m256i lutLo   = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                                             0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lutHi   = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                             0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lutRoll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                             0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i mask2F  = _mm256_set1_epi8(0x2F);
+
+    const __m256i mergeAB = _mm256_set1_epi32(0x01400140);
+    const __m256i mergeBC = _mm256_set1_epi32(0x00011000);
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                             2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i compact = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+
+    size_t consumed = 0;
+    size_t written  = 0;
+
+    // Each store writes 32 bytes, of which 24 are valid
+    while (size - consumed >= 32 && written + 32 <= capacity) {
+        __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + consumed));
+
+        // Check for invalid characters
+        __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(in, 4), mask2F);
+        __m256i loNibbles = _mm256_and_si256(in, mask2F);
+        __m256i lo        = _mm256_shuffle_epi8(lutLo, loNibbles);
+        __m256i hi        = _mm256_shuffle_epi8(lutHi, hiNibbles);
+
+        if (!_mm256_testz_si256(lo, hi)) {
+            break;
+        }
+
+        // Translate characters to 6 bit values
+        __m256i eq2F   = _mm256_cmpeq_epi8(in, mask2F);
+        __m256i roll   = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(eq2F, hiNibbles));
+        __m256i values = _mm256_add_epi8(in, roll);
+
+        // Pack values and move the 24 valid bytes to the front
+        __m256i merged = _mm256_madd_epi16(_mm256_maddubs_epi16(values, mergeAB), mergeBC);
+        __m256i out    = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(merged, shuffle), compact);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + written), out);
+
+        consumed += 32;
+        written  += 24;
+    }
+
+    return consumed;
+}
+#endif
+
+// Decode as many characters as possible with SIMD instructions, returns number of characters consumed
+size_t decodeVectorized(const unsigned char * src, size_t size, unsigned char * dst, size_t capacity)
+{
+    size_t consumed = 0;
+
+#if defined(BASE64_AVX2) && !defined(_MSC_VER)
+    static const bool hasAvx2  = __builtin_cpu_supports("avx2");
+    static const bool hasSsse3 = __builtin_cpu_supports("ssse3");
+#elif defined(BASE64_AVX2)
+    static const bool hasAvx2  = true;
+    static const bool hasSsse3 = true;
+#endif
+
+#ifdef BASE64_AVX2
+    if (hasAvx2) {
+        consumed = decodeAvx2(src, size, dst, capacity);
+    }
+#endif
+
+#ifdef BASE64_SSSE3
+    if (hasSsse3) {
+        size_t written = consumed / 4 * 3;
+        consumed += decodeSsse3(src + consumed, size - consumed, dst + written, capacity - written);
+    }
+#else
+    (void)src;
+    (void)size;
+    (void)dst;
+    (void)capacity;
+#endif
+
+    return consumed;
+}
+
+
+} // namespace
+
+
+namespace rendercore
+{
+
+
+size_t Base64::decodedSize(const char * data, size_t size)
+{
+    // Ignore padding
+    size = stripPadding(data, size);
+
+    // Every four characters encode three bytes
+    size_t remainder = size % 4;
+    return size / 4 * 3 + (remainder > 1 ? remainder - 1 : 0);
+}
+
+bool Base64::decode(const char * data, size_t size, char * output)
+{
+    // Ignore padding
+    size = stripPadding(data, size);
+
+    // A single remaining character is not valid
+    if (size % 4 == 1) {
+        return false;
+    }
+
+    const unsigned char * src = reinterpret_cast<const unsigned char *>(data);
+    unsigned char       * dst = reinterpret_cast<unsigned char *>(output);
+
+    // Decode blocks with SIMD instructions
+    size_t consumed = decodeVectorized(src, size, dst, decodedSize(data, size));
+
+    // Decode remaining characters (and blocks containing invalid characters)
+    return decodeScalar(src + consumed, size - consumed, dst + consumed / 4 * 3);
+}
+
+
+} // namespace rendercore
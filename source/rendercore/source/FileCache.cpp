@@ -0,0 +1,229 @@
+
+#include <rendercore/FileCache.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <atomic>
+#include <thread>
+
+#include <cppfs/fs.h>
+#include <cppfs/FileHandle.h>
+
+#include <cppassist/logging/logging.h>
+
+#include <rendercore/MappedFile.h>
+
+
+namespace
+{
+
+
+// xxHash64 primes
+const unsigned long long prime1 = 11400714785074694791ull;
+const unsigned long long prime2 = 14029467366897019727ull;
+const unsigned long long prime3 =  1609587929392839161ull;
+const unsigned long long prime4 =  9650029242287828579ull;
+const unsigned long long prime5 =  2870177450012600261ull;
+
+inline unsigned long long rotl(unsigned long long x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+inline unsigned long long read64(const unsigned char * p)
+{
+    unsigned long long value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline unsigned long long read32(const unsigned char * p)
+{
+    unsigned int value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline unsigned long long xxRound(unsigned long long acc, unsigned long long input)
+{
+    acc += input * prime2;
+    acc  = rotl(acc, 31);
+    acc *= prime1;
+    return acc;
+}
+
+inline unsigned long long mergeRound(unsigned long long acc, unsigned long long value)
+{
+    acc ^= xxRound(0, value);
+    acc  = acc * prime1 + prime4;
+    return acc;
+}
+
+
+} // namespace
+
+
+namespace rendercore
+{
+
+
+unsigned long long FileCache::hash(const void * data, size_t size, unsigned long long seed)
+{
+    const unsigned char * p   = static_cast<const unsigned char *>(data);
+    const unsigned char * end = p + size;
+    unsigned long long h;
+
+    if (size >= 32) {
+        // Process stripes of 32 bytes with four independent accumulators
+        const unsigned char * limit = end - 32;
+        unsigned long long v1 = seed + prime1 + prime2;
+        unsigned long long v2 = seed + prime2;
+        unsigned long long v3 = seed;
+        unsigned long long v4 = seed - prime1;
+
+        do {
+            v1 = xxRound(v1, read64(p)); p += 8;
+            v2 = xxRound(v2, read64(p)); p += 8;
+            v3 = xxRound(v3, read64(p)); p += 8;
+            v4 = xxRound(v4, read64(p)); p += 8;
+        } while (p <= limit);
+
+        h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        h = mergeRound(h, v1);
+        h = mergeRound(h, v2);
+        h = mergeRound(h, v3);
+        h = mergeRound(h, v4);
+    } else {
+        h = seed + prime5;
+    }
+
+    h += static_cast<unsigned long long>(size);
+
+    // Process remaining bytes
+    while (p + 8 <= end) {
+        h ^= xxRound(0, read64(p));
+        h  = rotl(h, 27) * prime1 + prime4;
+        p += 8;
+    }
+
+    if (p + 4 <= end) {
+        h ^= read32(p) * prime1;
+        h  = rotl(h, 23) * prime2 + prime3;
+        p += 4;
+    }
+
+    while (p < end) {
+        h ^= (*p) * prime5;
+        h  = rotl(h, 11) * prime1;
+        p++;
+    }
+
+    // Final avalanche
+    h ^= h >> 33;
+    h *= prime2;
+    h ^= h >> 29;
+    h *= prime3;
+    h ^= h >> 32;
+
+    return h;
+}
+
+FileCache::FileCache(const std::string & directory)
+{
+    setDirectory(directory);
+}
+
+FileCache::~FileCache()
+{
+}
+
+const std::string & FileCache::directory() const
+{
+    return m_directory;
+}
+
+void FileCache::setDirectory(const std::string & directory)
+{
+    m_directory = directory;
+
+    // Create cache directory
+    if (!m_directory.empty()) {
+        cppfs::FileHandle dir = cppfs::fs::open(m_directory);
+        if (!dir.isDirectory() && !dir.createDirectory()) {
+            cppassist::warning() << "Could not create cache directory '" << m_directory << "'.";
+        }
+    }
+}
+
+bool FileCache::enabled() const
+{
+    return !m_directory.empty();
+}
+
+std::string FileCache::path(unsigned long long key, const std::string & extension) const
+{
+    std::stringstream ss;
+    ss << m_directory << "/" << std::hex << std::setw(16) << std::setfill('0') << key << extension;
+    return ss.str();
+}
+
+std::shared_ptr<MappedFile> FileCache::load(unsigned long long key, const std::string & extension) const
+{
+    // Check if cache is enabled
+    if (!enabled()) {
+        return nullptr;
+    }
+
+    // Map cache file
+    auto file = std::make_shared<MappedFile>();
+    if (!file->open(path(key, extension))) {
+        return nullptr;
+    }
+
+    // Return mapped file
+    return file;
+}
+
+bool FileCache::store(unsigned long long key, const std::string & extension, const char * data, size_t size) const
+{
+    // Check if cache is enabled
+    if (!enabled()) {
+        return false;
+    }
+
+    // Write to a file that is unique to this writer
+    static std::atomic<unsigned int> counter(0);
+    std::stringstream tmp;
+    tmp << path(key, extension) << "." << std::hash<std::thread::id>()(std::this_thread::get_id()) << "." << counter++ << ".tmp";
+    const std::string tmpPath = tmp.str();
+
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!file.write(data, static_cast<std::streamsize>(size))) {
+            cppassist::warning() << "Could not write cache file '" << tmpPath << "'.";
+            file.close();
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+
+    // Move the complete file into place
+    const std::string finalPath = path(key, extension);
+#ifdef SYSTEM_WINDOWS
+    // Windows does not replace existing files on rename
+    std::remove(finalPath.c_str());
+#endif
+    if (std::rename(tmpPath.c_str(), finalPath.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+
+    // Done
+    return true;
+}
+
+
+} // namespace rendercore
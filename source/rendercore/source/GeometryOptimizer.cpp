@@ -0,0 +1,325 @@
+
+#include <rendercore/GeometryOptimizer.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include <glm/glm.hpp>
+
+
+namespace
+{
+
+
+// Read vertex position
+glm::vec3 readPosition(const char * positions, unsigned int stride, unsigned int index)
+{
+    float value[3];
+    std::memcpy(value, positions + static_cast<size_t>(index) * stride, sizeof(value));
+    return glm::vec3(value[0], value[1], value[2]);
+}
+
+
+} // namespace
+
+
+namespace rendercore
+{
+
+
+GeometryOptimizer::Statistics GeometryOptimizer::analyzeVertexCache(const std::vector<unsigned int> & indices, unsigned int vertexCount, unsigned int cacheSize)
+{
+    Statistics statistics;
+    statistics.acmr = 0.0f;
+    statistics.atvr = 0.0f;
+
+    // A vertex is in the cache if less than cacheSize misses have occured since it has been loaded
+    std::vector<unsigned int> cacheTime(vertexCount, 0);
+    unsigned int time = cacheSize + 1;
+
+    unsigned int misses     = 0;
+    unsigned int referenced = 0;
+
+    for (unsigned int index : indices) {
+        if (cacheTime[index] == 0) {
+            referenced++;
+        }
+
+        if (time - cacheTime[index] > cacheSize) {
+            cacheTime[index] = time;
+            time++;
+            misses++;
+        }
+    }
+
+    // Calculate ratios
+    const size_t triangles = indices.size() / 3;
+    if (triangles > 0) {
+        statistics.acmr = static_cast<float>(misses) / static_cast<float>(triangles);
+    }
+
+    if (referenced > 0) {
+        statistics.atvr = static_cast<float>(misses) / static_cast<float>(referenced);
+    }
+
+    return statistics;
+}
+
+void GeometryOptimizer::optimizeVertexCache(std::vector<unsigned int> & indices, unsigned int vertexCount, std::vector<unsigned int> * clusters, unsigned int cacheSize)
+{
+    const unsigned int triangles = static_cast<unsigned int>(indices.size() / 3);
+
+    if (clusters) {
+        clusters->clear();
+    }
+
+    // Count live triangles per vertex
+    std::vector<unsigned int> live(vertexCount, 0);
+    for (unsigned int index : indices) {
+        live[index]++;
+    }
+
+    // Build vertex-triangle adjacency
+    std::vector<unsigned int> offsets(vertexCount + 1, 0);
+    for (unsigned int i=0; i<vertexCount; i++) {
+        offsets[i + 1] = offsets[i] + live[i];
+    }
+
+    std::vector<unsigned int> adjacency(triangles * 3);
+    std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+    for (unsigned int i=0; i<triangles * 3; i++) {
+        adjacency[fill[indices[i]]++] = i / 3;
+    }
+
+    // Optimization state
+    std::vector<unsigned int>  cacheTime(vertexCount, 0);
+    std::vector<unsigned char> emitted(triangles, 0);
+    std::vector<unsigned int>  deadEnd;
+    std::vector<unsigned int>  candidates;
+    std::vector<unsigned int>  result;
+    unsigned int time   = cacheSize + 1;
+    unsigned int cursor = 0;
+
+    deadEnd.reserve(triangles * 3);
+    result.reserve(triangles * 3);
+
+    // Helper function: Get next vertex that still has live triangles from the dead-end stack or in input order
+    auto skipDeadEnd = [&] () -> int {
+        while (!deadEnd.empty()) {
+            unsigned int vertex = deadEnd.back();
+            deadEnd.pop_back();
+
+            if (live[vertex] > 0) {
+                return static_cast<int>(vertex);
+            }
+        }
+
+        while (cursor < vertexCount) {
+            if (live[cursor] > 0) {
+                return static_cast<int>(cursor);
+            }
+
+            cursor++;
+        }
+
+        return -1;
+    };
+
+    // Start first cluster
+    int fanning = skipDeadEnd();
+    if (clusters && fanning >= 0) {
+        clusters->push_back(0);
+    }
+
+    while (fanning >= 0) {
+        candidates.clear();
+
+        // Emit all remaining triangles around the fanning vertex
+        for (unsigned int i=offsets[fanning]; i<offsets[fanning + 1]; i++) {
+            unsigned int triangle = adjacency[i];
+            if (emitted[triangle]) {
+                continue;
+            }
+
+            for (unsigned int j=0; j<3; j++) {
+                unsigned int vertex = indices[triangle * 3 + j];
+
+                result.push_back(vertex);
+                deadEnd.push_back(vertex);
+                candidates.push_back(vertex);
+                live[vertex]--;
+
+                if (time - cacheTime[vertex] > cacheSize) {
+                    cacheTime[vertex] = time;
+                    time++;
+                }
+            }
+
+            emitted[triangle] = 1;
+        }
+
+        // Choose the oldest candidate that will still be in the cache after its triangles have been emitted
+        int best         = -1;
+        int bestPriority = -1;
+        for (unsigned int vertex : candidates) {
+            if (live[vertex] == 0) {
+                continue;
+            }
+
+            int priority = 0;
+            if (time - cacheTime[vertex] + 2 * live[vertex] <= cacheSize) {
+                priority = static_cast<int>(time - cacheTime[vertex]);
+            }
+
+            if (priority > bestPriority) {
+                best         = static_cast<int>(vertex);
+                bestPriority = priority;
+            }
+        }
+
+        // Start a new cluster if no candidate is left
+        if (best < 0) {
+            best = skipDeadEnd();
+
+            if (clusters && best >= 0) {
+                clusters->push_back(static_cast<unsigned int>(result.size() / 3));
+            }
+        }
+
+        fanning = best;
+    }
+
+    // Keep trailing indices that do not form a complete triangle
+    result.insert(result.end(), indices.begin() + triangles * 3, indices.end());
+
+    indices.swap(result);
+}
+
+void GeometryOptimizer::optimizeOverdraw(std::vector<unsigned int> & indices, const std::vector<unsigned int> & clusters, const char * positions, unsigned int stride, unsigned int vertexCount, float threshold)
+{
+    const unsigned int triangles = static_cast<unsigned int>(indices.size() / 3);
+    const unsigned int numClusters = static_cast<unsigned int>(clusters.size());
+
+    if (numClusters <= 1) {
+        return;
+    }
+
+    // Calculate area-weighted centroid and normal of each cluster
+    std::vector<glm::vec3> centroids(numClusters, glm::vec3(0.0f));
+    std::vector<glm::vec3> normals(numClusters, glm::vec3(0.0f));
+    std::vector<float>     areas(numClusters, 0.0f);
+
+    glm::vec3 meshCentroid(0.0f);
+    float     meshArea = 0.0f;
+
+    for (unsigned int c=0; c<numClusters; c++) {
+        unsigned int begin = clusters[c];
+        unsigned int end   = (c + 1 < numClusters) ? clusters[c + 1] : triangles;
+
+        for (unsigned int t=begin; t<end; t++) {
+            glm::vec3 p0 = readPosition(positions, stride, indices[t * 3 + 0]);
+            glm::vec3 p1 = readPosition(positions, stride, indices[t * 3 + 1]);
+            glm::vec3 p2 = readPosition(positions, stride, indices[t * 3 + 2]);
+
+            glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            float     area   = glm::length(normal);
+
+            centroids[c] += (p0 + p1 + p2) * (area / 3.0f);
+            normals[c]   += normal;
+            areas[c]     += area;
+        }
+
+        meshCentroid += centroids[c];
+        meshArea     += areas[c];
+
+        if (areas[c] > 0.0f) {
+            centroids[c] /= areas[c];
+        }
+    }
+
+    if (meshArea <= 0.0f) {
+        return;
+    }
+
+    meshCentroid /= meshArea;
+
+    // Sort clusters by how much they face away from the mesh center
+    std::vector<float> keys(numClusters, 0.0f);
+    for (unsigned int c=0; c<numClusters; c++) {
+        float length = glm::length(normals[c]);
+        if (length > 0.0f) {
+            keys[c] = glm::dot(centroids[c] - meshCentroid, normals[c] / length);
+        }
+    }
+
+    std::vector<unsigned int> order(numClusters);
+    for (unsigned int c=0; c<numClusters; c++) {
+        order[c] = c;
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&keys] (unsigned int a, unsigned int b) {
+        return keys[a] > keys[b];
+    });
+
+    // Build reordered triangle list
+    std::vector<unsigned int> result;
+    result.reserve(indices.size());
+
+    for (unsigned int c : order) {
+        unsigned int begin = clusters[c];
+        unsigned int end   = (c + 1 < numClusters) ? clusters[c + 1] : triangles;
+        result.insert(result.end(), indices.begin() + begin * 3, indices.begin() + end * 3);
+    }
+
+    result.insert(result.end(), indices.begin() + triangles * 3, indices.end());
+
+    // Keep the previous order if the vertex cache suffers too much
+    float before = analyzeVertexCache(indices, vertexCount).acmr;
+    float after  = analyzeVertexCache(result,  vertexCount).acmr;
+    if (after <= before * threshold) {
+        indices.swap(result);
+    }
+}
+
+void GeometryOptimizer::optimizeVertexFetch(std::vector<unsigned int> & indices, unsigned int vertexCount, std::vector<unsigned int> & remap)
+{
+    const unsigned int unused = ~0u;
+
+    remap.assign(vertexCount, unused);
+
+    // Number vertices in the order of their first reference
+    unsigned int next = 0;
+    for (unsigned int & index : indices) {
+        if (remap[index] == unused) {
+            remap[index] = next++;
+        }
+
+        index = remap[index];
+    }
+
+    // Move unreferenced vertices to the end
+    for (unsigned int i=0; i<vertexCount; i++) {
+        if (remap[i] == unused) {
+            remap[i] = next++;
+        }
+    }
+}
+
+void GeometryOptimizer::remapVertices(char * data, unsigned int elementSize, unsigned int stride, const std::vector<unsigned int> & remap)
+{
+    const size_t vertexCount = remap.size();
+
+    // Gather vertices in their new order
+    std::vector<char> reordered(vertexCount * elementSize);
+    for (size_t i=0; i<vertexCount; i++) {
+        std::memcpy(reordered.data() + static_cast<size_t>(remap[i]) * elementSize, data + i * stride, elementSize);
+    }
+
+    // Write back
+    for (size_t i=0; i<vertexCount; i++) {
+        std::memcpy(data + i * stride, reordered.data() + i * elementSize, elementSize);
+    }
+}
+
+
+} // namespace rendercore
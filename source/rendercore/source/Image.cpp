@@ -4,7 +4,6 @@
 #include <algorithm>
 
 #include <cppassist/logging/logging.h>
-#include <cppassist/memory/make_unique.h>
 
 
 namespace rendercore
@@ -17,7 +16,12 @@ Image::Image()
 , m_depth(0)
 , m_format(0)
 , m_type(0)
+, m_internalFormat(0)
 , m_size(0)
+, m_levels(1)
+, m_layers(1)
+, m_faces(1)
+, m_regions(1, Region{0, 0})
 , m_data(nullptr)
 {
 }
@@ -32,6 +36,7 @@ Image::Image(const Image & image)
 : Image()
 {
     setData(image.width(), image.height(), image.depth(), image.format(), image.dataType(), image.size(), image.data());
+    copyLayout(image);
 }
 
 Image::Image(Image && image)
@@ -40,7 +45,12 @@ Image::Image(Image && image)
 , m_depth(image.m_depth)
 , m_format(image.m_format)
 , m_type(image.m_type)
+, m_internalFormat(image.m_internalFormat)
 , m_size(image.m_size)
+, m_levels(image.m_levels)
+, m_layers(image.m_layers)
+, m_faces(image.m_faces)
+, m_regions(std::move(image.m_regions))
 , m_data(std::move(image.m_data))
 {
 }
@@ -52,6 +62,7 @@ Image::~Image()
 Image & Image::operator =(Image & image)
 {
     setData(image.width(), image.height(), image.depth(), image.format(), image.dataType(), image.size(), image.data());
+    copyLayout(image);
 
     return *this;
 }
@@ -59,6 +70,7 @@ Image & Image::operator =(Image & image)
 Image & Image::operator =(Image && image)
 {
     initializeImage(image.width(), image.height(), image.depth(), image.format(), image.dataType(), image.size());
+    copyLayout(image);
     m_data = std::move(image.m_data);
 
     return *this;
@@ -94,6 +106,36 @@ unsigned int Image::dataType() const
     return m_type;
 }
 
+unsigned int Image::internalFormat() const
+{
+    return m_internalFormat;
+}
+
+void Image::setInternalFormat(unsigned int internalFormat)
+{
+    m_internalFormat = internalFormat;
+}
+
+bool Image::compressed() const
+{
+    return m_format == 0 && m_type != 0;
+}
+
+unsigned int Image::levels() const
+{
+    return m_levels;
+}
+
+unsigned int Image::layers() const
+{
+    return m_layers;
+}
+
+unsigned int Image::faces() const
+{
+    return m_faces;
+}
+
 unsigned int Image::size() const
 {
     return m_size;
@@ -109,15 +151,94 @@ char * Image::data()
     return m_data.get();
 }
 
+unsigned int Image::size(unsigned int level, unsigned int slice) const
+{
+    // Check if level and slice are valid
+    if (level >= m_levels || slice >= m_layers * m_faces) {
+        return 0;
+    }
+
+    // Return size of region
+    return m_regions[level * m_layers * m_faces + slice].size;
+}
+
+const char * Image::data(unsigned int level, unsigned int slice) const
+{
+    // Check if level and slice are valid
+    if (!m_data || level >= m_levels || slice >= m_layers * m_faces) {
+        return nullptr;
+    }
+
+    // Return pointer to region
+    return m_data.get() + m_regions[level * m_layers * m_faces + slice].offset;
+}
+
+char * Image::data(unsigned int level, unsigned int slice)
+{
+    // Check if level and slice are valid
+    if (!m_data || level >= m_levels || slice >= m_layers * m_faces) {
+        return nullptr;
+    }
+
+    // Return pointer to region
+    return m_data.get() + m_regions[level * m_layers * m_faces + slice].offset;
+}
+
+unsigned int Image::levelWidth(unsigned int level) const
+{
+    return std::max(m_width >> level, 1u);
+}
+
+unsigned int Image::levelHeight(unsigned int level) const
+{
+    return std::max(m_height >> level, 1u);
+}
+
+unsigned int Image::levelDepth(unsigned int level) const
+{
+    return std::max(m_depth >> level, 1u);
+}
+
+void Image::setLayout(unsigned int levels, unsigned int layers, unsigned int faces)
+{
+    m_levels = std::max(levels, 1u);
+    m_layers = std::max(layers, 1u);
+    m_faces  = std::max(faces,  1u);
+
+    m_regions.assign(m_levels * m_layers * m_faces, Region{0, 0});
+}
+
+void Image::setRegion(unsigned int level, unsigned int slice, unsigned int offset, unsigned int size)
+{
+    // Check if level and slice are valid
+    if (level >= m_levels || slice >= m_layers * m_faces) {
+        return;
+    }
+
+    // Check if region lies within the image data
+    if (offset > m_size || size > m_size - offset) {
+        cppassist::warning() << "Image region exceeds image data.";
+        return;
+    }
+
+    // Set region
+    m_regions[level * m_layers * m_faces + slice] = Region{offset, size};
+}
+
 void Image::clear()
 {
-    m_width  = 0;
-    m_height = 0;
-    m_depth  = 0;
-    m_format = 0;
-    m_type   = 0;
-    m_size   = 0;
-    m_data   = nullptr;
+    m_width          = 0;
+    m_height         = 0;
+    m_depth          = 0;
+    m_format         = 0;
+    m_type           = 0;
+    m_internalFormat = 0;
+    m_size           = 0;
+    m_levels         = 1;
+    m_layers         = 1;
+    m_faces          = 1;
+    m_regions.assign(1, Region{0, 0});
+    m_data           = nullptr;
 }
 
 void Image::setData(unsigned int width, unsigned int height, unsigned int depth, unsigned int format, unsigned int type, unsigned int size, const char * data)
@@ -133,7 +254,7 @@ void Image::setData(unsigned int width, unsigned int height, unsigned int depth,
     }
 
     // Create image data
-    m_data = cppassist::make_unique<char[]>(m_size);
+    m_data = std::shared_ptr<char>(new char[m_size], std::default_delete<char[]>());
     if (!m_data) {
         cppassist::critical() << "Image buffer creation failed.";
         return;
@@ -143,6 +264,103 @@ void Image::setData(unsigned int width, unsigned int height, unsigned int depth,
     std::copy_n(data, m_size, m_data.get());
 }
 
+void Image::setExternalData(unsigned int width, unsigned int height, unsigned int depth, unsigned int format, unsigned int type, unsigned int size, char * data, std::shared_ptr<void> owner)
+{
+    // Release old image
+    clear();
+
+    // Initialize image information
+    initializeImage(width, height, depth, format, type, size);
+    if (m_size == 0 || !data) {
+        cppassist::critical() << "Image buffer creation failed.";
+        return;
+    }
+
+    // Reference data, keeping its owner alive
+    m_data = std::shared_ptr<char>(owner, data);
+}
+
+bool Image::generateMipmaps()
+{
+    // Check if image format is supported
+    unsigned int channels = 0;
+    switch (m_format)
+    {
+        case 6403:  channels = 1; break; // gl::GL_RED
+        case 33319: channels = 2; break; // gl::GL_RG
+        case 6407:  channels = 3; break; // gl::GL_RGB
+        case 32992: channels = 3; break; // gl::GL_BGR
+        case 6408:  channels = 4; break; // gl::GL_RGBA
+        case 32993: channels = 4; break; // gl::GL_BGRA
+        default:    break;
+    }
+
+    if (!m_data || channels == 0 || m_type != 5121 || m_depth > 1 || m_levels != 1 || m_layers * m_faces != 1) { // gl::GL_UNSIGNED_BYTE
+        return false;
+    }
+
+    // Check image size
+    if (m_size < m_width * m_height * channels) {
+        return false;
+    }
+
+    // Count levels and total size
+    unsigned int levels = 1;
+    unsigned int size   = m_width * m_height * channels;
+    while (levelWidth(levels - 1) > 1 || levelHeight(levels - 1) > 1) {
+        size += levelWidth(levels) * levelHeight(levels) * channels;
+        levels++;
+    }
+
+    // Create new image data and copy base level
+    std::shared_ptr<char> data(new char[size], std::default_delete<char[]>());
+    std::copy_n(m_data.get(), m_width * m_height * channels, data.get());
+
+    std::vector<Region> regions(levels, Region{0, 0});
+    regions[0] = Region{0, m_width * m_height * channels};
+
+    // Compute each level from the previous one
+    for (unsigned int level = 1; level < levels; level++) {
+        const unsigned int srcWidth  = levelWidth(level - 1);
+        const unsigned int srcHeight = levelHeight(level - 1);
+        const unsigned int dstWidth  = levelWidth(level);
+        const unsigned int dstHeight = levelHeight(level);
+
+        const unsigned char * src = reinterpret_cast<const unsigned char *>(data.get() + regions[level - 1].offset);
+        regions[level] = Region{regions[level - 1].offset + regions[level - 1].size, dstWidth * dstHeight * channels};
+        unsigned char * dst = reinterpret_cast<unsigned char *>(data.get() + regions[level].offset);
+
+        for (unsigned int y = 0; y < dstHeight; y++) {
+            // Clamp to the edge for odd sizes
+            const unsigned int y0 = std::min(2 * y,     srcHeight - 1);
+            const unsigned int y1 = std::min(2 * y + 1, srcHeight - 1);
+
+            for (unsigned int x = 0; x < dstWidth; x++) {
+                const unsigned int x0 = std::min(2 * x,     srcWidth - 1);
+                const unsigned int x1 = std::min(2 * x + 1, srcWidth - 1);
+
+                for (unsigned int c = 0; c < channels; c++) {
+                    const unsigned int sum = src[(y0 * srcWidth + x0) * channels + c]
+                                           + src[(y0 * srcWidth + x1) * channels + c]
+                                           + src[(y1 * srcWidth + x0) * channels + c]
+                                           + src[(y1 * srcWidth + x1) * channels + c];
+
+                    dst[(y * dstWidth + x) * channels + c] = static_cast<unsigned char>((sum + 2) / 4);
+                }
+            }
+        }
+    }
+
+    // Replace image data
+    m_data    = data;
+    m_size    = size;
+    m_levels  = levels;
+    m_regions = regions;
+
+    // Done
+    return true;
+}
+
 void Image::initializeImage(unsigned int width, unsigned int height, unsigned int depth, unsigned int format, unsigned int type, unsigned int size)
 {
     m_width  = width;
@@ -151,6 +369,21 @@ void Image::initializeImage(unsigned int width, unsigned int height, unsigned in
     m_format = format;
     m_type   = type;
     m_size   = size;
+
+    // Default layout: a single image covering all data
+    m_levels = 1;
+    m_layers = 1;
+    m_faces  = 1;
+    m_regions.assign(1, Region{0, size});
+}
+
+void Image::copyLayout(const Image & image)
+{
+    m_internalFormat = image.m_internalFormat;
+    m_levels         = image.m_levels;
+    m_layers         = image.m_layers;
+    m_faces          = image.m_faces;
+    m_regions        = image.m_regions;
 }
 
 
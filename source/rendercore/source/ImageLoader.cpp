@@ -1,22 +1,438 @@
 
 #include <rendercore/ImageLoader.h>
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
 
 #include <cppfs/FilePath.h>
 
+#include <cppassist/logging/logging.h>
 #include <cppassist/memory/make_unique.h>
 #include <cppassist/fs/DescriptiveRawFile.h>
 
+#include <rendercore/MappedFile.h>
+#include <rendercore/FileCache.h>
+
 
 using namespace rendercore;
 
 
+namespace
+{
+
+
+// OpenGL enums (rendercore does not depend on an OpenGL binding)
+const unsigned int GLenumRed          = 0x1903;
+const unsigned int GLenumRG           = 0x8227;
+const unsigned int GLenumRGB          = 0x1907;
+const unsigned int GLenumRGBA         = 0x1908;
+const unsigned int GLenumBGR          = 0x80E0;
+const unsigned int GLenumBGRA         = 0x80E1;
+
+const unsigned int GLenumUByte        = 0x1401;
+const unsigned int GLenumUShort       = 0x1403;
+const unsigned int GLenumFloat        = 0x1406;
+const unsigned int GLenumHalfFloat    = 0x140B;
+const unsigned int GLenumUInt10F11F   = 0x8C3B;
+const unsigned int GLenumUInt5999     = 0x8C3E;
+
+const unsigned int GLenumR8           = 0x8229;
+const unsigned int GLenumRG8          = 0x822B;
+const unsigned int GLenumRGB8         = 0x8051;
+const unsigned int GLenumRGBA8        = 0x8058;
+const unsigned int GLenumSRGB8        = 0x8C41;
+const unsigned int GLenumSRGB8A8      = 0x8C43;
+const unsigned int GLenumR16          = 0x822A;
+const unsigned int GLenumRG16         = 0x822C;
+const unsigned int GLenumRGBA16       = 0x805B;
+const unsigned int GLenumR16F         = 0x822D;
+const unsigned int GLenumRG16F        = 0x822F;
+const unsigned int GLenumRGB16F       = 0x881B;
+const unsigned int GLenumRGBA16F      = 0x881A;
+const unsigned int GLenumR32F         = 0x822E;
+const unsigned int GLenumRG32F        = 0x8230;
+const unsigned int GLenumRGB32F       = 0x8815;
+const unsigned int GLenumRGBA32F      = 0x8814;
+const unsigned int GLenumR11G11B10F   = 0x8C3A;
+const unsigned int GLenumRGB9E5       = 0x8C3D;
+
+const unsigned int GLenumDXT1         = 0x83F0;
+const unsigned int GLenumDXT1A        = 0x83F1;
+const unsigned int GLenumDXT3         = 0x83F2;
+const unsigned int GLenumDXT5         = 0x83F3;
+const unsigned int GLenumSRGBDXT1     = 0x8C4C;
+const unsigned int GLenumSRGBDXT1A    = 0x8C4D;
+const unsigned int GLenumSRGBDXT3     = 0x8C4E;
+const unsigned int GLenumSRGBDXT5     = 0x8C4F;
+const unsigned int GLenumRGTC1        = 0x8DBB;
+const unsigned int GLenumRGTC1S       = 0x8DBC;
+const unsigned int GLenumRGTC2        = 0x8DBD;
+const unsigned int GLenumRGTC2S       = 0x8DBE;
+const unsigned int GLenumBPTC         = 0x8E8C;
+const unsigned int GLenumSRGBBPTC     = 0x8E8D;
+const unsigned int GLenumBPTCSF       = 0x8E8E;
+const unsigned int GLenumBPTCUF       = 0x8E8F;
+const unsigned int GLenumR11EAC       = 0x9270;
+const unsigned int GLenumR11EACS      = 0x9271;
+const unsigned int GLenumRG11EAC      = 0x9272;
+const unsigned int GLenumRG11EACS     = 0x9273;
+const unsigned int GLenumETC2         = 0x9274;
+const unsigned int GLenumSRGBETC2     = 0x9275;
+const unsigned int GLenumETC2A1       = 0x9276;
+const unsigned int GLenumSRGBETC2A1   = 0x9277;
+const unsigned int GLenumETC2EAC      = 0x9278;
+const unsigned int GLenumSRGBETC2EAC  = 0x9279;
+const unsigned int GLenumASTC         = 0x93B0; // GL_COMPRESSED_RGBA_ASTC_4x4_KHR, followed by the other block sizes
+const unsigned int GLenumSRGBASTC     = 0x93D0; // GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR, followed by the other block sizes
+
+
+/**
+*  @brief
+*    Description of a GPU texture format
+*/
+struct FormatInfo
+{
+    unsigned int format;         ///< Image format (OpenGL enum, 0 for compressed formats)
+    unsigned int type;           ///< Data type (OpenGL enum), or compressed internal format
+    unsigned int internalFormat; ///< Internal format (OpenGL enum)
+    unsigned int blockWidth;     ///< Width of a block (1 for uncompressed formats)
+    unsigned int blockHeight;    ///< Height of a block (1 for uncompressed formats)
+    unsigned int blockSize;      ///< Size of a block or pixel (in bytes)
+};
+
+FormatInfo uncompressed(unsigned int format, unsigned int type, unsigned int internalFormat, unsigned int pixelSize)
+{
+    return FormatInfo{ format, type, internalFormat, 1, 1, pixelSize };
+}
+
+FormatInfo compressed(unsigned int internalFormat, unsigned int blockWidth, unsigned int blockHeight, unsigned int blockSize)
+{
+    return FormatInfo{ 0, internalFormat, internalFormat, blockWidth, blockHeight, blockSize };
+}
+
+// ASTC block sizes, in the order of the Vulkan and OpenGL enums
+const unsigned int astcBlocks[14][2] = {
+    {  4,  4 }, {  5,  4 }, {  5,  5 }, {  6,  5 }, {  6,  6 }, {  8,  5 }, {  8,  6 },
+    {  8,  8 }, { 10,  5 }, { 10,  6 }, { 10,  8 }, { 10, 10 }, { 12, 10 }, { 12, 12 }
+};
+
+bool vkFormatInfo(unsigned int vkFormat, FormatInfo & info)
+{
+    switch (vkFormat)
+    {
+        case   9: info = uncompressed(GLenumRed,  GLenumUByte,      GLenumR8,        1); return true; // R8_UNORM
+        case  16: info = uncompressed(GLenumRG,   GLenumUByte,      GLenumRG8,       2); return true; // R8G8_UNORM
+        case  23: info = uncompressed(GLenumRGB,  GLenumUByte,      GLenumRGB8,      3); return true; // R8G8B8_UNORM
+        case  29: info = uncompressed(GLenumRGB,  GLenumUByte,      GLenumSRGB8,     3); return true; // R8G8B8_SRGB
+        case  30: info = uncompressed(GLenumBGR,  GLenumUByte,      GLenumRGB8,      3); return true; // B8G8R8_UNORM
+        case  36: info = uncompressed(GLenumBGR,  GLenumUByte,      GLenumSRGB8,     3); return true; // B8G8R8_SRGB
+        case  37: info = uncompressed(GLenumRGBA, GLenumUByte,      GLenumRGBA8,     4); return true; // R8G8B8A8_UNORM
+        case  43: info = uncompressed(GLenumRGBA, GLenumUByte,      GLenumSRGB8A8,   4); return true; // R8G8B8A8_SRGB
+        case  44: info = uncompressed(GLenumBGRA, GLenumUByte,      GLenumRGBA8,     4); return true; // B8G8R8A8_UNORM
+        case  50: info = uncompressed(GLenumBGRA, GLenumUByte,      GLenumSRGB8A8,   4); return true; // B8G8R8A8_SRGB
+        case  70: info = uncompressed(GLenumRed,  GLenumUShort,     GLenumR16,       2); return true; // R16_UNORM
+        case  76: info = uncompressed(GLenumRed,  GLenumHalfFloat,  GLenumR16F,      2); return true; // R16_SFLOAT
+        case  77: info = uncompressed(GLenumRG,   GLenumUShort,     GLenumRG16,      4); return true; // R16G16_UNORM
+        case  83: info = uncompressed(GLenumRG,   GLenumHalfFloat,  GLenumRG16F,     4); return true; // R16G16_SFLOAT
+        case  90: info = uncompressed(GLenumRGB,  GLenumHalfFloat,  GLenumRGB16F,    6); return true; // R16G16B16_SFLOAT
+        case  91: info = uncompressed(GLenumRGBA, GLenumUShort,     GLenumRGBA16,    8); return true; // R16G16B16A16_UNORM
+        case  97: info = uncompressed(GLenumRGBA, GLenumHalfFloat,  GLenumRGBA16F,   8); return true; // R16G16B16A16_SFLOAT
+        case 100: info = uncompressed(GLenumRed,  GLenumFloat,      GLenumR32F,      4); return true; // R32_SFLOAT
+        case 103: info = uncompressed(GLenumRG,   GLenumFloat,      GLenumRG32F,     8); return true; // R32G32_SFLOAT
+        case 106: info = uncompressed(GLenumRGB,  GLenumFloat,      GLenumRGB32F,   12); return true; // R32G32B32_SFLOAT
+        case 109: info = uncompressed(GLenumRGBA, GLenumFloat,      GLenumRGBA32F,  16); return true; // R32G32B32A32_SFLOAT
+        case 122: info = uncompressed(GLenumRGB,  GLenumUInt10F11F, GLenumR11G11B10F, 4); return true; // B10G11R11_UFLOAT_PACK32
+        case 123: info = uncompressed(GLenumRGB,  GLenumUInt5999,   GLenumRGB9E5,    4); return true; // E5B9G9R9_UFLOAT_PACK32
+
+        case 131: info = compressed(GLenumDXT1,        4, 4,  8); return true; // BC1_RGB_UNORM
+        case 132: info = compressed(GLenumSRGBDXT1,    4, 4,  8); return true; // BC1_RGB_SRGB
+        case 133: info = compressed(GLenumDXT1A,       4, 4,  8); return true; // BC1_RGBA_UNORM
+        case 134: info = compressed(GLenumSRGBDXT1A,   4, 4,  8); return true; // BC1_RGBA_SRGB
+        case 135: info = compressed(GLenumDXT3,        4, 4, 16); return true; // BC2_UNORM
+        case 136: info = compressed(GLenumSRGBDXT3,    4, 4, 16); return true; // BC2_SRGB
+        case 137: info = compressed(GLenumDXT5,        4, 4, 16); return true; // BC3_UNORM
+        case 138: info = compressed(GLenumSRGBDXT5,    4, 4, 16); return true; // BC3_SRGB
+        case 139: info = compressed(GLenumRGTC1,       4, 4,  8); return true; // BC4_UNORM
+        case 140: info = compressed(GLenumRGTC1S,      4, 4,  8); return true; // BC4_SNORM
+        case 141: info = compressed(GLenumRGTC2,       4, 4, 16); return true; // BC5_UNORM
+        case 142: info = compressed(GLenumRGTC2S,      4, 4, 16); return true; // BC5_SNORM
+        case 143: info = compressed(GLenumBPTCUF,      4, 4, 16); return true; // BC6H_UFLOAT
+        case 144: info = compressed(GLenumBPTCSF,      4, 4, 16); return true; // BC6H_SFLOAT
+        case 145: info = compressed(GLenumBPTC,        4, 4, 16); return true; // BC7_UNORM
+        case 146: info = compressed(GLenumSRGBBPTC,    4, 4, 16); return true; // BC7_SRGB
+        case 147: info = compressed(GLenumETC2,        4, 4,  8); return true; // ETC2_R8G8B8_UNORM
+        case 148: info = compressed(GLenumSRGBETC2,    4, 4,  8); return true; // ETC2_R8G8B8_SRGB
+        case 149: info = compressed(GLenumETC2A1,      4, 4,  8); return true; // ETC2_R8G8B8A1_UNORM
+        case 150: info = compressed(GLenumSRGBETC2A1,  4, 4,  8); return true; // ETC2_R8G8B8A1_SRGB
+        case 151: info = compressed(GLenumETC2EAC,     4, 4, 16); return true; // ETC2_R8G8B8A8_UNORM
+        case 152: info = compressed(GLenumSRGBETC2EAC, 4, 4, 16); return true; // ETC2_R8G8B8A8_SRGB
+        case 153: info = compressed(GLenumR11EAC,      4, 4,  8); return true; // EAC_R11_UNORM
+        case 154: info = compressed(GLenumR11EACS,     4, 4,  8); return true; // EAC_R11_SNORM
+        case 155: info = compressed(GLenumRG11EAC,     4, 4, 16); return true; // EAC_R11G11_UNORM
+        case 156: info = compressed(GLenumRG11EACS,    4, 4, 16); return true; // EAC_R11G11_SNORM
+
+        default:
+            break;
+    }
+
+    // ASTC (157..184, alternating UNORM and SRGB for each block size)
+    if (vkFormat >= 157 && vkFormat <= 184) {
+        unsigned int block = (vkFormat - 157) / 2;
+        bool         srgb  = ((vkFormat - 157) % 2) == 1;
+
+        info = compressed((srgb ? GLenumSRGBASTC : GLenumASTC) + block, astcBlocks[block][0], astcBlocks[block][1], 16);
+        return true;
+    }
+
+    // Unsupported format
+    return false;
+}
+
+bool dxgiFormatInfo(unsigned int dxgiFormat, FormatInfo & info)
+{
+    switch (dxgiFormat)
+    {
+        case  2: info = uncompressed(GLenumRGBA, GLenumFloat,      GLenumRGBA32F,    16); return true; // R32G32B32A32_FLOAT
+        case  6: info = uncompressed(GLenumRGB,  GLenumFloat,      GLenumRGB32F,     12); return true; // R32G32B32_FLOAT
+        case 10: info = uncompressed(GLenumRGBA, GLenumHalfFloat,  GLenumRGBA16F,     8); return true; // R16G16B16A16_FLOAT
+        case 11: info = uncompressed(GLenumRGBA, GLenumUShort,     GLenumRGBA16,      8); return true; // R16G16B16A16_UNORM
+        case 16: info = uncompressed(GLenumRG,   GLenumFloat,      GLenumRG32F,       8); return true; // R32G32_FLOAT
+        case 26: info = uncompressed(GLenumRGB,  GLenumUInt10F11F, GLenumR11G11B10F,  4); return true; // R11G11B10_FLOAT
+        case 28: info = uncompressed(GLenumRGBA, GLenumUByte,      GLenumRGBA8,       4); return true; // R8G8B8A8_UNORM
+        case 29: info = uncompressed(GLenumRGBA, GLenumUByte,      GLenumSRGB8A8,     4); return true; // R8G8B8A8_UNORM_SRGB
+        case 34: info = uncompressed(GLenumRG,   GLenumHalfFloat,  GLenumRG16F,       4); return true; // R16G16_FLOAT
+        case 35: info = uncompressed(GLenumRG,   GLenumUShort,     GLenumRG16,        4); return true; // R16G16_UNORM
+        case 41: info = uncompressed(GLenumRed,  GLenumFloat,      GLenumR32F,        4); return true; // R32_FLOAT
+        case 49: info = uncompressed(GLenumRG,   GLenumUByte,      GLenumRG8,         2); return true; // R8G8_UNORM
+        case 54: info = uncompressed(GLenumRed,  GLenumHalfFloat,  GLenumR16F,        2); return true; // R16_FLOAT
+        case 56: info = uncompressed(GLenumRed,  GLenumUShort,     GLenumR16,         2); return true; // R16_UNORM
+        case 61: info = uncompressed(GLenumRed,  GLenumUByte,      GLenumR8,          1); return true; // R8_UNORM
+        case 67: info = uncompressed(GLenumRGB,  GLenumUInt5999,   GLenumRGB9E5,      4); return true; // R9G9B9E5_SHAREDEXP
+        case 87: info = uncompressed(GLenumBGRA, GLenumUByte,      GLenumRGBA8,       4); return true; // B8G8R8A8_UNORM
+        case 91: info = uncompressed(GLenumBGRA, GLenumUByte,      GLenumSRGB8A8,     4); return true; // B8G8R8A8_UNORM_SRGB
+
+        case 71: info = compressed(GLenumDXT1A,     4, 4,  8); return true; // BC1_UNORM
+        case 72: info = compressed(GLenumSRGBDXT1A, 4, 4,  8); return true; // BC1_UNORM_SRGB
+        case 74: info = compressed(GLenumDXT3,      4, 4, 16); return true; // BC2_UNORM
+        case 75: info = compressed(GLenumSRGBDXT3,  4, 4, 16); return true; // BC2_UNORM_SRGB
+        case 77: info = compressed(GLenumDXT5,      4, 4, 16); return true; // BC3_UNORM
+        case 78: info = compressed(GLenumSRGBDXT5,  4, 4, 16); return true; // BC3_UNORM_SRGB
+        case 80: info = compressed(GLenumRGTC1,     4, 4,  8); return true; // BC4_UNORM
+        case 81: info = compressed(GLenumRGTC1S,    4, 4,  8); return true; // BC4_SNORM
+        case 83: info = compressed(GLenumRGTC2,     4, 4, 16); return true; // BC5_UNORM
+        case 84: info = compressed(GLenumRGTC2S,    4, 4, 16); return true; // BC5_SNORM
+        case 95: info = compressed(GLenumBPTCUF,    4, 4, 16); return true; // BC6H_UF16
+        case 96: info = compressed(GLenumBPTCSF,    4, 4, 16); return true; // BC6H_SF16
+        case 98: info = compressed(GLenumBPTC,      4, 4, 16); return true; // BC7_UNORM
+        case 99: info = compressed(GLenumSRGBBPTC,  4, 4, 16); return true; // BC7_UNORM_SRGB
+
+        default:
+            return false;
+    }
+}
+
+unsigned int fourCC(char a, char b, char c, char d)
+{
+    return static_cast<unsigned int>(static_cast<unsigned char>(a))
+        | (static_cast<unsigned int>(static_cast<unsigned char>(b)) << 8)
+        | (static_cast<unsigned int>(static_cast<unsigned char>(c)) << 16)
+        | (static_cast<unsigned int>(static_cast<unsigned char>(d)) << 24);
+}
+
+bool ddsPixelFormatInfo(const char * header, FormatInfo & info)
+{
+    // DDS_PIXELFORMAT
+    const unsigned int DDPF_FOURCC    = 0x4;
+    const unsigned int DDPF_RGB       = 0x40;
+    const unsigned int DDPF_LUMINANCE = 0x20000;
+
+    unsigned int flags = 0, code = 0, bits = 0, rMask = 0, gMask = 0, bMask = 0, aMask = 0;
+    std::memcpy(&flags, header + 80,  4);
+    std::memcpy(&code,  header + 84,  4);
+    std::memcpy(&bits,  header + 88,  4);
+    std::memcpy(&rMask, header + 92,  4);
+    std::memcpy(&gMask, header + 96,  4);
+    std::memcpy(&bMask, header + 100, 4);
+    std::memcpy(&aMask, header + 104, 4);
+
+    if (flags & DDPF_FOURCC) {
+        // Compressed formats
+        if (code == fourCC('D', 'X', 'T', '1')) { info = compressed(GLenumDXT1A, 4, 4,  8); return true; }
+        if (code == fourCC('D', 'X', 'T', '3')) { info = compressed(GLenumDXT3,  4, 4, 16); return true; }
+        if (code == fourCC('D', 'X', 'T', '5')) { info = compressed(GLenumDXT5,  4, 4, 16); return true; }
+        if (code == fourCC('A', 'T', 'I', '1') || code == fourCC('B', 'C', '4', 'U')) { info = compressed(GLenumRGTC1,  4, 4,  8); return true; }
+        if (code == fourCC('B', 'C', '4', 'S'))                                       { info = compressed(GLenumRGTC1S, 4, 4,  8); return true; }
+        if (code == fourCC('A', 'T', 'I', '2') || code == fourCC('B', 'C', '5', 'U')) { info = compressed(GLenumRGTC2,  4, 4, 16); return true; }
+        if (code == fourCC('B', 'C', '5', 'S'))                                       { info = compressed(GLenumRGTC2S, 4, 4, 16); return true; }
+
+        // Float formats (stored as D3DFORMAT values)
+        switch (code)
+        {
+            case  36: info = uncompressed(GLenumRGBA, GLenumUShort,    GLenumRGBA16,   8); return true; // A16B16G16R16
+            case 111: info = uncompressed(GLenumRed,  GLenumHalfFloat, GLenumR16F,     2); return true; // R16F
+            case 112: info = uncompressed(GLenumRG,   GLenumHalfFloat, GLenumRG16F,    4); return true; // G16R16F
+            case 113: info = uncompressed(GLenumRGBA, GLenumHalfFloat, GLenumRGBA16F,  8); return true; // A16B16G16R16F
+            case 114: info = uncompressed(GLenumRed,  GLenumFloat,     GLenumR32F,     4); return true; // R32F
+            case 115: info = uncompressed(GLenumRG,   GLenumFloat,     GLenumRG32F,    8); return true; // G32R32F
+            case 116: info = uncompressed(GLenumRGBA, GLenumFloat,     GLenumRGBA32F, 16); return true; // A32B32G32R32F
+            default: break;
+        }
+
+        return false;
+    }
+
+    if (flags & DDPF_RGB) {
+        if (bits == 32 && rMask == 0x000000ff && gMask == 0x0000ff00 && bMask == 0x00ff0000) {
+            info = uncompressed(GLenumRGBA, GLenumUByte, GLenumRGBA8, 4);
+            return true;
+        }
+
+        if (bits == 32 && rMask == 0x00ff0000 && gMask == 0x0000ff00 && bMask == 0x000000ff) {
+            info = uncompressed(GLenumBGRA, GLenumUByte, GLenumRGBA8, 4);
+            return true;
+        }
+
+        if (bits == 24 && rMask == 0x000000ff && gMask == 0x0000ff00 && bMask == 0x00ff0000) {
+            info = uncompressed(GLenumRGB, GLenumUByte, GLenumRGB8, 3);
+            return true;
+        }
+
+        if (bits == 24 && rMask == 0x00ff0000 && gMask == 0x0000ff00 && bMask == 0x000000ff) {
+            info = uncompressed(GLenumBGR, GLenumUByte, GLenumRGB8, 3);
+            return true;
+        }
+
+        return false;
+    }
+
+    if ((flags & DDPF_LUMINANCE) && bits == 8 && aMask == 0) {
+        info = uncompressed(GLenumRed, GLenumUByte, GLenumR8, 1);
+        return true;
+    }
+
+    return false;
+}
+
+unsigned long long levelSize(const FormatInfo & info, unsigned int width, unsigned int height, unsigned int depth)
+{
+    unsigned long long blocksX = (width  + info.blockWidth  - 1) / info.blockWidth;
+    unsigned long long blocksY = (height + info.blockHeight - 1) / info.blockHeight;
+
+    return blocksX * blocksY * depth * info.blockSize;
+}
+
+// Number of levels of a full mipmap chain
+unsigned int mipmapLevels(unsigned int width, unsigned int height, unsigned int depth)
+{
+    unsigned int extent = std::max(width, std::max(height, depth));
+    unsigned int levels = 1;
+
+    while (extent > 1) {
+        extent >>= 1;
+        levels++;
+    }
+
+    return levels;
+}
+
+unsigned int readUInt32(const char * data)
+{
+    unsigned int value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+unsigned long long readUInt64(const char * data)
+{
+    unsigned long long value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+const unsigned char ktx2Identifier[12] = {
+    0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+};
+
+bool isKtx2(const char * data, size_t size)
+{
+    return size >= 12 && std::memcmp(data, ktx2Identifier, 12) == 0;
+}
+
+bool isDds(const char * data, size_t size)
+{
+    return size >= 4 && std::memcmp(data, "DDS ", 4) == 0;
+}
+
+FileCache & imageCache()
+{
+    static FileCache cache;
+    return cache;
+}
+
+bool & imageCacheMipmaps()
+{
+    static bool mipmaps = false;
+    return mipmaps;
+}
+
+// Cached image file: header, region table, then image data (aligned to 16 bytes)
+const unsigned int  cacheVersion   = 1;
+const char        * cacheExtension = ".rcimage";
+
+struct CachedImageHeader
+{
+    char         magic[4];
+    unsigned int version;
+    unsigned int width;
+    unsigned int height;
+    unsigned int depth;
+    unsigned int format;
+    unsigned int type;
+    unsigned int internalFormat;
+    unsigned int size;
+    unsigned int levels;
+    unsigned int layers;
+    unsigned int faces;
+};
+
+size_t cachedDataOffset(size_t regions)
+{
+    size_t offset = sizeof(CachedImageHeader) + regions * 2 * sizeof(unsigned int);
+    return (offset + 15) & ~static_cast<size_t>(15);
+}
+
+
+} // namespace
+
+
 namespace rendercore
 {
 
 
+const std::string & ImageLoader::cacheDirectory()
+{
+    return imageCache().directory();
+}
+
+void ImageLoader::setCacheDirectory(const std::string & directory)
+{
+    imageCache().setDirectory(directory);
+}
+
+bool ImageLoader::cacheMipmaps()
+{
+    return imageCacheMipmaps();
+}
+
+void ImageLoader::setCacheMipmaps(bool mipmaps)
+{
+    imageCacheMipmaps() = mipmaps;
+}
+
 ImageLoader::ImageLoader()
 {
 }
@@ -30,11 +446,27 @@ std::unique_ptr<Image> ImageLoader::load(const std::string & filename) const
     // Check filename extension
     std::string ext = cppfs::FilePath(filename).extension();
     if (ext == ".png" || ext == ".jpg" || ext == ".bmp") {
+        // Load image file through the cache
+        if (imageCache().enabled()) {
+            MappedFile file;
+            if (!file.open(filename)) {
+                return nullptr;
+            }
+
+            return loadCachedImage(file.data(), file.size());
+        }
+
         // Load image file
         return loadCommonImage(filename);
     } else if (ext == ".glraw") {
         // Load glraw file (RAW file with extended header)
         return loadGLRawImage(filename);
+    } else if (ext == ".ktx2") {
+        // Load KTX2 texture container
+        return loadKtx2Image(filename);
+    } else if (ext == ".dds") {
+        // Load DDS texture container
+        return loadDdsImage(filename);
     } else {
         // Unsupported file
         return nullptr;
@@ -42,6 +474,25 @@ std::unique_ptr<Image> ImageLoader::load(const std::string & filename) const
 }
 
 std::unique_ptr<Image> ImageLoader::loadFromMemory(const char * buffer, size_t size) const
+{
+    // Texture containers reference their data, so keep a copy alive with the image
+    if (isKtx2(buffer, size) || isDds(buffer, size)) {
+        std::shared_ptr<char> copy(new char[size], std::default_delete<char[]>());
+        std::copy_n(buffer, size, copy.get());
+
+        return isKtx2(buffer, size) ? createKtx2Image(copy.get(), size, copy) : createDdsImage(copy.get(), size, copy);
+    }
+
+    // Load image through the cache
+    if (imageCache().enabled()) {
+        return loadCachedImage(buffer, size);
+    }
+
+    // Decode image
+    return decodeCommonImage(buffer, size);
+}
+
+std::unique_ptr<Image> ImageLoader::decodeCommonImage(const char * buffer, size_t size) const
 {
     // Create image
     auto image = cppassist::make_unique<Image>();
@@ -122,11 +573,318 @@ std::unique_ptr<Image> ImageLoader::loadGLRawImage(const std::string & filename)
 
         // Copy image data
         image->setData(width, height, depth, format, type, size, rawFile.data());
+        image->setInternalFormat(type);
+    }
+
+    // Return image
+    return std::move(image);
+}
+
+std::unique_ptr<Image> ImageLoader::loadKtx2Image(const std::string & filename) const
+{
+    // Map file into memory
+    auto file = std::make_shared<MappedFile>();
+    if (!file->open(filename)) {
+        return nullptr;
+    }
+
+    // Create image that references the mapped data
+    return createKtx2Image(file->data(), file->size(), file);
+}
+
+std::unique_ptr<Image> ImageLoader::loadDdsImage(const std::string & filename) const
+{
+    // Map file into memory
+    auto file = std::make_shared<MappedFile>();
+    if (!file->open(filename)) {
+        return nullptr;
+    }
+
+    // Create image that references the mapped data
+    return createDdsImage(file->data(), file->size(), file);
+}
+
+std::unique_ptr<Image> ImageLoader::createKtx2Image(char * data, size_t size, std::shared_ptr<void> owner) const
+{
+    // Check header (identifier, 9 header fields, index)
+    if (!isKtx2(data, size) || size < 80) {
+        cppassist::warning() << "Invalid KTX2 file.";
+        return nullptr;
+    }
+
+    // Read header
+    unsigned int vkFormat       = readUInt32(data + 12);
+    unsigned int width          = readUInt32(data + 20);
+    unsigned int height         = readUInt32(data + 24);
+    unsigned int depth          = readUInt32(data + 28);
+    unsigned int layers         = readUInt32(data + 32);
+    unsigned int faces          = readUInt32(data + 36);
+    unsigned int levels         = readUInt32(data + 40);
+    unsigned int supercompression = readUInt32(data + 44);
+
+    // Supercompressed data would have to be decoded first
+    if (supercompression != 0) {
+        cppassist::warning() << "KTX2 supercompression scheme " << supercompression << " is not supported.";
+        return nullptr;
+    }
+
+    // Get texture format
+    FormatInfo info;
+    if (!vkFormatInfo(vkFormat, info)) {
+        cppassist::warning() << "KTX2 format " << vkFormat << " is not supported.";
+        return nullptr;
+    }
+
+    // Zero values denote dimensions that are not used
+    width  = std::max(width,  1u);
+    height = std::max(height, 1u);
+    depth  = std::max(depth,  1u);
+    layers = std::max(layers, 1u);
+    faces  = std::max(faces,  1u);
+    levels = std::max(levels, 1u);
+
+    // Check level index
+    if (levels > mipmapLevels(width, height, depth) || 80 + 24 * static_cast<unsigned long long>(levels) > size || (faces != 1 && faces != 6) || layers > 0xffffffffu / faces) {
+        cppassist::warning() << "Invalid KTX2 file.";
+        return nullptr;
+    }
+
+    // Find data range covered by the levels
+    unsigned long long begin = size;
+    unsigned long long end   = 0;
+    for (unsigned int level = 0; level < levels; level++) {
+        unsigned long long offset = readUInt64(data + 80 + 24 * level);
+        unsigned long long length = readUInt64(data + 80 + 24 * level + 8);
+
+        if (offset > size || length > size - offset) {
+            cppassist::warning() << "Invalid KTX2 level index.";
+            return nullptr;
+        }
+
+        begin = std::min(begin, offset);
+        end   = std::max(end,   offset + length);
+    }
+
+    if (begin >= end || end - begin > 0xffffffffull) {
+        cppassist::warning() << "Invalid KTX2 level index.";
+        return nullptr;
+    }
+
+    // Create image that references the level data
+    auto image = cppassist::make_unique<Image>();
+    image->setExternalData(width, height, depth, info.format, info.type, static_cast<unsigned int>(end - begin), data + begin, owner);
+    image->setInternalFormat(info.internalFormat);
+    image->setLayout(levels, layers, faces);
+
+    // Each level contains all layers and faces in order
+    unsigned int slices = layers * faces;
+    for (unsigned int level = 0; level < levels; level++) {
+        unsigned long long offset     = readUInt64(data + 80 + 24 * level) - begin;
+        unsigned long long length     = readUInt64(data + 80 + 24 * level + 8);
+        unsigned long long sliceSize  = length / slices;
+
+        for (unsigned int slice = 0; slice < slices; slice++) {
+            image->setRegion(level, slice, static_cast<unsigned int>(offset + slice * sliceSize), static_cast<unsigned int>(sliceSize));
+        }
     }
 
     // Return image
     return std::move(image);
 }
 
+std::unique_ptr<Image> ImageLoader::createDdsImage(char * data, size_t size, std::shared_ptr<void> owner) const
+{
+    // Flags in DDS_HEADER
+    const unsigned int DDSD_MIPMAPCOUNT          = 0x20000;
+    const unsigned int DDSCAPS2_CUBEMAP          = 0x200;
+    const unsigned int DDSCAPS2_VOLUME           = 0x200000;
+    const unsigned int DDS_RESOURCE_MISC_CUBE    = 0x4;
+    const unsigned int DDS_DIMENSION_TEXTURE3D   = 4;
+
+    // Check header (magic number and DDS_HEADER)
+    if (!isDds(data, size) || size < 128 || readUInt32(data + 4) != 124) {
+        cppassist::warning() << "Invalid DDS file.";
+        return nullptr;
+    }
+
+    // Read header
+    unsigned int height = std::max(readUInt32(data + 12), 1u);
+    unsigned int width  = std::max(readUInt32(data + 16), 1u);
+    unsigned int depth  = 1;
+    unsigned int levels = (readUInt32(data + 8) & DDSD_MIPMAPCOUNT) ? std::max(readUInt32(data + 28), 1u) : 1;
+    unsigned int caps2  = readUInt32(data + 112);
+    unsigned int layers = 1;
+    unsigned int faces  = (caps2 & DDSCAPS2_CUBEMAP) ? 6 : 1;
+    size_t       offset = 128;
+
+    if (caps2 & DDSCAPS2_VOLUME) {
+        depth = std::max(readUInt32(data + 24), 1u);
+    }
+
+    // Get texture format
+    FormatInfo info;
+    if (readUInt32(data + 84) == fourCC('D', 'X', '1', '0')) {
+        // Extended header (DDS_HEADER_DXT10)
+        if (size < 148) {
+            cppassist::warning() << "Invalid DDS file.";
+            return nullptr;
+        }
+
+        unsigned int dxgiFormat = readUInt32(data + 128);
+        unsigned int dimension  = readUInt32(data + 132);
+        unsigned int miscFlag   = readUInt32(data + 136);
+        layers = std::max(readUInt32(data + 140), 1u);
+        faces  = (miscFlag & DDS_RESOURCE_MISC_CUBE) ? 6 : 1;
+        offset = 148;
+
+        if (dimension == DDS_DIMENSION_TEXTURE3D) {
+            depth = std::max(readUInt32(data + 24), 1u);
+        }
+
+        if (!dxgiFormatInfo(dxgiFormat, info)) {
+            cppassist::warning() << "DDS format " << dxgiFormat << " is not supported.";
+            return nullptr;
+        }
+    } else if (!ddsPixelFormatInfo(data, info)) {
+        cppassist::warning() << "DDS pixel format is not supported.";
+        return nullptr;
+    }
+
+    // Check number of levels
+    if (levels > mipmapLevels(width, height, depth)) {
+        cppassist::warning() << "Invalid DDS mipmap count.";
+        return nullptr;
+    }
+
+    // Calculate size of data (each layer and face contains its full mipmap chain)
+    unsigned long long slices = static_cast<unsigned long long>(layers) * faces;
+    unsigned long long sliceSize = 0;
+    for (unsigned int level = 0; level < levels; level++) {
+        sliceSize += levelSize(info, std::max(width >> level, 1u), std::max(height >> level, 1u), std::max(depth >> level, 1u));
+    }
+
+    if (slices > 0xffffffffull || sliceSize > size - offset) {
+        cppassist::warning() << "DDS file is truncated.";
+        return nullptr;
+    }
+
+    unsigned long long dataSize = sliceSize * slices;
+    if (dataSize > size - offset || dataSize > 0xffffffffull) {
+        cppassist::warning() << "DDS file is truncated.";
+        return nullptr;
+    }
+
+    // Create image that references the image data
+    auto image = cppassist::make_unique<Image>();
+    image->setExternalData(width, height, depth, info.format, info.type, static_cast<unsigned int>(dataSize), data + offset, owner);
+    image->setInternalFormat(info.internalFormat);
+    image->setLayout(levels, layers, faces);
+
+    unsigned long long position = 0;
+    for (unsigned int slice = 0; slice < slices; slice++) {
+        for (unsigned int level = 0; level < levels; level++) {
+            unsigned long long length = levelSize(info, std::max(width >> level, 1u), std::max(height >> level, 1u), std::max(depth >> level, 1u));
+            image->setRegion(level, slice, static_cast<unsigned int>(position), static_cast<unsigned int>(length));
+            position += length;
+        }
+    }
+
+    // Return image
+    return std::move(image);
+}
+
+std::unique_ptr<Image> ImageLoader::loadCachedImage(const char * data, size_t size) const
+{
+    // Hash source data, taking options that change the result into account
+    const bool mipmaps = imageCacheMipmaps();
+    const unsigned long long key = FileCache::hash(data, size, mipmaps ? 1 : 0);
+
+    // Try to load image from cache
+    if (auto file = imageCache().load(key, cacheExtension)) {
+        CachedImageHeader header = CachedImageHeader();
+        if (file->size() >= sizeof(header)) {
+            std::memcpy(&header, file->data(), sizeof(header));
+        }
+
+        // Check header and size of the region table (computed in 64 bit to detect overflows)
+        const unsigned long long regions = static_cast<unsigned long long>(header.levels) * header.layers * header.faces;
+        bool valid = std::memcmp(header.magic, "RCIM", 4) == 0 && header.version == cacheVersion && regions > 0 &&
+                     regions <= (file->size() - sizeof(header)) / 8 &&
+                     file->size() >= cachedDataOffset(static_cast<size_t>(regions)) + header.size;
+
+        // Check that all regions lie within the image data
+        const char * table = file->data() + sizeof(header);
+        for (unsigned long long i = 0; valid && i < regions; i++) {
+            unsigned long long offset = readUInt32(table + i * 8);
+            unsigned long long length = readUInt32(table + i * 8 + 4);
+            valid = (offset + length <= header.size);
+        }
+
+        // Otherwise, the cache entry is ignored and the image is decoded again
+        if (valid) {
+            // Create image that references the mapped file
+            auto image = cppassist::make_unique<Image>();
+            image->setExternalData(header.width, header.height, header.depth, header.format, header.type, header.size, file->data() + cachedDataOffset(static_cast<size_t>(regions)), file);
+            image->setInternalFormat(header.internalFormat);
+            image->setLayout(header.levels, header.layers, header.faces);
+
+            for (unsigned int i = 0; i < regions; i++) {
+                image->setRegion(i / (header.layers * header.faces), i % (header.layers * header.faces), readUInt32(table + i * 8), readUInt32(table + i * 8 + 4));
+            }
+
+            return std::move(image);
+        }
+    }
+
+    // Decode image
+    auto image = decodeCommonImage(data, size);
+    if (!image || image->empty()) {
+        return image;
+    }
+
+    if (mipmaps) {
+        image->generateMipmaps();
+    }
+
+    // Serialize image
+    const unsigned int slices  = image->layers() * image->faces();
+    const unsigned int regions = image->levels() * slices;
+
+    CachedImageHeader header;
+    std::memcpy(header.magic, "RCIM", 4);
+    header.version        = cacheVersion;
+    header.width          = image->width();
+    header.height         = image->height();
+    header.depth          = image->depth();
+    header.format         = image->format();
+    header.type           = image->dataType();
+    header.internalFormat = image->internalFormat();
+    header.size           = image->size();
+    header.levels         = image->levels();
+    header.layers         = image->layers();
+    header.faces          = image->faces();
+
+    std::vector<char> blob(cachedDataOffset(regions) + image->size(), 0);
+    std::memcpy(blob.data(), &header, sizeof(header));
+
+    for (unsigned int i = 0; i < regions; i++) {
+        const unsigned int level  = i / slices;
+        const unsigned int slice  = i % slices;
+        const unsigned int offset = static_cast<unsigned int>(image->data(level, slice) - image->data());
+        const unsigned int length = image->size(level, slice);
+
+        std::memcpy(blob.data() + sizeof(header) + i * 8,     &offset, 4);
+        std::memcpy(blob.data() + sizeof(header) + i * 8 + 4, &length, 4);
+    }
+
+    std::copy_n(image->data(), image->size(), blob.data() + cachedDataOffset(regions));
+
+    // Store image in cache
+    imageCache().store(key, cacheExtension, blob.data(), blob.size());
+
+    // Return image
+    return image;
+}
+
 
 } // namespace rendercore
@@ -0,0 +1,142 @@
+
+#include <rendercore/MappedFile.h>
+
+#ifdef SYSTEM_WINDOWS
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+
+namespace rendercore
+{
+
+
+MappedFile::MappedFile()
+: m_data(nullptr)
+, m_size(0)
+, m_handle(nullptr)
+, m_mapping(nullptr)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::open(const std::string & filename)
+{
+    // Release previous mapping
+    close();
+
+#ifdef SYSTEM_WINDOWS
+    // Open file
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    // Get file size
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    // Create copy-on-write mapping
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void * data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    if (!data) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_handle  = file;
+    m_mapping = mapping;
+    m_data    = static_cast<char *>(data);
+    m_size    = static_cast<size_t>(size.QuadPart);
+#else
+    // Open file
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    // Get file size
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+
+    // Create copy-on-write mapping
+    void * data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+
+    // The file descriptor is not needed once the mapping exists
+    ::close(fd);
+
+    if (data == MAP_FAILED) {
+        return false;
+    }
+
+    m_data = static_cast<char *>(data);
+    m_size = static_cast<size_t>(info.st_size);
+#endif
+
+    // Done
+    return true;
+}
+
+void MappedFile::close()
+{
+    // Check if a file is mapped
+    if (!m_data) {
+        return;
+    }
+
+#ifdef SYSTEM_WINDOWS
+    UnmapViewOfFile(m_data);
+    CloseHandle(static_cast<HANDLE>(m_mapping));
+    CloseHandle(static_cast<HANDLE>(m_handle));
+#else
+    munmap(m_data, m_size);
+#endif
+
+    m_data    = nullptr;
+    m_size    = 0;
+    m_handle  = nullptr;
+    m_mapping = nullptr;
+}
+
+bool MappedFile::isOpen() const
+{
+    return m_data != nullptr;
+}
+
+size_t MappedFile::size() const
+{
+    return m_size;
+}
+
+const char * MappedFile::data() const
+{
+    return m_data;
+}
+
+char * MappedFile::data()
+{
+    return m_data;
+}
+
+
+} // namespace rendercore
@@ -0,0 +1,363 @@
+
+#include <rendercore/MeshSimplifier.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+
+#include <glm/glm.hpp>
+
+
+namespace
+{
+
+
+// Quadric (symmetric 4x4 matrix of the summed plane equations) and the summed weight of its planes
+struct Quadric
+{
+    double a2, b2, c2, ab, ac, bc, ad, bd, cd, d2;
+    double weight;
+};
+
+// Add plane to quadric
+void addPlane(Quadric & q, const glm::vec3 & normal, float distance, float weight)
+{
+    const double a = normal.x, b = normal.y, c = normal.z, d = distance, w = weight;
+
+    q.a2 += w * a * a; q.b2 += w * b * b; q.c2 += w * c * c;
+    q.ab += w * a * b; q.ac += w * a * c; q.bc += w * b * c;
+    q.ad += w * a * d; q.bd += w * b * d; q.cd += w * c * d;
+    q.d2 += w * d * d;
+    q.weight += w;
+}
+
+// Add quadric to another
+void addQuadric(Quadric & q, const Quadric & other)
+{
+    q.a2 += other.a2; q.b2 += other.b2; q.c2 += other.c2;
+    q.ab += other.ab; q.ac += other.ac; q.bc += other.bc;
+    q.ad += other.ad; q.bd += other.bd; q.cd += other.cd;
+    q.d2 += other.d2;
+    q.weight += other.weight;
+}
+
+// Evaluate mean squared distance of a point to the planes of the quadrics
+double evaluate(const Quadric & q0, const Quadric & q1, const glm::vec3 & p)
+{
+    const double x = p.x, y = p.y, z = p.z;
+
+    const double a2 = q0.a2 + q1.a2, b2 = q0.b2 + q1.b2, c2 = q0.c2 + q1.c2;
+    const double ab = q0.ab + q1.ab, ac = q0.ac + q1.ac, bc = q0.bc + q1.bc;
+    const double ad = q0.ad + q1.ad, bd = q0.bd + q1.bd, cd = q0.cd + q1.cd;
+    const double d2 = q0.d2 + q1.d2;
+    const double w  = q0.weight + q1.weight;
+
+    double error = x * x * a2 + y * y * b2 + z * z * c2
+                 + 2.0 * (x * y * ab + x * z * ac + y * z * bc)
+                 + 2.0 * (x * ad + y * bd + z * cd)
+                 + d2;
+
+    return w > 0.0 ? std::max(0.0, error / w) : 0.0;
+}
+
+// Key of an undirected edge
+unsigned long long edgeKey(unsigned int a, unsigned int b)
+{
+    if (a > b) std::swap(a, b);
+    return (static_cast<unsigned long long>(a) << 32) | b;
+}
+
+// Hash of a position
+struct PositionHash
+{
+    size_t operator()(const glm::vec3 & p) const
+    {
+        unsigned int bits[3];
+        std::memcpy(bits, &p, sizeof(bits));
+        return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+    }
+};
+
+// Bitwise comparison of positions
+struct PositionEqual
+{
+    bool operator()(const glm::vec3 & a, const glm::vec3 & b) const
+    {
+        return a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+};
+
+// Edge collapse
+struct Collapse
+{
+    unsigned int from;
+    unsigned int to;
+    double       error;
+};
+
+
+} // namespace
+
+
+namespace rendercore
+{
+
+
+float MeshSimplifier::simplify(std::vector<unsigned int> & indices, const char * positions, unsigned int stride, unsigned int vertexCount, unsigned int targetIndexCount, float maxError)
+{
+    // Read positions
+    std::vector<glm::vec3> points(vertexCount);
+    for (unsigned int i=0; i<vertexCount; i++) {
+        float value[3];
+        std::memcpy(value, positions + static_cast<size_t>(i) * stride, sizeof(value));
+        points[i] = glm::vec3(value[0], value[1], value[2]);
+    }
+
+    // Find vertices with equal positions, which are treated as a single vertex for topology and error
+    std::vector<unsigned int>  canonical(vertexCount);
+    std::vector<unsigned int>  nextCopy(vertexCount);
+    std::vector<unsigned char> locked(vertexCount, 0);
+    {
+        std::unordered_map<glm::vec3, unsigned int, PositionHash, PositionEqual> firstVertex;
+        firstVertex.reserve(vertexCount);
+
+        for (unsigned int i=0; i<vertexCount; i++) {
+            auto it = firstVertex.insert(std::make_pair(points[i], i));
+            canonical[i] = it.first->second;
+
+            // Link copies of a position (vertices on attribute seams) in a circular list
+            nextCopy[i] = nextCopy[canonical[i]];
+            nextCopy[canonical[i]] = i;
+        }
+    }
+
+    // Lock vertices on borders and non-manifold edges
+    {
+        std::unordered_map<unsigned long long, unsigned int> edgeUse;
+        edgeUse.reserve(indices.size());
+
+        for (size_t t=0; t+2<indices.size(); t+=3) {
+            for (unsigned int e=0; e<3; e++) {
+                edgeUse[edgeKey(canonical[indices[t + e]], canonical[indices[t + (e + 1) % 3]])]++;
+            }
+        }
+
+        for (auto & it : edgeUse) {
+            if (it.second != 2) {
+                locked[static_cast<unsigned int>(it.first >> 32)]        = 1;
+                locked[static_cast<unsigned int>(it.first & 0xFFFFFFFF)] = 1;
+            }
+        }
+
+        for (unsigned int i=0; i<vertexCount; i++) {
+            if (locked[canonical[i]]) locked[i] = 1;
+        }
+    }
+
+    // Accumulate area-weighted plane of each triangle in its vertices
+    std::vector<Quadric> quadrics(vertexCount, Quadric());
+    for (size_t t=0; t+2<indices.size(); t+=3) {
+        const glm::vec3 & p0 = points[indices[t + 0]];
+        const glm::vec3 & p1 = points[indices[t + 1]];
+        const glm::vec3 & p2 = points[indices[t + 2]];
+
+        glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+        float     area   = glm::length(normal);
+        if (area <= 0.0f) continue;
+
+        normal /= area;
+        float distance = -glm::dot(normal, p0);
+
+        for (unsigned int v=0; v<3; v++) {
+            addPlane(quadrics[canonical[indices[t + v]]], normal, distance, area);
+        }
+    }
+
+    // Collapse edges in passes of independent collapses
+    const double maxSquaredError = static_cast<double>(maxError) * maxError;
+    double       resultError     = 0.0;
+
+    std::vector<unsigned int>  remap(vertexCount);
+    std::vector<unsigned char> touched(vertexCount);
+    std::vector<unsigned int>  offsets(vertexCount + 1);
+    std::vector<unsigned int>  adjacency;
+    std::vector<Collapse>      collapses;
+
+    std::vector<std::pair<unsigned int, unsigned int>> moves;
+
+    while (indices.size() > targetIndexCount) {
+        const size_t triangles = indices.size() / 3;
+
+        // Build vertex-triangle adjacency
+        std::fill(offsets.begin(), offsets.end(), 0);
+        for (unsigned int index : indices) {
+            offsets[index + 1]++;
+        }
+
+        for (unsigned int i=0; i<vertexCount; i++) {
+            offsets[i + 1] += offsets[i];
+        }
+
+        adjacency.resize(triangles * 3);
+        std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t i=0; i<triangles * 3; i++) {
+            adjacency[fill[indices[i]]++] = static_cast<unsigned int>(i / 3);
+        }
+
+        // Rate all collapses of unlocked vertices onto their neighbours
+        collapses.clear();
+        for (size_t t=0; t<triangles; t++) {
+            for (unsigned int e=0; e<3; e++) {
+                unsigned int from = indices[t * 3 + e];
+                unsigned int to   = indices[t * 3 + (e + 1) % 3];
+
+                for (unsigned int dir=0; dir<2; dir++) {
+                    if (!locked[from] && canonical[from] != canonical[to]) {
+                        Collapse collapse;
+                        collapse.from  = from;
+                        collapse.to    = to;
+                        collapse.error = evaluate(quadrics[canonical[from]], quadrics[canonical[to]], points[to]);
+
+                        if (collapse.error <= maxSquaredError) {
+                            collapses.push_back(collapse);
+                        }
+                    }
+
+                    std::swap(from, to);
+                }
+            }
+        }
+
+        std::sort(collapses.begin(), collapses.end(), [] (const Collapse & a, const Collapse & b) {
+            return a.error < b.error;
+        });
+
+        // Apply cheapest collapses that do not affect each other
+        for (unsigned int i=0; i<vertexCount; i++) {
+            remap[i] = i;
+        }
+
+        std::fill(touched.begin(), touched.end(), 0);
+
+        const size_t targetTriangles = targetIndexCount / 3;
+        size_t       removed         = 0;
+        unsigned int applied         = 0;
+
+        for (const auto & collapse : collapses) {
+            if (triangles - removed <= targetTriangles) {
+                break;
+            }
+
+            // All copies of the moved vertex must collapse in the same direction, each onto
+            // a copy of the target that it shares an edge with, so that seams stay closed
+            bool valid = true;
+            moves.clear();
+
+            unsigned int copy = collapse.from;
+            do {
+                unsigned int target = (copy == collapse.from) ? collapse.to : ~0u;
+
+                for (unsigned int i=offsets[copy]; i<offsets[copy + 1] && target == ~0u; i++) {
+                    for (unsigned int v=0; v<3; v++) {
+                        unsigned int index = indices[adjacency[i] * 3 + v];
+                        if (canonical[index] == canonical[collapse.to]) target = index;
+                    }
+                }
+
+                // Unreferenced copies are ignored
+                if (target != ~0u) {
+                    valid = !touched[copy] && !touched[target];
+                    moves.push_back(std::make_pair(copy, target));
+                } else {
+                    valid = (offsets[copy] == offsets[copy + 1]);
+                }
+
+                copy = nextCopy[copy];
+            } while (copy != collapse.from && valid);
+
+            if (!valid) {
+                continue;
+            }
+
+            // Reject collapses that would flip or strongly rotate a triangle around the moved vertex
+            bool flipped = false;
+            size_t collapsed = 0;
+
+            for (size_t m=0; m<moves.size() && !flipped; m++) {
+                const unsigned int from = moves[m].first;
+
+                for (unsigned int i=offsets[from]; i<offsets[from + 1] && !flipped; i++) {
+                    const unsigned int * triangle = &indices[adjacency[i] * 3];
+
+                    if (canonical[triangle[0]] == canonical[collapse.to] || canonical[triangle[1]] == canonical[collapse.to] || canonical[triangle[2]] == canonical[collapse.to]) {
+                        collapsed++;
+                        continue;
+                    }
+
+                    glm::vec3 p[3], q[3];
+                    for (unsigned int v=0; v<3; v++) {
+                        p[v] = points[triangle[v]];
+                        q[v] = (triangle[v] == from) ? points[collapse.to] : p[v];
+                    }
+
+                    glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+                    glm::vec3 after  = glm::cross(q[1] - q[0], q[2] - q[0]);
+                    flipped = glm::dot(before, after) <= 0.25f * glm::length(before) * glm::length(after);
+                }
+            }
+
+            if (flipped) {
+                continue;
+            }
+
+            // Collapse edge
+            for (const auto & move : moves) {
+                remap[move.first] = move.second;
+            }
+
+            addQuadric(quadrics[canonical[collapse.to]], quadrics[canonical[collapse.from]]);
+            resultError = std::max(resultError, collapse.error);
+
+            // Vertices of the affected triangles must not be moved again in this pass
+            for (const auto & move : moves) {
+                for (unsigned int i=offsets[move.first]; i<offsets[move.first + 1]; i++) {
+                    for (unsigned int v=0; v<3; v++) {
+                        touched[indices[adjacency[i] * 3 + v]] = 1;
+                    }
+                }
+            }
+
+            removed += collapsed;
+            applied++;
+        }
+
+        if (applied == 0) {
+            break;
+        }
+
+        // Rewrite triangles and remove degenerate ones
+        size_t write = 0;
+        for (size_t t=0; t<triangles; t++) {
+            unsigned int a = remap[indices[t * 3 + 0]];
+            unsigned int b = remap[indices[t * 3 + 1]];
+            unsigned int c = remap[indices[t * 3 + 2]];
+
+            if (canonical[a] == canonical[b] || canonical[b] == canonical[c] || canonical[a] == canonical[c]) {
+                continue;
+            }
+
+            indices[write++] = a;
+            indices[write++] = b;
+            indices[write++] = c;
+        }
+
+        indices.resize(write);
+    }
+
+    return static_cast<float>(std::sqrt(resultError));
+}
+
+
+} // namespace rendercore
@@ -0,0 +1,245 @@
+
+#include <rendercore/MeshletBuilder.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+namespace
+{
+
+
+// Read vertex position
+glm::vec3 readPosition(const char * positions, unsigned int stride, unsigned int index)
+{
+    float value[3];
+    std::memcpy(value, positions + static_cast<size_t>(index) * stride, sizeof(value));
+    return glm::vec3(value[0], value[1], value[2]);
+}
+
+// Calculate bounding sphere and normal cone of a meshlet
+void computeBounds(rendercore::MeshletBuilder::Meshlet & meshlet, const std::vector<unsigned int> & indices, const char * positions, unsigned int stride)
+{
+    const unsigned int begin = meshlet.offset;
+    const unsigned int end   = meshlet.offset + meshlet.count;
+
+    // Bounding sphere around the center of the bounding box
+    glm::vec3 minValue = readPosition(positions, stride, indices[begin]);
+    glm::vec3 maxValue = minValue;
+
+    for (unsigned int i=begin; i<end; i++) {
+        glm::vec3 p = readPosition(positions, stride, indices[i]);
+        minValue = glm::min(minValue, p);
+        maxValue = glm::max(maxValue, p);
+    }
+
+    glm::vec3 center = (minValue + maxValue) * 0.5f;
+    float     radius = 0.0f;
+
+    for (unsigned int i=begin; i<end; i++) {
+        radius = std::max(radius, glm::length(readPosition(positions, stride, indices[i]) - center));
+    }
+
+    meshlet.boundingSphere = glm::vec4(center, radius);
+
+    // Average normal of the triangles
+    std::vector<glm::vec3> normals;
+    normals.reserve(meshlet.count / 3);
+
+    glm::vec3 axis(0.0f);
+    for (unsigned int i=begin; i+2<end; i+=3) {
+        glm::vec3 p0 = readPosition(positions, stride, indices[i + 0]);
+        glm::vec3 p1 = readPosition(positions, stride, indices[i + 1]);
+        glm::vec3 p2 = readPosition(positions, stride, indices[i + 2]);
+
+        glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+        float     length = glm::length(normal);
+        if (length <= 0.0f) continue;
+
+        normals.push_back(normal / length);
+        axis += normals.back();
+    }
+
+    // Without a common direction, the meshlet can not be backface culled
+    meshlet.cone = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+
+    float axisLength = glm::length(axis);
+    if (normals.empty() || axisLength <= 0.0f) {
+        return;
+    }
+
+    axis /= axisLength;
+
+    // Get largest angle between a normal and the axis
+    float minDot = 1.0f;
+    for (const auto & normal : normals) {
+        minDot = std::min(minDot, glm::dot(normal, axis));
+    }
+
+    // The cutoff is the sine of that angle, cones wider than about 85 degrees are not worth testing
+    if (minDot > 0.1f) {
+        meshlet.cone = glm::vec4(axis, std::sqrt(1.0f - minDot * minDot));
+    } else {
+        meshlet.cone = glm::vec4(axis, 1.0f);
+    }
+}
+
+
+} // namespace
+
+
+namespace rendercore
+{
+
+
+std::vector<MeshletBuilder::Meshlet> MeshletBuilder::build(std::vector<unsigned int> & indices, const char * positions, unsigned int stride, unsigned int vertexCount, unsigned int maxVertices, unsigned int maxTriangles)
+{
+    const unsigned int triangles = static_cast<unsigned int>(indices.size() / 3);
+    const unsigned int none      = ~0u;
+
+    std::vector<Meshlet> meshlets;
+
+    // Build vertex-triangle adjacency
+    std::vector<unsigned int> offsets(vertexCount + 1, 0);
+    for (unsigned int i=0; i<triangles * 3; i++) {
+        offsets[indices[i] + 1]++;
+    }
+
+    for (unsigned int i=0; i<vertexCount; i++) {
+        offsets[i + 1] += offsets[i];
+    }
+
+    std::vector<unsigned int> adjacency(triangles * 3);
+    std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+    for (unsigned int i=0; i<triangles * 3; i++) {
+        adjacency[fill[indices[i]]++] = i / 3;
+    }
+
+    // State of the current meshlet
+    std::vector<unsigned int>  vertexMeshlet(vertexCount, none);
+    std::vector<unsigned int>  meshletVertices;
+    std::vector<unsigned char> emitted(triangles, 0);
+    std::vector<unsigned int>  result;
+    result.reserve(triangles * 3);
+
+    unsigned int numTriangles = 0;
+    unsigned int last         = none;
+    unsigned int cursor       = 0;
+
+    // Each meshlet must hold at least one triangle
+    maxVertices  = std::max(maxVertices, 3u);
+    maxTriangles = std::max(maxTriangles, 1u);
+
+    meshletVertices.reserve(maxVertices);
+
+    // Helper function: Count vertices of a triangle that are not yet part of the current meshlet
+    auto newVertices = [&] (unsigned int triangle) -> unsigned int {
+        const unsigned int id = static_cast<unsigned int>(meshlets.size());
+        unsigned int count = 0;
+
+        for (unsigned int v=0; v<3; v++) {
+            if (vertexMeshlet[indices[triangle * 3 + v]] != id) count++;
+        }
+
+        return count;
+    };
+
+    // Helper function: Get best unused triangle adjacent to the given vertices
+    auto bestAdjacent = [&] (const unsigned int * vertices, size_t count, unsigned int & best, unsigned int & bestNew) {
+        for (size_t i=0; i<count; i++) {
+            unsigned int vertex = vertices[i];
+
+            for (unsigned int j=offsets[vertex]; j<offsets[vertex + 1]; j++) {
+                unsigned int triangle = adjacency[j];
+                if (emitted[triangle]) continue;
+
+                unsigned int added = newVertices(triangle);
+                if (added < bestNew) {
+                    best    = triangle;
+                    bestNew = added;
+                }
+            }
+        }
+    };
+
+    // Helper function: Finish current meshlet
+    auto finish = [&] () {
+        if (numTriangles == 0) return;
+
+        Meshlet meshlet;
+        meshlet.offset = static_cast<unsigned int>(result.size()) - numTriangles * 3;
+        meshlet.count  = numTriangles * 3;
+        computeBounds(meshlet, result, positions, stride);
+        meshlets.push_back(meshlet);
+
+        meshletVertices.clear();
+        numTriangles = 0;
+    };
+
+    for (unsigned int emittedCount=0; emittedCount<triangles; ) {
+        // Prefer neighbours of the last triangle, then of the whole meshlet
+        unsigned int best    = none;
+        unsigned int bestNew = 4;
+
+        if (last != none) {
+            bestAdjacent(&indices[last * 3], 3, best, bestNew);
+        }
+
+        if (best == none && !meshletVertices.empty()) {
+            bestAdjacent(meshletVertices.data(), meshletVertices.size(), best, bestNew);
+        }
+
+        // Continue with the next triangle in input order
+        if (best == none) {
+            while (emitted[cursor]) cursor++;
+
+            best    = cursor;
+            bestNew = newVertices(best);
+        }
+
+        // Start new meshlet if the triangle does not fit
+        if (numTriangles + 1 > maxTriangles || meshletVertices.size() + bestNew > maxVertices) {
+            finish();
+            continue;
+        }
+
+        // Add triangle to meshlet
+        const unsigned int id = static_cast<unsigned int>(meshlets.size());
+        for (unsigned int v=0; v<3; v++) {
+            unsigned int vertex = indices[best * 3 + v];
+            if (vertexMeshlet[vertex] != id) {
+                vertexMeshlet[vertex] = id;
+                meshletVertices.push_back(vertex);
+            }
+
+            result.push_back(vertex);
+        }
+
+        emitted[best] = 1;
+        last = best;
+        numTriangles++;
+        emittedCount++;
+    }
+
+    finish();
+
+    // Keep trailing indices that do not form a complete triangle
+    result.insert(result.end(), indices.begin() + triangles * 3, indices.end());
+
+    indices.swap(result);
+
+    return meshlets;
+}
+
+bool MeshletBuilder::isBackFacing(const Meshlet & meshlet, const glm::vec3 & cameraPosition)
+{
+    glm::vec3 center(meshlet.boundingSphere.x, meshlet.boundingSphere.y, meshlet.boundingSphere.z);
+    glm::vec3 axis(meshlet.cone.x, meshlet.cone.y, meshlet.cone.z);
+    glm::vec3 view = center - cameraPosition;
+
+    return glm::dot(view, axis) >= meshlet.cone.w * glm::length(view) + meshlet.boundingSphere.w;
+}
+
+
+} // namespace rendercore
@@ -0,0 +1,538 @@
+
+#include <rendercore/MeshoptDecoder.h>
+
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define MESHOPT_SSE2
+    #include <emmintrin.h>
+#endif
+
+
+namespace
+{
+
+
+// Vertex codec
+const unsigned char vertexHeader        = 0xa0;
+const unsigned int  vertexBlockSize     = 8192; // Maximum size of a decoded block (in bytes)
+const unsigned int  vertexBlockMaxCount = 256;  // Maximum number of vertices in a block
+const unsigned int  byteGroupSize       = 16;   // Number of bytes that share an encoding
+const unsigned int  byteGroupMaxSize    = 24;   // Maximum size of an encoded byte group (in bytes)
+const unsigned int  tailMinSize         = 32;   // Minimum size of the tail that holds the first vertex
+
+// Index codecs
+const unsigned char indexHeader    = 0xe0;
+const unsigned char sequenceHeader = 0xd0;
+
+// Get number of vertices in a block
+unsigned int blockCount(unsigned int stride)
+{
+    unsigned int count = (vertexBlockSize / stride) & ~(byteGroupSize - 1);
+    return count < vertexBlockMaxCount ? count : vertexBlockMaxCount;
+}
+
+// Decode group of 16 bytes with 0, 2, 4 or 8 bits each (values with all bits set are stored in an extra byte)
+const unsigned char * decodeByteGroup(const unsigned char * data, unsigned char * bytes, int bitsLog2)
+{
+    switch (bitsLog2) {
+        case 0: {
+            std::memset(bytes, 0, byteGroupSize);
+            return data;
+        }
+
+        case 1: {
+            const unsigned char * extra = data + 4;
+            for (unsigned int i=0; i<byteGroupSize; i++) {
+                unsigned char value = (data[i / 4] >> (6 - (i % 4) * 2)) & 3;
+                bytes[i] = (value == 3) ? *extra++ : value;
+            }
+            return extra;
+        }
+
+        case 2: {
+            const unsigned char * extra = data + 8;
+            for (unsigned int i=0; i<byteGroupSize; i++) {
+                unsigned char value = (data[i / 2] >> (4 - (i % 2) * 4)) & 15;
+                bytes[i] = (value == 15) ? *extra++ : value;
+            }
+            return extra;
+        }
+
+        default: {
+            std::memcpy(bytes, data, byteGroupSize);
+            return data + byteGroupSize;
+        }
+    }
+}
+
+// Decode byte stream of a block (count must be a multiple of 16)
+const unsigned char * decodeBytes(const unsigned char * data, const unsigned char * end, unsigned char * bytes, unsigned int count)
+{
+    // Get header with 2 bits per group
+    const unsigned char * header     = data;
+    const unsigned int    headerSize = (count / byteGroupSize + 3) / 4;
+    if (static_cast<size_t>(end - data) < headerSize) return nullptr;
+
+    data += headerSize;
+
+    // Decode groups (the tail guarantees that a group can always be read if this check passes)
+    for (unsigned int i=0; i<count; i+=byteGroupSize) {
+        if (static_cast<size_t>(end - data) < byteGroupMaxSize) return nullptr;
+
+        unsigned int group = i / byteGroupSize;
+        int bitsLog2 = (header[group / 4] >> ((group % 4) * 2)) & 3;
+        data = decodeByteGroup(data, bytes + i, bitsLog2);
+    }
+
+    return data;
+}
+
+// Decode block of vertices (each byte of a vertex is a zigzag encoded delta to the byte of the previous vertex)
+const unsigned char * decodeVertexBlock(const unsigned char * data, const unsigned char * end, unsigned char * vertices, unsigned int count, unsigned int stride, unsigned char * lastVertex)
+{
+    unsigned char bytes[vertexBlockMaxCount];
+    const unsigned int alignedCount = (count + byteGroupSize - 1) & ~(byteGroupSize - 1);
+
+    for (unsigned int k=0; k<stride; k++) {
+        data = decodeBytes(data, end, bytes, alignedCount);
+        if (!data) return nullptr;
+
+        unsigned char previous = lastVertex[k];
+        for (unsigned int i=0; i<count; i++) {
+            unsigned char delta = static_cast<unsigned char>(-(bytes[i] & 1) ^ (bytes[i] >> 1));
+            previous = static_cast<unsigned char>(previous + delta);
+            vertices[i * stride + k] = previous;
+        }
+    }
+
+    std::memcpy(lastVertex, vertices + (count - 1) * stride, stride);
+    return data;
+}
+
+// Decode variable length integer (7 bits per byte)
+unsigned int decodeVByte(const unsigned char *& data)
+{
+    unsigned char lead = *data++;
+    if (lead < 128) {
+        return lead;
+    }
+
+    // At most four more bytes are read, even for malformed data
+    unsigned int result = lead & 127;
+    unsigned int shift  = 7;
+    for (int i=0; i<4; i++) {
+        unsigned char group = *data++;
+        result |= static_cast<unsigned int>(group & 127) << shift;
+        shift  += 7;
+
+        if (group < 128) break;
+    }
+
+    return result;
+}
+
+// Decode index that is stored as zigzag encoded delta to the last index
+unsigned int decodeIndex(const unsigned char *& data, unsigned int last)
+{
+    unsigned int value = decodeVByte(data);
+    return last + ((value >> 1) ^ (0u - (value & 1)));
+}
+
+// Write index of the given size
+void writeIndex(char * destination, unsigned int i, unsigned int indexSize, unsigned int index)
+{
+    if (indexSize == 2) {
+        unsigned short value = static_cast<unsigned short>(index);
+        std::memcpy(destination + i * 2, &value, 2);
+    } else {
+        std::memcpy(destination + i * 4, &index, 4);
+    }
+}
+
+// Get signed component of the given size
+int readComponent(const char * data, unsigned int size)
+{
+    if (size == 1) {
+        return static_cast<signed char>(*data);
+    }
+
+    short value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// Set signed component of the given size
+void writeComponent(char * data, unsigned int size, int value)
+{
+    if (size == 1) {
+        *data = static_cast<char>(value);
+    } else {
+        short v = static_cast<short>(value);
+        std::memcpy(data, &v, sizeof(v));
+    }
+}
+
+// Round float to nearest integer (away from zero)
+inline int roundSigned(float value)
+{
+    return static_cast<int>(value + (value >= 0.0f ? 0.5f : -0.5f));
+}
+
+#ifdef MESHOPT_SSE2
+// Round floats to nearest integers (away from zero)
+inline __m128i roundSigned(__m128 value)
+{
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    return _mm_cvttps_epi32(_mm_add_ps(value, _mm_or_ps(_mm_set1_ps(0.5f), _mm_and_ps(value, sign))));
+}
+#endif
+
+
+} // namespace
+
+
+namespace rendercore
+{
+
+
+bool MeshoptDecoder::decodeVertexBuffer(char * destination, unsigned int count, unsigned int stride, const char * data, unsigned int size)
+{
+    // Check vertex size and header
+    if (stride == 0 || stride > 256 || stride % 4 != 0) return false;
+    if (size < 1 + stride) return false;
+
+    const unsigned char * input = reinterpret_cast<const unsigned char *>(data);
+    const unsigned char * end   = input + size;
+
+    unsigned char header = *input++;
+    if ((header & 0xf0) != vertexHeader || (header & 0x0f) > 0) return false;
+
+    // The first vertex is stored in the tail
+    unsigned char lastVertex[256];
+    std::memcpy(lastVertex, end - stride, stride);
+
+    // Decode blocks
+    unsigned char * output     = reinterpret_cast<unsigned char *>(destination);
+    unsigned int    blockSize  = blockCount(stride);
+    unsigned int    vertex     = 0;
+
+    while (vertex < count) {
+        unsigned int blockVertices = (count - vertex < blockSize) ? count - vertex : blockSize;
+
+        input = decodeVertexBlock(input, end, output + static_cast<size_t>(vertex) * stride, blockVertices, stride, lastVertex);
+        if (!input) return false;
+
+        vertex += blockVertices;
+    }
+
+    // Only the tail must remain
+    unsigned int tailSize = stride < tailMinSize ? tailMinSize : stride;
+    return static_cast<size_t>(end - input) == tailSize;
+}
+
+bool MeshoptDecoder::decodeIndexBuffer(char * destination, unsigned int count, unsigned int indexSize, const char * data, unsigned int size)
+{
+    // Check header (the minimum is one byte per triangle and a table of 16 bytes)
+    if (count % 3 != 0 || (indexSize != 2 && indexSize != 4)) return false;
+    if (size < 1 + count / 3 + 16) return false;
+
+    const unsigned char * input = reinterpret_cast<const unsigned char *>(data);
+    if ((input[0] & 0xf0) != indexHeader || (input[0] & 0x0f) > 1) return false;
+
+    const int version = input[0] & 0x0f;
+
+    // FIFOs of recent edges and vertices
+    unsigned int edges[16][2];
+    unsigned int vertices[16];
+    std::memset(edges,    -1, sizeof(edges));
+    std::memset(vertices, -1, sizeof(vertices));
+
+    unsigned int edgeOffset   = 0;
+    unsigned int vertexOffset = 0;
+    unsigned int next         = 0;
+    unsigned int last         = 0;
+    const int    fecMax       = version >= 1 ? 13 : 15;
+
+    auto pushEdge = [&edges, &edgeOffset] (unsigned int a, unsigned int b) {
+        edges[edgeOffset][0] = a;
+        edges[edgeOffset][1] = b;
+        edgeOffset = (edgeOffset + 1) & 15;
+    };
+
+    auto pushVertex = [&vertices, &vertexOffset] (unsigned int v, bool advance) {
+        vertices[vertexOffset] = v;
+        vertexOffset = (vertexOffset + (advance ? 1 : 0)) & 15;
+    };
+
+    // One code byte per triangle, followed by the extra data and a table of 16 bytes
+    const unsigned char * code     = input + 1;
+    const unsigned char * extra    = code + count / 3;
+    const unsigned char * extraEnd = input + size - 16;
+    const unsigned char * table    = extraEnd;
+
+    for (unsigned int i=0; i<count; i+=3) {
+        // A triangle reads at most 16 bytes of extra data, which the table guarantees
+        if (extra > extraEnd) return false;
+
+        unsigned char codeTri = *code++;
+
+        if (codeTri < 0xf0) {
+            // Triangle shares an edge with a recent triangle
+            int fe = codeTri >> 4;
+            unsigned int a = edges[(edgeOffset - 1 - fe) & 15][0];
+            unsigned int b = edges[(edgeOffset - 1 - fe) & 15][1];
+
+            int fec = codeTri & 15;
+            if (fec < fecMax) {
+                // Third vertex is new or recent
+                unsigned int c = (fec == 0) ? next : vertices[(vertexOffset - 1 - fec) & 15];
+                if (fec == 0) next++;
+
+                writeIndex(destination, i,     indexSize, a);
+                writeIndex(destination, i + 1, indexSize, b);
+                writeIndex(destination, i + 2, indexSize, c);
+
+                pushVertex(c, fec == 0);
+                pushEdge(c, b);
+                pushEdge(a, c);
+            } else {
+                // Third vertex is close to the last free index (13, 14) or stored explicitly (15)
+                unsigned int c = (fec != 15) ? last + (fec - (fec ^ 3)) : decodeIndex(extra, last);
+                last = c;
+
+                writeIndex(destination, i,     indexSize, a);
+                writeIndex(destination, i + 1, indexSize, b);
+                writeIndex(destination, i + 2, indexSize, c);
+
+                pushVertex(c, true);
+                pushEdge(c, b);
+                pushEdge(a, c);
+            }
+        } else if (codeTri < 0xfe) {
+            // New triangle, vertex codes are stored in the table
+            unsigned char codeAux = table[codeTri & 15];
+            int feb = codeAux >> 4;
+            int fec = codeAux & 15;
+
+            unsigned int a = next++;
+            unsigned int b = (feb == 0) ? next : vertices[(vertexOffset - feb) & 15];
+            if (feb == 0) next++;
+            unsigned int c = (fec == 0) ? next : vertices[(vertexOffset - fec) & 15];
+            if (fec == 0) next++;
+
+            writeIndex(destination, i,     indexSize, a);
+            writeIndex(destination, i + 1, indexSize, b);
+            writeIndex(destination, i + 2, indexSize, c);
+
+            pushVertex(a, true);
+            pushVertex(b, feb == 0);
+            pushVertex(c, fec == 0);
+            pushEdge(b, a);
+            pushEdge(c, b);
+            pushEdge(a, c);
+        } else {
+            // New triangle, vertex codes are stored in the extra data
+            unsigned char codeAux = *extra++;
+            int fea = (codeTri == 0xfe) ? 0 : 15;
+            int feb = codeAux >> 4;
+            int fec = codeAux & 15;
+
+            // Restart numbering of new vertices
+            if (codeAux == 0) next = 0;
+
+            unsigned int a = (fea == 0) ? next++ : 0;
+            unsigned int b = (feb == 0) ? next++ : vertices[(vertexOffset - feb) & 15];
+            unsigned int c = (fec == 0) ? next++ : vertices[(vertexOffset - fec) & 15];
+
+            if (fea == 15) last = a = decodeIndex(extra, last);
+            if (feb == 15) last = b = decodeIndex(extra, last);
+            if (fec == 15) last = c = decodeIndex(extra, last);
+
+            writeIndex(destination, i,     indexSize, a);
+            writeIndex(destination, i + 1, indexSize, b);
+            writeIndex(destination, i + 2, indexSize, c);
+
+            pushVertex(a, true);
+            pushVertex(b, feb == 0 || feb == 15);
+            pushVertex(c, fec == 0 || fec == 15);
+            pushEdge(b, a);
+            pushEdge(c, b);
+            pushEdge(a, c);
+        }
+    }
+
+    // All extra data must have been read
+    return extra == extraEnd;
+}
+
+bool MeshoptDecoder::decodeIndexSequence(char * destination, unsigned int count, unsigned int indexSize, const char * data, unsigned int size)
+{
+    // Check header (the minimum is one byte per index and a tail of 4 bytes)
+    if (indexSize != 2 && indexSize != 4) return false;
+    if (size < 1 + count + 4) return false;
+
+    const unsigned char * input = reinterpret_cast<const unsigned char *>(data);
+    if ((input[0] & 0xf0) != sequenceHeader || (input[0] & 0x0f) > 1) return false;
+
+    const unsigned char * end = input + size - 4;
+    input++;
+
+    // Each index is a delta to one of two baselines
+    unsigned int last[2] = { 0, 0 };
+
+    for (unsigned int i=0; i<count; i++) {
+        // An index reads at most 5 bytes, which the tail guarantees
+        if (input >= end) return false;
+
+        unsigned int value    = decodeVByte(input);
+        unsigned int baseline = value & 1;
+        value >>= 1;
+
+        unsigned int index = last[baseline] + ((value >> 1) ^ (0u - (value & 1)));
+        last[baseline] = index;
+
+        writeIndex(destination, i, indexSize, index);
+    }
+
+    // All data must have been read
+    return input == end;
+}
+
+void MeshoptDecoder::filterOctahedral(char * data, unsigned int count, unsigned int stride)
+{
+    const unsigned int size = stride / 4;
+    if (size != 1 && size != 2) return;
+
+    const float maxValue = static_cast<float>((1 << (size * 8 - 1)) - 1);
+    unsigned int i = 0;
+
+#ifdef MESHOPT_SSE2
+    // Process four vectors at once
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; i + 4 <= count; i += 4) {
+        char * v = data + i * stride;
+
+        __m128 x = _mm_setr_ps((float)readComponent(v,          size), (float)readComponent(v + stride,          size), (float)readComponent(v + 2 * stride,          size), (float)readComponent(v + 3 * stride,          size));
+        __m128 y = _mm_setr_ps((float)readComponent(v + size,   size), (float)readComponent(v + stride + size,   size), (float)readComponent(v + 2 * stride + size,   size), (float)readComponent(v + 3 * stride + size,   size));
+        __m128 z = _mm_setr_ps((float)readComponent(v + 2*size, size), (float)readComponent(v + stride + 2*size, size), (float)readComponent(v + 2 * stride + 2*size, size), (float)readComponent(v + 3 * stride + 2*size, size));
+
+        // Reconstruct z and unfold the lower hemisphere
+        z = _mm_sub_ps(_mm_sub_ps(z, _mm_andnot_ps(sign, x)), _mm_andnot_ps(sign, y));
+
+        __m128 t = _mm_min_ps(z, zero);
+        x = _mm_add_ps(x, _mm_xor_ps(t, _mm_and_ps(x, sign)));
+        y = _mm_add_ps(y, _mm_xor_ps(t, _mm_and_ps(y, sign)));
+
+        // Normalize to the integer range
+        __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+        __m128 scale  = _mm_div_ps(_mm_set1_ps(maxValue), length);
+
+        int xs[4], ys[4], zs[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(xs), roundSigned(_mm_mul_ps(x, scale)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(ys), roundSigned(_mm_mul_ps(y, scale)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(zs), roundSigned(_mm_mul_ps(z, scale)));
+
+        for (int j=0; j<4; j++) {
+            writeComponent(v + j * stride,            size, xs[j]);
+            writeComponent(v + j * stride + size,     size, ys[j]);
+            writeComponent(v + j * stride + 2 * size, size, zs[j]);
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        char * v = data + i * stride;
+
+        // Reconstruct z and unfold the lower hemisphere
+        float x = static_cast<float>(readComponent(v,            size));
+        float y = static_cast<float>(readComponent(v + size,     size));
+        float z = static_cast<float>(readComponent(v + 2 * size, size)) - std::fabs(x) - std::fabs(y);
+
+        float t = (z >= 0.0f) ? 0.0f : z;
+        x += (x >= 0.0f) ? t : -t;
+        y += (y >= 0.0f) ? t : -t;
+
+        // Normalize to the integer range
+        float scale = maxValue / std::sqrt(x * x + y * y + z * z);
+
+        writeComponent(v,            size, roundSigned(x * scale));
+        writeComponent(v + size,     size, roundSigned(y * scale));
+        writeComponent(v + 2 * size, size, roundSigned(z * scale));
+    }
+}
+
+void MeshoptDecoder::filterQuaternion(char * data, unsigned int count, unsigned int stride)
+{
+    if (stride != 8) return;
+
+    const float scale = 1.0f / std::sqrt(2.0f);
+
+    for (unsigned int i=0; i<count; i++) {
+        short q[4];
+        std::memcpy(q, data + i * 8, sizeof(q));
+
+        // The last component holds the scale and the index of the largest component
+        int   range  = q[3] | 3;
+        float factor = scale / static_cast<float>(range);
+
+        float x = q[0] * factor;
+        float y = q[1] * factor;
+        float z = q[2] * factor;
+
+        // Reconstruct the largest component (clamped to avoid NaN due to precision errors)
+        float ww = 1.0f - x * x - y * y - z * z;
+        float w  = std::sqrt(ww >= 0.0f ? ww : 0.0f);
+
+        int largest = q[3] & 3;
+
+        short result[4];
+        result[(largest + 1) & 3] = static_cast<short>(roundSigned(x * 32767.0f));
+        result[(largest + 2) & 3] = static_cast<short>(roundSigned(y * 32767.0f));
+        result[(largest + 3) & 3] = static_cast<short>(roundSigned(z * 32767.0f));
+        result[(largest + 0) & 3] = static_cast<short>(static_cast<int>(w * 32767.0f + 0.5f));
+
+        std::memcpy(data + i * 8, result, sizeof(result));
+    }
+}
+
+void MeshoptDecoder::filterExponential(char * data, unsigned int count, unsigned int stride)
+{
+    if (stride % 4 != 0) return;
+
+    const size_t numValues = static_cast<size_t>(count) * (stride / 4);
+    size_t i = 0;
+
+#ifdef MESHOPT_SSE2
+    // Process four values at once: mantissa (24 bits) times 2^exponent (8 bits)
+    for (; i + 4 <= numValues; i += 4) {
+        __m128i value    = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i * 4));
+        __m128i mantissa = _mm_srai_epi32(_mm_slli_epi32(value, 8), 8);
+        __m128i exponent = _mm_srai_epi32(value, 24);
+        __m128  power    = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(exponent, _mm_set1_epi32(127)), 23));
+
+        _mm_storeu_ps(reinterpret_cast<float *>(data + i * 4), _mm_mul_ps(power, _mm_cvtepi32_ps(mantissa)));
+    }
+#endif
+
+    for (; i < numValues; i++) {
+        unsigned int value;
+        std::memcpy(&value, data + i * 4, 4);
+
+        int mantissa = static_cast<int>(value << 8) >> 8;
+        int exponent = static_cast<int>(value) >> 24;
+
+        unsigned int bits = static_cast<unsigned int>(exponent + 127) << 23;
+        float power;
+        std::memcpy(&power, &bits, 4);
+
+        float result = power * static_cast<float>(mantissa);
+        std::memcpy(data + i * 4, &result, 4);
+    }
+}
+
+
+} // namespace rendercore
@@ -12,7 +12,7 @@ namespace rendercore
 
 
 Transform::Transform()
-: m_rotation(0.0f, 0.0f, 0.0f, 1.0f)
+: m_rotation(1.0f, 0.0f, 0.0f, 0.0f)
 , m_translation(0.0f, 0.0f, 0.0f)
 , m_scale(1.0f, 1.0f, 1.0f)
 {
@@ -58,7 +58,7 @@ void Transform::setRotation(const glm::quat & rotation)
 void Transform::setRotation(const glm::vec4 & rotation)
 {
     // Set rotation
-    m_rotation = glm::quat(rotation.x, rotation.y, rotation.z, rotation.w);
+    m_rotation = glm::quat(rotation.w, rotation.x, rotation.y, rotation.z);
 
     // Reset transformation matrix
     m_transform.invalidate();
@@ -99,10 +99,9 @@ const glm::mat4 & Transform::transform() const
     // Check if transformation matrix needs to be recalculated
     if (!m_transform.isValid()) {
         // Calculate transformation matrix
-        glm::mat4 transform = glm::mat4(1.0);
-        transform = glm::scale(transform, m_scale);
+        glm::mat4 transform = glm::translate(glm::mat4(1.0), m_translation);
         transform = transform * glm::toMat4(m_rotation);
-        transform = glm::translate(transform, m_translation);
+        transform = glm::scale(transform, m_scale);
 
         // Update transformation matrix
         m_transform.setValue(transform);
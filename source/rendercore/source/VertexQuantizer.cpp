@@ -0,0 +1,193 @@
+
+#include <rendercore/VertexQuantizer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+namespace
+{
+
+
+// Read float components of a vertex
+void readVertex(const char * data, unsigned int index, unsigned int stride, unsigned int components, float * values)
+{
+    std::memcpy(values, data + static_cast<size_t>(index) * stride, components * sizeof(float));
+}
+
+// Convert value in [-1, 1] to signed normalized integer with the given number of bits
+int toSnorm(float value, unsigned int bits)
+{
+    const float scale = static_cast<float>((1 << (bits - 1)) - 1);
+    return static_cast<int>(std::round(std::max(-1.0f, std::min(1.0f, value)) * scale));
+}
+
+// Convert value in [0, 1] to unsigned normalized 16 bit integer
+unsigned short toUnorm16(float value)
+{
+    return static_cast<unsigned short>(std::round(std::max(0.0f, std::min(1.0f, value)) * 65535.0f));
+}
+
+
+} // namespace
+
+
+namespace rendercore
+{
+
+
+void VertexQuantizer::bounds(const char * data, unsigned int count, unsigned int stride, unsigned int components, glm::vec4 & minValue, glm::vec4 & maxValue)
+{
+    minValue = glm::vec4(0.0f);
+    maxValue = glm::vec4(0.0f);
+
+    for (unsigned int i=0; i<count; i++) {
+        float values[4];
+        readVertex(data, i, stride, components, values);
+
+        for (unsigned int c=0; c<components; c++) {
+            minValue[c] = (i == 0) ? values[c] : std::min(minValue[c], values[c]);
+            maxValue[c] = (i == 0) ? values[c] : std::max(maxValue[c], values[c]);
+        }
+    }
+}
+
+std::vector<unsigned int> VertexQuantizer::packSnorm10(const char * data, unsigned int count, unsigned int stride, unsigned int components)
+{
+    std::vector<unsigned int> packed(count);
+
+    for (unsigned int i=0; i<count; i++) {
+        float values[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        readVertex(data, i, stride, components, values);
+
+        // Store fourth component as sign
+        int w = 0;
+        if (components > 3) {
+            w = values[3] < 0.0f ? -1 : 1;
+        }
+
+        // Pack components (x in the lowest bits)
+        packed[i] = (static_cast<unsigned int>(toSnorm(values[0], 10)) & 0x3FF)
+                  | (static_cast<unsigned int>(toSnorm(values[1], 10)) & 0x3FF) << 10
+                  | (static_cast<unsigned int>(toSnorm(values[2], 10)) & 0x3FF) << 20
+                  | (static_cast<unsigned int>(w)                      & 0x3)   << 30;
+    }
+
+    return packed;
+}
+
+std::vector<unsigned short> VertexQuantizer::packUnorm16(const char * data, unsigned int count, unsigned int stride)
+{
+    std::vector<unsigned short> packed(count * 2);
+
+    for (unsigned int i=0; i<count; i++) {
+        float values[2];
+        readVertex(data, i, stride, 2, values);
+
+        packed[i * 2 + 0] = toUnorm16(values[0]);
+        packed[i * 2 + 1] = toUnorm16(values[1]);
+    }
+
+    return packed;
+}
+
+std::vector<unsigned short> VertexQuantizer::packHalf(const char * data, unsigned int count, unsigned int stride)
+{
+    std::vector<unsigned short> packed(count * 2);
+
+    for (unsigned int i=0; i<count; i++) {
+        float values[2];
+        readVertex(data, i, stride, 2, values);
+
+        packed[i * 2 + 0] = toHalf(values[0]);
+        packed[i * 2 + 1] = toHalf(values[1]);
+    }
+
+    return packed;
+}
+
+std::vector<unsigned short> VertexQuantizer::quantizePositions(const char * data, unsigned int count, unsigned int stride, glm::mat4 & dequantization)
+{
+    // Get bounding box
+    glm::vec4 minValue, maxValue;
+    bounds(data, count, stride, 3, minValue, maxValue);
+
+    glm::vec3 offset(minValue.x, minValue.y, minValue.z);
+    glm::vec3 extent(maxValue.x - minValue.x, maxValue.y - minValue.y, maxValue.z - minValue.z);
+
+    // Transformation from [0, 1] back into the bounding box
+    dequantization = glm::mat4(1.0f);
+    dequantization[0][0] = extent.x;
+    dequantization[1][1] = extent.y;
+    dequantization[2][2] = extent.z;
+    dequantization[3]    = glm::vec4(offset, 1.0f);
+
+    // Quantize positions
+    std::vector<unsigned short> packed(count * 4, 0);
+
+    for (unsigned int i=0; i<count; i++) {
+        float values[3];
+        readVertex(data, i, stride, 3, values);
+
+        for (unsigned int c=0; c<3; c++) {
+            packed[i * 4 + c] = extent[c] > 0.0f ? toUnorm16((values[c] - offset[c]) / extent[c]) : 0;
+        }
+    }
+
+    return packed;
+}
+
+unsigned short VertexQuantizer::toHalf(float value)
+{
+    unsigned int bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const unsigned int sign     = (bits >> 16) & 0x8000;
+    const unsigned int exponent = (bits >> 23) & 0xFF;
+    unsigned int       mantissa = bits & 0x7FFFFF;
+
+    // Infinity and NaN
+    if (exponent == 0xFF) {
+        return static_cast<unsigned short>(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+    }
+
+    // Overflow
+    const int halfExponent = static_cast<int>(exponent) - 127 + 15;
+    if (halfExponent >= 31) {
+        return static_cast<unsigned short>(sign | 0x7C00);
+    }
+
+    // Subnormal half floats
+    if (halfExponent <= 0) {
+        if (halfExponent < -10) {
+            return static_cast<unsigned short>(sign);
+        }
+
+        mantissa |= 0x800000;
+
+        const unsigned int shift     = static_cast<unsigned int>(14 - halfExponent);
+        const unsigned int remainder = mantissa & ((1u << shift) - 1);
+        const unsigned int halfway   = 1u << (shift - 1);
+        unsigned int       half      = mantissa >> shift;
+
+        if (remainder > halfway || (remainder == halfway && (half & 1))) {
+            half++;
+        }
+
+        return static_cast<unsigned short>(sign | half);
+    }
+
+    // Normal half floats (rounding may carry into the exponent)
+    unsigned int half      = sign | (static_cast<unsigned int>(halfExponent) << 10) | (mantissa >> 13);
+    unsigned int remainder = mantissa & 0x1FFF;
+
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) {
+        half++;
+    }
+
+    return static_cast<unsigned short>(half);
+}
+
+
+} // namespace rendercore
@@ -0,0 +1,114 @@
+
+#include <rendercore/WorkerPool.h>
+
+
+namespace rendercore
+{
+
+
+WorkerPool::WorkerPool(unsigned int numThreads)
+: m_active(0)
+, m_stop(false)
+{
+    // Use all available cores, the owning thread takes part in wait()
+    if (numThreads == 0) {
+        unsigned int numCores = std::thread::hardware_concurrency();
+        numThreads = numCores > 1 ? numCores - 1 : 1;
+    }
+
+    // Start worker threads
+    for (unsigned int i=0; i<numThreads; i++) {
+        m_threads.emplace_back(&WorkerPool::work, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    // Finish remaining tasks
+    wait();
+
+    // Stop worker threads
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_taskAdded.notify_all();
+
+    for (auto & thread : m_threads) {
+        thread.join();
+    }
+}
+
+unsigned int WorkerPool::numThreads() const
+{
+    return static_cast<unsigned int>(m_threads.size());
+}
+
+void WorkerPool::run(std::function<void ()> task)
+{
+    // Add task
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+
+    // Wake up a worker thread
+    m_taskAdded.notify_one();
+}
+
+void WorkerPool::wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    // Help executing pending tasks
+    while (!m_tasks.empty()) {
+        execute(lock);
+    }
+
+    // Wait for tasks that are still running
+    m_taskFinished.wait(lock, [this] () {
+        return m_tasks.empty() && m_active == 0;
+    });
+}
+
+void WorkerPool::execute(std::unique_lock<std::mutex> & lock)
+{
+    // Take next task
+    auto task = std::move(m_tasks.front());
+    m_tasks.pop_front();
+    m_active++;
+
+    // Execute task without holding the lock
+    lock.unlock();
+    task();
+    lock.lock();
+
+    // Notify waiting threads when all tasks are done
+    m_active--;
+    if (m_tasks.empty() && m_active == 0) {
+        m_taskFinished.notify_all();
+    }
+}
+
+void WorkerPool::work()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true) {
+        // Wait for a task or a stop request
+        m_taskAdded.wait(lock, [this] () {
+            return m_stop || !m_tasks.empty();
+        });
+
+        if (m_stop && m_tasks.empty()) {
+            return;
+        }
+
+        // Execute task
+        execute(lock);
+    }
+}
+
+
+} // namespace rendercore
@@ -0,0 +1,390 @@
+
+#include <rendercore/scene/Animation.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define ANIMATION_SSE2
+    #include <emmintrin.h>
+#endif
+
+#include <rendercore/scene/SceneNode.h>
+
+
+namespace
+{
+
+
+// Rows of the gathered samples of a batch
+const size_t rowAx     = 0;
+const size_t rowAy     = 1;
+const size_t rowAz     = 2;
+const size_t rowAw     = 3;
+const size_t rowBx     = 4;
+const size_t rowBy     = 5;
+const size_t rowBz     = 6;
+const size_t rowBw     = 7;
+const size_t rowFactor = 8;
+const size_t rowCount  = 9;
+
+
+} // namespace
+
+
+namespace rendercore
+{
+
+
+Animation::Animation()
+: m_duration(0.0f)
+{
+    m_vectors.stride   = 0;
+    m_rotations.stride = 0;
+}
+
+Animation::~Animation()
+{
+}
+
+const std::string & Animation::name() const
+{
+    return m_name;
+}
+
+void Animation::setName(const std::string & name)
+{
+    m_name = name;
+}
+
+float Animation::duration() const
+{
+    return m_duration;
+}
+
+size_t Animation::channelCount() const
+{
+    return m_vectors.channels.size() + m_rotations.channels.size();
+}
+
+void Animation::addChannel(SceneNode * node, Path path, Interpolation interpolation, const float * times, const float * values, unsigned int keyCount)
+{
+    // Check parameters
+    if (!node || !times || !values || keyCount == 0 || path == Path::Weights) {
+        return;
+    }
+
+    // Create channel
+    Channel channel;
+    channel.node          = node;
+    channel.path          = path;
+    channel.interpolation = interpolation;
+    channel.keyCount      = keyCount;
+    channel.firstWeight   = 0;
+    channel.weightCount   = 0;
+
+    // Add channel
+    const unsigned int components = (path == Path::Rotation) ? 4 : 3;
+    insertChannel(channel, times, values, components, 0, components);
+}
+
+void Animation::addWeightsChannel(SceneNode * node, Interpolation interpolation, const float * times, const float * values, unsigned int keyCount, unsigned int weightCount)
+{
+    // Check parameters
+    if (!node || !times || !values || keyCount == 0 || weightCount == 0) {
+        return;
+    }
+
+    // Add one channel for each group of three weights
+    for (unsigned int first=0; first<weightCount; first+=3) {
+        Channel channel;
+        channel.node          = node;
+        channel.path          = Path::Weights;
+        channel.interpolation = interpolation;
+        channel.keyCount      = keyCount;
+        channel.firstWeight   = first;
+        channel.weightCount   = std::min(weightCount - first, 3u);
+
+        insertChannel(channel, times, values, weightCount, first, channel.weightCount);
+    }
+}
+
+void Animation::insertChannel(Channel & channel, const float * times, const float * values, unsigned int stride, unsigned int offset, unsigned int components)
+{
+    const unsigned int keyCount = channel.keyCount;
+
+    channel.firstTime  = static_cast<unsigned int>(m_times.size());
+    channel.firstValue = static_cast<unsigned int>(m_values.size());
+    channel.cursor     = 0;
+
+    // Copy keyframe times
+    m_times.insert(m_times.end(), times, times + keyCount);
+    m_duration = std::max(m_duration, times[keyCount - 1]);
+
+    // Copy keyframe values (padded to four components)
+    const unsigned int numValues = (channel.interpolation == Interpolation::CubicSpline) ? keyCount * 3 : keyCount;
+
+    for (unsigned int i=0; i<numValues; i++) {
+        glm::vec4 value(0.0f);
+        for (unsigned int c=0; c<components; c++) {
+            value[c] = values[i * stride + offset + c];
+        }
+
+        m_values.push_back(value);
+    }
+
+    // Add channel to batch and resize samples (rows are padded with zeros to a multiple of four)
+    Batch & batch = (channel.path == Path::Rotation) ? m_rotations : m_vectors;
+    batch.channels.push_back(channel);
+    batch.stride = (batch.channels.size() + 3) / 4 * 4;
+    batch.samples.assign(rowCount * batch.stride, 0.0f);
+}
+
+void Animation::apply(float time)
+{
+    // Translation, scale and weights
+    if (!m_vectors.channels.empty()) {
+        gather(m_vectors, time);
+        interpolateVectors(m_vectors);
+        scatter(m_vectors);
+    }
+
+    // Rotation
+    if (!m_rotations.channels.empty()) {
+        gather(m_rotations, time);
+        interpolateRotations(m_rotations);
+        scatter(m_rotations);
+    }
+}
+
+void Animation::gather(Batch & batch, float time)
+{
+    float * samples = batch.samples.data();
+    const size_t stride = batch.stride;
+
+    for (size_t i=0; i<batch.channels.size(); i++) {
+        Channel & channel = batch.channels[i];
+
+        const float     * times  = &m_times[channel.firstTime];
+        const glm::vec4 * values = &m_values[channel.firstValue];
+        const bool        cubic  = (channel.interpolation == Interpolation::CubicSpline);
+
+        // Find keyframes around the given time
+        unsigned int key = findKey(channel, time);
+
+        glm::vec4 a = cubic ? values[key * 3 + 1] : values[key];
+        glm::vec4 b = a;
+        float     f = 0.0f;
+
+        // Interpolate only between two keyframes, else hold the first or last value
+        if (key + 1 < channel.keyCount && time > times[key]) {
+            const float dt = times[key + 1] - times[key];
+            const float s  = dt > 0.0f ? (time - times[key]) / dt : 0.0f;
+
+            if (channel.interpolation == Interpolation::Linear) {
+                b = values[key + 1];
+                f = s;
+            } else if (cubic) {
+                // Hermite spline with the out-tangent of the first and the in-tangent of the second keyframe
+                const float s2 = s * s;
+                const float s3 = s2 * s;
+
+                a = (2.0f * s3 - 3.0f * s2 + 1.0f) * values[key * 3 + 1]
+                  + (s3 - 2.0f * s2 + s) * dt      * values[key * 3 + 2]
+                  + (-2.0f * s3 + 3.0f * s2)       * values[key * 3 + 4]
+                  + (s3 - s2) * dt                 * values[key * 3 + 3];
+                b = a;
+            }
+        }
+
+        // Store samples in their column
+        samples[rowAx * stride + i]     = a.x;
+        samples[rowAy * stride + i]     = a.y;
+        samples[rowAz * stride + i]     = a.z;
+        samples[rowAw * stride + i]     = a.w;
+        samples[rowBx * stride + i]     = b.x;
+        samples[rowBy * stride + i]     = b.y;
+        samples[rowBz * stride + i]     = b.z;
+        samples[rowBw * stride + i]     = b.w;
+        samples[rowFactor * stride + i] = f;
+    }
+}
+
+unsigned int Animation::findKey(Channel & channel, float time) const
+{
+    const float        * times = &m_times[channel.firstTime];
+    const unsigned int   count = channel.keyCount;
+
+    // Helper function: Check if the time lies in the interval that starts at the given keyframe
+    auto contains = [times, count, time] (unsigned int key) -> bool {
+        return time >= times[key] && (key + 1 >= count || time < times[key + 1]);
+    };
+
+    // Try last keyframe and its successor, which is the common case when playing forward
+    unsigned int key = channel.cursor;
+    if (!contains(key)) {
+        if (key + 1 < count && contains(key + 1)) {
+            key++;
+        } else {
+            // Search all keyframes
+            key = static_cast<unsigned int>(std::upper_bound(times, times + count, time) - times);
+            key = key > 0 ? key - 1 : 0;
+        }
+    }
+
+    channel.cursor = key;
+    return key;
+}
+
+void Animation::interpolateVectors(Batch & batch)
+{
+    const size_t stride = batch.stride;
+
+    float       * ax = &batch.samples[rowAx * stride];
+    float       * ay = &batch.samples[rowAy * stride];
+    float       * az = &batch.samples[rowAz * stride];
+    const float * bx = &batch.samples[rowBx * stride];
+    const float * by = &batch.samples[rowBy * stride];
+    const float * bz = &batch.samples[rowBz * stride];
+    const float * f  = &batch.samples[rowFactor * stride];
+
+#ifdef ANIMATION_SSE2
+    // Interpolate four channels at once
+    for (size_t i=0; i<stride; i+=4) {
+        const __m128 t = _mm_loadu_ps(f + i);
+
+        const __m128 x = _mm_loadu_ps(ax + i);
+        const __m128 y = _mm_loadu_ps(ay + i);
+        const __m128 z = _mm_loadu_ps(az + i);
+
+        _mm_storeu_ps(ax + i, _mm_add_ps(x, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(bx + i), x), t)));
+        _mm_storeu_ps(ay + i, _mm_add_ps(y, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(by + i), y), t)));
+        _mm_storeu_ps(az + i, _mm_add_ps(z, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(bz + i), z), t)));
+    }
+#else
+    for (size_t i=0; i<stride; i++) {
+        ax[i] += (bx[i] - ax[i]) * f[i];
+        ay[i] += (by[i] - ay[i]) * f[i];
+        az[i] += (bz[i] - az[i]) * f[i];
+    }
+#endif
+}
+
+void Animation::interpolateRotations(Batch & batch)
+{
+    const size_t stride = batch.stride;
+
+    float       * ax = &batch.samples[rowAx * stride];
+    float       * ay = &batch.samples[rowAy * stride];
+    float       * az = &batch.samples[rowAz * stride];
+    float       * aw = &batch.samples[rowAw * stride];
+    const float * bx = &batch.samples[rowBx * stride];
+    const float * by = &batch.samples[rowBy * stride];
+    const float * bz = &batch.samples[rowBz * stride];
+    const float * bw = &batch.samples[rowBw * stride];
+    const float * f  = &batch.samples[rowFactor * stride];
+
+#ifdef ANIMATION_SSE2
+    const __m128 zero     = _mm_setzero_ps();
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 epsilon  = _mm_set1_ps(1e-20f);
+
+    // Interpolate four channels at once
+    for (size_t i=0; i<stride; i+=4) {
+        const __m128 t  = _mm_loadu_ps(f + i);
+        const __m128 x0 = _mm_loadu_ps(ax + i);
+        const __m128 y0 = _mm_loadu_ps(ay + i);
+        const __m128 z0 = _mm_loadu_ps(az + i);
+        const __m128 w0 = _mm_loadu_ps(aw + i);
+        __m128       x1 = _mm_loadu_ps(bx + i);
+        __m128       y1 = _mm_loadu_ps(by + i);
+        __m128       z1 = _mm_loadu_ps(bz + i);
+        __m128       w1 = _mm_loadu_ps(bw + i);
+
+        // Take the shorter way by negating the second quaternion if necessary
+        __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x0, x1), _mm_mul_ps(y0, y1)),
+                              _mm_add_ps(_mm_mul_ps(z0, z1), _mm_mul_ps(w0, w1)));
+        __m128 flip = _mm_and_ps(_mm_cmplt_ps(d, zero), signMask);
+
+        x1 = _mm_xor_ps(x1, flip);
+        y1 = _mm_xor_ps(y1, flip);
+        z1 = _mm_xor_ps(z1, flip);
+        w1 = _mm_xor_ps(w1, flip);
+
+        // Interpolate
+        __m128 x = _mm_add_ps(x0, _mm_mul_ps(_mm_sub_ps(x1, x0), t));
+        __m128 y = _mm_add_ps(y0, _mm_mul_ps(_mm_sub_ps(y1, y0), t));
+        __m128 z = _mm_add_ps(z0, _mm_mul_ps(_mm_sub_ps(z1, z0), t));
+        __m128 w = _mm_add_ps(w0, _mm_mul_ps(_mm_sub_ps(w1, w0), t));
+
+        // Normalize
+        __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+                                               _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w))));
+        length = _mm_max_ps(length, epsilon);
+
+        _mm_storeu_ps(ax + i, _mm_div_ps(x, length));
+        _mm_storeu_ps(ay + i, _mm_div_ps(y, length));
+        _mm_storeu_ps(az + i, _mm_div_ps(z, length));
+        _mm_storeu_ps(aw + i, _mm_div_ps(w, length));
+    }
+#else
+    for (size_t i=0; i<stride; i++) {
+        // Take the shorter way by negating the second quaternion if necessary
+        const float d    = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i] + aw[i] * bw[i];
+        const float sign = d < 0.0f ? -1.0f : 1.0f;
+
+        // Interpolate
+        const float x = ax[i] + (sign * bx[i] - ax[i]) * f[i];
+        const float y = ay[i] + (sign * by[i] - ay[i]) * f[i];
+        const float z = az[i] + (sign * bz[i] - az[i]) * f[i];
+        const float w = aw[i] + (sign * bw[i] - aw[i]) * f[i];
+
+        // Normalize
+        const float length = std::max(std::sqrt(x * x + y * y + z * z + w * w), 1e-20f);
+
+        ax[i] = x / length;
+        ay[i] = y / length;
+        az[i] = z / length;
+        aw[i] = w / length;
+    }
+#endif
+}
+
+void Animation::scatter(const Batch & batch)
+{
+    const size_t stride = batch.stride;
+
+    const float * x = &batch.samples[rowAx * stride];
+    const float * y = &batch.samples[rowAy * stride];
+    const float * z = &batch.samples[rowAz * stride];
+    const float * w = &batch.samples[rowAw * stride];
+
+    for (size_t i=0; i<batch.channels.size(); i++) {
+        const Channel & channel = batch.channels[i];
+        Transform & transform = channel.node->transform();
+
+        switch (channel.path) {
+            case Path::Translation: transform.setTranslation(glm::vec3(x[i], y[i], z[i]));    break;
+            case Path::Rotation:    transform.setRotation(glm::quat(w[i], x[i], y[i], z[i])); break;
+            case Path::Scale:       transform.setScale(glm::vec3(x[i], y[i], z[i]));          break;
+
+            case Path::Weights:
+            {
+                std::vector<float> & weights = channel.node->morphWeights();
+                if (weights.size() < channel.firstWeight + channel.weightCount) {
+                    weights.resize(channel.firstWeight + channel.weightCount, 0.0f);
+                }
+
+                const float values[3] = { x[i], y[i], z[i] };
+                for (unsigned int c=0; c<channel.weightCount; c++) {
+                    weights[channel.firstWeight + c] = values[c];
+                }
+
+                break;
+            }
+        }
+    }
+}
+
+
+} // namespace rendercore
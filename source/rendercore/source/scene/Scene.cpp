@@ -1,4 +1,6 @@
 
+#include <limits>
+
 #include <cppassist/memory/make_unique.h>
 
 #include <rendercore/scene/Scene.h>
@@ -9,6 +11,8 @@ namespace rendercore
 
 
 Scene::Scene()
+: m_boundingBoxMin(std::numeric_limits<float>::max())
+, m_boundingBoxMax(-std::numeric_limits<float>::max())
 {
     // Create a root node
     m_root = cppassist::make_unique<SceneNode>();
@@ -39,5 +43,70 @@ void Scene::setRoot(std::unique_ptr<SceneNode> && node)
     m_root = std::move(node);
 }
 
+SceneArena & Scene::arena()
+{
+    return m_arena;
+}
+
+std::vector<Animation *> Scene::animations() const
+{
+    std::vector<Animation *> lst;
+
+    for (auto & animation : m_animations) {
+        lst.push_back(animation.get());
+    }
+
+    return lst;
+}
+
+void Scene::addAnimation(std::unique_ptr<Animation> && animation)
+{
+    // Check if animation is valid
+    if (!animation.get()) {
+        return;
+    }
+
+    // Add animation
+    m_animations.push_back(std::move(animation));
+}
+
+std::vector<Skin *> Scene::skins() const
+{
+    std::vector<Skin *> lst;
+
+    for (auto & skin : m_skins) {
+        lst.push_back(skin.get());
+    }
+
+    return lst;
+}
+
+void Scene::addSkin(std::unique_ptr<Skin> && skin)
+{
+    // Check if skin is valid
+    if (!skin.get()) {
+        return;
+    }
+
+    // Add skin
+    m_skins.push_back(std::move(skin));
+}
+
+const glm::vec3 & Scene::boundingBoxMin() const
+{
+    return m_boundingBoxMin;
+}
+
+const glm::vec3 & Scene::boundingBoxMax() const
+{
+    return m_boundingBoxMax;
+}
+
+void Scene::setBoundingBox(const glm::vec3 & min, const glm::vec3 & max)
+{
+    m_boundingBoxMin = min;
+    m_boundingBoxMax = max;
+}
+
 
 } // namespace rendercore
@@ -0,0 +1,69 @@
+
+#include <rendercore/scene/SceneArena.h>
+
+
+namespace rendercore
+{
+
+
+SceneArena::SceneArena()
+: m_used(0)
+, m_size(0)
+{
+}
+
+SceneArena::~SceneArena()
+{
+    // Destroy objects in reverse order of their creation
+    for (auto it = m_objects.rbegin(); it != m_objects.rend(); ++it) {
+        if (it->first) {
+            it->second(it->first);
+        }
+    }
+}
+
+size_t SceneArena::count() const
+{
+    return m_objects.size();
+}
+
+size_t SceneArena::size() const
+{
+    return m_size;
+}
+
+void * SceneArena::allocate(size_t size, size_t alignment)
+{
+    // Allocate a block of its own for large objects (keep using the current block afterwards)
+    if (size > blockSize() / 4) {
+        std::unique_ptr<char[]> block(new char[size]);
+        char * memory = block.get();
+
+        m_blocks.insert(m_blocks.empty() ? m_blocks.end() : m_blocks.end() - 1, std::move(block));
+        m_size += size;
+
+        return memory;
+    }
+
+    // Align position in current block
+    size_t offset = (m_used + alignment - 1) & ~(alignment - 1);
+
+    // Start new block if the object does not fit
+    if (m_blocks.empty() || offset + size > blockSize()) {
+        m_blocks.push_back(std::unique_ptr<char[]>(new char[blockSize()]));
+        m_size += blockSize();
+        offset = 0;
+    }
+
+    // Use memory
+    m_used = offset + size;
+    return m_blocks.back().get() + offset;
+}
+
+size_t SceneArena::blockSize()
+{
+    return 64 * 1024;
+}
+
+
+} // namespace rendercore
@@ -1,6 +1,8 @@
 
 #include <rendercore/scene/SceneNode.h>
 
+#include <algorithm>
+
 
 namespace rendercore
 {
@@ -20,7 +22,7 @@ SceneNode * SceneNode::parent() const
     return m_parent;
 }
 
-const std::vector< std::unique_ptr<SceneNode> > & SceneNode::children() const
+const std::vector<SceneNode *> & SceneNode::children() const
 {
     return m_children;
 }
@@ -32,14 +34,56 @@ void SceneNode::addChild(std::unique_ptr<SceneNode> && node)
         return;
     }
 
+    // Add to list
+    addChild(node.get());
+
+    // Take ownership
+    m_ownedChildren.push_back(std::move(node));
+}
+
+void SceneNode::addChild(SceneNode * node)
+{
+    // Check if node is valid
+    if (!node) {
+        return;
+    }
+
     // Set parent
     node->m_parent = this;
 
     // Add to list
-    m_children.push_back(std::move(node));
+    m_children.push_back(node);
+}
+
+std::unique_ptr<SceneNode> SceneNode::removeChild(SceneNode * node)
+{
+    // Find child node
+    auto it = std::find(m_children.begin(), m_children.end(), node);
+    if (it == m_children.end()) {
+        // Not a child of this node
+        return nullptr;
+    }
+
+    // Remove from list
+    m_children.erase(it);
+
+    // Reset parent
+    node->m_parent = nullptr;
+
+    // Release ownership
+    for (auto ownedIt = m_ownedChildren.begin(); ownedIt != m_ownedChildren.end(); ++ownedIt) {
+        if (ownedIt->get() == node) {
+            std::unique_ptr<SceneNode> child = std::move(*ownedIt);
+            m_ownedChildren.erase(ownedIt);
+            return child;
+        }
+    }
+
+    // Node is not owned by this node
+    return nullptr;
 }
 
-const std::vector< std::unique_ptr<SceneNodeComponent> > & SceneNode::components() const
+const std::vector<SceneNodeComponent *> & SceneNode::components() const
 {
     return m_components;
 }
@@ -51,11 +95,25 @@ void SceneNode::addComponent(std::unique_ptr<SceneNodeComponent> && component)
         return;
     }
 
+    // Add to list
+    addComponent(component.get());
+
+    // Take ownership
+    m_ownedComponents.push_back(std::move(component));
+}
+
+void SceneNode::addComponent(SceneNodeComponent * component)
+{
+    // Check if component is valid
+    if (!component) {
+        return;
+    }
+
     // Set node
     component->m_node = this;
 
     // Add to list
-    m_components.push_back(std::move(component));
+    m_components.push_back(component);
 }
 
 const Transform & SceneNode::transform() const
@@ -64,11 +122,43 @@ const Transform & SceneNode::transform() const
     return m_transform;
 }
 
+Transform & SceneNode::transform()
+{
+    // Return transformation
+    return m_transform;
+}
+
 void SceneNode::setTransform(const Transform & transform)
 {
     // Set transformation
     m_transform = transform;
 }
 
+glm::mat4 SceneNode::globalTransform() const
+{
+    // Accumulate transformations up to the root
+    glm::mat4 transform = m_transform.transform();
+    for (const SceneNode * node = m_parent; node; node = node->m_parent) {
+        transform = node->m_transform.transform() * transform;
+    }
+
+    return transform;
+}
+
+const std::vector<float> & SceneNode::morphWeights() const
+{
+    return m_morphWeights;
+}
+
+std::vector<float> & SceneNode::morphWeights()
+{
+    return m_morphWeights;
+}
+
+void SceneNode::setMorphWeights(const std::vector<float> & weights)
+{
+    m_morphWeights = weights;
+}
+
 
 } // namespace rendercore
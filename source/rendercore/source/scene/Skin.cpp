@@ -0,0 +1,148 @@
+
+#include <rendercore/scene/Skin.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define SKIN_SSE2
+    #include <emmintrin.h>
+#endif
+
+#include <rendercore/scene/SceneNode.h>
+
+
+namespace
+{
+
+
+// Multiply 4x4 matrices (result must not be one of the operands)
+void multiply(const glm::mat4 & a, const glm::mat4 & b, glm::mat4 & result)
+{
+#ifdef SKIN_SSE2
+    const float * lhs = &a[0][0];
+    const float * rhs = &b[0][0];
+    float       * res = &result[0][0];
+
+    const __m128 a0 = _mm_loadu_ps(lhs + 0);
+    const __m128 a1 = _mm_loadu_ps(lhs + 4);
+    const __m128 a2 = _mm_loadu_ps(lhs + 8);
+    const __m128 a3 = _mm_loadu_ps(lhs + 12);
+
+    // Each column of the result is a combination of the columns of a
+    for (int i=0; i<4; i++) {
+        const __m128 column = _mm_loadu_ps(rhs + i * 4);
+
+        __m128 value = _mm_mul_ps(a0, _mm_shuffle_ps(column, column, _MM_SHUFFLE(0, 0, 0, 0)));
+        value = _mm_add_ps(value, _mm_mul_ps(a1, _mm_shuffle_ps(column, column, _MM_SHUFFLE(1, 1, 1, 1))));
+        value = _mm_add_ps(value, _mm_mul_ps(a2, _mm_shuffle_ps(column, column, _MM_SHUFFLE(2, 2, 2, 2))));
+        value = _mm_add_ps(value, _mm_mul_ps(a3, _mm_shuffle_ps(column, column, _MM_SHUFFLE(3, 3, 3, 3))));
+
+        _mm_storeu_ps(res + i * 4, value);
+    }
+#else
+    result = a * b;
+#endif
+}
+
+
+} // namespace
+
+
+namespace rendercore
+{
+
+
+Skin::Skin()
+{
+}
+
+Skin::~Skin()
+{
+}
+
+const std::string & Skin::name() const
+{
+    return m_name;
+}
+
+void Skin::setName(const std::string & name)
+{
+    m_name = name;
+}
+
+const std::vector<SceneNode *> & Skin::joints() const
+{
+    return m_joints;
+}
+
+const std::vector<glm::mat4> & Skin::inverseBindMatrices() const
+{
+    return m_inverseBindMatrices;
+}
+
+void Skin::setJoints(const std::vector<SceneNode *> & joints, const std::vector<glm::mat4> & inverseBindMatrices)
+{
+    // Save joints and inverse bind matrices
+    m_joints              = joints;
+    m_inverseBindMatrices = inverseBindMatrices;
+    m_inverseBindMatrices.resize(joints.size(), glm::mat4(1.0f));
+    m_globals.resize(joints.size());
+
+    // Find parent joint of each joint
+    std::unordered_map<const SceneNode *, int> jointIndices;
+    for (size_t i=0; i<joints.size(); i++) {
+        jointIndices[joints[i]] = static_cast<int>(i);
+    }
+
+    m_parents.assign(joints.size(), -1);
+    std::vector<unsigned int> depths(joints.size(), 0);
+
+    for (size_t i=0; i<joints.size(); i++) {
+        auto it = jointIndices.find(joints[i]->parent());
+        if (it != jointIndices.end()) {
+            m_parents[i] = it->second;
+        }
+
+        for (const SceneNode * node = joints[i]->parent(); node; node = node->parent()) {
+            depths[i]++;
+        }
+    }
+
+    // Sort joints by depth, so parents are processed before their children
+    m_order.resize(joints.size());
+    for (size_t i=0; i<joints.size(); i++) {
+        m_order[i] = i;
+    }
+
+    std::stable_sort(m_order.begin(), m_order.end(), [&depths] (size_t a, size_t b) {
+        return depths[a] < depths[b];
+    });
+}
+
+void Skin::computeJointMatrices(const glm::mat4 & meshTransform, std::vector<glm::mat4> & jointMatrices)
+{
+    // Calculate transformation of each joint relative to the scene root
+    for (size_t i : m_order) {
+        const SceneNode * joint = m_joints[i];
+
+        if (m_parents[i] >= 0) {
+            multiply(m_globals[m_parents[i]], joint->transform().transform(), m_globals[i]);
+        } else {
+            m_globals[i] = joint->globalTransform();
+        }
+    }
+
+    // Calculate joint matrices relative to the mesh
+    const glm::mat4 inverseMesh = glm::inverse(meshTransform);
+    glm::mat4 joint;
+
+    jointMatrices.resize(m_joints.size());
+    for (size_t i=0; i<m_joints.size(); i++) {
+        multiply(inverseMesh, m_globals[i], joint);
+        multiply(joint, m_inverseBindMatrices[i], jointMatrices[i]);
+    }
+}
+
+
+} // namespace rendercore
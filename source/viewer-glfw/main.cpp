@@ -8,6 +8,7 @@
 
 #include <rendercore/rendercore.h>
 #include <rendercore/Canvas.h>
+#include <rendercore/ImageLoader.h>
 
 #include <rendercore-glfw/Application.h>
 #include <rendercore-glfw/RenderWindow.h>
@@ -33,6 +34,14 @@ int main(int argc, char * argv[])
     argumentParser.parse(argc, argv);
 
     const auto contextString = argumentParser.value("--context");
+    const auto cacheString   = argumentParser.value("--cache");
+
+    // Enable cache for decoded images
+    if (!cacheString.empty())
+    {
+        ImageLoader::setCacheDirectory(cacheString);
+        ImageLoader::setCacheMipmaps(true);
+    }
 
     // Initialize GLFW
     Application::init();